@@ -0,0 +1,72 @@
+#include "TaskCancelScope.h"
+#include "common/StripedCounter.h"
+#include <algorithm>
+
+namespace task
+{
+void TaskCancelScope::track(const TaskOperatorPtr& task)
+{
+    if (task == nullptr)
+    {
+        return;
+    }
+
+    auto&                       stripe = mStripes[currentStripe(kStripes)];
+    std::lock_guard<std::mutex> lock(stripe.mMutex);
+    stripe.mTasks.emplace_back(task);
+    if (stripe.mTasks.size() >= stripe.mPruneAt)
+    {
+        _prune(stripe);
+    }
+}
+
+size_t TaskCancelScope::cancel()
+{
+    size_t cancelled = 0;
+    for (auto& stripe : mStripes)
+    {
+        // 取出记录后在锁外取消， 取消时释放的资源可能再次提交任务
+        std::vector<std::weak_ptr<TaskOperator>> tasks;
+        {
+            std::lock_guard<std::mutex> lock(stripe.mMutex);
+            tasks.swap(stripe.mTasks);
+            stripe.mPruneAt = kMinPrune;
+        }
+
+        for (auto& weakTask : tasks)
+        {
+            auto task = weakTask.lock();
+            if (task && !task->isCancelled())
+            {
+                task->cancel();
+                ++cancelled;
+            }
+        }
+    }
+    return cancelled;
+}
+
+size_t TaskCancelScope::trackedCount() const
+{
+    size_t count = 0;
+    for (auto& stripe : mStripes)
+    {
+        std::lock_guard<std::mutex> lock(stripe.mMutex);
+        count += stripe.mTasks.size();
+    }
+    return count;
+}
+
+void TaskCancelScope::_prune(Stripe& stripe)
+{
+    auto& tasks = stripe.mTasks;
+    // 只判断是否已释放， 持锁时不能持有任务 (最后一个引用在锁内释放时， 任务析构可能再次提交任务)
+    tasks.erase(std::remove_if(tasks.begin(), tasks.end(),
+                               [](const std::weak_ptr<TaskOperator>& weakTask) { return weakTask.expired(); }),
+                tasks.end());
+
+    // 清理后仍有效的记录翻倍时再清理， 均摊O(1)
+    stripe.mPruneAt = std::max(kMinPrune, tasks.size() * 2);
+}
+
+}  // namespace task
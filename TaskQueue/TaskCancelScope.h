@@ -0,0 +1,66 @@
+// 取消作用域
+// 记录提交的任务， 一次调用取消其中所有未执行的任务
+// 每个队列与任务组各有一个作用域 (TaskQueue::cancelAll / TaskGroup::cancelAll)；
+// 也可以自行创建作为标签， 通过 TaskOperator::setCancelScope 标记任务， 任务提交到队列/任务组时记录
+//
+// 取消时立即释放任务捕获的资源 (任务正在执行时在执行结束后释放)， 队列中只留下空任务， 出队时跳过
+// 记录按CPU分片， 只持有任务的弱引用， 已释放的任务按需清理
+//
+// eg:
+// auto scope = std::make_shared<TaskCancelScope>();
+// auto task  = std::make_shared<TaskOperator>(...);
+// task->setCancelScope(scope);
+// queue->async(task);
+// scope->cancel();
+
+#ifndef __TASK_CANCEL_SCOPE_H__
+#define __TASK_CANCEL_SCOPE_H__
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "TaskOperator.h"
+#include "TaskQueueDefine.h"
+namespace task
+{
+class TaskCancelScope final
+{
+public:
+    TaskCancelScope()  = default;
+    ~TaskCancelScope() = default;
+
+    TaskCancelScope(const TaskCancelScope&)            = delete;
+    TaskCancelScope& operator=(const TaskCancelScope&) = delete;
+
+    // 记录任务 【由队列/任务组在提交时调用】
+    void track(const TaskOperatorPtr& task);
+
+    // 取消所有已记录且仍存在的任务， 返回本次取消的任务数 (不含已取消的任务)
+    // 作用域可以继续使用， 之后提交的任务不受影响
+    size_t cancel();
+
+    // 当前记录的任务数 (包含已执行完但还未清理的记录)
+    size_t trackedCount() const;
+
+private:
+    static constexpr size_t kStripes  = 8;
+    static constexpr size_t kMinPrune = 64;
+
+    struct alignas(64) Stripe
+    {
+        mutable std::mutex                       mMutex;
+        std::vector<std::weak_ptr<TaskOperator>> mTasks;
+        size_t                                   mPruneAt{ kMinPrune };  // 达到该数量时清理无效记录
+    };
+
+    // 清理已释放的任务 【持锁调用】
+    static void _prune(Stripe& stripe);
+
+    std::array<Stripe, kStripes> mStripes;
+};
+
+}  // namespace task
+
+#endif  // __TASK_CANCEL_SCOPE_H__
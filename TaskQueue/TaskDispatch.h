@@ -5,6 +5,13 @@
 #include "TaskOperator.h"
 #include "TaskQueue.h"
 #include "TaskGroup.h"
+#include "TaskGraph.h"
+#include "TaskPipeline.h"
+#include "TaskCancelScope.h"
+#include "TaskParallel.h"
+#include "TaskForkJoin.h"
+#include "TaskReactor.h"
+#include "TaskFileIo.h"
 #include "TaskQueueFactory.h"
 
 #endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "TaskFileIo.h"
+#include "TaskQueueDefine.h"
+#include "backend/IFileIoImpl.h"
+#include "TaskQueueFactory.h"
+#include "common/LogHelper.h"
+namespace task
+{
+static bool submitRequest(IFileIoImpl& impl, IFileIoImpl::Op op, int fd, void* buf, size_t len, uint64_t offset, const TaskQueuePtr& queue,
+                          TaskFileIo::Completion&& done)
+{
+    if (fd < 0 || !done)
+    {
+        LOGE("[TASK]TaskFileIo::submit invalid argument, fd: %d", fd);
+        return false;
+    }
+
+    auto request     = std::make_unique<IFileIoImpl::Request>();
+    request->mOp     = op;
+    request->mFd     = fd;
+    request->mBuf    = buf;
+    request->mLen    = len;
+    request->mOffset = offset;
+    request->mQueue  = queue ? queue : TaskQueueFactory::GetInstance().globalConcurrencyQueue(TaskQueuePriority::TQP_Normal);
+    request->mDone   = std::move(done);
+    return impl.submit(std::move(request));
+}
+
+bool TaskFileIo::read(int fd, void* buf, size_t len, uint64_t offset, const TaskQueuePtr& queue, Completion&& done)
+{
+    return submitRequest(*mFileIoImpl, IFileIoImpl::FO_Read, fd, buf, len, offset, queue, std::move(done));
+}
+
+bool TaskFileIo::write(int fd, const void* buf, size_t len, uint64_t offset, const TaskQueuePtr& queue, Completion&& done)
+{
+    return submitRequest(*mFileIoImpl, IFileIoImpl::FO_Write, fd, const_cast<void*>(buf), len, offset, queue, std::move(done));
+}
+
+bool TaskFileIo::fsync(int fd, const TaskQueuePtr& queue, Completion&& done, bool dataOnly)
+{
+    return submitRequest(*mFileIoImpl, dataOnly ? IFileIoImpl::FO_Fdatasync : IFileIoImpl::FO_Fsync, fd, nullptr, 0, 0, queue,
+                         std::move(done));
+}
+
+TaskFileIoBackend TaskFileIo::backend() const
+{
+    return mFileIoImpl->backend();
+}
+
+TaskFileIoStat TaskFileIo::stat() const
+{
+    return mFileIoImpl->stat();
+}
+
+}  // namespace task
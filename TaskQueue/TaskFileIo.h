@@ -0,0 +1,61 @@
+// 异步文件IO
+// 读/写/fsync 提交后立即返回， 完成后在指定队列上执行回调， 工作线程不会阻塞在磁盘上
+// 优先使用 io_uring： 请求积累后一次批量提交， 一个IO线程收割完成事件； io_uring 不可用时回退到独立的IO线程执行阻塞读写
+// 回调参数为读写的字节数 (可能少于请求长度) 或 -errno； 缓冲区在回调执行前需保持有效
+// 回调投递不受队列的速率限制、 降载与容量限制， 每个请求都会回调 (线程池已关闭时为 -ECANCELED)
+// 释放最后一个引用时等待已提交的请求完成
+//
+// eg:
+// auto io  = TaskQueueFactory::GetInstance().createTaskFileIo();
+// auto buf = std::make_shared<std::vector<char>>(4096);
+// io->read(fd, buf->data(), buf->size(), 0, queue, [buf](int64_t result) {
+//     if (result < 0) { ... }
+//     parse(buf->data(), result);
+// });
+
+#ifndef __TASK_FILE_IO_H__
+#define __TASK_FILE_IO_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "TaskQueueDefine.h"
+namespace task
+{
+class IFileIoImpl;
+class TaskFileIo final
+{
+public:
+    using Completion = std::function<void(int64_t result)>;
+
+public:
+    explicit TaskFileIo(const std::shared_ptr<IFileIoImpl>& fileIoImpl)
+        : mFileIoImpl(fileIoImpl)
+    {
+    }
+
+    ~TaskFileIo() = default;
+
+    // 从 offset 读取最多 len 字节到 buf， queue为空时在全局并行队列(TQP_Normal)执行回调
+    // 参数无效或已停止返回false (不会回调)
+    bool read(int fd, void* buf, size_t len, uint64_t offset, const TaskQueuePtr& queue, Completion&& done);
+
+    // 把 buf 中 len 字节写到 offset
+    bool write(int fd, const void* buf, size_t len, uint64_t offset, const TaskQueuePtr& queue, Completion&& done);
+
+    // 刷盘， dataOnly 为 true 时只刷数据 (fdatasync)， 成功时结果为0
+    bool fsync(int fd, const TaskQueuePtr& queue, Completion&& done, bool dataOnly = false);
+
+    // 实际使用的后端
+    TaskFileIoBackend backend() const;
+
+    TaskFileIoStat stat() const;
+
+private:
+    std::shared_ptr<IFileIoImpl> mFileIoImpl;
+};
+
+}  // namespace task
+
+#endif  // __TASK_FILE_IO_H__
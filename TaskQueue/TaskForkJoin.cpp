@@ -0,0 +1,57 @@
+#include "TaskForkJoin.h"
+#include <chrono>
+#include "backend/ForkJoinScheduler.h"
+namespace task
+{
+TaskForkJoin::~TaskForkJoin()
+{
+    join();
+}
+
+void TaskForkJoin::spawn(Func&& f)
+{
+    if (!f)
+    {
+        return;
+    }
+
+    mPending.fetch_add(1, std::memory_order_relaxed);
+    ForkJoinScheduler::GetInstance().push(new ForkJoinScheduler::Job{ std::move(f), this });
+}
+
+void TaskForkJoin::join()
+{
+    auto& scheduler = ForkJoinScheduler::GetInstance();
+    while (mPending.load(std::memory_order_acquire) > 0)
+    {
+        // 优先执行自己未被窃取的子任务， 其次帮助其他线程
+        auto job = scheduler.popLocal(this);
+        if (job == nullptr)
+        {
+            job = scheduler.steal();
+        }
+        if (job != nullptr)
+        {
+            scheduler.run(job);
+            continue;
+        }
+
+        // 剩余子任务都在其他线程执行中， 短暂等待后再尝试窃取
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCond.wait_for(lock, std::chrono::milliseconds(1), [this] { return mPending.load(std::memory_order_acquire) == 0; });
+    }
+
+    // 等待最后一个子任务的执行线程释放锁， 之后作用域才可以析构
+    std::lock_guard<std::mutex> lock(mMutex);
+}
+
+void TaskForkJoin::_onChildFinished()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mPending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        mCond.notify_all();
+    }
+}
+
+}  // namespace task
@@ -0,0 +1,63 @@
+// 分治任务 (fork-join)
+// spawn 把子任务压入当前线程的本地双端队列 (后进先出)， 并行线程池的空闲线程从队列另一端窃取
+// join 不阻塞等待： 先执行本地队列中本作用域未被窃取的子任务， 再从其他线程窃取任务执行， 都没有时才短暂等待
+// 递归深度只增加调用栈， 不占用额外的线程， 在任务中递归调用不会让线程池不断创建线程
+// 作用域析构时自动 join， 子任务可以引用作用域所在栈帧的变量
+//
+// eg:
+// long fib(int n)
+// {
+//     if (n < 20) return fibSerial(n);
+//     long         a = 0;
+//     TaskForkJoin scope;
+//     scope.spawn([&a, n] { a = fib(n - 1); });
+//     long b = fib(n - 2);
+//     scope.join();
+//     return a + b;
+// }
+
+#ifndef __TASK_FORK_JOIN_H__
+#define __TASK_FORK_JOIN_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include "TaskQueueDefine.h"
+namespace task
+{
+class ForkJoinScheduler;
+class TaskForkJoin final
+{
+public:
+    using Func = std::function<void()>;
+
+public:
+    TaskForkJoin() = default;
+    ~TaskForkJoin();
+
+    TaskForkJoin(const TaskForkJoin&)            = delete;
+    TaskForkJoin& operator=(const TaskForkJoin&) = delete;
+
+    // 派生子任务 【只能在创建作用域的线程调用】
+    void spawn(Func&& f);
+
+    // 等待所有子任务完成， 等待期间执行子任务或窃取其他任务 【只能在创建作用域的线程调用】
+    void join();
+
+private:
+    friend class ForkJoinScheduler;
+
+    // 子任务执行完成， 由执行线程回调
+    void _onChildFinished();
+
+private:
+    std::atomic<int32_t>    mPending{ 0 };  // 未完成的子任务数
+    std::mutex              mMutex;
+    std::condition_variable mCond;
+};
+
+}  // namespace task
+
+#endif  // __TASK_FORK_JOIN_H__
@@ -0,0 +1,53 @@
+#include "TaskGraph.h"
+#include "TaskQueueDefine.h"
+#include "backend/GraphImpl.h"
+#include "TaskQueueFactory.h"
+#include "TaskQueue.h"
+namespace task
+{
+TaskGraph::NodeId TaskGraph::addNode(const TaskOperatorPtr& task, const TaskQueuePtr& queue)
+{
+    auto q = queue;
+    if (q == nullptr)
+    {
+        q = TaskQueueFactory::GetInstance().globalConcurrencyQueue(TaskQueuePriority::TQP_Normal);
+    }
+    return mGraphImpl->addNode(task, q);
+}
+
+bool TaskGraph::addEdge(NodeId from, NodeId to)
+{
+    return mGraphImpl->addEdge(from, to);
+}
+
+bool TaskGraph::run()
+{
+    return mGraphImpl->run(nullptr, nullptr);
+}
+
+bool TaskGraph::run(const TaskOperatorPtr& task, const TaskQueuePtr& queue)
+{
+    auto q = queue;
+    if (q == nullptr)
+    {
+        q = TaskQueueFactory::GetInstance().globalConcurrencyQueue(TaskQueuePriority::TQP_Normal);
+    }
+    return mGraphImpl->run(task, q);
+}
+
+bool TaskGraph::wait(std::chrono::milliseconds t)
+{
+    return mGraphImpl->wait(t);
+}
+
+size_t TaskGraph::nodeCount() const
+{
+    return mGraphImpl->nodeCount();
+}
+
+size_t TaskGraph::skippedCount() const
+{
+    return mGraphImpl->skippedCount();
+}
+
+}  // namespace task
@@ -0,0 +1,85 @@
+// 任务图 (DAG)
+// 节点绑定到指定队列执行，边表示依赖关系：from 完成后 to 才能执行
+// 节点通过原子前驱计数就绪，前驱全部完成的瞬间即投递到对应队列，执行线程不阻塞等待
+// 同一个图可以重复运行，运行期间不再分配节点对象
+// 节点被丢弃时其后继节点不再执行，仍计为结束，wait() 不会卡住
+//
+// eg:
+// auto graph = TaskQueueFactory::GetInstance().createTaskGraph();
+// auto a = graph->addNode([] { ... });
+// auto b = graph->addNode([] { ... }, serialQueue);
+// graph->addEdge(a, b);
+// graph->run();
+// graph->wait();
+
+#ifndef __TASK_GRAPH_H__
+#define __TASK_GRAPH_H__
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "TaskOperator.h"
+#include "TaskQueueDefine.h"
+namespace task
+{
+class GraphImpl;
+class TaskGraph final
+{
+public:
+    using Func   = std::function<void()>;
+    using NodeId = int32_t;  // 节点ID， -1 表示无效节点
+
+public:
+    explicit TaskGraph(const std::shared_ptr<GraphImpl>& graphImpl)
+        : mGraphImpl(graphImpl)
+    {
+    }
+
+    ~TaskGraph() = default;
+
+    // 添加节点， queue为空时在全局并行队列(TQP_Normal)执行
+    // 图运行中添加返回 -1
+    NodeId addNode(const TaskOperatorPtr& task, const TaskQueuePtr& queue = nullptr);
+    NodeId addNode( Func&& f, const TaskQueuePtr& queue = nullptr)
+    {
+        auto task = std::make_shared<TaskOperator>([f](const TaskOperatorPtr&) {
+            f();
+        });
+        return addNode(task, queue);
+    }
+
+    // 添加依赖边 from -> to
+    // 节点不存在、自环、图运行中返回false
+    bool addEdge(NodeId from, NodeId to);
+
+    // 异步运行整个图
+    // 图正在运行或存在环时返回false
+    bool run();
+
+    // 异步运行整个图， 所有节点完成后在指定queue上异步通知
+    bool run(const TaskOperatorPtr& task, const TaskQueuePtr& queue = nullptr);
+    bool run( Func&& f, const TaskQueuePtr& queue = nullptr)
+    {
+        auto task = std::make_shared<TaskOperator>([f](const TaskOperatorPtr&) {
+            f();
+        });
+        return run(task, queue);
+    }
+
+    // 等待本次运行结束， 超时返回false
+    bool wait(std::chrono::milliseconds t = std::chrono::milliseconds(-1));
+
+    // 节点数量
+    size_t nodeCount() const;
+
+    // 本次运行未执行的节点数量： 被丢弃 (队列取消/拒绝/错过截止时间等) 的节点， 及其所有后继节点
+    size_t skippedCount() const;
+
+private:
+    std::shared_ptr<GraphImpl> mGraphImpl;
+};
+
+}  // namespace task
+
+#endif  // __TASK_GRAPH_H__
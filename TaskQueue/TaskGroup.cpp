@@ -35,4 +35,9 @@ bool TaskGroup::wait(std::chrono::milliseconds t)
     return mGroupImpl->wait(t);
 }
 
+size_t TaskGroup::cancelAll()
+{
+    return mGroupImpl->cancelAll();
+}
+
 }  // namespace task
\ No newline at end of file
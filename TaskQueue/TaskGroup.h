@@ -58,6 +58,10 @@ public:
     // group 等待所有任务结束
     bool wait(std::chrono::milliseconds t = std::chrono::milliseconds(-1));
 
+    // 取消所有经过任务组提交且还未执行的任务， 返回取消的任务数
+    // 立即释放任务捕获的资源， 被取消的任务同样计为完成， wait不会卡住
+    size_t cancelAll();
+
 private:
     std::shared_ptr<GroupImpl> mGroupImpl;
 };
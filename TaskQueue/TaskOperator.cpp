@@ -1,17 +1,25 @@
 #include "TaskOperator.h"
 #include "common/HETimerHelper.h"
+#include <algorithm>
 #include <string>
 #include <thread>
 namespace task
 {
+static uint64_t nextTaskId()
+{
+    static std::atomic<uint64_t> sTaskId{ 1 };
+    return sTaskId.fetch_add(1, std::memory_order_relaxed);
+}
 
 TaskOperator::TaskOperator()
+    : mTaskId(nextTaskId())
 {
     resetCallStartTime();
 }
 
 TaskOperator::TaskOperator(CallBack callback)
     : mCallBack(std::move(callback))
+    , mTaskId(nextTaskId())
 {
     resetCallStartTime();
 }
@@ -22,44 +30,110 @@ void TaskOperator::operator()()
         // 任务已取消，不执行
         return;
     }
-    
+
+    // 标记执行中， 回调已释放时不再执行
+    auto runners = mRunners.load(std::memory_order_acquire);
+    do
+    {
+        if (runners < 0)
+        {
+            return;
+        }
+    } while (!mRunners.compare_exchange_weak(runners, runners + 1, std::memory_order_acq_rel));
+
     recordRunStart();
     if (mCallBack)
     {
         mCallBack(shared_from_this());
     }
     recordRunEnd();
+
+    // 执行期间被取消， 由最后一个执行线程释放 (与cancel的标记/释放均为seq_cst， 不会都错过)
+    if (mRunners.fetch_sub(1) == 1 && mIsCancelled.load())
+    {
+        _releaseCallBack();
+    }
+}
+
+void TaskOperator::cancel()
+{
+    mIsCancelled.store(true);
+    _releaseCallBack();
+}
+
+void TaskOperator::_releaseCallBack()
+{
+    int32_t idle = 0;
+    if (mRunners.compare_exchange_strong(idle, -1))
+    {
+        mCallBack = nullptr;
+    }
 }
 
 void TaskOperator::resetCallStartTime()
 {
-    mTaskCallStartTime = task::HETimerHelper::currentTimeMillis();
+    mTaskCallStartTime = task::HETimerHelper::microsecondTimestamp64();
+    if (mDeadlineBudget >= 0)
+    {
+        mDeadline = task::HETimerHelper::millisecondTimestamp64() + static_cast<uint64_t>(mDeadlineBudget);
+    }
+}
+
+void TaskOperator::setDeadline(std::chrono::milliseconds startWithin, bool dropIfMissed)
+{
+    mDeadlineBudget = std::max<int64_t>(startWithin.count(), 0);
+    mDropIfMissed   = dropIfMissed;
+    mDeadline       = task::HETimerHelper::millisecondTimestamp64() + static_cast<uint64_t>(mDeadlineBudget);
 }
 
 std::string TaskOperator::taskCostInfo() const
 {
-    return std::string("tskType:") + std::to_string(static_cast<int>(0))
-           + std::string(" tskWait: ") + std::to_string(mTaskRunStartTime - mTaskCallStartTime)
-           + std::string(" tskRun: ") + std::to_string(mTaskRunDuration);
+    return std::string("tskType:") + std::to_string(static_cast<int>(mCategory))
+           + std::string(" tskWait: ") + std::to_string(taskWaitDuration())
+           + std::string(" tskRun: ") + std::to_string(taskRunDuration());
 }
 
 uint64_t TaskOperator::taskRunDuration() const
 {
-    return mTaskRunDuration;
+    return mTaskRunDuration / 1000;
 }
 
 uint64_t TaskOperator::taskWaitDuration() const
 {
-    return mTaskRunStartTime - mTaskCallStartTime;
+    return taskWaitDurationMicros() / 1000;
+}
+
+uint64_t TaskOperator::taskRunDurationMicros() const
+{
+    return mTaskRunDuration;
+}
+
+uint64_t TaskOperator::taskCpuDurationMicros() const
+{
+    return mTaskCpuDuration;
+}
+
+uint64_t TaskOperator::taskWaitDurationMicros() const
+{
+    // 还未执行时没有等待耗时
+    return hasRunRecord() ? mTaskRunStartTime - mTaskCallStartTime : 0;
 }
 
 void TaskOperator::recordRunStart()
 {
-    mTaskRunStartTime = task::HETimerHelper::currentTimeMillis();
+    mTaskRunStartTime = task::HETimerHelper::microsecondTimestamp64();
+    if (mCategory != kNoTaskCategory)
+    {
+        mTaskCpuStartTime = task::HETimerHelper::threadCpuMicroseconds();
+    }
 }
 void TaskOperator::recordRunEnd()
 {
-    mTaskRunDuration = task::HETimerHelper::currentTimeMillis() - mTaskRunStartTime;
+    mTaskRunDuration = task::HETimerHelper::microsecondTimestamp64() - mTaskRunStartTime;
+    if (mCategory != kNoTaskCategory)
+    {
+        mTaskCpuDuration = task::HETimerHelper::threadCpuMicroseconds() - mTaskCpuStartTime;
+    }
 }
 
 }  // namespace task
\ No newline at end of file
@@ -1,5 +1,6 @@
 #ifndef __TASK_OPERATOR_H__
 #define __TASK_OPERATOR_H__
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <functional>
@@ -9,6 +10,7 @@
 #include "TaskQueueDefine.h"
 namespace task
 {
+class TaskCancelScope;
 class TaskOperator : public std::enable_shared_from_this<TaskOperator>
 {
 public:
@@ -33,29 +35,140 @@ public:
     }
 
     // 任务控制 - 新增取消功能
-    virtual void cancel() { mIsCancelled.store(true); }
+    // 取消后立即释放回调及其捕获的资源 (正在执行时在执行结束后释放)
+    virtual void cancel();
     virtual bool isCancelled() const { return mIsCancelled.load(); }
 
+    // 取消作用域 (标签)， 提交到队列/任务组时记录到该作用域 【入队前设置】
+    void setCancelScope(const std::shared_ptr<TaskCancelScope>& scope)
+    {
+        mCancelScope = scope;
+    }
+    const std::shared_ptr<TaskCancelScope>& cancelScope() const
+    {
+        return mCancelScope;
+    }
+
+    // 任务因队列已满被拒绝或丢弃， 不会再执行 【内部使用】
+    // 默认标记取消； 包装任务在此唤醒等待方 (同步任务/任务组/任务图)
+    virtual void discard() { cancel(); }
+
+    // 执行 (或跳过) 后统计已记录， 执行方之后不再访问任务 【内部使用】
+    // 周期任务在此之后才允许再次投递， 避免下一次入队与统计记录并发
+    virtual void onRecorded() {}
+
     // task push入队列时，重置时间
     void        resetCallStartTime();
     std::string taskCostInfo() const;
 
+    // 任务类别 (入队前设置)， 未分类的任务不读取CPU时间
+    void setCategory(TaskCategory category)
+    {
+        mCategory = category;
+    }
+    TaskCategory category() const
+    {
+        return mCategory;
+    }
+
+    // 毫秒
     uint64_t taskRunDuration() const;
     uint64_t taskWaitDuration() const;
-    
+    // 微秒
+    uint64_t taskRunDurationMicros() const;
+    uint64_t taskWaitDurationMicros() const;
+    uint64_t taskCpuDurationMicros() const;  // 线程CPU耗时， 只统计有类别的任务
+
+    // 任务ID (进程内唯一)
+    uint64_t taskId() const
+    {
+        return mTaskId;
+    }
+
+    // 本次入队后是否已经执行 (有执行耗时记录)
+    bool hasRunRecord() const
+    {
+        return mTaskRunStartTime != 0 && mTaskRunStartTime >= mTaskCallStartTime;
+    }
+
+    // 归属队列的统计 【内部使用， 由队列在入队时设置】
+    void setQueueStat(const std::shared_ptr<QueueStat>& stat)
+    {
+        mQueueStat = stat;
+    }
+    const std::shared_ptr<QueueStat>& queueStat() const
+    {
+        return mQueueStat;
+    }
+
+    // 必须投递的任务 (已完成的IO回调)： 入队时不受速率限制、 降载与容量限制 (仍占用空位) 【内部使用】
+    virtual bool isMandatory() const
+    {
+        return false;
+    }
+
+    // 任务占用了队列容量的一个空位 【内部使用， 由容量限制在入队前设置、 出队时清除】
+    void setHoldsSlot(bool holds)
+    {
+        mHoldsSlot = holds;
+    }
+    bool holdsSlot() const
+    {
+        return mHoldsSlot;
+    }
+
+    // 截止时间： 入队后需要在startWithin内开始执行 【只用于并行队列， 进入EDF通道优先调度】
+    // dropIfMissed: 开始执行时已错过截止时间， 不再执行
+    void setDeadline(std::chrono::milliseconds startWithin, bool dropIfMissed = false);
+    bool hasDeadline() const
+    {
+        return mDeadlineBudget >= 0;
+    }
+    // 截止时间点 (steady clock 毫秒)
+    uint64_t deadline() const
+    {
+        return mDeadline;
+    }
+    std::chrono::milliseconds deadlineBudget() const
+    {
+        return std::chrono::milliseconds(mDeadlineBudget);
+    }
+    bool dropIfMissed() const
+    {
+        return mDropIfMissed;
+    }
+
 private:
     CallBack                      mCallBack{ nullptr };
     mutable std::shared_ptr<void> mUserData{ nullptr };
 
     std::atomic<bool>            mIsCancelled{ false };  // 任务取消标记
+    std::atomic<int32_t>         mRunners{ 0 };          // 正在执行回调的线程数， -1表示回调已释放
+    uint64_t                     mTaskId{ 0 };
+    std::shared_ptr<QueueStat>   mQueueStat{ nullptr };
+    std::shared_ptr<TaskCancelScope> mCancelScope{ nullptr };
+
+    int64_t  mDeadlineBudget{ -1 };  // 入队后允许等待的时间， -1表示无截止时间
+    uint64_t mDeadline{ 0 };         // 截止时间点， 每次入队时重新计算
+    bool     mDropIfMissed{ false };
+    bool     mHoldsSlot{ false };  // 占用队列容量的空位
+
+    TaskCategory mCategory{ kNoTaskCategory };
 
 protected:
+    // 单调时钟， 微秒
     uint64_t mTaskCallStartTime{ 0 };  ///调用开始时间
     uint64_t mTaskRunStartTime{ 0 };   ///任务开始时间  (mTaskRunStartTime - mTaskCallStartTime) 在队列中等待执行时间
-    uint32_t mTaskRunDuration{ 0 };    ///任务执行时间
+    uint64_t mTaskRunDuration{ 0 };    ///任务执行时间
+    uint64_t mTaskCpuStartTime{ 0 };   ///任务开始时的线程CPU时间
+    uint64_t mTaskCpuDuration{ 0 };    ///任务执行的线程CPU时间
 
     void recordRunStart();
     void recordRunEnd();
+
+private:
+    // 已取消且没有线程在执行时释放回调
+    void _releaseCallBack();
 };
 }  // namespace task
 
@@ -0,0 +1,16 @@
+#include "TaskParallel.h"
+#include "backend/ParallelLoop.h"
+
+namespace task
+{
+void parallelForRange(size_t begin, size_t end, const ParallelRangeFunc& func, const TaskParallelOptions& options)
+{
+    ParallelLoop::run(begin, end, func, options);
+}
+
+size_t parallelConcurrency(const TaskParallelOptions& options)
+{
+    return ParallelLoop::workers(options) + 1;
+}
+
+}  // namespace task
@@ -0,0 +1,322 @@
+// 并行算法
+// parallelFor 把下标区间 [begin, end) 切分成块在并行线程池上执行， 每个块只有一次函数调用， 不为每个元素创建任务
+// 工作线程按块从共享游标领取， 先分大块， 剩余越少块越小， 执行快的线程自然多领， 不需要预先均分
+// 调用线程同样领取块执行， 不阻塞在wait上； 所有块执行完后返回， 可以在任务中嵌套调用 (工作线程全忙时由调用线程执行完)
+// 块边界默认对齐到64的整数倍下标， 按下标写入的输出数组 (首地址按缓存行对齐) 不同块不会写同一缓存行
+//
+// eg:
+// std::vector<float> out(n);
+// parallelFor(0, n, [&](size_t i) { out[i] = f(in[i]); });
+// parallelForRange(0, n, [&](size_t first, size_t last) { ... });
+//
+// parallelReduce / transformReduce 把区间按下标切成固定的块， 每个块在局部变量上累加， 结果写入该块自己的槽位 (不需要原子操作与锁)
+// 块划分只与元素数和 mGrain 有关， 与线程数、执行顺序无关； 所有块完成后按下标两两合并 (树形)， 浮点等非结合运算每次结果相同
+// combine 需要满足结合律， 不要求交换律
+//
+// eg:
+// double sum = parallelReduce(0, n, 0.0, [&](size_t i) { return v[i]; }, std::plus<double>());
+// double dot = transformReduce(a.begin(), a.end(), 0.0, std::plus<double>(), [](double x) { return x * x; });
+//
+// parallelSort / parallelStableSort 为并行归并排序： 区间切成 2 的幂个块各自排序， 再逐轮两两归并 (在临时缓冲区与原区间之间交替)
+// 每轮按输出位置切分， 每段用二分查找定位两侧的起点 (merge path)， 所有段并行归并， 最后一轮的单次大归并同样并行
+// 元素数不超过顺序阈值 (默认 kParallelSortCutoff， mGrain 指定) 时直接调用 std::sort / std::stable_sort
+// 元素需要可默认构造与移动 (临时缓冲区)
+//
+// eg:
+// parallelSort(records.begin(), records.end(), [](const Record& a, const Record& b) { return a.mKey < b.mKey; });
+
+#ifndef __TASK_PARALLEL_H__
+#define __TASK_PARALLEL_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "TaskQueueDefine.h"
+namespace task
+{
+using ParallelRangeFunc = std::function<void(size_t first, size_t last)>;
+
+// 按块执行 [begin, end)， 每个块调用一次 func(first, last)
+void parallelForRange(size_t begin, size_t end, const ParallelRangeFunc& func, const TaskParallelOptions& options = TaskParallelOptions());
+
+// 可参与执行的线程数 (含调用线程)
+size_t parallelConcurrency(const TaskParallelOptions& options = TaskParallelOptions());
+
+// 逐个下标执行 func(i)， 块内循环在调用方展开
+template <typename Func>
+void parallelFor(size_t begin, size_t end, Func&& func, const TaskParallelOptions& options = TaskParallelOptions())
+{
+    parallelForRange(
+        begin, end,
+        [&func](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i)
+            {
+                func(i);
+            }
+        },
+        options);
+}
+
+// 自动划分时的块数 (元素不足时每个元素一块)
+constexpr size_t kParallelReduceBlocks = 256;
+
+// 按块归约 [begin, end)： 每个块调用一次 map(first, last) 得到部分结果， 按下标顺序树形合并
+// 空区间返回 identity； mGrain 为块大小 (0为自动)， 块划分不受线程数影响
+template <typename T, typename RangeMap, typename Combine>
+T parallelReduceRange(size_t begin, size_t end, T identity, RangeMap&& map, Combine&& combine,
+                      const TaskParallelOptions& options = TaskParallelOptions())
+{
+    if (end <= begin)
+    {
+        return identity;
+    }
+
+    const size_t count     = end - begin;
+    const size_t blockSize = options.mGrain > 0 ? options.mGrain : (count + kParallelReduceBlocks - 1) / kParallelReduceBlocks;
+    const size_t blocks    = (count + blockSize - 1) / blockSize;
+    if (blocks == 1)
+    {
+        return map(begin, end);
+    }
+
+    // 每个块独占一个缓存行， 写回部分结果时不互相影响
+    struct alignas(64) Partial
+    {
+        T mValue;
+    };
+    std::vector<Partial> partials(blocks, Partial{ identity });
+
+    // 按块下标分配， 每个块由领取到它的线程独立完成
+    TaskParallelOptions blockOptions = options;
+    blockOptions.mGrain              = 1;
+    blockOptions.mAlign              = 1;
+    parallelForRange(
+        0, blocks,
+        [&](size_t firstBlock, size_t lastBlock) {
+            for (size_t block = firstBlock; block < lastBlock; ++block)
+            {
+                const size_t first     = begin + block * blockSize;
+                const size_t last      = block + 1 == blocks ? end : first + blockSize;
+                partials[block].mValue = map(first, last);
+            }
+        },
+        blockOptions);
+
+    // 树形合并： 每轮把间隔 stride 的相邻部分结果合并到左侧， 合并顺序固定
+    for (size_t stride = 1; stride < blocks; stride *= 2)
+    {
+        for (size_t i = 0; i + stride < blocks; i += 2 * stride)
+        {
+            partials[i].mValue = combine(std::move(partials[i].mValue), std::move(partials[i + stride].mValue));
+        }
+    }
+    return std::move(partials[0].mValue);
+}
+
+// 逐个下标归约： identity ⊕ map(begin) ⊕ ... ⊕ map(end - 1)， identity 作为每个块的初始值 (需为单位元)
+template <typename T, typename Map, typename Combine>
+T parallelReduce(size_t begin, size_t end, T identity, Map&& map, Combine&& combine,
+                 const TaskParallelOptions& options = TaskParallelOptions())
+{
+    return parallelReduceRange(
+        begin, end, identity,
+        [&identity, &map, &combine](size_t first, size_t last) {
+            T value = identity;
+            for (size_t i = first; i < last; ++i)
+            {
+                value = combine(std::move(value), map(i));
+            }
+            return value;
+        },
+        combine, options);
+}
+
+// 与 std::transform_reduce 一致： init ⊕ transform(*first) ⊕ ... ， 不需要单位元 (每个块以首元素的变换结果开始)
+template <typename RandomIt, typename T, typename Reduce, typename Transform>
+T transformReduce(RandomIt first, RandomIt last, T init, Reduce&& reduce, Transform&& transform,
+                  const TaskParallelOptions& options = TaskParallelOptions())
+{
+    const auto count = std::distance(first, last);
+    if (count <= 0)
+    {
+        return init;
+    }
+
+    T total = parallelReduceRange(
+        0, static_cast<size_t>(count), init,
+        [first, &reduce, &transform](size_t from, size_t to) {
+            T value = transform(first[from]);
+            for (size_t i = from + 1; i < to; ++i)
+            {
+                value = reduce(std::move(value), transform(first[i]));
+            }
+            return value;
+        },
+        reduce, options);
+    return reduce(std::move(init), std::move(total));
+}
+
+// 排序的顺序阈值： 元素不超过该值或每个块不足该值时不再切分
+constexpr size_t kParallelSortCutoff = 1 << 14;
+
+// 并行归并排序 【内部实现， 使用 parallelSort / parallelStableSort】
+class ParallelSort final
+{
+public:
+    template <bool Stable, typename RandomIt, typename Compare>
+    static void run(RandomIt first, RandomIt last, Compare& comp, const TaskParallelOptions& options)
+    {
+        using Value = typename std::iterator_traits<RandomIt>::value_type;
+
+        const auto   distance = std::distance(first, last);
+        const size_t count    = distance > 0 ? static_cast<size_t>(distance) : 0;
+        const size_t cutoff   = options.mGrain > 0 ? options.mGrain : kParallelSortCutoff;
+
+        // 块数为不小于参与线程数两倍的 2 的幂 (各块排序耗时不均时由其他线程分担)， 每块不少于阈值
+        const size_t participants = parallelConcurrency(options) * 2;
+        size_t       blocks       = 1;
+        while (blocks < participants)
+        {
+            blocks *= 2;
+        }
+        while (blocks > 1 && count / blocks < cutoff)
+        {
+            blocks /= 2;
+        }
+        if (blocks == 1)
+        {
+            _sequential<Stable>(first, last, comp);
+            return;
+        }
+
+        // 各块排序
+        const size_t        blockSize    = (count + blocks - 1) / blocks;
+        TaskParallelOptions blockOptions = options;
+        blockOptions.mGrain              = 1;
+        blockOptions.mAlign              = 1;
+        parallelForRange(
+            0, blocks,
+            [&](size_t firstBlock, size_t lastBlock) {
+                for (size_t block = firstBlock; block < lastBlock; ++block)
+                {
+                    const size_t from = std::min(count, block * blockSize);
+                    const size_t to   = std::min(count, from + blockSize);
+                    _sequential<Stable>(first + from, first + to, comp);
+                }
+            },
+            blockOptions);
+
+        // 逐轮归并， 宽度翻倍
+        std::vector<Value>  buffer(count);
+        TaskParallelOptions mergeOptions = options;
+        mergeOptions.mGrain              = kMergeGrain;
+        bool inBuffer                    = false;
+        for (size_t width = blockSize; width < count; width *= 2)
+        {
+            if (inBuffer)
+            {
+                _mergeRound(buffer.begin(), first, count, width, comp, mergeOptions);
+            }
+            else
+            {
+                _mergeRound(first, buffer.begin(), count, width, comp, mergeOptions);
+            }
+            inBuffer = !inBuffer;
+        }
+
+        if (inBuffer)
+        {
+            parallelForRange(
+                0, count, [&](size_t from, size_t to) { std::move(buffer.begin() + from, buffer.begin() + to, first + from); },
+                mergeOptions);
+        }
+    }
+
+private:
+    template <bool Stable, typename RandomIt, typename Compare>
+    static void _sequential(RandomIt first, RandomIt last, Compare& comp)
+    {
+        if (Stable)
+        {
+            std::stable_sort(first, last, comp);
+        }
+        else
+        {
+            std::sort(first, last, comp);
+        }
+    }
+
+    // 合并 a[0, m) 与 b[0, n) 时输出第 k 个位置之前取自 a 的元素数 (相等时 a 在前， 保持稳定)
+    template <typename It, typename Compare>
+    static size_t _coRank(size_t k, It a, size_t m, It b, size_t n, Compare& comp)
+    {
+        size_t lo = k > n ? k - n : 0;
+        size_t hi = std::min(k, m);
+        while (lo < hi)
+        {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (comp(b[k - mid - 1], a[mid]))
+            {
+                hi = mid;
+            }
+            else
+            {
+                lo = mid + 1;
+            }
+        }
+        return lo;
+    }
+
+    // 把 src 中相邻的已排序段 [2w * p, 2w * p + w) 与 [2w * p + w, 2w * (p + 1)) 归并到 dst 的相同位置
+    // 按输出位置分块， 一个块可能跨多对段
+    template <typename SrcIt, typename DstIt, typename Compare>
+    static void _mergeRound(SrcIt src, DstIt dst, size_t count, size_t width, Compare& comp, const TaskParallelOptions& options)
+    {
+        parallelForRange(
+            0, count,
+            [&](size_t from, size_t to) {
+                while (from < to)
+                {
+                    const size_t pairBegin = from / (2 * width) * (2 * width);
+                    const size_t middle    = std::min(count, pairBegin + width);
+                    const size_t pairEnd   = std::min(count, pairBegin + 2 * width);
+                    const size_t stop      = std::min(to, pairEnd);
+
+                    const size_t m  = middle - pairBegin;
+                    const size_t n  = pairEnd - middle;
+                    const size_t k0 = from - pairBegin;
+                    const size_t k1 = stop - pairBegin;
+                    const size_t i0 = _coRank(k0, src + pairBegin, m, src + middle, n, comp);
+                    const size_t i1 = _coRank(k1, src + pairBegin, m, src + middle, n, comp);
+                    std::merge(std::make_move_iterator(src + pairBegin + i0), std::make_move_iterator(src + pairBegin + i1),
+                               std::make_move_iterator(src + middle + (k0 - i0)), std::make_move_iterator(src + middle + (k1 - i1)),
+                               dst + from, comp);
+                    from = stop;
+                }
+            },
+            options);
+    }
+
+    static constexpr size_t kMergeGrain = 4096;  // 归并的最小块 (分摊两次二分查找)
+};
+
+// 并行排序 (不稳定)
+template <typename RandomIt, typename Compare = std::less<>>
+void parallelSort(RandomIt first, RandomIt last, Compare comp = Compare(), const TaskParallelOptions& options = TaskParallelOptions())
+{
+    ParallelSort::run<false>(first, last, comp, options);
+}
+
+// 并行稳定排序： 相等元素保持原有顺序
+template <typename RandomIt, typename Compare = std::less<>>
+void parallelStableSort(RandomIt first, RandomIt last, Compare comp = Compare(), const TaskParallelOptions& options = TaskParallelOptions())
+{
+    ParallelSort::run<true>(first, last, comp, options);
+}
+
+}  // namespace task
+
+#endif  // __TASK_PARALLEL_H__
@@ -0,0 +1,58 @@
+#include "TaskPipeline.h"
+#include "TaskQueueDefine.h"
+#include "backend/PipelineImpl.h"
+#include "TaskQueueFactory.h"
+#include "TaskQueue.h"
+namespace task
+{
+bool TaskPipeline::setSource(SourceFunc&& f, const TaskQueuePtr& queue)
+{
+    auto q = queue;
+    if (q == nullptr)
+    {
+        q = TaskQueueFactory::GetInstance().globalConcurrencyQueue(TaskQueuePriority::TQP_Normal);
+    }
+    return mPipelineImpl->setSource(std::move(f), q);
+}
+
+bool TaskPipeline::addStage(TaskPipelineMode mode, StageFunc&& f, const TaskQueuePtr& queue)
+{
+    auto q = queue;
+    if (q == nullptr)
+    {
+        q = TaskQueueFactory::GetInstance().globalConcurrencyQueue(TaskQueuePriority::TQP_Normal);
+    }
+    return mPipelineImpl->addStage(mode, std::move(f), q);
+}
+
+bool TaskPipeline::run(size_t maxTokens)
+{
+    return mPipelineImpl->run(maxTokens, nullptr, nullptr);
+}
+
+bool TaskPipeline::run(size_t maxTokens, const TaskOperatorPtr& task, const TaskQueuePtr& queue)
+{
+    auto q = queue;
+    if (q == nullptr)
+    {
+        q = TaskQueueFactory::GetInstance().globalConcurrencyQueue(TaskQueuePriority::TQP_Normal);
+    }
+    return mPipelineImpl->run(maxTokens, task, q);
+}
+
+void TaskPipeline::stop()
+{
+    mPipelineImpl->stop();
+}
+
+bool TaskPipeline::wait(std::chrono::milliseconds t)
+{
+    return mPipelineImpl->wait(t);
+}
+
+size_t TaskPipeline::stageCount() const
+{
+    return mPipelineImpl->stageCount();
+}
+
+}  // namespace task
@@ -0,0 +1,91 @@
+// 流水线
+// 输入阶段逐个产生数据项， 数据项依次经过各阶段处理； 每个阶段绑定到指定队列执行
+// 阶段模式： 串行有序 (逐个处理， 按输入顺序)、串行无序 (逐个处理， 先到先处理)、并行
+// 令牌数限制同时在流水线中的数据项， 数据项离开最后一个阶段 (或被过滤) 后归还令牌， 输入阶段才继续读取， 快的阶段不会淹没慢的阶段
+// 数据项处理完直接投递到下一阶段的队列； 串行阶段的积压项由一个排空任务依次处理， 不占用线程等待
+//
+// eg:
+// auto pipeline = TaskQueueFactory::GetInstance().createTaskPipeline();
+// pipeline->setSource([&](TaskPipeline::Item& item) {
+//     std::string line;
+//     if (!std::getline(in, line)) return false;
+//     item = std::move(line);
+//     return true;
+// }, ioQueue);
+// pipeline->addStage(TaskPipelineMode::TPM_Parallel, [](TaskPipeline::Item&& item) -> TaskPipeline::Item {
+//     return parse(std::any_cast<std::string&>(item));
+// });
+// pipeline->addStage(TaskPipelineMode::TPM_SerialInOrder, [&](TaskPipeline::Item&& item) -> TaskPipeline::Item {
+//     emit(std::any_cast<Record&>(item));
+//     return {};
+// }, outQueue);
+// pipeline->run(16);
+// pipeline->wait();
+
+#ifndef __TASK_PIPELINE_H__
+#define __TASK_PIPELINE_H__
+
+#include <any>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include "TaskOperator.h"
+#include "TaskQueueDefine.h"
+namespace task
+{
+class PipelineImpl;
+class TaskPipeline final
+{
+public:
+    using Func       = std::function<void()>;
+    using Item       = std::any;
+    using SourceFunc = std::function<bool(Item& item)>;    // 写入一个数据项， 返回false表示输入结束
+    using StageFunc  = std::function<Item(Item&& item)>;   // 返回空Item表示过滤掉该数据项 (不再进入后续阶段)
+
+public:
+    explicit TaskPipeline(const std::shared_ptr<PipelineImpl>& pipelineImpl)
+        : mPipelineImpl(pipelineImpl)
+    {
+    }
+
+    ~TaskPipeline() = default;
+
+    // 设置输入阶段 (串行调用)， queue为空时在全局并行队列(TQP_Normal)执行
+    // 流水线运行中返回false
+    bool setSource(SourceFunc&& f, const TaskQueuePtr& queue = nullptr);
+
+    // 追加一个阶段， queue为空时在全局并行队列(TQP_Normal)执行； 串行阶段在并行队列上同样逐个处理
+    // 流水线运行中返回false
+    bool addStage(TaskPipelineMode mode, StageFunc&& f, const TaskQueuePtr& queue = nullptr);
+
+    // 异步运行， 同时最多 maxTokens 个数据项在流水线中
+    // 正在运行、未设置输入阶段或 maxTokens 为0时返回false
+    bool run(size_t maxTokens);
+
+    // 异步运行， 输入结束且所有数据项处理完后在指定queue上异步通知
+    bool run(size_t maxTokens, const TaskOperatorPtr& task, const TaskQueuePtr& queue = nullptr);
+    bool run(size_t maxTokens, Func&& f, const TaskQueuePtr& queue = nullptr)
+    {
+        auto task = std::make_shared<TaskOperator>([f](const TaskOperatorPtr&) {
+            f();
+        });
+        return run(maxTokens, task, queue);
+    }
+
+    // 停止读取输入， 已在流水线中的数据项继续处理完
+    void stop();
+
+    // 等待本次运行结束， 超时返回false
+    bool wait(std::chrono::milliseconds t = std::chrono::milliseconds(-1));
+
+    // 阶段数量 (不含输入阶段)
+    size_t stageCount() const;
+
+private:
+    std::shared_ptr<PipelineImpl> mPipelineImpl;
+};
+
+}  // namespace task
+
+#endif  // __TASK_PIPELINE_H__
@@ -8,20 +8,87 @@ TaskQueue::TaskQueue(const std::string& label, const TaskQueueImplPtr& impl)
     : mLabel(label)
     , mImpl(impl)
 {
+    mImpl->setLabel(label);
 }
 
-void TaskQueue::async(const TaskOperatorPtr& task)
+TaskSubmitResult TaskQueue::async(const TaskOperatorPtr& task)
 {
-    mImpl->async(task);
+    mImpl->trackCancel(task);
+    return mImpl->submit(task);
 }
 
 void TaskQueue::sync(const TaskOperatorPtr& task, std::chrono::milliseconds timeout)
 {
+    mImpl->trackCancel(task);
     mImpl->sync(task, timeout);
 }
 
-void TaskQueue::after(std::chrono::milliseconds delay, const TaskOperatorPtr& task)
+TaskOperatorPtr TaskQueue::after(std::chrono::milliseconds delay, const TaskOperatorPtr& task)
 {
-    mImpl->after(delay, task);
+    // 记录延时句柄， 批量取消时同时移除定时器
+    auto handle = mImpl->after(delay, task);
+    mImpl->trackCancel(handle);
+    return handle;
+}
+
+void TaskQueue::setCancelTracking(bool enable)
+{
+    mImpl->setCancelTracking(enable);
+}
+
+size_t TaskQueue::cancelAll()
+{
+    return mImpl->cancelAll();
+}
+
+void TaskQueue::suspend()
+{
+    mImpl->suspend();
+}
+
+bool TaskQueue::resume()
+{
+    return mImpl->resume();
+}
+
+bool TaskQueue::isSuspended() const
+{
+    return mImpl->isSuspended();
+}
+
+bool TaskQueue::setCapacity(const TaskCapacity& capacity)
+{
+    return mImpl->setCapacity(capacity);
+}
+
+TaskOverflowStat TaskQueue::overflowStat() const
+{
+    return mImpl->overflowStat();
+}
+
+void TaskQueue::setRateLimit(const TaskRateLimit& limit)
+{
+    mImpl->setRateLimit(limit);
+}
+
+TaskRateLimitStat TaskQueue::rateLimitStat() const
+{
+    return mImpl->rateLimitStat();
+}
+
+TaskLatencyStat TaskQueue::latencyStat() const
+{
+    return mImpl->latencyStat();
+}
+
+TaskQueueMetrics TaskQueue::metrics() const
+{
+    return mImpl->metrics();
+}
+
+TaskOperatorPtr TaskQueue::every(std::chrono::milliseconds interval, std::chrono::milliseconds leeway, const TaskOperatorPtr& task)
+{
+    mImpl->trackCancel(task);
+    return mImpl->every(interval, leeway, task);
 }
 }  // namespace task
@@ -1,6 +1,7 @@
 // 任务队列
 #ifndef __TASK_QUEUE_H__
 #define __TASK_QUEUE_H__
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <string>
@@ -25,18 +26,28 @@ public:
     }
 
     // 异步任务
-    void async(const TaskOperatorPtr& task);
+    // 未设置容量限制/速率限制时总是返回 TSR_Accepted； 被拒绝的任务标记为取消
+    TaskSubmitResult async(const TaskOperatorPtr& task);
     // 直接使用std::functiond对象，处理lambda回调(参数由lambda捕获列表进行传递)
-    void async( Func&& func)
+    TaskSubmitResult async( Func&& func)
     {
         auto task = std::make_shared<TaskOperator>([func](const TaskOperatorPtr&) {
             func();
         });
-        async(task);
+        return async(task);
+    }
+    // 带类别的异步任务 (类别由 TaskQueueFactory::registerTaskCategory 注册)
+    TaskSubmitResult async(TaskCategory category, Func&& func)
+    {
+        auto task = std::make_shared<TaskOperator>([func](const TaskOperatorPtr&) {
+            func();
+        });
+        task->setCategory(category);
+        return async(task);
     }
 
     // 同步任务
-    // timeout 设置同步等待的超时时间， 默认一直等待
+    // timeout 设置同步等待的超时时间， 默认一直等待 (被容量限制拒绝时立即返回)
     void sync(const TaskOperatorPtr& task, std::chrono::milliseconds timeout = std::chrono::milliseconds(-1));
     void sync( Func&& func, std::chrono::milliseconds timeout = std::chrono::milliseconds(-1))
     {
@@ -46,16 +57,63 @@ public:
         sync(task, timeout);
     }
 
-    // 延时任务
-    void after(std::chrono::milliseconds delay, const TaskOperatorPtr& task);
-    void after( std::chrono::milliseconds delay, Func&& func)
+    // 延时任务， 返回的句柄调用cancel()取消 (立即从定时器中移除， 释放任务捕获的资源)
+    TaskOperatorPtr after(std::chrono::milliseconds delay, const TaskOperatorPtr& task);
+    TaskOperatorPtr after( std::chrono::milliseconds delay, Func&& func)
+    {
+        auto task = std::make_shared<TaskOperator>([func](const TaskOperatorPtr&) {
+            func();
+        });
+        return after(delay, task);
+    }
+
+    // 周期任务， 返回的句柄调用cancel()停止
+    // 触发时间按首次调度的时间表计算， 不会累计漂移
+    // leeway 允许延后触发的时间， 与其他定时器合并唤醒， 降低空闲时的唤醒次数
+    TaskOperatorPtr every(std::chrono::milliseconds interval, std::chrono::milliseconds leeway, const TaskOperatorPtr& task);
+    TaskOperatorPtr every(std::chrono::milliseconds interval, std::chrono::milliseconds leeway, Func&& func)
     {
         auto task = std::make_shared<TaskOperator>([func](const TaskOperatorPtr&) {
             func();
         });
-        after(delay, task);
+        return every(interval, leeway, task);
     }
 
+    // 记录经过本队列提交的任务， 供cancelAll取消 【默认关闭， 关闭时提交不记录， 只有一次relaxed读】
+    // 记录只持有任务的弱引用， 但 make_shared 创建的任务在记录清理前不会归还内存， 只在需要批量取消的队列上开启
+    void setCancelTracking(bool enable);
+
+    // 取消所有开启记录后经过本队列提交且还未执行的任务 (含延时/周期任务)， 返回取消的任务数
+    // 立即释放任务捕获的资源， 队列中的空任务出队时跳过； 正在执行的任务执行完后释放
+    size_t cancelAll();
+
+    // 挂起/恢复 【可嵌套， resume次数与suspend相同时恢复； 未挂起时resume返回false】
+    // 挂起期间提交的任务 (含延时/周期任务到期) 返回 TSR_Suspended， 暂存在队列中不占用工作线程， 恢复时按提交顺序批量入队
+    // 已投递到线程池的任务不受影响 (非独占串行队列在当前任务执行完后暂停)； 挂起期间的同步任务等待到恢复后执行完 (或超时)
+    void suspend();
+    bool resume();
+    bool isSuspended() const;
+
+    // 容量限制 【只用于串行队列， 返回false； 并行队列共享线程池的限制 TaskQueueFactory::setPoolCapacity】
+    // 独占队列限制独占线程的任务队列， 非独占队列限制自身的任务队列； 重新设置时统计清零
+    bool setCapacity(const TaskCapacity& capacity);
+
+    // 容量限制统计 (入队/阻塞/拒绝/超时/丢弃/提交线程执行)
+    TaskOverflowStat overflowStat() const;
+
+    // 速率限制 (令牌桶， 每秒任务数 + 突发上限)， 作用于异步/延时/周期任务， 同步任务不限速
+    // 超出速率的任务返回 TSR_RateLimited， 暂存在队列中由定时器按速率入队； mRate <= 0 取消限制
+    void setRateLimit(const TaskRateLimit& limit);
+
+    // 速率限制统计 (直接入队/暂存/当前暂存数/暂存后被拒绝数)
+    TaskRateLimitStat rateLimitStat() const;
+
+    // 队列耗时统计 (执行耗时 + 等待耗时分布， 微秒)
+    TaskLatencyStat latencyStat() const;
+
+    // 队列指标 (入队/完成/取消/未完成数 + 耗时分布)
+    TaskQueueMetrics metrics() const;
+
 private:
     std::string                       mLabel;
     std::shared_ptr<class IQueueImpl> mImpl;
@@ -9,6 +9,7 @@ uint32_t             TaskQueueConstant::sMaxTaskQueueCount       = 10;
 uint32_t             TaskQueueConstant::sMaxReportCountThreshold = 5;                          // 上报最大次数阈值
 std::chrono::seconds TaskQueueConstant::sMaxSleepTimeout         = std::chrono::seconds(120);  // 线程调度，最大等待时间2分钟还没有任务，可以自动退出 [独占线程除外]
 uint32_t             TaskQueueConstant::sBlockTimeoutThreshold = 5000;
+uint32_t             TaskQueueConstant::sWatchdogInterval      = 1000;
 
 // 固定参数
 uint32_t             TaskQueueConstant::sOneMinuteMillisCount  = 60000;
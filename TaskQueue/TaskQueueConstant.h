@@ -18,6 +18,7 @@ public:
 
     static uint32_t sOneMinuteMillisCount;   // 一分钟的毫秒数
     static uint32_t sBlockTimeoutThreshold;  // 卡顿检查阈值
+    static uint32_t sWatchdogInterval;       // 看门狗扫描间隔 (毫秒)
 
     // 更新一次配置
     static void updateConfig();
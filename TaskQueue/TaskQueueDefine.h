@@ -2,8 +2,11 @@
 #ifndef __TASK_QUEUE_DEFINE_H__
 #define __TASK_QUEUE_DEFINE_H__
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
 
 namespace task
 {
@@ -36,15 +39,251 @@ enum class WorkThreadPriority : std::uint8_t
     WTP_Count,
 };
 
+// 截止时间统计 【并行线程池EDF通道】
+struct TaskDeadlineStat
+{
+    uint64_t mScheduled{ 0 };  // 进入EDF通道的任务数
+    uint64_t mStarted{ 0 };    // 已出队的任务数 (包含丢弃)
+    uint64_t mMissed{ 0 };     // 出队时已错过截止时间
+    uint64_t mDropped{ 0 };    // 错过截止时间被丢弃
+
+    // 截止时间错过率
+    double missRate() const
+    {
+        return mStarted == 0 ? 0.0 : static_cast<double>(mMissed) / static_cast<double>(mStarted);
+    }
+};
+
+// 耗时分布 (微秒)
+struct TaskLatencySummary
+{
+    uint64_t mCount{ 0 };
+    uint64_t mMean{ 0 };
+    uint64_t mP50{ 0 };
+    uint64_t mP99{ 0 };
+    uint64_t mP999{ 0 };
+    uint64_t mMax{ 0 };
+};
+
+// 任务耗时统计： 执行耗时 + 队列等待耗时
+struct TaskLatencyStat
+{
+    TaskLatencySummary mRun;
+    TaskLatencySummary mWait;
+};
+
+// 队列指标 (同名队列合并， 包含已释放的队列)
+struct TaskQueueMetrics
+{
+    std::string     mLabel;
+    uint32_t        mQueueCount{ 0 };  // 同名存活队列数
+    uint64_t        mSubmitted{ 0 };   // 入队任务数
+    uint64_t        mCompleted{ 0 };   // 执行完成数
+    uint64_t        mCancelled{ 0 };   // 出队时已取消 (含错过截止时间被丢弃)
+    uint64_t        mInFlight{ 0 };    // 已入队未出队 (排队中 + 执行中)
+    TaskLatencyStat mLatency;
+};
+
+// 任务类别 【由 TaskQueueFactory::registerTaskCategory 注册， 同名返回同一ID】
+using TaskCategory                     = uint16_t;
+constexpr TaskCategory kNoTaskCategory = 0;  // 未分类， 不做类别统计
+
+// 任务类别耗时统计 (累计值， 微秒)
+struct TaskCategoryStat
+{
+    std::string  mName;
+    TaskCategory mCategory{ kNoTaskCategory };
+    uint64_t     mCount{ 0 };       // 执行完成数
+    uint64_t     mRunMicros{ 0 };   // 执行耗时 (墙钟)
+    uint64_t     mWaitMicros{ 0 };  // 队列等待耗时
+    uint64_t     mCpuMicros{ 0 };   // 线程CPU耗时 (CLOCK_THREAD_CPUTIME_ID)
+
+    // CPU耗时占执行耗时的比例， 接近1为CPU密集， 接近0为IO/等待为主
+    double cpuRatio() const
+    {
+        return mRunMicros == 0 ? 0.0 : static_cast<double>(mCpuMicros) / static_cast<double>(mRunMicros);
+    }
+};
+
+// 队列满时的处理策略
+enum class TaskOverflowPolicy : std::uint8_t
+{
+    TOP_Block = 0,   // 阻塞提交线程， 等待空位或超时 (工作线程/定时器线程/IO线程提交时不阻塞， 直接拒绝)
+    TOP_Reject,      // 拒绝新任务
+    TOP_DropOldest,  // 丢弃最早入队的任务， 新任务入队 (没有可丢弃的任务时拒绝)
+    TOP_CallerRuns,  // 在提交线程直接执行新任务 (只用于并行线程池； 串行队列 及 工作线程/定时器线程/IO线程提交时直接拒绝)
+};
+
+// 任务提交结果
+enum class TaskSubmitResult : std::uint8_t
+{
+    TSR_Accepted = 0,   // 已入队
+    TSR_Rejected,       // 队列已满， 被拒绝
+    TSR_TimedOut,       // 阻塞等待超时， 被拒绝
+    TSR_DroppedOldest,  // 已入队， 丢弃了最早入队的任务
+    TSR_CallerRan,      // 已在提交线程执行完成
+    TSR_Shed,           // 线程池过载降载， 被拒绝
+    TSR_Deferred,       // 线程池过载降载， 延后投递
+    TSR_RateLimited,    // 超出队列速率限制， 暂存后由定时器按速率入队
+    TSR_Suspended,      // 队列已挂起， 暂存到恢复时入队
+    TSR_Shutdown,       // 线程池已关闭， 被拒绝
+};
+
+// 容量限制 【入队前原子地预留空位， 并发提交不会超出； 设置限制前已排队的任务不计入】
+// 被拒绝/丢弃的任务标记为取消， 计入队列取消数
+struct TaskCapacity
+{
+    uint32_t                  mMaxPending{ 0 };  // 最大排队任务数， 0为不限制
+    TaskOverflowPolicy        mPolicy{ TaskOverflowPolicy::TOP_Reject };
+    std::chrono::milliseconds mBlockTimeout{ -1 };  // TOP_Block 最长等待时间， -1一直等待
+};
+
+// 容量限制统计 (累计值， 只统计设置了容量限制后的提交)
+struct TaskOverflowStat
+{
+    uint64_t mAccepted{ 0 };    // 未满， 直接入队
+    uint64_t mBlocked{ 0 };     // 阻塞等待后入队
+    uint64_t mRejected{ 0 };    // 被拒绝
+    uint64_t mTimedOut{ 0 };    // 阻塞等待超时被拒绝
+    uint64_t mDropped{ 0 };     // 被丢弃的旧任务
+    uint64_t mCallerRuns{ 0 };  // 在提交线程执行
+};
+
+// 降载处理方式
+enum class TaskShedAction : std::uint8_t
+{
+    TSA_Reject = 0,  // 拒绝 (标记取消， 计入队列取消数)
+    TSA_Defer,       // 延后投递， 到期后重新判断
+};
+
+// 降载配置 【并行线程池】
+// 普通/高优先级任务的排队延迟在一个观察窗口内始终高于目标值时进入降载， 窗口内出现低于目标值的延迟后退出
+// 降载期间新提交的 TQP_Low 任务被拒绝或延后； mShedQueued 时已排队的 TQP_Low 任务出队时同样处理
+// 带截止时间的任务不降载
+struct TaskLoadShedding
+{
+    bool                      mEnabled{ false };
+    std::chrono::milliseconds mTargetDelay{ 5 };   // 目标排队延迟
+    std::chrono::milliseconds mInterval{ 100 };    // 观察窗口
+    TaskShedAction            mAction{ TaskShedAction::TSA_Reject };
+    std::chrono::milliseconds mDeferDelay{ 100 };  // TSA_Defer 延后时间
+    bool                      mShedQueued{ false };
+};
+
+// 降载状态与统计 (累计值)
+struct TaskLoadShedStat
+{
+    bool     mShedding{ false };         // 当前是否处于降载
+    uint64_t mMinWaitMicros{ 0 };        // 上一个观察窗口内普通/高优先级任务的最小排队延迟 (微秒)
+    uint64_t mEnterCount{ 0 };           // 进入降载次数
+    uint64_t mRejectedSubmitted{ 0 };    // 提交时被拒绝的低优先级任务
+    uint64_t mRejectedQueued{ 0 };       // 出队时被拒绝的低优先级任务
+    uint64_t mDeferred{ 0 };             // 延后投递次数
+};
+
+// 队列速率限制 (令牌桶)
+// 每秒最多 mRate 个任务， 空闲时最多积累 mBurst 个令牌； 超出速率的任务暂存在队列中， 由定时器按速率入队
+// 设置了容量限制时， 暂存前预留空位 (按溢出策略处理， TOP_CallerRuns 退化为拒绝)， 暂存的任务计入排队数
+// mRate <= 0 表示不限制
+struct TaskRateLimit
+{
+    double   mRate{ 0 };   // 每秒任务数
+    uint32_t mBurst{ 1 };  // 突发上限
+};
+
+// 速率限制统计 (设置后的累计值)
+struct TaskRateLimitStat
+{
+    uint64_t mImmediate{ 0 };  // 有令牌， 直接入队
+    uint64_t mDelayed{ 0 };    // 暂存后由定时器入队
+    uint64_t mPending{ 0 };    // 当前暂存的任务数
+    uint64_t mRejected{ 0 };   // 暂存后入队时被拒绝 (线程池已关闭/降载等)， 令牌已归还
+};
+
+// 线程池关闭策略
+enum class TaskShutdownPolicy : std::uint8_t
+{
+    TSP_Drain = 0,  // 执行完排队中的任务， 超时后取消剩余的任务
+    TSP_Cancel,     // 取消排队中的任务， 只等待正在执行的任务
+};
+
+// 线程池关闭结果
+struct TaskShutdownStat
+{
+    uint64_t mDropped{ 0 };        // 取消的排队任务数 (含关闭期间提交被拒绝的任务)
+    uint32_t mJoinedThreads{ 0 };  // 已退出并回收的工作线程数
+    uint32_t mBusyThreads{ 0 };    // 超时仍在执行任务的线程数 (不再等待， 执行完后自行退出)
+    bool     mTimedOut{ false };   // 超时前排队任务未执行完 (TSP_Drain)， 或仍有线程未退出
+};
+
+// 并行循环配置 (parallelFor)
+// 区间按块分配给调用线程与并行线程池的工作线程， 先分大块， 剩余越少块越小， 最小为 mGrain
+struct TaskParallelOptions
+{
+    size_t            mGrain{ 0 };       // 最小块大小 (元素数)， 0为自动 (按区间大小与线程数)
+    size_t            mAlign{ 0 };       // 块边界对齐到下标的整数倍， 0为自动 (块足够大时按64对齐)， 1为不对齐
+    uint32_t          mMaxWorkers{ 0 };  // 参与的工作线程上限 (不含调用线程)， 0为并行线程池最大线程数
+    TaskQueuePriority mPriority{ TaskQueuePriority::TQP_Normal };
+};
+
+// 流水线阶段模式
+enum class TaskPipelineMode : std::uint8_t
+{
+    TPM_SerialInOrder = 0,  // 逐个处理， 按输入顺序
+    TPM_SerialOutOfOrder,   // 逐个处理， 先到先处理
+    TPM_Parallel,           // 并行处理
+};
+
+// IO就绪监听方式 (TaskReactor)
+enum class TaskIoTrigger : std::uint8_t
+{
+    TIT_OneShot = 0,  // 就绪一次后自动移除
+    TIT_Persistent,   // 持续监听， 回调执行完后才重新监听， 仍就绪时再次回调 (电平触发语义， 回调不会并发)
+    TIT_Edge,         // 边沿触发， 只在新数据到达/重新可写时回调， 回调必须读/写到 EAGAIN (回调不会并发， 执行期间的新事件在回调结束后再回调一次)
+};
+
+// IO就绪监听统计 (累计值)
+struct TaskReactorStat
+{
+    uint64_t mRegistrations{ 0 };  // 当前监听数
+    uint64_t mReactorEvents{ 0 };  // 监听线程投递的就绪回调
+    uint64_t mIdleEvents{ 0 };     // 并行线程池空闲线程投递的就绪回调
+    uint64_t mDropped{ 0 };        // 回调被队列拒绝/丢弃而移除的监听
+};
+
+// 异步文件IO后端 (TaskFileIo)
+enum class TaskFileIoBackend : std::uint8_t
+{
+    TFB_IoUring = 0,  // io_uring 批量提交， 一个线程收割完成事件
+    TFB_ThreadPool,   // 独立IO线程执行阻塞读写 (io_uring 不可用时回退)
+};
+
+// 异步文件IO统计 (累计值)
+struct TaskFileIoStat
+{
+    TaskFileIoBackend mBackend{ TaskFileIoBackend::TFB_ThreadPool };
+    uint64_t          mSubmitted{ 0 };  // 提交的请求
+    uint64_t          mCompleted{ 0 };  // 完成并投递回调的请求
+    uint64_t          mBatches{ 0 };    // io_uring_enter 提交次数 (一次提交多个请求)， 线程池后端为0
+    uint64_t          mDropped{ 0 };    // 完成回调投递时线程池已关闭， 回调以 -ECANCELED 执行
+};
+
 class TaskQueue;
 class TaskGroup;
+class TaskGraph;
+class TaskPipeline;
+class TaskFileIo;
 class IQueueImpl;
 class TaskOperator;
+class QueueStat;
 }  // namespace task
 
 // alias
 using TaskQueuePtr     = std::shared_ptr<task::TaskQueue>;
 using TaskGroupPtr     = std::shared_ptr<task::TaskGroup>;
+using TaskGraphPtr     = std::shared_ptr<task::TaskGraph>;
+using TaskPipelinePtr  = std::shared_ptr<task::TaskPipeline>;
+using TaskFileIoPtr    = std::shared_ptr<task::TaskFileIo>;
 using TaskQueueImplPtr = std::shared_ptr<task::IQueueImpl>;
 using TaskOperatorPtr  = std::shared_ptr<task::TaskOperator>;
 #endif
\ No newline at end of file
@@ -40,4 +40,69 @@ TaskGroupPtr TaskQueueFactory::createTaskGroup()
     return _getFactoryImpl()->createTaskGroup();
 }
 
+TaskGraphPtr TaskQueueFactory::createTaskGraph()
+{
+    return _getFactoryImpl()->createTaskGraph();
+}
+
+TaskPipelinePtr TaskQueueFactory::createTaskPipeline()
+{
+    return _getFactoryImpl()->createTaskPipeline();
+}
+
+TaskFileIoPtr TaskQueueFactory::createTaskFileIo(TaskFileIoBackend backend)
+{
+    return _getFactoryImpl()->createTaskFileIo(backend);
+}
+
+TaskDeadlineStat TaskQueueFactory::deadlineStat()
+{
+    return _getFactoryImpl()->deadlineStat();
+}
+
+void TaskQueueFactory::setPoolCapacity(const TaskCapacity& capacity)
+{
+    _getFactoryImpl()->setPoolCapacity(capacity);
+}
+
+TaskOverflowStat TaskQueueFactory::poolOverflowStat()
+{
+    return _getFactoryImpl()->poolOverflowStat();
+}
+
+void TaskQueueFactory::setLoadShedding(const TaskLoadShedding& config)
+{
+    _getFactoryImpl()->setLoadShedding(config);
+}
+
+TaskLoadShedStat TaskQueueFactory::loadShedStat()
+{
+    return _getFactoryImpl()->loadShedStat();
+}
+
+TaskLatencyStat TaskQueueFactory::poolLatencyStat(TaskQueueType type)
+{
+    return _getFactoryImpl()->poolLatencyStat(type);
+}
+
+TaskShutdownStat TaskQueueFactory::shutdownPool(TaskQueueType type, std::chrono::milliseconds timeout, TaskShutdownPolicy policy)
+{
+    return _getFactoryImpl()->shutdownPool(type, timeout, policy);
+}
+
+std::vector<TaskQueueMetrics> TaskQueueFactory::queueMetrics()
+{
+    return _getFactoryImpl()->queueMetrics();
+}
+
+TaskCategory TaskQueueFactory::registerTaskCategory(const std::string& name)
+{
+    return _getFactoryImpl()->registerTaskCategory(name);
+}
+
+std::vector<TaskCategoryStat> TaskQueueFactory::taskCategoryStats()
+{
+    return _getFactoryImpl()->taskCategoryStats();
+}
+
 }  // namespace task
\ No newline at end of file
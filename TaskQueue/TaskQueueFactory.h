@@ -4,8 +4,10 @@
 
 #include "common/HESingleton.h"
 #include "TaskQueueDefine.h"
+#include <chrono>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace task
 {
@@ -37,6 +39,50 @@ public:
     // 创建group
     TaskGroupPtr createTaskGroup();
 
+    // 创建任务图 (DAG)
+    TaskGraphPtr createTaskGraph();
+
+    // 创建流水线
+    TaskPipelinePtr createTaskPipeline();
+
+    // 创建异步文件IO， 指定的后端不可用时回退到线程池 (TaskFileIo::backend 为实际使用的后端)
+    TaskFileIoPtr createTaskFileIo(TaskFileIoBackend backend = TaskFileIoBackend::TFB_IoUring);
+
+    // 截止时间统计 【并行线程池EDF通道】
+    TaskDeadlineStat deadlineStat();
+
+    // 并行线程池容量限制 (所有并行队列与任务组的排队任务总数， 不包含非独占串行队列中排队的任务)
+    void setPoolCapacity(const TaskCapacity& capacity);
+
+    // 并行线程池容量限制统计
+    TaskOverflowStat poolOverflowStat();
+
+    // 并行线程池降载 (过载时拒绝或延后低优先级任务)， 重新设置会重置降载状态与统计
+    void setLoadShedding(const TaskLoadShedding& config);
+
+    // 并行线程池降载状态与统计
+    TaskLoadShedStat loadShedStat();
+
+    // 线程池耗时统计 (执行耗时 + 等待耗时分布， 微秒)
+    // type: TQT_Serial 独占线程池， TQT_Parallel 并行线程池 (包含非独占串行队列)
+    TaskLatencyStat poolLatencyStat(TaskQueueType type);
+
+    // 关闭线程池： 停止接收任务， 按策略执行完或取消排队中的任务， 等待工作线程退出， 返回取消的任务数等
+    // type: TQT_Serial 独占线程池， TQT_Parallel 并行线程池 (包含非独占串行队列)
+    // timeout: 整个关闭过程的最长时间， 超时后取消剩余的排队任务， 仍在执行任务的线程不再等待 (-1一直等待)
+    // 只能关闭一次， 关闭后提交的任务返回 TSR_Shutdown； 不能在任务中调用
+    TaskShutdownStat shutdownPool(TaskQueueType type, std::chrono::milliseconds timeout,
+                                  TaskShutdownPolicy policy = TaskShutdownPolicy::TSP_Drain);
+
+    // 所有队列指标， 按标签合并同名队列 (包含已释放的队列)， 按标签排序
+    std::vector<TaskQueueMetrics> queueMetrics();
+
+    // 注册任务类别， 同名返回同一ID； 通过 TaskOperator::setCategory 或 TaskQueue::async(category, func) 标记任务
+    TaskCategory registerTaskCategory(const std::string& name);
+
+    // 任务类别耗时统计 (执行/等待/线程CPU耗时累计值)， 按ID排序
+    std::vector<TaskCategoryStat> taskCategoryStats();
+
 private:
     const std::shared_ptr<TaskQueueFactoryImpl>& _getFactoryImpl();
     std::shared_ptr<TaskQueueFactoryImpl>        mFactoryImpl;
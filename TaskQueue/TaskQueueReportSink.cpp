@@ -0,0 +1,132 @@
+#include "TaskQueueReportSink.h"
+#include "common/LogHelper.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace task
+{
+namespace
+{
+constexpr size_t kReportLineLength = 256;
+}  // namespace
+
+void TaskQueueLogSink::onReport(const TaskQueueReportEvent& event)
+{
+    char line[kReportLineLength];
+    TaskQueueReporter::format(event, line, sizeof(line));
+    LOGI("%s", line);
+    for (size_t i = 0; TaskQueueReporter::formatFrame(event, i, line, sizeof(line)) > 0; ++i)
+    {
+        LOGI("%s", line);
+    }
+}
+
+TaskQueueFileSink::TaskQueueFileSink(const std::string& path)
+{
+    mFile = fopen(path.c_str(), "a");
+    if (mFile == nullptr)
+    {
+        LOGE("[TASK]TaskQueueFileSink, open failed: %s", path.c_str());
+    }
+}
+
+TaskQueueFileSink::~TaskQueueFileSink()
+{
+    if (mFile)
+    {
+        fclose(mFile);
+        mFile = nullptr;
+    }
+}
+
+void TaskQueueFileSink::onReport(const TaskQueueReportEvent& event)
+{
+    if (mFile == nullptr)
+    {
+        return;
+    }
+    char line[kReportLineLength];
+    TaskQueueReporter::format(event, line, sizeof(line));
+    fprintf(mFile, "%llu %s\n", ( unsigned long long )event.mTimestamp, line);
+    for (size_t i = 0; TaskQueueReporter::formatFrame(event, i, line, sizeof(line)) > 0; ++i)
+    {
+        fprintf(mFile, "%s\n", line);
+    }
+}
+
+void TaskQueueFileSink::flush()
+{
+    if (mFile)
+    {
+        fflush(mFile);
+    }
+}
+
+TaskQueueUnixSocketSink::TaskQueueUnixSocketSink(const std::string& path)
+    : mPath(path)
+{
+    _connect();
+}
+
+TaskQueueUnixSocketSink::~TaskQueueUnixSocketSink()
+{
+    if (mSocket >= 0)
+    {
+        close(mSocket);
+        mSocket = -1;
+    }
+}
+
+void TaskQueueUnixSocketSink::onReport(const TaskQueueReportEvent& event)
+{
+    if (mSocket < 0 && !_connect())
+    {
+        ++mDropped;
+        return;
+    }
+
+    char line[kReportLineLength];
+    auto len = TaskQueueReporter::format(event, line, sizeof(line));
+    if (send(mSocket, line, len, MSG_DONTWAIT | MSG_NOSIGNAL) < 0)
+    {
+        ++mDropped;
+        // 对端关闭， 下次重新连接
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            close(mSocket);
+            mSocket = -1;
+        }
+    }
+}
+
+bool TaskQueueUnixSocketSink::_connect()
+{
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (mPath.empty() || mPath.size() >= sizeof(addr.sun_path))
+    {
+        LOGE("[TASK]TaskQueueUnixSocketSink, invalid path: %s", mPath.c_str());
+        return false;
+    }
+    memcpy(addr.sun_path, mPath.c_str(), mPath.size());
+
+    int fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+    {
+        close(fd);
+        return false;
+    }
+    mSocket = fd;
+    return true;
+}
+
+}  // namespace task
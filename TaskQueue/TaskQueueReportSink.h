@@ -0,0 +1,98 @@
+#ifndef TASK_QUEUE_REPORT_SINK_H
+#define TASK_QUEUE_REPORT_SINK_H
+
+// 上报器， 由上报线程串行调用， 实现中可以做耗时操作 (不影响任务线程)
+
+#include "TaskQueueReporter.h"
+#include <cstdio>
+#include <functional>
+#include <string>
+
+namespace task
+{
+class TaskQueueReportSink
+{
+public:
+    virtual ~TaskQueueReportSink() = default;
+
+    virtual void onReport(const TaskQueueReportEvent& event) = 0;
+
+    // 缓冲中的数据写出
+    virtual void flush() {}
+};
+
+// 输出到日志 (默认)， 卡顿事件的堆栈每帧一行
+class TaskQueueLogSink : public TaskQueueReportSink
+{
+public:
+    virtual void onReport(const TaskQueueReportEvent& event) override;
+};
+
+// 追加写入文件， 每个事件一行 (卡顿事件的堆栈每帧追加一行)
+class TaskQueueFileSink : public TaskQueueReportSink
+{
+public:
+    explicit TaskQueueFileSink(const std::string& path);
+    ~TaskQueueFileSink();
+
+    bool isOpen() const
+    {
+        return mFile != nullptr;
+    }
+
+    virtual void onReport(const TaskQueueReportEvent& event) override;
+    virtual void flush() override;
+
+private:
+    FILE* mFile{ nullptr };
+};
+
+// 回调
+class TaskQueueCallbackSink : public TaskQueueReportSink
+{
+public:
+    using Callback = std::function<void(const TaskQueueReportEvent&)>;
+
+    explicit TaskQueueCallbackSink(Callback&& callback)
+        : mCallback(std::move(callback)) {}
+
+    virtual void onReport(const TaskQueueReportEvent& event) override
+    {
+        if (mCallback)
+        {
+            mCallback(event);
+        }
+    }
+
+private:
+    Callback mCallback;
+};
+
+// 发送到unix domain socket (SOCK_DGRAM)， 每个事件一个数据报
+// 非阻塞发送， 对端不存在或缓冲区满时丢弃， 下次发送时重新连接
+class TaskQueueUnixSocketSink : public TaskQueueReportSink
+{
+public:
+    explicit TaskQueueUnixSocketSink(const std::string& path);
+    ~TaskQueueUnixSocketSink();
+
+    virtual void onReport(const TaskQueueReportEvent& event) override;
+
+    // 发送失败被丢弃的事件数
+    uint64_t droppedEvents() const
+    {
+        return mDropped;
+    }
+
+private:
+    bool _connect();
+
+private:
+    std::string mPath;
+    int         mSocket{ -1 };
+    uint64_t    mDropped{ 0 };
+};
+
+}  // namespace task
+
+#endif
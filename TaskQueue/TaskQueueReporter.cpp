@@ -1,57 +1,261 @@
 #include "TaskQueueReporter.h"
-#include <string>
+#include "TaskQueueReportSink.h"
+#include "common/HETimerHelper.h"
 #include "common/LogHelper.h"
+#include "common/MPMCRing.h"
+#include "common/ThreadStack.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
 namespace task
 {
+std::atomic<bool> TaskQueueReporter::sAlive{ false };
+
+namespace
+{
+constexpr size_t   kReportRingCapacity = 1024;
+constexpr uint32_t kReportIdleTimeout  = 100;  // 上报线程空闲等待(ms)， 兜底丢失的唤醒
 
-void TaskQueueReporter::notifyReport(TaskQueueReporterType type, std::string&& msg)
+const char* poolTypeName(TaskQueueType type)
 {
-    switch (type)
+    return type == TaskQueueType::TQT_Serial ? "SerialPool" : "ParallelPool";
+}
+
+const char* reasonName(TaskQueueReportReason reason)
+{
+    switch (reason)
     {
-        case TaskQueueReporterType::TQRT_ThreadCountChanged:
-            _reportThreadCountChanged(std::move(msg));
-            break;
-        case TaskQueueReporterType::TQRT_TaskDurationExceedThreshold:
-            _reportTaskDurationExceedThreshold(std::move(msg));
-            break;
-        case TaskQueueReporterType::TQRT_TaskCountExceedThreshold:
-            _reportTaskCountExceedThreshold(std::move(msg));
-            break;
+        case TaskQueueReportReason::TQRR_ThreadCreated:
+            return "created";
+        case TaskQueueReportReason::TQRR_ThreadReleased:
+            return "released";
+        case TaskQueueReportReason::TQRR_MaxThreadsArrived:
+            return "max_threads_arrived";
+        case TaskQueueReportReason::TQRR_ThreadBlocked:
+            return "blocked";
+        case TaskQueueReportReason::TQRR_TaskCountExceed:
+            return "tsk_exceed";
         default:
-            break;
+            return "none";
     }
 }
+}  // namespace
+
+struct TaskQueueReporter::Ring : public MPMCRing<TaskQueueReportEvent, kReportRingCapacity>
+{
+};
+
+TaskQueueReporter::TaskQueueReporter()
+    : mRing(new Ring())
+{
+    mSinks.push_back(std::make_shared<TaskQueueLogSink>());
+    mThread = std::thread(&TaskQueueReporter::_run, this);
+    sAlive.store(true, std::memory_order_release);
+}
 
-void TaskQueueReporter::notifyReportLimit(int32_t limit, int32_t& val, TaskQueueReporterType type, std::string&& msg)
+TaskQueueReporter::~TaskQueueReporter()
 {
-    if (val >= limit)
+    sAlive.store(false, std::memory_order_release);
+    mStopped.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCond.notify_all();
+    }
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+}
+
+bool TaskQueueReporter::notifyReport(const TaskQueueReportEvent& event)
+{
+    if (!sAlive.load(std::memory_order_acquire) || event.mType == TaskQueueReporterType::TQRT_None)
+    {
+        return false;
+    }
+
+    TaskQueueReportEvent stamped = event;
+    stamped.mTimestamp           = HETimerHelper::millisecondTimestamp64();
+    if (!mRing->tryPush(stamped))
+    {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // 上报线程休眠时唤醒， 不加锁 (错过的唤醒由等待超时兜底)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (mSleeping.load(std::memory_order_relaxed))
+    {
+        mCond.notify_one();
+    }
+    return true;
+}
+
+void TaskQueueReporter::addSink(const std::shared_ptr<TaskQueueReportSink>& sink)
+{
+    if (sink == nullptr)
     {
         return;
     }
-    val++;
+    std::lock_guard<std::mutex> lock(mSinkMutex);
+    mSinks.push_back(sink);
+}
 
-    notifyReport(type, std::move(msg));
+void TaskQueueReporter::removeSink(const std::shared_ptr<TaskQueueReportSink>& sink)
+{
+    std::lock_guard<std::mutex> lock(mSinkMutex);
+    mSinks.erase(std::remove(mSinks.begin(), mSinks.end(), sink), mSinks.end());
 }
 
-void TaskQueueReporter::_reportThreadCountChanged(std::string&& msg)
+void TaskQueueReporter::clearSinks()
 {
-    // 线程数量变化
-    // TODO
-    LOGI("Thread count changed: %s", msg.c_str());
+    std::lock_guard<std::mutex> lock(mSinkMutex);
+    mSinks.clear();
 }
 
-void TaskQueueReporter::_reportTaskDurationExceedThreshold(std::string&& msg)
+void TaskQueueReporter::flush()
 {
-    //上报任务超时
-    // TODO
-    LOGI("Task duration exceed threshold: %s", msg.c_str());
+    // 以环形队列的入队位置为目标： 包含已占位但还未写完的事件， 出队位置越过目标时调用前的事件都已分发
+    const auto target = static_cast<uint64_t>(mRing->enqueuePos());
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCond.notify_one();
+    mFlushCond.wait(lock, [this, target]() {
+        return mFlushed.load(std::memory_order_acquire) >= target || mStopped.load(std::memory_order_acquire);
+    });
+}
+
+void TaskQueueReporter::_run()
+{
+    TaskQueueReportEvent event;
+    for (;;)
+    {
+        bool dispatched = false;
+        while (mRing->tryPop(event))
+        {
+            _dispatch(event);
+            dispatched = true;
+        }
+
+        if (dispatched)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mSinkMutex);
+                for (auto& sink : mSinks)
+                {
+                    sink->flush();
+                }
+            }
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFlushed.store(mRing->dequeuePos(), std::memory_order_release);
+            mFlushCond.notify_all();
+        }
+
+        if (mStopped.load(std::memory_order_acquire) && mRing->sizeApprox() == 0)
+        {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mSleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (mRing->sizeApprox() == 0 && !mStopped.load(std::memory_order_acquire))
+        {
+            mCond.wait_for(lock, std::chrono::milliseconds(kReportIdleTimeout));
+        }
+        mSleeping.store(false, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFlushCond.notify_all();
+}
+
+void TaskQueueReporter::_dispatch(const TaskQueueReportEvent& event)
+{
+    {
+        std::lock_guard<std::mutex> lock(mSinkMutex);
+        for (auto& sink : mSinks)
+        {
+            sink->onReport(event);
+        }
+    }
+    mDelivered.fetch_add(1, std::memory_order_release);
+}
+
+size_t TaskQueueReporter::format(const TaskQueueReportEvent& event, char* buffer, size_t size)
+{
+    if (buffer == nullptr || size == 0)
+    {
+        return 0;
+    }
+
+    int len = 0;
+    switch (event.mType)
+    {
+        case TaskQueueReporterType::TQRT_ThreadCountChanged:
+        {
+            const auto& e = event.mThreadCount;
+            len           = snprintf(buffer, size,
+                           "Thread count changed: %s: active: %u, idle: %u, max: %u, reason: %s, threadid: %d",
+                           poolTypeName(e.mPoolType), e.mActive, e.mIdle, e.mMax, reasonName(e.mReason), e.mThreadId);
+            break;
+        }
+        case TaskQueueReporterType::TQRT_TaskDurationExceedThreshold:
+        {
+            const auto& e = event.mDuration;
+            len           = snprintf(buffer, size,
+                           "Task duration exceed threshold: %s: tid: %d, tname: %s, task: %llu, blockT: %llu ms, cnt: %llu, p99R: %llu us, stack: %u",
+                           poolTypeName(e.mPoolType), e.mThreadId, e.mThreadName,
+                           ( unsigned long long )e.mTaskId, ( unsigned long long )e.mBlockedMillis,
+                           ( unsigned long long )e.mTaskCount, ( unsigned long long )e.mRunP99Micros, e.mStackDepth);
+            break;
+        }
+        case TaskQueueReporterType::TQRT_TaskCountExceedThreshold:
+        {
+            const auto& e = event.mTaskCount;
+            len           = snprintf(buffer, size,
+                           "Task count exceed threshold: %s: tid: %d, tname: %s, pri: %d, tsk_cnt: %llu",
+                           poolTypeName(e.mPoolType), e.mThreadId, e.mThreadName, e.mPriority,
+                           ( unsigned long long )e.mPendingCount);
+            break;
+        }
+        default:
+            buffer[0] = '\0';
+            return 0;
+    }
+
+    if (len < 0)
+    {
+        buffer[0] = '\0';
+        return 0;
+    }
+    return std::min(static_cast<size_t>(len), size - 1);
+}
+
+size_t TaskQueueReporter::formatFrame(const TaskQueueReportEvent& event, size_t index, char* buffer, size_t size)
+{
+    if (buffer == nullptr || size == 0 || event.mType != TaskQueueReporterType::TQRT_TaskDurationExceedThreshold
+        || index >= std::min<size_t>(event.mDuration.mStackDepth, kReportStackDepth))
+    {
+        return 0;
+    }
+
+    int len = snprintf(buffer, size, "    #%02zu ", index);
+    if (len < 0 || static_cast<size_t>(len) >= size)
+    {
+        buffer[0] = '\0';
+        return 0;
+    }
+    return len + ThreadStack::symbolize(event.mDuration.mStack[index], buffer + len, size - len);
 }
 
-void TaskQueueReporter::_reportTaskCountExceedThreshold(std::string&& msg)
+void TaskQueueReporter::copyName(char (&dst)[kReportNameLength], const std::string& name)
 {
-    // 任务数量超限
-    // TODO
-    LOGI("Task count exceed threshold: %s", msg.c_str());
+    auto len = std::min(name.size(), kReportNameLength - 1);
+    memcpy(dst, name.data(), len);
+    dst[len] = '\0';
 }
 
-}  // namespace task
\ No newline at end of file
+}  // namespace task
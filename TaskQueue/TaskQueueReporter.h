@@ -8,17 +8,30 @@
 
 // 上报时机
 // 1. 线程数量变化超过阈值时上报
-// 2. 单个任务耗时超过阈值时上报
+// 2. 单个任务耗时超过阈值时上报 (看门狗线程检测， 抓取卡住线程的堆栈)
 // 3. 任务数量超出阈值时上报
 // 4. 间隔性上报统计信息
 
+// 上报方式
+// 事件为定长结构体， 生产者写入有界无锁环形队列后立即返回 (不阻塞， 不分配内存， 队列满时丢弃并计数)
+// 后台上报线程取出事件， 依次分发给注册的上报器 (TaskQueueReportSink: 日志/文件/回调/unix socket)
+
 #include "common/HESingleton.h"
+#include "TaskQueueDefine.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace task
 {
 
-enum class TaskQueueReporterType
+enum class TaskQueueReporterType : uint8_t
 {
     TQRT_None                        = 0,
     TQRT_ThreadCountChanged          = 1,  // 线程数量变化
@@ -26,22 +39,156 @@ enum class TaskQueueReporterType
     TQRT_TaskCountExceedThreshold    = 3,  // 任务数量超出阈值
 };
 
+// 上报原因
+enum class TaskQueueReportReason : uint8_t
+{
+    TQRR_None = 0,
+    TQRR_ThreadCreated,      // 创建线程
+    TQRR_ThreadReleased,     // 释放线程
+    TQRR_MaxThreadsArrived,  // 达到最大线程数
+    TQRR_ThreadBlocked,      // 线程卡住
+    TQRR_TaskCountExceed,    // 任务堆积
+};
+
+constexpr size_t kReportNameLength = 32;
+constexpr size_t kReportStackDepth = 32;
+
+// 线程数量变化
+struct ThreadCountChangedEvent
+{
+    TaskQueueType         mPoolType{ TaskQueueType::TQT_Parallel };
+    TaskQueueReportReason mReason{ TaskQueueReportReason::TQRR_None };
+    int32_t               mThreadId{ -1 };  // 引起变化的线程， 没有为-1
+    uint32_t              mActive{ 0 };
+    uint32_t              mIdle{ 0 };
+    uint32_t              mMax{ 0 };
+};
+
+// 单个任务耗时超过阈值 (线程卡住)
+struct TaskDurationExceedEvent
+{
+    TaskQueueType mPoolType{ TaskQueueType::TQT_Parallel };
+    int32_t       mThreadId{ -1 };
+    char          mThreadName[kReportNameLength]{};  // 超长截断
+    uint64_t      mTaskId{ 0 };                      // 正在执行的任务
+    uint64_t      mBlockedMillis{ 0 };               // 当前任务已执行时长
+    uint64_t      mTaskCount{ 0 };                   // 线程已执行任务数
+    uint64_t      mRunP99Micros{ 0 };                // 线程任务执行耗时p99
+    uint32_t      mStackDepth{ 0 };                  // 堆栈帧数， 抓取失败为0
+    uint64_t      mStack[kReportStackDepth]{};       // 卡住时的调用栈 (返回地址， 由内向外)
+};
+
+// 任务数量超出阈值
+struct TaskCountExceedEvent
+{
+    TaskQueueType mPoolType{ TaskQueueType::TQT_Parallel };
+    int32_t       mThreadId{ -1 };  // 串行独占线程， 并行线程池为-1
+    char          mThreadName[kReportNameLength]{};
+    int32_t       mPriority{ 0 };   // 并行队列优先级
+    uint64_t      mPendingCount{ 0 };
+};
+
+// 上报事件， 按 mType 读取对应结构体
+struct TaskQueueReportEvent
+{
+    TaskQueueReporterType mType{ TaskQueueReporterType::TQRT_None };
+    uint64_t              mTimestamp{ 0 };  // 毫秒 (steady clock)
+    union
+    {
+        ThreadCountChangedEvent mThreadCount;
+        TaskDurationExceedEvent mDuration;
+        TaskCountExceedEvent    mTaskCount;
+    };
+
+    TaskQueueReportEvent()
+        : mThreadCount() {}
+    TaskQueueReportEvent(const ThreadCountChangedEvent& event)
+        : mType(TaskQueueReporterType::TQRT_ThreadCountChanged), mThreadCount(event) {}
+    TaskQueueReportEvent(const TaskDurationExceedEvent& event)
+        : mType(TaskQueueReporterType::TQRT_TaskDurationExceedThreshold), mDuration(event) {}
+    TaskQueueReportEvent(const TaskCountExceedEvent& event)
+        : mType(TaskQueueReporterType::TQRT_TaskCountExceedThreshold), mTaskCount(event) {}
+};
+
+class TaskQueueReportSink;
+
 class TaskQueueReporter : public task::HESingleton<TaskQueueReporter>
 {
     friend class task::HESingleton<TaskQueueReporter>;
 
 public:
-    // 根据类型通知上报
-    void notifyReport(TaskQueueReporterType type, std::string&& msg = "");
+    ~TaskQueueReporter();
+
+    // 投递事件， 不阻塞， 队列满或已停止返回false
+    bool notifyReport(const TaskQueueReportEvent& event);
+
+    // 最多上报limit次， 超过次数时不构造事件 (count由调用方在恢复正常时清零)
+    template <typename Maker>
+    bool notifyReportLimit(int32_t limit, std::atomic<int32_t>& count, Maker&& makeEvent)
+    {
+        if (count.load(std::memory_order_relaxed) >= limit)
+        {
+            return false;
+        }
+        count.fetch_add(1, std::memory_order_relaxed);
+        return notifyReport(makeEvent());
+    }
+
+    // 上报器管理 (默认注册日志上报器)
+    void addSink(const std::shared_ptr<TaskQueueReportSink>& sink);
+    void removeSink(const std::shared_ptr<TaskQueueReportSink>& sink);
+    void clearSinks();
+
+    // 等待调用前已投递的事件分发完成
+    void flush();
+
+    // 队列满被丢弃的事件数
+    uint64_t droppedEvents() const
+    {
+        return mDropped.load(std::memory_order_relaxed);
+    }
+
+    // 已分发的事件数
+    uint64_t deliveredEvents() const
+    {
+        return mDelivered.load(std::memory_order_acquire);
+    }
+
+    // 格式化为一行文本， 返回写入长度 (不含结尾'\0')
+    static size_t format(const TaskQueueReportEvent& event, char* buffer, size_t size);
 
-    // 最多上报多少次
-    void notifyReportLimit(int32_t limit, int32_t& val, TaskQueueReporterType type, std::string&& msg = "");
+    // 格式化卡顿事件的第index帧堆栈， 超出帧数返回0
+    static size_t formatFrame(const TaskQueueReportEvent& event, size_t index, char* buffer, size_t size);
+
+    // 拷贝线程名称到事件
+    static void copyName(char (&dst)[kReportNameLength], const std::string& name);
+
+private:
+    TaskQueueReporter();
+
+    void _run();
+    void _dispatch(const TaskQueueReportEvent& event);
 
 private:
-    void _reportThreadCountChanged(std::string&& msg);
-    void _reportTaskDurationExceedThreshold(std::string&& msg);
-    void _reportTaskCountExceedThreshold(std::string&& msg);
+    struct Ring;
+    std::unique_ptr<Ring> mRing;
+
+    std::thread             mThread;
+    std::mutex              mMutex;
+    std::condition_variable mCond;         // 唤醒上报线程
+    std::condition_variable mFlushCond;    // 通知flush
+    std::atomic<bool>       mSleeping{ false };
+    std::atomic<bool>       mStopped{ false };
+
+    std::atomic<uint64_t> mDelivered{ 0 };
+    std::atomic<uint64_t> mFlushed{ 0 };  // 已分发并flush到的出队位置
+    std::atomic<uint64_t> mDropped{ 0 };
+
+    std::mutex                                        mSinkMutex;
+    std::vector<std::shared_ptr<TaskQueueReportSink>> mSinks;
+
+    static std::atomic<bool> sAlive;  // 静态析构后不再投递
 };
 }  // namespace task
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,296 @@
+#include "TaskQueueTracer.h"
+#include "TaskOperator.h"
+#include "backend/QueueStat.h"
+#include "backend/WorkThreadBase.h"
+#include "common/HETimerHelper.h"
+#include "common/LogHelper.h"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace task
+{
+std::atomic<bool> TaskQueueTracer::sEnabled{ false };
+
+namespace
+{
+// JSON字符串转义 (引号、反斜杠、控制字符)
+std::string jsonEscape(const std::string& text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (auto c : text)
+    {
+        switch (c)
+        {
+            case '"':
+                escaped += "\\\"";
+                break;
+            case '\\':
+                escaped += "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char buffer[8];
+                    snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+                    escaped += buffer;
+                }
+                else
+                {
+                    escaped += c;
+                }
+                break;
+        }
+    }
+    return escaped;
+}
+
+struct TraceEvent
+{
+    uint64_t           mTime;  // 微秒
+    uint64_t           mTaskId;
+    uint32_t           mLabel;
+    TaskTraceEventType mType;
+};
+
+constexpr uint32_t kRingCapacity = 1 << 14;
+constexpr uint32_t kRingMask     = kRingCapacity - 1;
+}  // namespace
+
+// 单生产者(所属线程) / 单消费者(写线程) 环形缓冲区
+struct TaskQueueTracer::Ring
+{
+    std::array<TraceEvent, kRingCapacity> mEvents;
+    std::atomic<uint64_t>                 mHead{ 0 };  // 生产者写入位置
+    std::atomic<uint64_t>                 mTail{ 0 };  // 消费者读取位置
+    std::atomic<bool>                     mRetired{ false };
+    int32_t                               mThreadId{ 0 };
+    bool                                  mIsWorker{ false };
+    bool                                  mNamed{ false };  // 是否已输出线程名
+};
+
+// 线程退出时标记缓冲区， 由写线程读完后回收
+struct TaskQueueTracer::RingHolder
+{
+    std::shared_ptr<Ring> mRing;
+    ~RingHolder()
+    {
+        if (mRing)
+        {
+            mRing->mRetired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+TaskQueueTracer::~TaskQueueTracer()
+{
+    stop();
+}
+
+bool TaskQueueTracer::start(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mStopped)
+    {
+        return false;
+    }
+
+    mFile = fopen(path.c_str(), "w");
+    if (mFile == nullptr)
+    {
+        LOGE("[TASK]TaskQueueTracer::start, open failed: %s", path.c_str());
+        return false;
+    }
+
+    // 丢弃上一次停止后残留的事件
+    {
+        std::lock_guard<std::mutex> ringLock(mRingMutex);
+        for (auto& ring : mRings)
+        {
+            ring->mTail.store(ring->mHead.load(std::memory_order_acquire), std::memory_order_release);
+            ring->mNamed = false;
+        }
+    }
+
+    fprintf(mFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(mFile, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"TaskQueue\"}}");
+    mStartTime = HETimerHelper::microsecondTimestamp64();
+    mDropped.store(0, std::memory_order_relaxed);
+    mStopped = false;
+    mThread  = std::thread(&TaskQueueTracer::_run, this);
+    sEnabled.store(true, std::memory_order_release);
+    return true;
+}
+
+void TaskQueueTracer::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mStopped)
+        {
+            return;
+        }
+        sEnabled.store(false, std::memory_order_release);
+        mStopped = true;
+    }
+    mCond.notify_all();
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    _drain();
+    fprintf(mFile, "\n]}\n");
+    fclose(mFile);
+    mFile = nullptr;
+}
+
+uint32_t TaskQueueTracer::internLabel(const std::string& label)
+{
+    std::lock_guard<std::mutex> lock(mLabelMutex);
+    auto                        it = mLabelIds.find(label);
+    if (it != mLabelIds.end())
+    {
+        return it->second;
+    }
+
+    // 写入时直接作为JSON字符串， 注册时转义一次
+    auto id = static_cast<uint32_t>(mLabels.size());
+    mLabels.push_back(jsonEscape(label));
+    mLabelIds.emplace(label, id);
+    return id;
+}
+
+void TaskQueueTracer::trace(TaskTraceEventType type, const TaskOperator& task)
+{
+    auto ring = _threadRing();
+    auto head = ring->mHead.load(std::memory_order_relaxed);
+    if (head - ring->mTail.load(std::memory_order_acquire) >= kRingCapacity)
+    {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto& event   = ring->mEvents[head & kRingMask];
+    event.mTime   = HETimerHelper::microsecondTimestamp64();
+    event.mTaskId = task.taskId();
+    event.mLabel  = task.queueStat() ? task.queueStat()->traceLabel() : 0;
+    event.mType   = type;
+    ring->mHead.store(head + 1, std::memory_order_release);
+}
+
+TaskQueueTracer::Ring* TaskQueueTracer::_threadRing()
+{
+    static thread_local RingHolder tHolder;
+    if (__builtin_expect(tHolder.mRing == nullptr, 0))
+    {
+        static std::atomic<int32_t> sThreadSeq{ 1 };
+
+        auto ring    = std::make_shared<Ring>();
+        auto worker  = WorkThreadBase::current();
+        ring->mIsWorker = worker != nullptr;
+        ring->mThreadId = worker ? worker->threadId() : sThreadSeq.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(mRingMutex);
+        mRings.push_back(ring);
+        tHolder.mRing = std::move(ring);
+    }
+    return tHolder.mRing.get();
+}
+
+void TaskQueueTracer::_run()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (!mStopped)
+    {
+        mCond.wait_for(lock, std::chrono::milliseconds(100));
+        _drain();
+    }
+}
+
+void TaskQueueTracer::_drain()
+{
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard<std::mutex> lock(mRingMutex);
+        rings = mRings;
+    }
+
+    std::vector<std::string> labels;
+    {
+        std::lock_guard<std::mutex> lock(mLabelMutex);
+        labels = mLabels;
+    }
+
+    for (auto& ring : rings)
+    {
+        _writeRing(*ring, labels);
+    }
+
+    // 回收已退出线程的缓冲区
+    std::lock_guard<std::mutex> lock(mRingMutex);
+    for (auto it = mRings.begin(); it != mRings.end();)
+    {
+        auto& ring = *it;
+        if (ring->mRetired.load(std::memory_order_acquire)
+            && ring->mTail.load(std::memory_order_relaxed) == ring->mHead.load(std::memory_order_acquire))
+        {
+            it = mRings.erase(it);
+            continue;
+        }
+        ++it;
+    }
+}
+
+void TaskQueueTracer::_writeRing(Ring& ring, const std::vector<std::string>& labels)
+{
+    auto tail = ring.mTail.load(std::memory_order_relaxed);
+    auto head = ring.mHead.load(std::memory_order_acquire);
+    if (tail == head)
+    {
+        return;
+    }
+
+    if (!ring.mNamed)
+    {
+        fprintf(mFile,
+                ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s_%d\"}}",
+                ring.mThreadId,
+                ring.mIsWorker ? "worker" : "thread",
+                ring.mThreadId);
+        ring.mNamed = true;
+    }
+
+    for (; tail != head; ++tail)
+    {
+        const auto& event = ring.mEvents[tail & kRingMask];
+        const auto  ts    = event.mTime >= mStartTime ? event.mTime - mStartTime : 0;
+        const char* label = event.mLabel < labels.size() ? labels[event.mLabel].c_str() : "";
+        const auto  id    = static_cast<unsigned long long>(event.mTaskId);
+        switch (event.mType)
+        {
+            case TaskTraceEventType::TTET_Enqueue:
+                // 入队瞬时事件 + 指向开始执行的流事件
+                fprintf(mFile,
+                        ",\n{\"name\":\"enqueue\",\"cat\":\"task\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":1,\"tid\":%d,\"args\":{\"task\":%llu,\"queue\":\"%s\"}}"
+                        ",\n{\"name\":\"task\",\"cat\":\"flow\",\"ph\":\"s\",\"id\":%llu,\"ts\":%llu,\"pid\":1,\"tid\":%d}",
+                        ( unsigned long long )ts, ring.mThreadId, id, label, id, ( unsigned long long )ts, ring.mThreadId);
+                break;
+            case TaskTraceEventType::TTET_Start:
+                fprintf(mFile,
+                        ",\n{\"name\":\"task\",\"cat\":\"flow\",\"ph\":\"f\",\"bp\":\"e\",\"id\":%llu,\"ts\":%llu,\"pid\":1,\"tid\":%d}"
+                        ",\n{\"name\":\"%s\",\"cat\":\"task\",\"ph\":\"B\",\"ts\":%llu,\"pid\":1,\"tid\":%d,\"args\":{\"task\":%llu}}",
+                        id, ( unsigned long long )ts, ring.mThreadId, label[0] ? label : "task", ( unsigned long long )ts, ring.mThreadId, id);
+                break;
+            case TaskTraceEventType::TTET_End:
+                fprintf(mFile, ",\n{\"ph\":\"E\",\"ts\":%llu,\"pid\":1,\"tid\":%d}", ( unsigned long long )ts, ring.mThreadId);
+                break;
+        }
+    }
+    ring.mTail.store(tail, std::memory_order_release);
+}
+
+}  // namespace task
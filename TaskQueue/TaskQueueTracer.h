@@ -0,0 +1,95 @@
+#ifndef TASK_QUEUE_TRACER_H
+#define TASK_QUEUE_TRACER_H
+
+// 任务执行轨迹
+// 记录任务 入队 / 开始 / 结束 事件 (队列标签， 线程ID， 任务ID)， 输出 Chrome trace JSON
+// 使用 chrome://tracing 或 ui.perfetto.dev 打开
+//
+// 每条线程一个无锁单生产者环形缓冲区， 后台线程异步写文件， 缓冲区满时丢弃并计数
+// 未开启时每个记录点只有一次原子读判断
+
+#include "common/HESingleton.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace task
+{
+class TaskOperator;
+
+enum class TaskTraceEventType : uint8_t
+{
+    TTET_Enqueue = 0,  // 入队
+    TTET_Start,        // 开始执行
+    TTET_End,          // 执行结束
+};
+
+class TaskQueueTracer : public task::HESingleton<TaskQueueTracer>
+{
+    friend class task::HESingleton<TaskQueueTracer>;
+
+public:
+    ~TaskQueueTracer();
+
+    // 开始记录到文件， 已在记录或文件打开失败返回false
+    bool start(const std::string& path);
+
+    // 停止记录， 写完剩余事件并关闭文件
+    void stop();
+
+    static bool isEnabled()
+    {
+        return __builtin_expect(sEnabled.load(std::memory_order_relaxed), 0);
+    }
+
+    // 缓冲区满被丢弃的事件数
+    uint64_t droppedEvents() const
+    {
+        return mDropped.load(std::memory_order_relaxed);
+    }
+
+    // 队列标签转换为ID (队列创建时调用)
+    uint32_t internLabel(const std::string& label);
+
+    // 记录事件 【调用前需判断 isEnabled()】
+    void trace(TaskTraceEventType type, const TaskOperator& task);
+
+private:
+    TaskQueueTracer() = default;
+
+    struct Ring;
+    struct RingHolder;
+    Ring* _threadRing();
+    void  _run();
+    void  _drain();
+    void  _writeRing(Ring& ring, const std::vector<std::string>& labels);
+
+private:
+    static std::atomic<bool> sEnabled;
+
+    std::mutex                         mRingMutex;
+    std::vector<std::shared_ptr<Ring>> mRings;
+
+    std::mutex                                mLabelMutex;
+    std::vector<std::string>                  mLabels{ "" };  // 0 为无标签， 已做JSON转义
+    std::unordered_map<std::string, uint32_t> mLabelIds;
+
+    std::mutex              mMutex;  // 保护文件与写线程
+    std::condition_variable mCond;
+    std::thread             mThread;
+    bool                    mStopped{ true };
+    FILE*                   mFile{ nullptr };
+    uint64_t                mStartTime{ 0 };
+
+    std::atomic<uint64_t> mDropped{ 0 };
+};
+}  // namespace task
+
+#endif
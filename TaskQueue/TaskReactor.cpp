@@ -0,0 +1,25 @@
+#include "TaskReactor.h"
+#include "backend/IoReactor.h"
+namespace task
+{
+uint64_t TaskReactor::onReadable(int fd, const TaskQueuePtr& queue, Callback&& func, TaskIoTrigger trigger)
+{
+    return IoReactor::GetInstance().add(fd, false, queue, std::move(func), trigger);
+}
+
+uint64_t TaskReactor::onWritable(int fd, const TaskQueuePtr& queue, Callback&& func, TaskIoTrigger trigger)
+{
+    return IoReactor::GetInstance().add(fd, true, queue, std::move(func), trigger);
+}
+
+bool TaskReactor::cancel(uint64_t id)
+{
+    return IoReactor::GetInstance().remove(id);
+}
+
+TaskReactorStat TaskReactor::stat()
+{
+    return IoReactor::GetInstance().stat();
+}
+
+}  // namespace task
@@ -0,0 +1,56 @@
+// IO就绪监听
+// fd 可读/可写时把回调直接投递到指定队列执行， 不需要为每个服务单独起监听线程再转发
+// 一次性监听就绪一次后自动移除； 持续监听 (TIT_Persistent) 回调执行完才重新监听， 同一监听的回调不会并发执行
+// 持续监听不是边沿触发： 重新监听时 fd 仍就绪会再次回调， 回调中没读完的数据不会丢失
+// 边沿触发 (TIT_Edge) 只在新数据到达/重新可写时回调， 回调必须读/写到 EAGAIN， 没读完的数据不会再回调 (直到有新数据)；
+// 回调同样不会并发， 执行期间到达的新事件在回调结束后再回调一次； 同一fd的可读与可写必须同为边沿触发或同为非边沿触发
+// 回调中应使用非阻塞 fd 读/写到 EAGAIN， 可能出现没有数据的回调 (出错/挂断时两个方向都会回调)
+// 关闭 fd 前先 cancel， 否则同号的新 fd 可能收到旧监听的回调
+// 仅支持 Linux (epoll)
+//
+// eg:
+// auto id = TaskReactor::GetInstance().onReadable(fd, queue, [](int fd) {
+//     char buf[4096];
+//     while (::read(fd, buf, sizeof(buf)) > 0) { ... }
+// }, TaskIoTrigger::TIT_Persistent);
+// ...
+// TaskReactor::GetInstance().cancel(id);
+
+#ifndef __TASK_REACTOR_H__
+#define __TASK_REACTOR_H__
+
+#include "common/HESingleton.h"
+#include "TaskQueueDefine.h"
+#include <cstdint>
+#include <functional>
+
+namespace task
+{
+class TaskReactor : public task::HESingleton<TaskReactor>
+{
+    friend class task::HESingleton<TaskReactor>;
+
+public:
+    using Callback = std::function<void(int fd)>;
+
+public:
+    // 监听可读， 返回监听ID， 失败返回0 (包括同一fd另一方向的触发方式不一致)； 同一fd已有可读监听时替换
+    // queue: 执行回调的队列
+    uint64_t onReadable(int fd, const TaskQueuePtr& queue, Callback&& func, TaskIoTrigger trigger = TaskIoTrigger::TIT_OneShot);
+
+    // 监听可写， 返回监听ID， 失败返回0； 同一fd已有可写监听时替换
+    uint64_t onWritable(int fd, const TaskQueuePtr& queue, Callback&& func, TaskIoTrigger trigger = TaskIoTrigger::TIT_OneShot);
+
+    // 移除监听， 已投递未执行的回调不再执行， 正在执行的回调不等待； 已触发的一次性监听或不存在返回false
+    bool cancel(uint64_t id);
+
+    // 监听统计
+    TaskReactorStat stat();
+
+private:
+    TaskReactor() = default;
+};
+
+}  // namespace task
+
+#endif  // __TASK_REACTOR_H__
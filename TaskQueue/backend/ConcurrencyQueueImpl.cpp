@@ -10,20 +10,26 @@ ConcurrencyQueueImpl::ConcurrencyQueueImpl(TaskQueuePriority prio, const ThreadP
     : IQueueImpl(TaskQueueType::TQT_Parallel, threadPool)
     , mPriority(prio)
 {
-    LOGE("[TASK]ConcurrencyQueueImpl() %d\n", prio);
+    LOGD("[TASK]ConcurrencyQueueImpl() %d\n", prio);
 }
 
 ConcurrencyQueueImpl::~ConcurrencyQueueImpl()
 {
-    LOGE("[TASK]~ConcurrencyQueueImpl() %d\n", mPriority);
+    LOGD("[TASK]~ConcurrencyQueueImpl() %d\n", mPriority);
+    _dropHeld();
 }
 
-void ConcurrencyQueueImpl::async(const TaskOperatorPtr& task)
+TaskSubmitResult ConcurrencyQueueImpl::async(const TaskOperatorPtr& task)
 {
     assert(_threadPool());
     task->resetCallStartTime();
+    _onEnqueue(task);
+    if (_holdIfSuspended(task))
+    {
+        return TaskSubmitResult::TSR_Suspended;
+    }
 
-    _threadPool()->execute(task, mPriority);
+    return _threadPool()->execute(task, mPriority);
 }
 
 void ConcurrencyQueueImpl::sync(const TaskOperatorPtr& task, std::chrono::milliseconds timeout)
@@ -32,7 +38,12 @@ void ConcurrencyQueueImpl::sync(const TaskOperatorPtr& task, std::chrono::millis
     task->resetCallStartTime();
 
     auto syncTask = std::make_shared<TaskBarrierOperator>(task);
-    _threadPool()->execute(syncTask, mPriority);
+    _onEnqueue(syncTask);
+    // 被拒绝时同步任务已唤醒， 不会等待； 挂起时等待到恢复后执行完 (或超时)
+    if (!_holdIfSuspended(syncTask))
+    {
+        _threadPool()->execute(syncTask, mPriority);
+    }
     
     // 超时取消任务
     if(!syncTask->wait(timeout)){
@@ -40,12 +51,35 @@ void ConcurrencyQueueImpl::sync(const TaskOperatorPtr& task, std::chrono::millis
     }
 }
 
-void ConcurrencyQueueImpl::after(std::chrono::milliseconds delay, const TaskOperatorPtr& task)
+void ConcurrencyQueueImpl::_flushSuspended(std::vector<TaskOperatorPtr>& tasks)
+{
+    if (!tasks.empty())
+    {
+        _threadPool()->executeBulk(tasks, mPriority);
+    }
+}
+
+TaskSubmitResult ConcurrencyQueueImpl::_reserve(const TaskOperatorPtr& task)
+{
+    return _threadPool()->reserve(task, mPriority);
+}
+
+void ConcurrencyQueueImpl::_unreserve(const TaskOperatorPtr& task)
+{
+    _threadPool()->unreserve(task, mPriority);
+}
+
+TaskOperatorPtr ConcurrencyQueueImpl::after(std::chrono::milliseconds delay, const TaskOperatorPtr& task)
 {
     assert(_threadPool());
     task->resetCallStartTime();
-    auto delayTask = std::make_shared<TaskDelayOperator>(delay, task);
-    _threadPool()->execute(delayTask, mPriority);
+    return _scheduleAfter(delay, task);
+}
+
+TaskOperatorPtr ConcurrencyQueueImpl::every(std::chrono::milliseconds interval, std::chrono::milliseconds leeway, const TaskOperatorPtr& task)
+{
+    assert(_threadPool());
+    return _scheduleEvery(interval, leeway, task);
 }
 
 }  // namespace task
\ No newline at end of file
@@ -10,9 +10,15 @@ public:
     ConcurrencyQueueImpl(TaskQueuePriority prio, const ThreadPoolPtr& threadPool);
     ~ConcurrencyQueueImpl();
 
-    virtual void async(const TaskOperatorPtr& task) override;
+    virtual TaskSubmitResult async(const TaskOperatorPtr& task) override;
     virtual void sync(const TaskOperatorPtr& task, std::chrono::milliseconds timeout = std::chrono::milliseconds(-1)) override;
-    virtual void after(std::chrono::milliseconds delay, const TaskOperatorPtr& task) override;
+    virtual TaskOperatorPtr after(std::chrono::milliseconds delay, const TaskOperatorPtr& task) override;
+    virtual TaskOperatorPtr every(std::chrono::milliseconds interval, std::chrono::milliseconds leeway, const TaskOperatorPtr& task) override;
+
+protected:
+    virtual void _flushSuspended(std::vector<TaskOperatorPtr>& tasks) override;
+    virtual TaskSubmitResult _reserve(const TaskOperatorPtr& task) override;
+    virtual void             _unreserve(const TaskOperatorPtr& task) override;
 
 private:
     TaskQueuePriority mPriority{ TaskQueuePriority::TQP_Normal };
@@ -6,20 +6,24 @@
 #include "common/LogHelper.h"
 #include "TaskQueueConstant.h"
 #include "TaskQueueReporter.h"
+#include "TaskOperator.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 namespace task
 {
 
 ConcurrencyThreadPool::ConcurrencyThreadPool()
 {
-    LOGE("[TASK]ConcurrencyThreadPool()\n");
+    LOGD("[TASK]ConcurrencyThreadPool()\n");
     // 线程池最大线程数为cpu核数
     mData = std::make_shared<Data>();
     mData->mMaxThreads.store(SysUtils::cpuCount(), std::memory_order_release);
@@ -27,9 +31,17 @@ ConcurrencyThreadPool::ConcurrencyThreadPool()
 
 ConcurrencyThreadPool::~ConcurrencyThreadPool()
 {
-    LOGE("[TASK]~ConcurrencyThreadPool()\n");
-    // 通知所有线程退出
-    mData->mSemaphore.release(mData->mMaxThreads.load(std::memory_order_acquire));
+    LOGD("[TASK]~ConcurrencyThreadPool()\n");
+    // 通知所有线程退出 (看门狗补偿的线程可能使线程数超过最大线程数)
+    mData->mSemaphore.release(std::max(mData->mMaxThreads.load(std::memory_order_acquire),
+                                       mData->mActiveThreads.load(std::memory_order_acquire)));
+
+    // 最后一个引用可能在工作线程上释放 (如退出时)， 该线程对象延长到线程退出
+    std::lock_guard<std::mutex> lock(mParallelMutex);
+    for (auto& it : mParallelThreads)
+    {
+        WorkThreadBase::retainIfCurrent(it.second);
+    }
 }
 
 void ConcurrencyThreadPool::registerWorkThread(const std::shared_ptr<WorkThreadBase>& thread)
@@ -45,8 +57,7 @@ void ConcurrencyThreadPool::registerWorkThread(const std::shared_ptr<WorkThreadB
     // 计数加一
     mData->mActiveThreads.fetch_add(1, std::memory_order_release);
     // mData->mIdleThreads.fetch_add(1, std::memory_order_release); [因为线程启动了， 执行过程中会++， 所以此处会重叠++， 出现一条线程， idle值为2的情况]
-    TaskQueueReporter::GetInstance().notifyReport(TaskQueueReporterType::TQRT_ThreadCountChanged,
-                                                  _threadPoolInfo(std::string(" threadid: ") + std::to_string(thread->threadId()) + " created"));
+    TaskQueueReporter::GetInstance().notifyReport(_threadCountEvent(TaskQueueReportReason::TQRR_ThreadCreated, thread->threadId()));
 }
 
 void ConcurrencyThreadPool::unregisterWorkThread(const std::shared_ptr<WorkThreadBase>& thread)
@@ -59,25 +70,62 @@ void ConcurrencyThreadPool::unregisterWorkThread(const std::shared_ptr<WorkThrea
     std::lock_guard<std::mutex> lock(mParallelMutex);
     mExpiredThreads.push_back(thread);
     mParallelThreads.erase(thread->threadId());
+    _retireLatency(thread);
 
     // 计数减一
     mData->mActiveThreads.fetch_sub(1, std::memory_order_release);
     mData->mIdleThreads.fetch_sub(1, std::memory_order_release);  // 确保线程池空闲线程数减一
-    TaskQueueReporter::GetInstance().notifyReport(TaskQueueReporterType::TQRT_ThreadCountChanged,
-                                                  _threadPoolInfo(std::string(" threadid: ") + std::to_string(thread->threadId()) + " released"));
+    TaskQueueReporter::GetInstance().notifyReport(_threadCountEvent(TaskQueueReportReason::TQRR_ThreadReleased, thread->threadId()));
 }
 
-void ConcurrencyThreadPool::execute(const TaskOperatorPtr& task, TaskQueuePriority priority)
+TaskSubmitResult ConcurrencyThreadPool::execute(const TaskOperatorPtr& task, TaskQueuePriority priority)
 {
 
-    LOGE("[Job] %s, task: %p, priority: %d , threadId: %d", __FUNCTION__, task.get(), priority, std::this_thread::get_id());
+    LOGT("[Job] %s, task: %p, priority: %d", __FUNCTION__, task.get(), priority);
 
     // 优先级判断
     if (priority < TaskQueuePriority::TQP_Low || priority >= TaskQueuePriority::TQP_Count)
     {
         LOGE("[TASK]ConcurrencyThreadPool::execute, invalid priority: %d \n", priority);
         assert(false);
-        return;
+        return TaskSubmitResult::TSR_Rejected;
+    }
+
+    // 关闭后拒绝经过队列提交的任务； 非独占串行队列的转发任务在工作线程退出前仍然入队， 由串行队列处理自身的任务
+    if (isShutdown() && (task->queueStat() || _isStopped()))
+    {
+        if (task->queueStat())
+        {
+            dropOnShutdown(task);
+        }
+        return TaskSubmitResult::TSR_Shutdown;
+    }
+
+    // 容量限制： 只限制经过队列入队的任务， 非独占串行队列的转发任务由串行队列自身限制
+    auto result = TaskSubmitResult::TSR_Accepted;
+    if (task->queueStat())
+    {
+        // 降载： 排队延迟持续超过目标时， 拒绝或延后低优先级任务 (带截止时间的任务与必须投递的任务不降载)
+        if (priority == TaskQueuePriority::TQP_Low && !task->hasDeadline() && !task->isMandatory() && mData->mShedder.isShedding())
+        {
+            // 速率限制暂存时预留的空位先归还， 延后投递时重新判断容量
+            mData->mCapacity.onDequeue(task);
+            return mData->mShedder.shed(task, shared_from_this(), false);
+        }
+
+        result = mData->mCapacity.admit(task, false, [this, priority]() { return _dropOldest(priority); });
+        switch (result)
+        {
+            case TaskSubmitResult::TSR_CallerRan:
+                QueueCapacity::runInCaller(task);
+                return result;
+            case TaskSubmitResult::TSR_Rejected:
+            case TaskSubmitResult::TSR_TimedOut:
+                QueueCapacity::discard(task);
+                return result;
+            default:
+                break;
+        }
     }
 
     // 队列数量监控
@@ -86,6 +134,15 @@ void ConcurrencyThreadPool::execute(const TaskOperatorPtr& task, TaskQueuePriori
     // 标记当前线程
     mData->mInputThreadID = std::this_thread::get_id();
 
+    // 带截止时间的任务进入EDF通道
+    if (task->hasDeadline())
+    {
+        mData->mDeadlineQueue.push(task);
+        mData->mSemaphore.release();
+        _schedule(priority);
+        return result;
+    }
+
     int32_t    prio     = static_cast<int32_t>(priority);
     const auto enqueued = mData->mTaskQueues[prio].enqueue(task);
     if (enqueued)
@@ -97,11 +154,255 @@ void ConcurrencyThreadPool::execute(const TaskOperatorPtr& task, TaskQueuePriori
 
     // 线程调度
     _schedule(priority);
+    return result;
+}
+
+void ConcurrencyThreadPool::executeBulk(std::vector<TaskOperatorPtr>& tasks, TaskQueuePriority priority)
+{
+    if (tasks.empty())
+    {
+        return;
+    }
+
+    // 设置了容量限制、正在降载或已关闭时逐个判断
+    if (mData->mCapacity.isLimited() || (priority == TaskQueuePriority::TQP_Low && mData->mShedder.isShedding()) || isShutdown())
+    {
+        for (auto& task : tasks)
+        {
+            execute(task, priority);
+        }
+        return;
+    }
+
+    if (priority < TaskQueuePriority::TQP_Low || priority >= TaskQueuePriority::TQP_Count)
+    {
+        LOGE("[TASK]ConcurrencyThreadPool::executeBulk, invalid priority: %d \n", priority);
+        assert(false);
+        return;
+    }
+
+    _monitorTask(priority);
+    mData->mInputThreadID = std::this_thread::get_id();
+
+    // 带截止时间的任务进入EDF通道， 其余任务一次入队
+    auto it = std::stable_partition(tasks.begin(), tasks.end(), [](const TaskOperatorPtr& task) { return !task->hasDeadline(); });
+    for (auto deadline = it; deadline != tasks.end(); ++deadline)
+    {
+        mData->mDeadlineQueue.push(*deadline);
+    }
+
+    size_t     released = static_cast<size_t>(tasks.end() - it);
+    const auto count    = static_cast<size_t>(it - tasks.begin());
+    if (count > 0)
+    {
+        if (mData->mTaskQueues[static_cast<int32_t>(priority)].enqueue_bulk(tasks.begin(), count))
+        {
+            released += count;
+        }
+        else
+        {
+            std::for_each(tasks.begin(), it, [](const TaskOperatorPtr& task) { QueueCapacity::discard(task); });
+        }
+    }
+    mData->mSemaphore.release(static_cast<int>(released));
+
+    // 每次调度最多创建一条线程， 按任务数调度 (不超过最大线程数)
+    const auto schedules = std::min<size_t>(tasks.size(), static_cast<size_t>(std::max(1, mData->mMaxThreads.load(std::memory_order_acquire))));
+    for (size_t i = 0; i < schedules; ++i)
+    {
+        _schedule(priority);
+    }
+}
+
+TaskShutdownStat ConcurrencyThreadPool::shutdown(std::chrono::milliseconds timeout, TaskShutdownPolicy policy)
+{
+    TaskShutdownStat stat;
+    if (!_beginShutdown(policy))
+    {
+        LOGW("[TASK]ConcurrencyThreadPool::shutdown, already shutdown\n");
+        return stat;
+    }
+    LOGD("[TASK]ConcurrencyThreadPool::shutdown, timeout: %lld, policy: %d\n", ( long long )timeout.count(), policy);
+
+    const auto start    = std::chrono::steady_clock::now();
+    const auto timedOut = [&start, timeout]() { return timeout.count() >= 0 && std::chrono::steady_clock::now() - start >= timeout; };
+
+    // 1. 取消或等待排队中的任务 (非独占串行队列的转发任务保留， 由串行队列处理自身的任务)
+    if (policy == TaskShutdownPolicy::TSP_Cancel)
+    {
+        _cancelPending();
+    }
+    while (!_isDrained())
+    {
+        if (timedOut())
+        {
+            // 超时： 剩余的排队任务取消
+            stat.mTimedOut = true;
+            _setShutdownState(SS_Cancelling);
+            _cancelPending();
+            break;
+        }
+        std::this_thread::sleep_for(kShutdownPollInterval);
+    }
+
+    // 2. 不再创建线程， 通知所有线程退出， 等待正在执行的任务结束
+    _setShutdownState(SS_Stopped);
+    while (_stopThreads() > 0 && !timedOut())
+    {
+        std::this_thread::sleep_for(kShutdownPollInterval);
+    }
+
+    // 3. 回收已退出的线程， 清理退出期间入队的任务
+    std::vector<std::shared_ptr<WorkThreadBase>> expiredThreads;
+    {
+        std::lock_guard<std::mutex> lock(mParallelMutex);
+        expiredThreads.swap(mExpiredThreads);
+        stat.mBusyThreads = static_cast<uint32_t>(mParallelThreads.size());
+    }
+    stat.mJoinedThreads = static_cast<uint32_t>(expiredThreads.size());
+    expiredThreads.clear();
+    _cancelPending();
+
+    stat.mTimedOut = stat.mTimedOut || stat.mBusyThreads > 0;
+    stat.mDropped  = _shutdownDropped();
+    LOGD("[TASK]ConcurrencyThreadPool::shutdown, dropped: %llu, joined: %u, busy: %u\n", ( unsigned long long )stat.mDropped,
+         stat.mJoinedThreads, stat.mBusyThreads);
+    return stat;
+}
+
+void ConcurrencyThreadPool::_cancelPending()
+{
+    // 信号量计数比任务多， 工作线程取不到任务时进入下一轮等待
+    TaskOperatorPtr op;
+    bool            dropped = false;
+    while (mData->mDeadlineQueue.tryPop(op, 0, dropped))
+    {
+        mData->mCapacity.onDequeue(op);
+        dropOnShutdown(op);
+    }
+
+    std::vector<TaskOperatorPtr> forwards;
+    for (auto& queue : mData->mTaskQueues)
+    {
+        while (queue.try_dequeue(op))
+        {
+            if (op == nullptr)
+            {
+                continue;
+            }
+            if (op->queueStat() == nullptr)
+            {
+                // 内部转发任务 (非独占串行队列) 放回， 执行时丢弃串行队列中的任务
+                forwards.push_back(std::move(op));
+                continue;
+            }
+            mData->mCapacity.onDequeue(op);
+            dropOnShutdown(op);
+        }
+    }
+
+    if (forwards.empty())
+    {
+        return;
+    }
+    if (_isStopped())
+    {
+        // 工作线程已退出， 在当前线程丢弃串行队列中的任务 (不执行任务)
+        for (auto& forward : forwards)
+        {
+            (*forward)();
+        }
+        return;
+    }
+    mData->mTaskQueues[static_cast<int32_t>(TaskQueuePriority::TQP_High)].enqueue_bulk(forwards.begin(), forwards.size());
+}
+
+int32_t ConcurrencyThreadPool::_stopThreads()
+{
+    int32_t threadCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(mParallelMutex);
+        for (auto& item : mParallelThreads)
+        {
+            item.second->cancel();
+        }
+        threadCount = static_cast<int32_t>(mParallelThreads.size());
+    }
+
+    // 唤醒等待中的线程 (多余的计数不影响， 线程池不再使用)
+    if (threadCount > 0)
+    {
+        mData->mSemaphore.release(threadCount);
+    }
+    return threadCount;
+}
+
+bool ConcurrencyThreadPool::_isDrained() const
+{
+    // 没有排队的任务， 且所有线程都在等待 (线程取到信号量后才减少空闲数， 出队前已计为忙碌)
+    return _pendingCount() == 0
+           && mData->mIdleThreads.load(std::memory_order_seq_cst) >= mData->mActiveThreads.load(std::memory_order_seq_cst);
+}
+
+size_t ConcurrencyThreadPool::_pendingCount() const
+{
+    size_t pending = mData->mDeadlineQueue.size();
+    for (auto& queue : mData->mTaskQueues)
+    {
+        pending += queue.size_approx();
+    }
+    return pending;
+}
+
+TaskSubmitResult ConcurrencyThreadPool::reserve(const TaskOperatorPtr& task, TaskQueuePriority priority)
+{
+    if (priority < TaskQueuePriority::TQP_Low || priority >= TaskQueuePriority::TQP_Count)
+    {
+        return TaskSubmitResult::TSR_Accepted;
+    }
+
+    auto result = mData->mCapacity.admit(task, true, [this, priority]() { return _dropOldest(priority); });
+    if (result == TaskSubmitResult::TSR_Rejected || result == TaskSubmitResult::TSR_TimedOut)
+    {
+        QueueCapacity::discard(task);
+    }
+    return result;
+}
+
+void ConcurrencyThreadPool::unreserve(const TaskOperatorPtr& task, TaskQueuePriority /*priority*/)
+{
+    mData->mCapacity.onDequeue(task);
+}
+
+bool ConcurrencyThreadPool::_dropOldest(TaskQueuePriority priority)
+{
+    // 优先丢弃低优先级的任务， 不丢弃更高优先级 与 EDF通道中的任务
+    for (int32_t i = 0; i <= static_cast<int32_t>(priority); ++i)
+    {
+        TaskOperatorPtr op;
+        if (!mData->mTaskQueues[i].try_dequeue(op) || op == nullptr)
+        {
+            continue;
+        }
+
+        // 内部转发任务 (非独占串行队列) 不能丢弃， 放回队尾
+        if (op->queueStat() == nullptr)
+        {
+            mData->mTaskQueues[i].enqueue(std::move(op));
+            continue;
+        }
+
+        // 信号量计数比任务多一次， 工作线程取不到任务时进入下一轮等待
+        mData->mCapacity.onDequeue(op);
+        QueueCapacity::discard(op);
+        return true;
+    }
+    return false;
 }
 
 void ConcurrencyThreadPool::notifyNextThread(int32_t threadID)
 {
-    LOGE("[Job] ConcurrencyThreadPool::notifyNextThread, threadId: %d \n", threadID);
+    LOGT("[Job] ConcurrencyThreadPool::notifyNextThread, threadId: %d \n", threadID);
     _schedule(TaskQueuePriority::TQP_Normal);
     mData->mSemaphore.release();
 }
@@ -112,13 +413,13 @@ void ConcurrencyThreadPool::_monitorTask(TaskQueuePriority priority)
     //1. 监控任务队列数量
     if (mData->mTaskQueues[prio].size_approx() >= TaskQueueConstant::sMaxTaskQueueCount)
     {
-        TaskQueueReporter::GetInstance().notifyReportLimit(TaskQueueConstant::sMaxReportCountThreshold,
-                                                           mReportCnt,
-                                                           TaskQueueReporterType::TQRT_TaskCountExceedThreshold,
-                                                           _threadPoolInfo(std::string(" tsk_exceed, pri: ")
-                                                                           + std::to_string(prio)
-                                                                           + ", tsk_cnt: "
-                                                                           + std::to_string(mData->mTaskQueues[prio].size_approx())));
+        TaskQueueReporter::GetInstance().notifyReportLimit(TaskQueueConstant::sMaxReportCountThreshold, mReportCnt, [this, prio]() {
+            TaskCountExceedEvent event;
+            event.mPoolType     = TaskQueueType::TQT_Parallel;
+            event.mPriority     = prio;
+            event.mPendingCount = mData->mTaskQueues[prio].size_approx();
+            return TaskQueueReportEvent(event);
+        });
     }
     else
     {
@@ -128,6 +429,11 @@ void ConcurrencyThreadPool::_monitorTask(TaskQueuePriority priority)
 
 void ConcurrencyThreadPool::_schedule(TaskQueuePriority priority)
 {
+    // 关闭后不再创建线程
+    if (_isStopped())
+    {
+        return;
+    }
 
     // 如果有idle线程，不需要调度
     // 如果当前队列数量小于10，暂不创建新线程
@@ -145,59 +451,84 @@ void ConcurrencyThreadPool::_schedule(TaskQueuePriority priority)
     {
         // 创建新线程，注册到线程池
         auto thread = std::make_shared<WorkThreadConcurrency>(shared_from_this());
-        LOGE("[Job] ConcurrencyThreadPool::_schedule, create new thread, threadId: %d, idleThreads: %d, activeThreads: %d \n", thread->threadId(), idleCount, activeCount);
+        LOGD("[Job] ConcurrencyThreadPool::_schedule, create new thread, threadId: %d, idleThreads: %d, activeThreads: %d \n", thread->threadId(), idleCount, activeCount);
 
         registerWorkThread(std::static_pointer_cast<WorkThreadBase>(thread));
         
     }
     else
     {
-        // 如果达到最大线程数量，就只有等待被调度了
-        TaskQueueReporter::GetInstance().notifyReportLimit(TaskQueueConstant::sMaxReportCountThreshold,
-                                                           mReportCnt,
-                                                           TaskQueueReporterType::TQRT_ThreadCountChanged,
-                                                           _threadPoolInfo("max_threads_arrived"));
+        // 如果达到最大线程数量，就只有等待被调度了 (卡住的线程由看门狗检查)
+        TaskQueueReporter::GetInstance().notifyReportLimit(TaskQueueConstant::sMaxReportCountThreshold, mReportCnt, [this]() {
+            return TaskQueueReportEvent(_threadCountEvent(TaskQueueReportReason::TQRR_MaxThreadsArrived));
+        });
+    }
+    // 删除过期线程, 确保生命周期正确
+    {
+        std::vector<std::shared_ptr<WorkThreadBase>> expiredThreads;
+        {
+            std::lock_guard<std::mutex> lock(mParallelMutex);
+            expiredThreads.swap(mExpiredThreads);
+        }
+    }
+}
 
-        //检查线程是否有block
+void ConcurrencyThreadPool::checkBlocked()
+{
+    std::vector<std::shared_ptr<WorkThreadBase>> blockedThreads;
+    {
         std::lock_guard<std::mutex> lock(mParallelMutex);
-        for (auto it = mParallelThreads.begin(); it != mParallelThreads.end();)
+        for (auto& item : mParallelThreads)
         {
-            if (it->second->isBlocked())
+            if (item.second && item.second->isBlocked() && item.second->markBlocked())
             {
-                TaskQueueReporter::GetInstance().notifyReport(TaskQueueReporterType::TQRT_TaskDurationExceedThreshold,
-                                                              it->second->blockedInfo());
-                it = mParallelThreads.erase(it);
-
-                // 减少一条活跃线程
-                mData->mActiveThreads.fetch_sub(1, std::memory_order_release);
-                continue;
+                blockedThreads.push_back(item.second);
             }
-            ++it;
         }
     }
-    // 删除过期线程, 确保生命周期正确
+
+    for (auto& thread : blockedThreads)
     {
-        std::vector<std::shared_ptr<WorkThreadBase>> expiredThreads;
+        auto event = thread->blockedEvent();
+        thread->captureStack(event);
+        TaskQueueReporter::GetInstance().notifyReport(event);
+        LOGW("[TASK]ConcurrencyThreadPool::checkBlocked, threadId: %d is blocked, %llu ms", thread->threadId(),
+             ( unsigned long long )event.mBlockedMillis);
+
+        // 卡住的线程不计入容量， 补偿一条工作线程 (线程恢复后归还容量， 多余的线程空闲超时后退出)
+        // 关闭期间不再补偿
+        if (isShutdown())
         {
-            std::lock_guard<std::mutex> lock(mParallelMutex);
-            expiredThreads.swap(mExpiredThreads);
+            continue;
         }
+        mData->mMaxThreads.fetch_add(1, std::memory_order_acq_rel);
+        auto worker = std::make_shared<WorkThreadConcurrency>(shared_from_this());
+        registerWorkThread(std::static_pointer_cast<WorkThreadBase>(worker));
     }
 }
 
-std::string ConcurrencyThreadPool::_threadPoolInfo(std::string reason) const
+ThreadCountChangedEvent ConcurrencyThreadPool::_threadCountEvent(TaskQueueReportReason reason, int32_t threadId) const
 {
-    std::string info = "ParallelPool: active: "
-                       + std::to_string(mData->mActiveThreads.load(std::memory_order_relaxed))
-                       + ", idle: "
-                       + std::to_string(mData->mIdleThreads.load(std::memory_order_relaxed))
-                       + ", max: "
-                       + std::to_string(mData->mMaxThreads.load(std::memory_order_relaxed))
-                       + ", reason: "
-                       + reason;
+    ThreadCountChangedEvent event;
+    event.mPoolType = TaskQueueType::TQT_Parallel;
+    event.mReason   = reason;
+    event.mThreadId = threadId;
+    event.mActive   = mData->mActiveThreads.load(std::memory_order_relaxed);
+    event.mIdle     = mData->mIdleThreads.load(std::memory_order_relaxed);
+    event.mMax      = mData->mMaxThreads.load(std::memory_order_relaxed);
+    return event;
+}
 
-    LOGE("[TASK] %s \n", info.c_str());
-    return info;
+void ConcurrencyThreadPool::_collectLatency(LatencyHistogram::Snapshot& run, LatencyHistogram::Snapshot& wait)
+{
+    std::lock_guard<std::mutex> lock(mParallelMutex);
+    for (auto& item : mParallelThreads)
+    {
+        if (item.second)
+        {
+            item.second->collectLatency(run, wait);
+        }
+    }
 }
 
-}  // namespace task
\ No newline at end of file
+}  // namespace task
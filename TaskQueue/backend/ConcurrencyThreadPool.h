@@ -5,12 +5,14 @@
 #include "Semaphore.h"
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
 
 #include "QueueDefine.h"
+#include "TaskQueueReporter.h"
 namespace task
 {
 class WorkThreadBase;
@@ -25,9 +27,21 @@ public:
     virtual void unregisterWorkThread(const std::shared_ptr<WorkThreadBase>& thread) override;
 
     // 线程池管理任务
-    virtual void execute(const TaskOperatorPtr& task, TaskQueuePriority priority = TaskQueuePriority::TQP_Normal) override;
+    // 设置了容量限制时， 队列已满按溢出策略处理 (内部转发任务不受限制)
+    virtual TaskSubmitResult execute(const TaskOperatorPtr& task, TaskQueuePriority priority = TaskQueuePriority::TQP_Normal) override;
+    // 批量提交， 未设置容量限制且不在降载时一次入队
+    virtual void executeBulk(std::vector<TaskOperatorPtr>& tasks, TaskQueuePriority priority) override;
+    // 预留/归还排队空位 (速率限制暂存任务)
+    virtual TaskSubmitResult reserve(const TaskOperatorPtr& task, TaskQueuePriority priority) override;
+    virtual void             unreserve(const TaskOperatorPtr& task, TaskQueuePriority priority) override;
+
+    // 关闭线程池， 非独占串行队列随线程池关闭
+    virtual TaskShutdownStat shutdown(std::chrono::milliseconds timeout, TaskShutdownPolicy policy) override;
 
     virtual void notifyNextThread(int32_t threadID) override;
+
+    // 卡住的线程上报堆栈， 并补偿一条工作线程 (卡住的线程恢复后归还)
+    virtual void checkBlocked() override;
     
     virtual const std::shared_ptr<Data> getData() const override
     {
@@ -35,12 +49,26 @@ public:
     }
 
 protected:
+    virtual void _collectLatency(LatencyHistogram::Snapshot& run, LatencyHistogram::Snapshot& wait) override;
+
     // 线程调度
-    void        _schedule(TaskQueuePriority priority);
-    std::string _threadPoolInfo(std::string reason) const;
+    void                    _schedule(TaskQueuePriority priority);
+    ThreadCountChangedEvent _threadCountEvent(TaskQueueReportReason reason, int32_t threadId = -1) const;
 
     void _monitorTask(TaskQueuePriority priority);
 
+    // 排队任务总数 (近似值)
+    size_t _pendingCount() const;
+    // 从低优先级到priority丢弃一个最早入队的任务
+    bool _dropOldest(TaskQueuePriority priority);
+
+    // 关闭时取消排队中的任务 (内部转发任务放回)
+    void _cancelPending();
+    // 排队任务已全部执行完
+    bool _isDrained() const;
+    // 通知所有线程退出， 返回仍未退出的线程数
+    int32_t _stopThreads();
+
 private:
     // 并行线程集合
     std::shared_ptr<Data>                                        mData;
@@ -49,7 +77,9 @@ private:
     std::vector<std::shared_ptr<WorkThreadBase>>                 mExpiredThreads;  // 过期线程
 
     // stat
-    int32_t mReportCnt{ 0 };
+    std::atomic<int32_t> mReportCnt{ 0 };
+
+    static constexpr std::chrono::milliseconds kShutdownPollInterval{ 1 };
 };
 
 }  // namespace task
@@ -0,0 +1,121 @@
+#include "DeadlineQueue.h"
+#include "TaskOperator.h"
+#include <thread>
+#include <utility>
+namespace task
+{
+void DeadlineQueue::push(const TaskOperatorPtr& task)
+{
+    Entry entry{ task->deadline(), 0, task };
+
+    _lock();
+    entry.mSeq = mSeq++;
+    mHeap.push_back(std::move(entry));
+
+    // 上浮
+    size_t index = mHeap.size() - 1;
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (!_earlier(mHeap[index], mHeap[parent]))
+        {
+            break;
+        }
+        std::swap(mHeap[index], mHeap[parent]);
+        index = parent;
+    }
+    mSize.store(mHeap.size(), std::memory_order_release);
+    _unlock();
+
+    mScheduled.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool DeadlineQueue::tryPop(TaskOperatorPtr& task, uint64_t now, bool& dropped)
+{
+    dropped = false;
+    if (empty())
+    {
+        return false;
+    }
+
+    Entry top;
+    _lock();
+    if (mHeap.empty())
+    {
+        _unlock();
+        return false;
+    }
+
+    top = std::move(mHeap.front());
+    mHeap.front() = std::move(mHeap.back());
+    mHeap.pop_back();
+
+    // 下沉
+    const size_t count = mHeap.size();
+    size_t       index = 0;
+    while (true)
+    {
+        size_t left     = index * 2 + 1;
+        size_t smallest = index;
+        if (left < count && _earlier(mHeap[left], mHeap[smallest]))
+        {
+            smallest = left;
+        }
+        if (left + 1 < count && _earlier(mHeap[left + 1], mHeap[smallest]))
+        {
+            smallest = left + 1;
+        }
+        if (smallest == index)
+        {
+            break;
+        }
+        std::swap(mHeap[index], mHeap[smallest]);
+        index = smallest;
+    }
+    mSize.store(count, std::memory_order_release);
+    _unlock();
+
+    mStarted.fetch_add(1, std::memory_order_relaxed);
+    if (now > top.mDeadline)
+    {
+        mMissed.fetch_add(1, std::memory_order_relaxed);
+        if (top.mTask && top.mTask->dropIfMissed())
+        {
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            dropped = true;
+        }
+    }
+
+    task = std::move(top.mTask);
+    return true;
+}
+
+TaskDeadlineStat DeadlineQueue::stat() const
+{
+    TaskDeadlineStat stat;
+    stat.mScheduled = mScheduled.load(std::memory_order_relaxed);
+    stat.mStarted   = mStarted.load(std::memory_order_relaxed);
+    stat.mMissed    = mMissed.load(std::memory_order_relaxed);
+    stat.mDropped   = mDropped.load(std::memory_order_relaxed);
+    return stat;
+}
+
+void DeadlineQueue::_lock()
+{
+    int spin = 0;
+    while (mLock.test_and_set(std::memory_order_acquire))
+    {
+        // 临界区很短， 自旋一段时间后让出CPU
+        if (++spin > 64)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void DeadlineQueue::_unlock()
+{
+    mLock.clear(std::memory_order_release);
+}
+
+}  // namespace task
@@ -0,0 +1,69 @@
+// EDF (最早截止时间优先) 任务通道
+// 按截止时间排序的并发最小堆： 自旋锁保护二叉堆， 临界区只有O(logN)的堆调整
+// 空队列判断只读原子计数， 不加锁， 工作线程每次取任务都会先检查此通道
+#ifndef __DEADLINE_QUEUE_H__
+#define __DEADLINE_QUEUE_H__
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "TaskQueueDefine.h"
+
+namespace task
+{
+class DeadlineQueue final
+{
+public:
+    DeadlineQueue() = default;
+    ~DeadlineQueue() = default;
+
+    void push(const TaskOperatorPtr& task);
+
+    // 取出截止时间最早的任务， 队列为空返回false
+    // 已错过截止时间且要求丢弃时， dropped为true， 由调用方丢弃 (唤醒等待方)
+    bool tryPop(TaskOperatorPtr& task, uint64_t now, bool& dropped);
+
+    bool empty() const
+    {
+        return mSize.load(std::memory_order_acquire) == 0;
+    }
+
+    size_t size() const
+    {
+        return mSize.load(std::memory_order_acquire);
+    }
+
+    TaskDeadlineStat stat() const;
+
+private:
+    struct Entry
+    {
+        uint64_t        mDeadline;
+        uint64_t        mSeq;  // 截止时间相同时按入队顺序
+        TaskOperatorPtr mTask;
+    };
+
+    static bool _earlier(const Entry& lhs, const Entry& rhs)
+    {
+        return lhs.mDeadline < rhs.mDeadline || (lhs.mDeadline == rhs.mDeadline && lhs.mSeq < rhs.mSeq);
+    }
+
+    void _lock();
+    void _unlock();
+
+private:
+    std::atomic_flag    mLock = ATOMIC_FLAG_INIT;
+    std::vector<Entry>  mHeap;
+    uint64_t            mSeq{ 0 };
+    std::atomic<size_t> mSize{ 0 };
+
+    // 统计
+    std::atomic<uint64_t> mScheduled{ 0 };
+    std::atomic<uint64_t> mStarted{ 0 };
+    std::atomic<uint64_t> mMissed{ 0 };
+    std::atomic<uint64_t> mDropped{ 0 };
+};
+
+}  // namespace task
+
+#endif  // __DEADLINE_QUEUE_H__
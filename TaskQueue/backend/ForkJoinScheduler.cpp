@@ -0,0 +1,172 @@
+#include "ForkJoinScheduler.h"
+#include "IThreadPool.h"
+#include "ParallelLoop.h"
+#include "TaskForkJoin.h"
+#include "TaskOperator.h"
+#include "common/LogHelper.h"
+
+namespace task
+{
+// 线程退出时标记本地队列， 新线程注册时复用 (线程退出前所有作用域都已 join， 队列为空)
+struct ForkJoinScheduler::DequeHolder
+{
+    std::shared_ptr<WorkerDeque> mDeque;
+    ~DequeHolder()
+    {
+        if (mDeque)
+        {
+            mDeque->mRetired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+void ForkJoinScheduler::push(Job* job)
+{
+    auto& local = _local();
+    {
+        std::lock_guard<std::mutex> lock(local.mMutex);
+        local.mJobs.push_back(job);
+        local.mEmpty.store(false, std::memory_order_release);
+    }
+    _addHelper();
+}
+
+ForkJoinScheduler::Job* ForkJoinScheduler::popLocal(const TaskForkJoin* scope)
+{
+    auto&                       local = _local();
+    std::lock_guard<std::mutex> lock(local.mMutex);
+    if (local.mJobs.empty() || local.mJobs.back()->mScope != scope)
+    {
+        return nullptr;
+    }
+
+    auto job = local.mJobs.back();
+    local.mJobs.pop_back();
+    local.mEmpty.store(local.mJobs.empty(), std::memory_order_release);
+    return job;
+}
+
+ForkJoinScheduler::Job* ForkJoinScheduler::steal()
+{
+    const size_t count = mSlotCount.load(std::memory_order_acquire);
+    if (count == 0)
+    {
+        return nullptr;
+    }
+
+    const size_t start = mStealStart.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto deque = mSlots[(start + i) % count].load(std::memory_order_acquire);
+        if (deque == nullptr || deque->mEmpty.load(std::memory_order_acquire))
+        {
+            continue;
+        }
+
+        auto& victim = *deque;
+
+        // 队列正被所属线程或其他窃取者使用时换下一个
+        std::unique_lock<std::mutex> lock(victim.mMutex, std::try_to_lock);
+        if (!lock.owns_lock() || victim.mJobs.empty())
+        {
+            continue;
+        }
+
+        auto job = victim.mJobs.front();
+        victim.mJobs.pop_front();
+        victim.mEmpty.store(victim.mJobs.empty(), std::memory_order_release);
+        return job;
+    }
+    return nullptr;
+}
+
+void ForkJoinScheduler::run(Job* job)
+{
+    auto scope = job->mScope;
+    job->mFunc();
+    delete job;
+    scope->_onChildFinished();
+}
+
+ForkJoinScheduler::WorkerDeque& ForkJoinScheduler::_local()
+{
+    static thread_local DequeHolder tHolder;
+    if (__builtin_expect(tHolder.mDeque == nullptr, 0))
+    {
+        tHolder.mDeque = _register();
+    }
+    return *tHolder.mDeque;
+}
+
+std::shared_ptr<ForkJoinScheduler::WorkerDeque> ForkJoinScheduler::_register()
+{
+    std::lock_guard<std::mutex> lock(mRegistryMutex);
+
+    // 复用已退出线程的队列 (队列对象不释放， 窃取者持有的指针始终有效)
+    const size_t count = mSlotCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto& owned = mOwned[i];
+        if (owned && owned->mRetired.load(std::memory_order_acquire))
+        {
+            owned->mRetired.store(false, std::memory_order_relaxed);
+            return owned;
+        }
+    }
+
+    auto deque = std::make_shared<WorkerDeque>();
+    if (count == kMaxDeques)
+    {
+        // 槽位已满， 本线程的子任务不能被窃取
+        LOGE("[TASK]ForkJoinScheduler::_register slots full: %zu", kMaxDeques);
+        return deque;
+    }
+    mOwned[count] = deque;
+    mSlots[count].store(deque.get(), std::memory_order_release);
+    mSlotCount.store(count + 1, std::memory_order_release);
+    return deque;
+}
+
+void ForkJoinScheduler::_addHelper()
+{
+    const auto maxHelpers = static_cast<int32_t>(ParallelLoop::workers(TaskParallelOptions()));
+    int32_t    helpers    = mHelpers.load(std::memory_order_relaxed);
+    do
+    {
+        if (helpers >= maxHelpers)
+        {
+            return;
+        }
+    } while (!mHelpers.compare_exchange_weak(helpers, helpers + 1, std::memory_order_acq_rel));
+
+    auto task = std::make_shared<TaskOperator>([this](const TaskOperatorPtr&) { _help(); });
+    if (IThreadPool::parallelThreadPool()->execute(task) != TaskSubmitResult::TSR_Accepted)
+    {
+        // 线程池拒绝时子任务由派生线程在 join 时执行
+        LOGE("[TASK]ForkJoinScheduler::_addHelper rejected by parallel pool");
+        mHelpers.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void ForkJoinScheduler::_help()
+{
+    while (true)
+    {
+        while (auto job = steal())
+        {
+            run(job);
+        }
+        mHelpers.fetch_sub(1, std::memory_order_acq_rel);
+
+        // 退出前再检查一次： 派生线程可能在计数减少前看到协助任务已满而没有补充
+        auto job = steal();
+        if (job == nullptr)
+        {
+            return;
+        }
+        mHelpers.fetch_add(1, std::memory_order_acq_rel);
+        run(job);
+    }
+}
+
+}  // namespace task
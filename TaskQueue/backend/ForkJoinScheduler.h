@@ -0,0 +1,83 @@
+// 分治任务调度
+// 每个调用过 spawn 的线程有一个本地双端队列， 本线程从尾部压入/取出， 其他线程从头部窃取 (最早派生的子任务， 通常是最大的子问题)
+// spawn 时协助任务不足线程池最大线程数则向并行线程池补充一个， 协助任务窃取并执行任务， 窃取不到时退出
+// 协助任务退出前再检查一次， 避免与同时派生的子任务错过； 错过时子任务仍由派生线程在 join 时执行， 不会卡住
+// 窃取的是子任务 (child stealing)， 派生线程继续执行 spawn 之后的代码； 续体窃取 (continuation stealing) 需要编译器保存调用栈，
+// 库中无法实现， join 时执行本地未被窃取的子任务或窃取其他任务， 同样不阻塞线程
+// 本地队列注册到定长槽位， 窃取时无锁遍历， 不分配内存； 线程退出后槽位由新线程复用
+#ifndef __FORK_JOIN_SCHEDULER_H__
+#define __FORK_JOIN_SCHEDULER_H__
+
+#include "TaskQueueDefine.h"
+#include "common/HESingleton.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace task
+{
+class TaskForkJoin;
+class ForkJoinScheduler : public task::HESingleton<ForkJoinScheduler>
+{
+    friend class task::HESingleton<ForkJoinScheduler>;
+
+public:
+    struct Job
+    {
+        std::function<void()> mFunc;
+        TaskForkJoin*         mScope{ nullptr };
+    };
+
+    ~ForkJoinScheduler() = default;
+
+    // 压入当前线程的本地队列， 按需补充协助任务
+    void push(Job* job);
+
+    // 从当前线程的本地队列尾部取出属于scope的任务 (其他作用域的任务留在队列中， 由它们自己的 join 取出)
+    Job* popLocal(const TaskForkJoin* scope);
+
+    // 从其他线程的队列头部窃取一个任务
+    Job* steal();
+
+    // 执行任务并通知所属作用域
+    void run(Job* job);
+
+private:
+    // 超出后新线程的子任务不能被窃取， 由派生线程在 join 时执行
+    static constexpr size_t kMaxDeques = 256;
+
+    struct WorkerDeque
+    {
+        std::mutex        mMutex;
+        std::deque<Job*>  mJobs;
+        std::atomic<bool> mEmpty{ true };     // 窃取时跳过空队列， 不加锁
+        std::atomic<bool> mRetired{ false };  // 所属线程已退出， 可由新线程复用
+    };
+    struct DequeHolder;
+
+    ForkJoinScheduler() = default;
+
+    // 当前线程的本地队列， 首次使用时注册
+    WorkerDeque&                 _local();
+    std::shared_ptr<WorkerDeque> _register();
+    void                         _addHelper();
+    // 协助任务： 窃取并执行， 直到窃取不到
+    void _help();
+
+private:
+    std::mutex                                           mRegistryMutex;  // 注册本地队列 (每个线程一次)
+    std::array<std::shared_ptr<WorkerDeque>, kMaxDeques> mOwned;          // 槽位持有的队列 【持锁访问】
+    std::array<std::atomic<WorkerDeque*>, kMaxDeques>    mSlots{};        // 窃取时无锁读取， 队列不会释放
+    std::atomic<size_t>                                  mSlotCount{ 0 };  // 已使用的槽位数
+    std::atomic<size_t>                                  mStealStart{ 0 };  // 窃取起点轮转， 分散竞争
+    std::atomic<int32_t>                                 mHelpers{ 0 };     // 已投递未退出的协助任务
+};
+
+}  // namespace task
+
+#endif  // __FORK_JOIN_SCHEDULER_H__
@@ -0,0 +1,273 @@
+#include "GraphImpl.h"
+#include "TaskOperator.h"
+#include "TaskQueue.h"
+#include "TaskQueueDefine.h"
+#include <cassert>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "common/LogHelper.h"
+namespace task
+{
+// 图节点任务： 执行用户任务后， 递减后继节点的前驱计数； 被丢弃时跳过所有后继节点
+class GraphNodeOperator : public TaskOperator
+{
+public:
+    GraphNodeOperator(GraphImpl* graph, int32_t index, const TaskOperatorPtr& op)
+        : mGraph(graph)
+        , mIndex(index)
+        , mRealTask(op)
+    {
+    }
+    ~GraphNodeOperator() = default;
+
+    virtual void operator()() override
+    {
+        recordRunStart();
+        if (mRealTask)
+        {
+            (*mRealTask)();
+        }
+        recordRunEnd();
+
+        // 必须放在最后， 图运行结束后可能被释放
+        mGraph->onNodeFinished(mIndex, false);
+    }
+
+    // 节点任务在多次运行间复用， 不随队列一起取消
+    virtual void cancel() override {}
+
+    // 被丢弃时本节点及其所有后继节点都不执行， 仍计为结束， 本次运行不会卡住 (节点任务在多次运行间复用， 不标记取消)
+    virtual void discard() override
+    {
+        mGraph->onNodeFinished(mIndex, true);
+    }
+
+private:
+    GraphImpl*      mGraph;  // 运行期间由 GraphImpl::mRunningSelf 保证生命周期
+    int32_t         mIndex;
+    TaskOperatorPtr mRealTask;
+};
+
+int32_t GraphImpl::addNode(const TaskOperatorPtr& task, const TaskQueuePtr& queue)
+{
+    if (task == nullptr || queue == nullptr || mRunning.load(std::memory_order_acquire))
+    {
+        LOGE("[TASK]GraphImpl::addNode failed, running: %d", mRunning.load());
+        return -1;
+    }
+
+    auto index      = static_cast<int32_t>(mNodes.size());
+    auto node       = std::make_unique<Node>();
+    node->mTask     = task;
+    node->mQueue    = queue;
+    node->mNodeTask = std::make_shared<GraphNodeOperator>(this, index, task);
+    mNodes.push_back(std::move(node));
+
+    mValidated = false;
+    return index;
+}
+
+bool GraphImpl::addEdge(int32_t from, int32_t to)
+{
+    const auto count = static_cast<int32_t>(mNodes.size());
+    if (from < 0 || from >= count || to < 0 || to >= count || from == to || mRunning.load(std::memory_order_acquire))
+    {
+        LOGE("[TASK]GraphImpl::addEdge failed, from: %d, to: %d, count: %d", from, to, count);
+        return false;
+    }
+
+    mNodes[from]->mSuccessors.push_back(to);
+    mNodes[to]->mPredecessors++;
+
+    mValidated = false;
+    return true;
+}
+
+bool GraphImpl::_validate()
+{
+    // Kahn 拓扑排序， 能遍历所有节点说明无环
+    const auto           count = mNodes.size();
+    std::vector<int32_t> inDegree(count);
+    std::vector<int32_t> ready;
+    ready.reserve(count);
+
+    mRoots.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        inDegree[i] = mNodes[i]->mPredecessors;
+        if (inDegree[i] == 0)
+        {
+            mRoots.push_back(static_cast<int32_t>(i));
+            ready.push_back(static_cast<int32_t>(i));
+        }
+    }
+
+    size_t visited = 0;
+    while (!ready.empty())
+    {
+        auto index = ready.back();
+        ready.pop_back();
+        visited++;
+
+        for (auto succ : mNodes[index]->mSuccessors)
+        {
+            if (--inDegree[succ] == 0)
+            {
+                ready.push_back(succ);
+            }
+        }
+    }
+
+    return visited == count;
+}
+
+bool GraphImpl::run(const TaskOperatorPtr& notifyTask, const TaskQueuePtr& notifyQueue)
+{
+    // 同一时刻只允许一次运行
+    if (mRunning.exchange(true, std::memory_order_acq_rel))
+    {
+        LOGE("[TASK]GraphImpl::run failed, graph is running");
+        return false;
+    }
+
+    if (!mValidated)
+    {
+        mAcyclic   = _validate();
+        mValidated = true;
+    }
+
+    if (!mAcyclic)
+    {
+        LOGE("[TASK]GraphImpl::run failed, graph has cycle");
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mRunning.store(false, std::memory_order_release);
+        }
+        mCond.notify_all();
+        return false;
+    }
+
+    // 重置计数 (复用节点， 不重新分配)
+    for (auto& node : mNodes)
+    {
+        node->mPending.store(node->mPredecessors, std::memory_order_relaxed);
+        node->mFailed.store(false, std::memory_order_relaxed);
+    }
+    mSkipped.store(0, std::memory_order_relaxed);
+    mNotifyTask  = notifyTask;
+    mNotifyQueue = notifyQueue;
+    mRemaining.store(static_cast<int32_t>(mNodes.size()), std::memory_order_release);
+
+    if (mNodes.empty())
+    {
+        _finishRun();
+        return true;
+    }
+
+    // 运行期间持有自身， 用户释放TaskGraph后仍能执行完成
+    mRunningSelf = shared_from_this();
+
+    // 根节点直接投递
+    // 先复制再投递： 根节点可能在工作线程上完成整张图并结束本次运行， 之后新的 run()/addNode() 会修改节点和根节点列表
+    std::vector<std::pair<TaskQueuePtr, TaskOperatorPtr>> roots;
+    roots.reserve(mRoots.size());
+    for (auto index : mRoots)
+    {
+        const auto& node = mNodes[index];
+        roots.emplace_back(node->mQueue, node->mNodeTask);
+    }
+    for (auto& root : roots)
+    {
+        root.first->async(root.second);
+    }
+    return true;
+}
+
+void GraphImpl::onNodeFinished(int32_t index, bool failed)
+{
+    // 被跳过的后继节点在本线程直接结束， 不投递 (正常完成时不分配)
+    std::vector<int32_t> skipped;
+    int32_t              finished = 1;
+    if (failed)
+    {
+        mSkipped.fetch_add(1, std::memory_order_relaxed);
+    }
+    _releaseSuccessors(index, failed, skipped);
+
+    while (!skipped.empty())
+    {
+        auto succ = skipped.back();
+        skipped.pop_back();
+        mSkipped.fetch_add(1, std::memory_order_relaxed);
+        finished++;
+        _releaseSuccessors(succ, true, skipped);
+    }
+
+    if (finished == mRemaining.fetch_sub(finished, std::memory_order_acq_rel))
+    {
+        _finishRun();
+    }
+}
+
+void GraphImpl::_releaseSuccessors(int32_t index, bool failed, std::vector<int32_t>& skipped)
+{
+    const auto& node = mNodes[index];
+
+    // 前驱全部结束的节点立即投递， 有前驱未执行时跳过
+    for (auto succ : node->mSuccessors)
+    {
+        const auto& succNode = mNodes[succ];
+        if (failed)
+        {
+            // 先于计数递减写入， 最后递减的线程可见
+            succNode->mFailed.store(true, std::memory_order_relaxed);
+        }
+        if (1 == succNode->mPending.fetch_sub(1, std::memory_order_acq_rel))
+        {
+            if (succNode->mFailed.load(std::memory_order_relaxed))
+            {
+                skipped.push_back(succ);
+            }
+            else
+            {
+                succNode->mQueue->async(succNode->mNodeTask);
+            }
+        }
+    }
+}
+
+void GraphImpl::_finishRun()
+{
+    // 局部变量延长生命周期到函数结束
+    auto self        = std::move(mRunningSelf);
+    auto notifyTask  = std::move(mNotifyTask);
+    auto notifyQueue = std::move(mNotifyQueue);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRunning.store(false, std::memory_order_release);
+    }
+    mCond.notify_all();
+
+    if (notifyTask && notifyQueue)
+    {
+        notifyQueue->async(notifyTask);
+    }
+}
+
+bool GraphImpl::wait(std::chrono::milliseconds t)
+{
+    auto predicate = [this] { return !mRunning.load(std::memory_order_acquire); };
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (t != std::chrono::milliseconds(-1))
+    {
+        return mCond.wait_for(lock, t, predicate);
+    }
+
+    mCond.wait(lock, predicate);
+    return true;
+}
+
+}  // namespace task
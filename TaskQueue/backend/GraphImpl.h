@@ -0,0 +1,84 @@
+#ifndef __GRAPH_IMPL_H__
+#define __GRAPH_IMPL_H__
+
+#include "TaskQueueDefine.h"
+#include "QueueDefine.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+namespace task
+{
+class GraphImpl : public std::enable_shared_from_this<GraphImpl>
+{
+public:
+    GraphImpl() = default;
+    ~GraphImpl() = default;
+
+    // 添加节点， 返回节点ID
+    int32_t addNode(const TaskOperatorPtr& task, const TaskQueuePtr& queue);
+
+    // 添加依赖边 from -> to
+    bool addEdge(int32_t from, int32_t to);
+
+    // 运行图， notifyTask 不为空时，全部节点完成后在notifyQueue上异步通知
+    bool run(const TaskOperatorPtr& notifyTask, const TaskQueuePtr& notifyQueue);
+
+    // 等待本次运行结束
+    bool wait(std::chrono::milliseconds t = std::chrono::milliseconds(-1));
+
+    size_t nodeCount() const
+    {
+        return mNodes.size();
+    }
+
+    // 本次运行未执行的节点数量
+    size_t skippedCount() const
+    {
+        return static_cast<size_t>(mSkipped.load(std::memory_order_acquire));
+    }
+
+    // 节点结束， 由节点任务在执行线程上回调
+    // failed: 节点被丢弃 (队列取消/拒绝等)， 其后继节点不再执行
+    void onNodeFinished(int32_t index, bool failed);
+
+private:
+    struct Node
+    {
+        TaskOperatorPtr      mTask;                // 用户任务
+        TaskQueuePtr         mQueue;               // 执行队列
+        TaskOperatorPtr      mNodeTask;            // 节点包装任务， 添加节点时创建， 多次运行复用
+        std::vector<int32_t> mSuccessors;          // 后继节点
+        int32_t              mPredecessors{ 0 };   // 前驱数量
+        std::atomic<int32_t> mPending{ 0 };        // 本次运行剩余未完成的前驱数量
+        std::atomic<bool>    mFailed{ false };     // 本次运行有前驱未执行， 就绪时跳过
+    };
+
+    // 检查是否有环， 同时收集根节点
+    bool _validate();
+    // 递减后继节点的前驱计数， 前驱全部结束的节点投递执行， 有前驱未执行的节点放入skipped
+    void _releaseSuccessors(int32_t index, bool failed, std::vector<int32_t>& skipped);
+    void _finishRun();
+
+private:
+    std::vector<std::unique_ptr<Node>> mNodes;
+    std::vector<int32_t>               mRoots;               // 无前驱的节点
+    bool                               mValidated{ false };  // 拓扑是否已检查 (增删边后重置)
+    bool                               mAcyclic{ false };
+
+    std::atomic<bool>          mRunning{ false };
+    std::atomic<int32_t>       mRemaining{ 0 };  // 本次运行剩余未完成的节点数量
+    std::atomic<int32_t>       mSkipped{ 0 };    // 本次运行未执行的节点数量 (被丢弃 + 因前驱未执行而跳过)
+    std::shared_ptr<GraphImpl> mRunningSelf;     // 运行期间保证图的生命周期
+    TaskOperatorPtr            mNotifyTask;
+    TaskQueuePtr               mNotifyQueue;
+
+    std::mutex              mMutex;
+    std::condition_variable mCond;
+};
+
+}  // namespace task
+
+#endif  //__GRAPH_IMPL_H__
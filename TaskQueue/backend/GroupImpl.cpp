@@ -12,11 +12,12 @@ namespace task
 {
 GroupImpl::~GroupImpl()
 {
-    LOGE("[TASK]~GroupImpl()\n");
+    LOGD("[TASK]~GroupImpl()\n");
 }
 // 在指定队列抛一个任务
 void GroupImpl::async(const TaskOperatorPtr& task, const TaskQueuePtr& queue)
 {
+    _trackCancel(task);
     mConsumable->retain();
 
     auto consumTask =
@@ -27,12 +28,22 @@ void GroupImpl::async(const TaskOperatorPtr& task, const TaskQueuePtr& queue)
 // 在全局队列抛一个任务
 void GroupImpl::async(const TaskOperatorPtr& task, TaskQueuePriority priority)
 {
+    _trackCancel(task);
     mConsumable->retain();
     auto consumTask =
         std::make_shared<ConsumableOperator>(task, mConsumable);
     TaskQueueFactory::GetInstance().globalConcurrencyQueue(priority)->async(consumTask);
 }
 
+void GroupImpl::_trackCancel(const TaskOperatorPtr& task)
+{
+    mCancelScope.track(task);
+    if (task->cancelScope())
+    {
+        task->cancelScope()->track(task);
+    }
+}
+
 // group所有执行完后，在指定queue上异步通知
 void GroupImpl::notify(const TaskOperatorPtr& task, const TaskQueuePtr& queue)
 {
@@ -55,12 +66,15 @@ bool GroupImpl::wait(std::chrono::milliseconds t)
     do
     {
         oldC = std::atomic_load(&mConsumable);
-        newC = std::make_shared<Consumable>(0, oldC);  //依赖链式创建
+        newC = std::make_shared<Consumable>(1, oldC);  //依赖链式创建
     } while (!std::atomic_compare_exchange_weak(&mConsumable, &oldC, newC));
 
     assert(oldC);
     assert(newC);
 
+    // 归还提交期间保留的计数， 避免任务执行快于提交时计数中途归零提前唤醒
+    oldC->release();
+
     // 只等待之前提交的任务
     return oldC->wait_for(t);
 }
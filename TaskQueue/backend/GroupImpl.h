@@ -4,6 +4,7 @@
 #include "TaskQueueDefine.h"
 #include "QueueDefine.h"
 #include "Consumable.h"
+#include "TaskCancelScope.h"
 #include <memory>
 namespace task
 {
@@ -12,7 +13,7 @@ class GroupImpl : public std::enable_shared_from_this<GroupImpl>
 public:
     explicit GroupImpl(const ThreadPoolPtr& pool)
         : mThreadPool(pool)
-        , mConsumable(std::make_shared<Consumable>(0)){};
+        , mConsumable(std::make_shared<Consumable>(1)){};  // 提交期间保留1个计数， 由wait归还
     ~GroupImpl();
 
     // 在指定队列抛一个任务
@@ -27,9 +28,20 @@ public:
     // group 等待所有任务结束
     bool wait(std::chrono::milliseconds t = std::chrono::milliseconds(-1));
 
+    // 取消所有未执行的任务， 返回取消的任务数
+    size_t cancelAll()
+    {
+        return mCancelScope.cancel();
+    }
+
+private:
+    // 记录到任务组及任务自身的取消作用域
+    void _trackCancel(const TaskOperatorPtr& task);
+
 private:
     ThreadPoolPtr mThreadPool;  //线程池
     ConsumablePtr mConsumable;
+    TaskCancelScope mCancelScope;  // 经过任务组提交的任务
 };
 
 }  // namespace task
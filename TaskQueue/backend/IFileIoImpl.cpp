@@ -0,0 +1,92 @@
+#include "IFileIoImpl.h"
+#include "ThreadFileIoImpl.h"
+#include "UringFileIoImpl.h"
+#include "TaskOperator.h"
+#include "TaskQueue.h"
+#include "common/LogHelper.h"
+#include <errno.h>
+namespace task
+{
+// 完成回调任务
+// IO已经完成， 投递时不受速率限制、 降载与容量限制； 只有线程池关闭时被丢弃， 此时回调以 -ECANCELED 执行
+class FileIoOperator : public TaskOperator
+{
+public:
+    FileIoOperator(IFileIoImpl::RequestPtr&& request, int64_t result)
+        : mRequest(std::move(request))
+        , mResult(result)
+    {
+    }
+    ~FileIoOperator() = default;
+
+    virtual void operator()() override
+    {
+        recordRunStart();
+        mRequest->mDone(mResult);
+        recordRunEnd();
+    }
+
+    // IO已经完成， 回调不随队列一起取消
+    virtual void cancel() override {}
+
+    virtual bool isMandatory() const override
+    {
+        return true;
+    }
+
+    // 被丢弃 (线程池已关闭) 时在丢弃的线程上以 -ECANCELED 回调， 等待结果的调用方不会卡住
+    virtual void discard() override
+    {
+        LOGE("[TASK]FileIoOperator::discard, fd: %d, result: %lld", mRequest->mFd, ( long long )mResult);
+        auto done = std::move(mRequest->mDone);
+        mRequest->mDone = nullptr;
+        if (done)
+        {
+            done(-ECANCELED);
+        }
+    }
+
+private:
+    IFileIoImpl::RequestPtr mRequest;
+    int64_t                 mResult;
+};
+
+TaskFileIoStat IFileIoImpl::stat() const
+{
+    TaskFileIoStat stat;
+    stat.mBackend   = backend();
+    stat.mSubmitted = mSubmitted.load(std::memory_order_relaxed);
+    stat.mCompleted = mCompleted.load(std::memory_order_relaxed);
+    stat.mBatches   = mBatches.load(std::memory_order_relaxed);
+    stat.mDropped   = mDropped.load(std::memory_order_relaxed);
+    return stat;
+}
+
+std::shared_ptr<IFileIoImpl> IFileIoImpl::create(TaskFileIoBackend backend)
+{
+    if (backend == TaskFileIoBackend::TFB_IoUring)
+    {
+        auto uring = std::make_shared<UringFileIoImpl>();
+        if (uring->isReady())
+        {
+            return uring;
+        }
+        LOGE("[TASK]IFileIoImpl::create io_uring unavailable, fallback to thread pool");
+    }
+    return std::make_shared<ThreadFileIoImpl>();
+}
+
+void IFileIoImpl::_complete(RequestPtr&& request, int64_t result)
+{
+    mCompleted.fetch_add(1, std::memory_order_relaxed);
+    auto queue = request->mQueue;
+    // 不受容量限制， IO线程不会阻塞； 只有队列已关闭时被丢弃 (回调以 -ECANCELED 执行)
+    const auto submit = queue->async(std::make_shared<FileIoOperator>(std::move(request), result));
+    if (submit == TaskSubmitResult::TSR_Rejected || submit == TaskSubmitResult::TSR_TimedOut || submit == TaskSubmitResult::TSR_Shed
+        || submit == TaskSubmitResult::TSR_Shutdown)
+    {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace task
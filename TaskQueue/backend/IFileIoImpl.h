@@ -0,0 +1,65 @@
+#ifndef __I_FILE_IO_IMPL_H__
+#define __I_FILE_IO_IMPL_H__
+
+#include "TaskQueueDefine.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+namespace task
+{
+// 异步文件IO实现接口
+// 请求完成后把回调投递到请求指定的队列， 回调的执行不占用IO线程
+// 析构时等待已提交的请求全部完成 (缓冲区在完成前由调用方保持有效)
+class IFileIoImpl
+{
+public:
+    using Completion = std::function<void(int64_t result)>;
+
+    enum Op : uint8_t
+    {
+        FO_Read = 0,
+        FO_Write,
+        FO_Fsync,
+        FO_Fdatasync,
+    };
+
+    struct Request
+    {
+        Op           mOp{ FO_Read };
+        int          mFd{ -1 };
+        void*        mBuf{ nullptr };
+        size_t       mLen{ 0 };
+        uint64_t     mOffset{ 0 };
+        TaskQueuePtr mQueue;
+        Completion   mDone;
+    };
+    using RequestPtr = std::unique_ptr<Request>;
+
+    virtual ~IFileIoImpl() = default;
+
+    // 提交请求， 已停止返回false
+    virtual bool submit(RequestPtr&& request) = 0;
+
+    virtual TaskFileIoBackend backend() const = 0;
+
+    TaskFileIoStat stat() const;
+
+    // 按后端创建， io_uring 不可用时回退到线程池
+    static std::shared_ptr<IFileIoImpl> create(TaskFileIoBackend backend);
+
+protected:
+    // 在请求的队列上执行完成回调， result 为字节数或 -errno
+    void _complete(RequestPtr&& request, int64_t result);
+
+protected:
+    std::atomic<uint64_t> mSubmitted{ 0 };
+    std::atomic<uint64_t> mCompleted{ 0 };
+    std::atomic<uint64_t> mBatches{ 0 };
+    std::atomic<uint64_t> mDropped{ 0 };
+};
+
+}  // namespace task
+
+#endif  // __I_FILE_IO_IMPL_H__
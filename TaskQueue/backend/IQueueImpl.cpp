@@ -0,0 +1,179 @@
+#include "IQueueImpl.h"
+#include "TaskOperatorBackend.h"
+#include "TimerManager.h"
+#include <memory>
+#include <vector>
+namespace task
+{
+TaskOperatorPtr IQueueImpl::_scheduleAfter(std::chrono::milliseconds delay, const TaskOperatorPtr& task)
+{
+    auto delayTask = std::make_shared<TaskDelayOperator>(delay, task);
+    // 句柄继承原始任务的取消作用域， 作用域取消时同时移除定时器
+    delayTask->setCancelScope(task->cancelScope());
+    if (task->hasDeadline())
+    {
+        // 截止时间从到期投递时开始计算
+        delayTask->setDeadline(task->deadlineBudget(), task->dropIfMissed());
+    }
+
+    // 队列释放后不再投递
+    std::weak_ptr<IQueueImpl> weakSelf = shared_from_this();
+    auto timerId = TimerManager::GetInstance().addTimer(delay, [weakSelf, delayTask]() {
+        auto self = weakSelf.lock();
+        if (self && !delayTask->isCancelled())
+        {
+            self->submit(delayTask);
+        }
+    });
+    delayTask->setTimerId(timerId);
+    return delayTask;
+}
+
+TaskOperatorPtr IQueueImpl::_scheduleEvery(std::chrono::milliseconds interval,
+                                           std::chrono::milliseconds leeway,
+                                           const TaskOperatorPtr&    task)
+{
+    auto periodicTask = std::make_shared<TaskPeriodicOperator>(interval, leeway, task);
+
+    std::weak_ptr<IQueueImpl> weakSelf = shared_from_this();
+    auto timerId = TimerManager::GetInstance().addPeriodicTimer(interval, leeway, [weakSelf, periodicTask]() {
+        auto self = weakSelf.lock();
+        if (!self || periodicTask->isCancelled())
+        {
+            // 队列已释放或任务已取消， 停止定时器
+            periodicTask->cancel();
+            return;
+        }
+
+        // 上一次还未执行完， 跳过本次， 避免任务堆积
+        if (periodicTask->tryMarkPending())
+        {
+            self->submit(periodicTask);
+        }
+    });
+    periodicTask->setTimerId(timerId);
+    return periodicTask;
+}
+
+size_t IQueueImpl::cancelAll()
+{
+    auto cancelled = mCancelScope.cancel();
+
+    // 速率限制/挂起暂存的已取消任务直接移除， 不再等待令牌或恢复
+    std::vector<TaskOperatorPtr> removed;
+    mRateLimiter.removeCancelled(removed);
+    mSuspender.removeCancelled(removed);
+    _dropReserved(removed);
+    return cancelled;
+}
+
+void IQueueImpl::_dropHeld()
+{
+    std::vector<TaskOperatorPtr> removed;
+    mRateLimiter.clear(removed);
+    mSuspender.clear(removed);
+    _dropReserved(removed);
+}
+
+void IQueueImpl::_dropReserved(std::vector<TaskOperatorPtr>& tasks)
+{
+    for (auto& task : tasks)
+    {
+        if (task->holdsSlot())
+        {
+            _unreserve(task);
+        }
+        task->discard();
+    }
+}
+
+bool IQueueImpl::resume()
+{
+    return mSuspender.resume([this](std::vector<TaskOperatorPtr>& tasks) {
+        // 挂起时长不计入排队耗时 (避免恢复后被误判为过载)， 截止时间从恢复时开始计算
+        for (auto& task : tasks)
+        {
+            task->resetCallStartTime();
+        }
+        _flushSuspended(tasks);
+    });
+}
+
+void IQueueImpl::setRateLimit(const TaskRateLimit& limit)
+{
+    std::vector<TaskOperatorPtr> ready;
+    mRateLimiter.configure(limit, ready);
+    for (auto& task : ready)
+    {
+        _asyncLimited(task, true);
+    }
+}
+
+TaskSubmitResult IQueueImpl::_submitLimited(const TaskOperatorPtr& task)
+{
+    // 先预留容量空位： 暂存的任务同样占用空位 (暂存数不超过容量上限)， 被拒绝时不消耗令牌
+    const auto reserved = _reserve(task);
+    if (_isRejected(reserved))
+    {
+        return reserved;
+    }
+
+    std::chrono::milliseconds armDelay;
+    if (mRateLimiter.acquire(task, armDelay))
+    {
+        const auto result = _asyncLimited(task, false);
+        return result == TaskSubmitResult::TSR_Accepted ? reserved : result;
+    }
+    if (armDelay.count() >= 0)
+    {
+        _armRateTimer(armDelay);
+    }
+    return TaskSubmitResult::TSR_RateLimited;
+}
+
+TaskSubmitResult IQueueImpl::_asyncLimited(const TaskOperatorPtr& task, bool released)
+{
+    const auto result = async(task);
+    if (_isRejected(result))
+    {
+        // 在预留的空位之外被拒绝 (线程池已关闭/降载等)
+        if (task->holdsSlot())
+        {
+            _unreserve(task);
+        }
+        mRateLimiter.refund(released);
+    }
+    return result;
+}
+
+void IQueueImpl::_releaseLimited()
+{
+    std::vector<TaskOperatorPtr> ready;
+    std::vector<TaskOperatorPtr> cancelled;
+    std::chrono::milliseconds    armDelay;
+    mRateLimiter.release(ready, cancelled, armDelay);
+    if (armDelay.count() >= 0)
+    {
+        _armRateTimer(armDelay);
+    }
+    _dropReserved(cancelled);
+    for (auto& task : ready)
+    {
+        _asyncLimited(task, true);
+    }
+}
+
+void IQueueImpl::_armRateTimer(std::chrono::milliseconds delay)
+{
+    // 队列释放后暂存的任务由RateLimiter丢弃
+    std::weak_ptr<IQueueImpl> weakSelf = shared_from_this();
+    TimerManager::GetInstance().addTimer(delay, [weakSelf]() {
+        auto self = weakSelf.lock();
+        if (self)
+        {
+            self->_releaseLimited();
+        }
+    });
+}
+
+}  // namespace task
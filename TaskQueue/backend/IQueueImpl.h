@@ -4,25 +4,117 @@
 #include "TaskOperator.h"
 #include "TaskQueueDefine.h"
 #include "IThreadPool.h"
+#include <atomic>
 #include <chrono>
+#include <memory>
+#include <vector>
 #include "QueueDefine.h"
+#include "QueueStat.h"
+#include "QueueStatRegistry.h"
+#include "QueueSuspender.h"
+#include "RateLimiter.h"
+#include "TaskCancelScope.h"
+#include "TaskQueueTracer.h"
 namespace task
 {
 class IThreadPool;
-class IQueueImpl
+class IQueueImpl : public std::enable_shared_from_this<IQueueImpl>
 {
 public:
     IQueueImpl(TaskQueueType type, const ThreadPoolPtr& threadPool)
-        : mType(type), mThreadPool(threadPool) {}
+        : mType(type), mThreadPool(threadPool), mQueueStat(std::make_shared<QueueStat>()) {}
     virtual ~IQueueImpl() = default;
     inline TaskQueueType type() const
     {
         return mType;
     }
 
-    virtual void async(const TaskOperatorPtr& task)                                                                   = 0;
+    virtual TaskSubmitResult async(const TaskOperatorPtr& task)                                                       = 0;
     virtual void sync(const TaskOperatorPtr& task, std::chrono::milliseconds timeout = std::chrono::milliseconds(-1)) = 0;
-    virtual void after(std::chrono::milliseconds delay, const TaskOperatorPtr& task)                                  = 0;
+    virtual TaskOperatorPtr after(std::chrono::milliseconds delay, const TaskOperatorPtr& task)                       = 0;
+    virtual TaskOperatorPtr every(std::chrono::milliseconds interval, std::chrono::milliseconds leeway, const TaskOperatorPtr& task) = 0;
+
+    // 提交异步任务 (TaskQueue::async 及延时/周期任务到期)， 设置速率限制时经过令牌桶 (必须投递的任务除外)
+    inline TaskSubmitResult submit(const TaskOperatorPtr& task)
+    {
+        if (!mRateLimiter.isEnabled() || task->isMandatory())
+        {
+            return async(task);
+        }
+        return _submitLimited(task);
+    }
+
+    // 速率限制， 取消限制时暂存的任务立即入队
+    void setRateLimit(const TaskRateLimit& limit);
+
+    TaskRateLimitStat rateLimitStat() const
+    {
+        return mRateLimiter.stat();
+    }
+
+    // 记录提交的任务到队列的取消作用域 (开启记录时) 及任务自身的取消作用域 (标签)
+    // 未开启记录且任务没有标签时只有一次relaxed读
+    inline void trackCancel(const TaskOperatorPtr& task)
+    {
+        if (mCancelTracking.load(std::memory_order_relaxed))
+        {
+            mCancelScope.track(task);
+        }
+        if (task->cancelScope())
+        {
+            task->cancelScope()->track(task);
+        }
+    }
+
+    // 记录经过本队列提交的任务， 供cancelAll取消 【默认关闭】
+    inline void setCancelTracking(bool enable)
+    {
+        mCancelTracking.store(enable, std::memory_order_relaxed);
+    }
+
+    // 取消所有经过本队列提交且未执行的任务 (开启记录后提交的)， 返回取消的任务数
+    size_t cancelAll();
+
+    // 挂起/恢复 【可嵌套， resume次数与suspend相同时恢复； 未挂起时resume返回false】
+    // 挂起期间提交的任务暂存在队列中， 不投递到线程池； 恢复时批量入队
+    inline void suspend()
+    {
+        mSuspender.suspend();
+    }
+    bool resume();
+    inline bool isSuspended() const
+    {
+        return mSuspender.isSuspended();
+    }
+
+    // 容量限制 【只用于串行队列， 并行队列共享线程池的限制】
+    virtual bool setCapacity(const TaskCapacity& /*capacity*/)
+    {
+        return false;
+    }
+    virtual TaskOverflowStat overflowStat() const
+    {
+        return TaskOverflowStat();
+    }
+
+    // 队列标签， 设置后注册到队列统计注册表
+    void setLabel(const std::string& label)
+    {
+        mQueueStat->setLabel(label);
+        QueueStatRegistry::GetInstance().add(mQueueStat);
+    }
+
+    // 队列耗时统计
+    TaskLatencyStat latencyStat() const
+    {
+        return mQueueStat->latencyStat();
+    }
+
+    // 队列指标
+    TaskQueueMetrics metrics() const
+    {
+        return mQueueStat->metrics();
+    }
 
 protected:
     inline const ThreadPoolPtr& _threadPool() const
@@ -30,9 +122,77 @@ protected:
         return mThreadPool;
     }
 
+    // 任务入队： 挂上队列统计， 开启轨迹时记录入队事件
+    inline void _onEnqueue(const TaskOperatorPtr& task) const
+    {
+        task->setQueueStat(mQueueStat);
+        mQueueStat->recordSubmit();
+        if (TaskQueueTracer::isEnabled())
+        {
+            TaskQueueTracer::GetInstance().trace(TaskTraceEventType::TTET_Enqueue, *task);
+        }
+    }
+
+    // 挂起期间暂存任务， 返回true时调用方不再入队
+    inline bool _holdIfSuspended(const TaskOperatorPtr& task)
+    {
+        return mSuspender.isHolding() && mSuspender.hold(task);
+    }
+
+    // 恢复时批量入队暂存的任务 (暂存为空时也调用一次)
+    virtual void _flushSuspended(std::vector<TaskOperatorPtr>& tasks) = 0;
+
+    // 速率限制暂存任务前预留容量空位， 按溢出策略处理 (TOP_CallerRuns 退化为拒绝)， 被拒绝时任务已丢弃
+    virtual TaskSubmitResult _reserve(const TaskOperatorPtr& /*task*/)
+    {
+        return TaskSubmitResult::TSR_Accepted;
+    }
+    // 归还未入队任务预留的空位
+    virtual void _unreserve(const TaskOperatorPtr& /*task*/) {}
+
+    // 丢弃速率限制/挂起暂存的全部任务并归还空位 【派生类析构时调用， 容量限制仍有效】
+    void _dropHeld();
+
+    // 延时任务交给定时器， 到期后投递到当前队列
+    TaskOperatorPtr _scheduleAfter(std::chrono::milliseconds delay, const TaskOperatorPtr& task);
+
+    // 周期任务交给定时器， 每次到期投递到当前队列， 返回可取消的句柄
+    TaskOperatorPtr _scheduleEvery(std::chrono::milliseconds interval, std::chrono::milliseconds leeway, const TaskOperatorPtr& task);
+
+private:
+    // 任务未被接受 (已丢弃)
+    static inline bool _isRejected(TaskSubmitResult result)
+    {
+        switch (result)
+        {
+            case TaskSubmitResult::TSR_Rejected:
+            case TaskSubmitResult::TSR_TimedOut:
+            case TaskSubmitResult::TSR_Shed:
+            case TaskSubmitResult::TSR_Shutdown:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    TaskSubmitResult _submitLimited(const TaskOperatorPtr& task);
+    // 取得令牌的任务入队， 未被接受时归还空位与令牌； released 为暂存后入队的任务
+    TaskSubmitResult _asyncLimited(const TaskOperatorPtr& task, bool released);
+    // 丢弃未入队的暂存任务， 归还预留的空位
+    void _dropReserved(std::vector<TaskOperatorPtr>& tasks);
+    // 释放定时器到期， 按令牌数将暂存任务入队
+    void _releaseLimited();
+    void _armRateTimer(std::chrono::milliseconds delay);
+
 private:
     TaskQueueType mType{ TaskQueueType::TQT_Serial };
     ThreadPoolPtr mThreadPool{ nullptr };  //线程池
+
+    std::shared_ptr<QueueStat> mQueueStat;  // 队列统计， 任务入队时挂到任务上
+    RateLimiter                mRateLimiter;  // 速率限制， 暂存的任务尚未入队 (不计入队列统计)
+    TaskCancelScope            mCancelScope;  // 经过本队列提交的任务
+    std::atomic<bool>          mCancelTracking{ false };
+    QueueSuspender             mSuspender;    // 挂起状态及暂存的任务 (非独占串行队列暂存在自身的任务队列)
 };
 
 }  // namespace task
@@ -1,21 +1,76 @@
 #include "IThreadPool.h"
 #include "SerialThreadPool.h"
 #include "ConcurrencyThreadPool.h"
+#include "QueueStat.h"
+#include "TaskQueueReporter.h"
+#include "WorkThreadBase.h"
+#include "WorkThreadWatchdog.h"
+#include "TaskCategoryRegistry.h"
 #include <memory>
 namespace task
 {
+namespace
+{
+std::shared_ptr<IThreadPool> watched(const std::shared_ptr<IThreadPool>& pool)
+{
+    WorkThreadWatchdog::GetInstance().watch(pool);
+    return pool;
+}
+}  // namespace
+
+// 线程池析构时仍会上报/记录类别统计， 先构造上报器、类别注册表与看门狗， 保证其晚于线程池析构
 const std::shared_ptr<IThreadPool>& IThreadPool::serialThreadPool()
 {
-    static std::shared_ptr<IThreadPool> sSerialThreadPool =
-        std::static_pointer_cast<IThreadPool>(std::make_shared<SerialThreadPool>());
+    TaskQueueReporter::GetInstance();
+    TaskCategoryRegistry::GetInstance();
+    WorkThreadWatchdog::GetInstance();
+    static std::shared_ptr<IThreadPool> sSerialThreadPool = watched(std::make_shared<SerialThreadPool>());
     return sSerialThreadPool;
 }
 
 const std::shared_ptr<IThreadPool>& IThreadPool::parallelThreadPool()
 {
-    static std::shared_ptr<IThreadPool> sGlobalThreadPool =
-        std::static_pointer_cast<IThreadPool>(std::make_shared<ConcurrencyThreadPool>());
+    TaskQueueReporter::GetInstance();
+    TaskCategoryRegistry::GetInstance();
+    WorkThreadWatchdog::GetInstance();
+    static std::shared_ptr<IThreadPool> sGlobalThreadPool = watched(std::make_shared<ConcurrencyThreadPool>());
     return sGlobalThreadPool;
 }
 
+bool IThreadPool::_beginShutdown(TaskShutdownPolicy policy)
+{
+    uint8_t expected = SS_Running;
+    const uint8_t state = policy == TaskShutdownPolicy::TSP_Cancel ? SS_Cancelling : SS_Draining;
+    return mShutdownState.compare_exchange_strong(expected, state, std::memory_order_acq_rel);
+}
+
+void IThreadPool::dropOnShutdown(const TaskOperatorPtr& task)
+{
+    QueueCapacity::discard(task);
+    mShutdownDropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+TaskLatencyStat IThreadPool::latencyStat()
+{
+    LatencyHistogram::Snapshot run;
+    LatencyHistogram::Snapshot wait;
+    mRetiredRunLatency.snapshot(run);
+    mRetiredWaitLatency.snapshot(wait);
+    _collectLatency(run, wait);
+
+    TaskLatencyStat stat;
+    stat.mRun  = latencySummary(run);
+    stat.mWait = latencySummary(wait);
+    return stat;
+}
+
+void IThreadPool::_retireLatency(const std::shared_ptr<WorkThreadBase>& thread)
+{
+    LatencyHistogram::Snapshot run;
+    LatencyHistogram::Snapshot wait;
+    thread->collectLatency(run, wait);
+    mRetiredRunLatency.add(run);
+    mRetiredWaitLatency.add(wait);
+}
+
 }  // namespace task
\ No newline at end of file
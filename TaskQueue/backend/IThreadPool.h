@@ -1,11 +1,18 @@
 #ifndef IThreadPool_H
 #define IThreadPool_H
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <vector>
 #include "TaskQueueDefine.h"
 #include "Semaphore.h"
 #include "QueueDefine.h"
+#include "DeadlineQueue.h"
+#include "QueueCapacity.h"
+#include "LoadShedder.h"
+#include "common/LatencyHistogram.h"
 namespace task
 {
 class WorkThreadBase;
@@ -24,20 +31,88 @@ public:
     virtual void unregisterWorkThread(const std::shared_ptr<WorkThreadBase>& /*thread*/) = 0;
 
     // 独占线程接口
-    virtual void    execute(const TaskOperatorPtr& /*task*/, int32_t /*threadId*/) {}
+    virtual TaskSubmitResult execute(const TaskOperatorPtr& /*task*/, int32_t /*threadId*/)
+    {
+        return TaskSubmitResult::TSR_Rejected;
+    }
     virtual int32_t attachOneThread(const std::string& /*name*/, WorkThreadPriority /*priority*/ = WorkThreadPriority::WTP_Normal)
     {
         return -1;
     }
     virtual void detachOneThread(int32_t /*threadID*/) {}
+    // 批量提交到独占线程 (队列恢复时)， 默认逐个提交
+    virtual void executeBulk(std::vector<TaskOperatorPtr>& tasks, int32_t threadId)
+    {
+        for (auto& task : tasks)
+        {
+            execute(task, threadId);
+        }
+    }
+
+    // 独占线程的容量限制 (即独占串行队列的容量)， 线程归还后取消
+    virtual void             setCapacity(int32_t /*threadId*/, const TaskCapacity& /*capacity*/) {}
+    virtual TaskOverflowStat overflowStat(int32_t /*threadId*/) const
+    {
+        return TaskOverflowStat();
+    }
+    // 预留独占线程任务队列的空位 (速率限制暂存任务前)， 按溢出策略处理 (TOP_CallerRuns 退化为拒绝)， 被拒绝时任务已丢弃
+    virtual TaskSubmitResult reserve(const TaskOperatorPtr& /*task*/, int32_t /*threadId*/)
+    {
+        return TaskSubmitResult::TSR_Accepted;
+    }
+    // 归还未入队任务预留的空位
+    virtual void unreserve(const TaskOperatorPtr& /*task*/, int32_t /*threadId*/) {}
 
     // 全局线程池接口
-    virtual void execute(const TaskOperatorPtr& /*task*/, TaskQueuePriority /*priority*/ = TaskQueuePriority::TQP_Normal) {}
+    virtual TaskSubmitResult execute(const TaskOperatorPtr& /*task*/, TaskQueuePriority /*priority*/ = TaskQueuePriority::TQP_Normal)
+    {
+        return TaskSubmitResult::TSR_Rejected;
+    }
+    // 批量提交 (队列恢复时)， 默认逐个提交
+    virtual void executeBulk(std::vector<TaskOperatorPtr>& tasks, TaskQueuePriority priority)
+    {
+        for (auto& task : tasks)
+        {
+            execute(task, priority);
+        }
+    }
+    // 预留线程池排队空位 (速率限制暂存任务前)， 同独占线程
+    virtual TaskSubmitResult reserve(const TaskOperatorPtr& /*task*/, TaskQueuePriority /*priority*/)
+    {
+        return TaskSubmitResult::TSR_Accepted;
+    }
+    virtual void unreserve(const TaskOperatorPtr& /*task*/, TaskQueuePriority /*priority*/) {}
+
 
+    // 关闭线程池： 停止接收经过队列提交的任务， 按策略执行完或取消排队中的任务， 等待工作线程退出
+    // timeout 为整个关闭过程的最长时间 (-1一直等待)； 只能关闭一次， 关闭后不能恢复
+    // 【不能在本线程池的工作线程上调用】
+    virtual TaskShutdownStat shutdown(std::chrono::milliseconds /*timeout*/, TaskShutdownPolicy /*policy*/)
+    {
+        return TaskShutdownStat();
+    }
+
+    // 已关闭 (或正在关闭)
+    inline bool isShutdown() const
+    {
+        return mShutdownState.load(std::memory_order_acquire) != SS_Running;
+    }
+
+    // 正在取消排队中的任务 (非独占串行队列丢弃自身队列中的任务)
+    inline bool isCancelling() const
+    {
+        return mShutdownState.load(std::memory_order_acquire) >= SS_Cancelling;
+    }
+
+    // 关闭期间被拒绝/取消的任务： 标记丢弃并计入关闭结果
+    void dropOnShutdown(const TaskOperatorPtr& task);
 
     // 由线程判断 当前任务可能导致死锁时， 通知线程池切换另外一条线程执行
     virtual void notifyNextThread(int32_t /*threadID*/) {}
 
+    // 卡顿检查， 由看门狗线程低频调用 (不在任务提交路径上)
+    virtual void checkBlocked() {}
+
     // 线程池数据
     struct Data
     {
@@ -46,12 +121,55 @@ public:
         std::atomic<int32_t>                                       mActiveThreads{ 0 };     //活动线程数
         std::atomic<int32_t>                                       mIdleThreads{ 0 };       //认为在wait等待的线程为idle线程
         std::array<WorkQueue, ( int )TaskQueuePriority::TQP_Count> mTaskQueues;             // 按优先级定义队列
+        DeadlineQueue                                              mDeadlineQueue;          // 带截止时间的任务 (EDF， 优先于优先级队列)
         std::thread::id                                            mInputThreadID;          // 标记当前push任务的线程id (用于判断 push线程 和 执行线程不能在同一条线程进行)
+        QueueCapacity                                              mCapacity;               // 排队任务总数限制 (EDF通道 + 各优先级队列)
+        LoadShedder                                                mShedder;                // 过载时降载低优先级任务
     };
     virtual const std::shared_ptr<Data> getData() const
     {
         return nullptr;
     }
+
+    // 线程池耗时统计， 合并所有工作线程 (包含已退出的线程)
+    TaskLatencyStat latencyStat();
+
+protected:
+    enum ShutdownState : uint8_t
+    {
+        SS_Running = 0,
+        SS_Draining,    // 停止接收， 执行完排队中的任务
+        SS_Cancelling,  // 停止接收， 取消排队中的任务
+        SS_Stopped,     // 工作线程已退出， 内部转发任务同样拒绝
+    };
+
+    // 进入关闭状态， 已关闭时返回false
+    bool _beginShutdown(TaskShutdownPolicy policy);
+    inline void _setShutdownState(ShutdownState state)
+    {
+        mShutdownState.store(state, std::memory_order_release);
+    }
+    inline bool _isStopped() const
+    {
+        return mShutdownState.load(std::memory_order_acquire) == SS_Stopped;
+    }
+    inline uint64_t _shutdownDropped() const
+    {
+        return mShutdownDropped.load(std::memory_order_relaxed);
+    }
+
+    // 累加当前所有工作线程的耗时分布
+    virtual void _collectLatency(LatencyHistogram::Snapshot& /*run*/, LatencyHistogram::Snapshot& /*wait*/) {}
+
+    // 线程退出时保留其统计
+    void _retireLatency(const std::shared_ptr<WorkThreadBase>& thread);
+
+private:
+    std::atomic<uint8_t>  mShutdownState{ SS_Running };
+    std::atomic<uint64_t> mShutdownDropped{ 0 };
+
+    LatencyHistogram mRetiredRunLatency;
+    LatencyHistogram mRetiredWaitLatency;
 };
 
 }  // namespace task
@@ -0,0 +1,482 @@
+#include "IoReactor.h"
+#include "QueueCapacity.h"
+#include "TaskOperator.h"
+#include "TaskQueue.h"
+#include <vector>
+#include "common/LogHelper.h"
+#if defined(__linux__)
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace task
+{
+#if defined(__linux__)
+static constexpr uint64_t kWakeKey = UINT64_MAX;
+
+static inline uint64_t eventKey(int fd, uint32_t generation)
+{
+    return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(fd);
+}
+#endif
+
+std::atomic<IoReactor*> IoReactor::sActive{ nullptr };
+std::atomic<int32_t>    IoReactor::sIdlePollers{ 0 };
+
+// 就绪回调任务
+class ReactorOperator : public TaskOperator
+{
+public:
+    explicit ReactorOperator(const IoReactor::RegistrationPtr& registration)
+        : mRegistration(registration)
+    {
+    }
+    ~ReactorOperator() = default;
+
+    virtual void operator()() override
+    {
+        recordRunStart();
+        IoReactor::GetInstance().onCallback(mRegistration, false);
+        recordRunEnd();
+    }
+
+    // 监听随 TaskReactor::cancel 移除， 不随队列一起取消
+    virtual void cancel() override {}
+
+    // 被队列拒绝/丢弃时移除监听， 避免持续就绪的fd反复投递
+    virtual void discard() override
+    {
+        IoReactor::GetInstance().onCallback(mRegistration, true);
+    }
+
+private:
+    IoReactor::RegistrationPtr mRegistration;
+};
+
+IoReactor::~IoReactor()
+{
+    // 等待正在取事件的空闲线程退出
+    // 与 pollIdle 是 "先写自己的变量再读对方的变量" 的握手， 需要 seq_cst： 否则清空 sActive 与读取 sIdlePollers 可能重排，
+    // 两边同时看到旧值， 空闲线程仍在使用即将析构的 reactor
+    sActive.store(nullptr, std::memory_order_seq_cst);
+    while (sIdlePollers.load(std::memory_order_seq_cst) > 0)
+    {
+        std::this_thread::yield();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopped = true;
+    }
+#if defined(__linux__)
+    if (mWakeFd >= 0)
+    {
+        uint64_t value = 1;
+        (void)::write(mWakeFd, &value, sizeof(value));
+    }
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+    if (mWakeFd >= 0)
+    {
+        ::close(mWakeFd);
+    }
+    if (mEpoll >= 0)
+    {
+        ::close(mEpoll);
+    }
+#endif
+}
+
+uint64_t IoReactor::add(int fd, bool writable, const TaskQueuePtr& queue, Callback&& callback, TaskIoTrigger trigger)
+{
+    if (fd < 0 || queue == nullptr || !callback)
+    {
+        LOGE("[TASK]IoReactor::add invalid argument, fd: %d", fd);
+        return kInvalidId;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mStopped || !_start())
+    {
+        return kInvalidId;
+    }
+
+    auto& entry     = mEntries[fd];
+    auto  direction = writable ? 1 : 0;
+    const bool edge = trigger == TaskIoTrigger::TIT_Edge;
+    if (entry.mRegistrations[1 - direction] && entry.mEdge != edge)
+    {
+        // 一个fd在epoll中只有一种触发方式
+        LOGE("[TASK]IoReactor::add trigger mismatch, fd: %d, edge: %d", fd, edge);
+        return kInvalidId;
+    }
+    if (entry.mRegistrations[direction])
+    {
+        // 替换旧监听， 随后重新加入epoll
+        auto old = std::move(entry.mRegistrations[direction]);
+        old->mCancelled.store(true, std::memory_order_release);
+        mRegistrations.erase(old->mId);
+    }
+
+    auto registration       = std::make_shared<Registration>();
+    registration->mId       = ++mNextId;
+    registration->mFd       = fd;
+    registration->mWritable = writable;
+    registration->mTrigger  = trigger;
+    registration->mQueue    = queue;
+    registration->mFunc     = std::move(callback);
+
+    entry.mRegistrations[direction] = registration;
+    entry.mArmed[direction]         = true;
+    entry.mEdge                     = edge;
+    if (!_arm(fd, entry))
+    {
+        entry.mRegistrations[direction].reset();
+        entry.mArmed[direction] = false;
+        if (!entry.mRegistrations[1 - direction])
+        {
+            mEntries.erase(fd);
+        }
+        return kInvalidId;
+    }
+
+    mRegistrations.emplace(registration->mId, registration);
+    mRegistrationCount.store(mRegistrations.size(), std::memory_order_release);
+    return registration->mId;
+}
+
+bool IoReactor::remove(uint64_t id)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto                        it = mRegistrations.find(id);
+    if (it == mRegistrations.end())
+    {
+        return false;
+    }
+
+    auto registration = it->second;
+    _removeLocked(registration);
+    return true;
+}
+
+void IoReactor::_removeLocked(const RegistrationPtr& registration)
+{
+    registration->mCancelled.store(true, std::memory_order_release);
+    mRegistrations.erase(registration->mId);
+    mRegistrationCount.store(mRegistrations.size(), std::memory_order_release);
+
+    auto it = mEntries.find(registration->mFd);
+    if (it == mEntries.end())
+    {
+        return;
+    }
+
+    auto direction = registration->mWritable ? 1 : 0;
+    if (it->second.mRegistrations[direction] == registration)
+    {
+        it->second.mRegistrations[direction].reset();
+        it->second.mArmed[direction] = false;
+        _arm(registration->mFd, it->second);
+    }
+}
+
+TaskReactorStat IoReactor::stat()
+{
+    TaskReactorStat stat;
+    stat.mRegistrations = mRegistrationCount.load(std::memory_order_acquire);
+    stat.mReactorEvents = mReactorEvents.load(std::memory_order_relaxed);
+    stat.mIdleEvents    = mIdleEvents.load(std::memory_order_relaxed);
+    stat.mDropped       = mDropped.load(std::memory_order_relaxed);
+    return stat;
+}
+
+size_t IoReactor::pollIdle()
+{
+#if defined(__linux__)
+    // 与析构的握手： 先登记再读取 sActive， 均为 seq_cst
+    sIdlePollers.fetch_add(1, std::memory_order_seq_cst);
+    size_t dispatched = 0;
+    auto   reactor    = sActive.load(std::memory_order_seq_cst);
+    if (reactor != nullptr && reactor->mRegistrationCount.load(std::memory_order_acquire) > 0)
+    {
+        std::unique_lock<std::mutex> lock(reactor->mPollMutex, std::try_to_lock);
+        if (lock.owns_lock())
+        {
+            epoll_event events[kMaxEvents];
+            const int   count = ::epoll_wait(reactor->mEpoll, events, kMaxEvents, 0);
+            if (count > 0)
+            {
+                dispatched = reactor->_dispatch(events, count, true);
+            }
+        }
+    }
+    sIdlePollers.fetch_sub(1, std::memory_order_seq_cst);
+    return dispatched;
+#else
+    return 0;
+#endif
+}
+
+void IoReactor::onCallback(const RegistrationPtr& registration, bool discarded)
+{
+    if (!discarded && !registration->mCancelled.load(std::memory_order_acquire))
+    {
+        registration->mFunc(registration->mFd);
+    }
+
+    // 一次性监听触发时已移除
+    if (registration->mTrigger == TaskIoTrigger::TIT_OneShot)
+    {
+        if (discarded)
+        {
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            LOGE("[TASK]IoReactor::onCallback discarded, fd: %d", registration->mFd);
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (registration->mCancelled.load(std::memory_order_acquire) || mStopped)
+    {
+        return;
+    }
+
+    if (discarded)
+    {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        LOGE("[TASK]IoReactor::onCallback discarded, fd: %d", registration->mFd);
+        _removeLocked(registration);
+        return;
+    }
+
+    if (registration->mTrigger == TaskIoTrigger::TIT_Edge)
+    {
+        if (_edgeFinished(registration))
+        {
+            // 投递可能被拒绝并同步回调 discard， 不能持有锁
+            lock.unlock();
+            registration->mQueue->async(std::make_shared<ReactorOperator>(registration));
+        }
+        return;
+    }
+
+    auto it = mEntries.find(registration->mFd);
+    if (it != mEntries.end())
+    {
+        it->second.mArmed[registration->mWritable ? 1 : 0] = true;
+        _arm(registration->mFd, it->second);
+    }
+}
+
+bool IoReactor::_edgeFinished(const RegistrationPtr& registration)
+{
+    // fd 常驻 epoll， 不需要重新加入； 回调期间到达的事件只投递一次 (回调读/写到 EAGAIN 即可覆盖之前的所有事件)
+    if (registration->mRefire)
+    {
+        registration->mRefire = false;
+        return true;
+    }
+    registration->mInFlight = false;
+    return false;
+}
+
+bool IoReactor::_start()
+{
+#if defined(__linux__)
+    if (mEpoll >= 0)
+    {
+        return true;
+    }
+
+    // 第一次使用时创建epoll并启动监听线程
+    mEpoll = ::epoll_create1(EPOLL_CLOEXEC);
+    if (mEpoll < 0)
+    {
+        LOGE("[TASK]IoReactor::_start epoll_create1 failed, errno: %d", errno);
+        return false;
+    }
+    mWakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event event{};
+    event.events   = EPOLLIN;
+    event.data.u64 = kWakeKey;
+    if (mWakeFd < 0 || ::epoll_ctl(mEpoll, EPOLL_CTL_ADD, mWakeFd, &event) != 0)
+    {
+        LOGE("[TASK]IoReactor::_start eventfd failed, errno: %d", errno);
+        if (mWakeFd >= 0)
+        {
+            ::close(mWakeFd);
+            mWakeFd = -1;
+        }
+        ::close(mEpoll);
+        mEpoll = -1;
+        return false;
+    }
+
+    mThread = std::thread(&IoReactor::_run, this);
+    sActive.store(this, std::memory_order_seq_cst);
+    return true;
+#else
+    LOGE("[TASK]IoReactor::_start not supported on this platform");
+    return false;
+#endif
+}
+
+void IoReactor::_run()
+{
+#if defined(__linux__)
+    LOGD("[TASK]IoReactor::run");
+    QueueCapacity::markIoThread();
+    epoll_event events[kMaxEvents];
+    while (true)
+    {
+        const int count = ::epoll_wait(mEpoll, events, kMaxEvents, -1);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            LOGE("[TASK]IoReactor::_run epoll_wait failed, errno: %d", errno);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mStopped)
+            {
+                return;
+            }
+        }
+        _dispatch(events, count, false);
+    }
+#endif
+}
+
+bool IoReactor::_arm(int fd, FdEntry& entry)
+{
+#if defined(__linux__)
+    const uint32_t mask = (entry.mArmed[0] ? static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP) : 0u)
+                          | (entry.mArmed[1] ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    if (mask == 0)
+    {
+        // 没有任何监听时移除； 持续监听的回调执行中时保持 (一次性触发后已不会再上报)
+        if (!entry.mRegistrations[0] && !entry.mRegistrations[1])
+        {
+            if (entry.mInEpoll)
+            {
+                ::epoll_ctl(mEpoll, EPOLL_CTL_DEL, fd, nullptr);
+            }
+            mEntries.erase(fd);
+        }
+        return true;
+    }
+
+    epoll_event event{};
+    event.events   = mask | (entry.mEdge ? static_cast<uint32_t>(EPOLLET) : static_cast<uint32_t>(EPOLLONESHOT));
+    event.data.u64 = eventKey(fd, ++entry.mGeneration);
+
+    // fd 被关闭后 epoll 会自动移除， 同号的新 fd 需要重新加入
+    int result = ::epoll_ctl(mEpoll, entry.mInEpoll ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event);
+    if (result != 0 && errno == ENOENT)
+    {
+        result = ::epoll_ctl(mEpoll, EPOLL_CTL_ADD, fd, &event);
+    }
+    else if (result != 0 && errno == EEXIST)
+    {
+        result = ::epoll_ctl(mEpoll, EPOLL_CTL_MOD, fd, &event);
+    }
+    if (result != 0)
+    {
+        LOGE("[TASK]IoReactor::_arm epoll_ctl failed, fd: %d, errno: %d(%s)", fd, errno, strerror(errno));
+        return false;
+    }
+    entry.mInEpoll = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t IoReactor::_dispatch(const epoll_event* events, int count, bool idle)
+{
+#if defined(__linux__)
+    std::vector<RegistrationPtr> fired;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (int i = 0; i < count; ++i)
+        {
+            const uint64_t key = events[i].data.u64;
+            if (key == kWakeKey)
+            {
+                continue;
+            }
+
+            const int fd = static_cast<int>(static_cast<uint32_t>(key));
+            auto      it = mEntries.find(fd);
+            if (it == mEntries.end() || it->second.mGeneration != static_cast<uint32_t>(key >> 32))
+            {
+                continue;
+            }
+
+            // 出错/挂断时两个方向都回调， 由读写结果感知
+            auto&          entry  = it->second;
+            const uint32_t ready  = events[i].events;
+            const bool     failed = (ready & (EPOLLERR | EPOLLHUP)) != 0;
+            const bool     hits[2]{ failed || (ready & (EPOLLIN | EPOLLRDHUP)) != 0, failed || (ready & EPOLLOUT) != 0 };
+            for (int direction = 0; direction < 2; ++direction)
+            {
+                if (!hits[direction] || !entry.mArmed[direction])
+                {
+                    continue;
+                }
+
+                auto registration = entry.mRegistrations[direction];
+                if (entry.mEdge)
+                {
+                    // 边沿触发保持监听， 回调执行中只记录
+                    if (registration->mInFlight)
+                    {
+                        registration->mRefire = true;
+                        continue;
+                    }
+                    registration->mInFlight = true;
+                    fired.push_back(std::move(registration));
+                    continue;
+                }
+
+                entry.mArmed[direction] = false;
+                if (registration->mTrigger == TaskIoTrigger::TIT_OneShot)
+                {
+                    entry.mRegistrations[direction].reset();
+                    mRegistrations.erase(registration->mId);
+                }
+                fired.push_back(std::move(registration));
+            }
+            mRegistrationCount.store(mRegistrations.size(), std::memory_order_release);
+
+            // EPOLLONESHOT 触发后整个fd都不再上报， 另一个方向仍需监听时重新加入
+            if (!entry.mEdge)
+            {
+                _arm(fd, entry);
+            }
+        }
+    }
+
+    (idle ? mIdleEvents : mReactorEvents).fetch_add(fired.size(), std::memory_order_relaxed);
+    for (auto& registration : fired)
+    {
+        auto queue = registration->mQueue;
+        queue->async(std::make_shared<ReactorOperator>(registration));
+    }
+    return fired.size();
+#else
+    return 0;
+#endif
+}
+
+}  // namespace task
@@ -0,0 +1,113 @@
+// IO就绪监听 (epoll)
+// 独立监听线程等待 epoll， 就绪后直接把回调投递到注册时指定的队列， 不经过额外的转发线程
+// 一次性与持续监听以 EPOLLONESHOT 加入 epoll： 一次就绪只会被一个线程取到， 监听线程与空闲工作线程可以同时 epoll_wait
+// 持续监听 (TIT_Persistent) 在回调执行完后重新加入， 同一监听的回调不会并发执行； 重新加入时仍就绪会再次回调 (电平触发语义)
+// 边沿触发 (TIT_Edge) 的fd以 EPOLLET 常驻 epoll， 不重新加入 (重新加入会检查当前状态， 变回电平语义)；
+// 回调执行中到达的事件只记录， 回调结束后再投递一次， 同一监听的回调不会并发执行； 同一fd的两个方向必须同为边沿触发或同为非边沿触发
+// 并行线程池的工作线程在等待信号量前非阻塞地取一次就绪事件， 负载高时省去监听线程的唤醒
+// epoll_event.data 为 代数(高32位) + fd(低32位)， 每次加入代数加一， 丢弃重新加入前取到的旧事件
+// 仅支持 Linux， 其他平台注册失败
+#ifndef __IO_REACTOR_H__
+#define __IO_REACTOR_H__
+
+#include "TaskQueueDefine.h"
+#include "common/HESingleton.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+struct epoll_event;
+namespace task
+{
+class IoReactor : public task::HESingleton<IoReactor>
+{
+    friend class task::HESingleton<IoReactor>;
+
+public:
+    using Callback = std::function<void(int fd)>;
+
+    static constexpr uint64_t kInvalidId = 0;
+
+    // 一个fd一个方向的监听
+    struct Registration
+    {
+        uint64_t          mId{ kInvalidId };
+        int               mFd{ -1 };
+        bool              mWritable{ false };
+        TaskIoTrigger     mTrigger{ TaskIoTrigger::TIT_OneShot };
+        TaskQueuePtr      mQueue;
+        Callback          mFunc;
+        std::atomic<bool> mCancelled{ false };
+        bool              mInFlight{ false };  // 边沿触发： 回调已投递未结束 【持有mMutex】
+        bool              mRefire{ false };    // 边沿触发： 回调执行中又有新事件， 结束后再投递 【持有mMutex】
+    };
+    using RegistrationPtr = std::shared_ptr<Registration>;
+
+public:
+    ~IoReactor();
+
+    // 添加监听， 返回监听ID， 失败返回 kInvalidId； 同一fd同一方向已有监听时替换
+    uint64_t add(int fd, bool writable, const TaskQueuePtr& queue, Callback&& callback, TaskIoTrigger trigger);
+
+    // 移除监听， 已触发的一次性监听或不存在返回false
+    bool remove(uint64_t id);
+
+    TaskReactorStat stat();
+
+    // 非阻塞地取就绪事件并投递回调， 返回投递的回调数 【并行线程池空闲线程调用】
+    static size_t pollIdle();
+
+    // 回调任务执行或被队列丢弃 【回调任务调用】
+    void onCallback(const RegistrationPtr& registration, bool discarded);
+
+private:
+    IoReactor() = default;
+
+    static constexpr int kMaxEvents = 64;
+
+    struct FdEntry
+    {
+        RegistrationPtr mRegistrations[2];             // 0: 可读， 1: 可写
+        bool            mArmed[2]{ false, false };     // 已加入epoll等待就绪 (回调执行中的持续监听不在其中)
+        bool            mInEpoll{ false };
+        bool            mEdge{ false };                // 以 EPOLLET 常驻 epoll (边沿触发监听)
+        uint32_t        mGeneration{ 0 };
+    };
+
+    bool   _start();
+    void   _run();
+    // 按当前监听重新加入epoll， 没有任何监听时移除 【持有mMutex】
+    bool   _arm(int fd, FdEntry& entry);
+    void   _removeLocked(const RegistrationPtr& registration);
+    size_t _dispatch(const epoll_event* events, int count, bool idle);
+    // 边沿触发监听的回调结束： 执行中有新事件时返回true， 由调用方再投递 【持有mMutex】
+    bool   _edgeFinished(const RegistrationPtr& registration);
+
+private:
+    static std::atomic<IoReactor*> sActive;       // 已启动的实例， 析构时清空
+    static std::atomic<int32_t>    sIdlePollers;  // 正在 pollIdle 的线程数
+
+    std::mutex                                      mMutex;
+    std::unordered_map<int, FdEntry>                mEntries;
+    std::unordered_map<uint64_t, RegistrationPtr>   mRegistrations;
+    uint64_t                                        mNextId{ kInvalidId };
+    bool                                            mStopped{ false };
+    int                                             mEpoll{ -1 };
+    int                                             mWakeFd{ -1 };  // 析构时唤醒监听线程
+    std::thread                                     mThread;
+
+    std::mutex            mPollMutex;  // 同一时刻只有一个空闲线程取事件
+    std::atomic<size_t>   mRegistrationCount{ 0 };
+    std::atomic<uint64_t> mReactorEvents{ 0 };
+    std::atomic<uint64_t> mIdleEvents{ 0 };
+    std::atomic<uint64_t> mDropped{ 0 };
+};
+
+}  // namespace task
+
+#endif  // __IO_REACTOR_H__
@@ -0,0 +1,130 @@
+#include "LoadShedder.h"
+#include "IThreadPool.h"
+#include "QueueCapacity.h"
+#include "TaskOperator.h"
+#include "TimerManager.h"
+#include "common/HETimerHelper.h"
+#include "common/LogHelper.h"
+
+namespace task
+{
+void LoadShedder::configure(const TaskLoadShedding& config)
+{
+    mEnabled.store(false, std::memory_order_relaxed);
+
+    mShedQueued.store(config.mShedQueued, std::memory_order_relaxed);
+    mAction.store(static_cast<uint8_t>(config.mAction), std::memory_order_relaxed);
+    mTargetMicros.store(static_cast<uint64_t>(config.mTargetDelay.count()) * 1000, std::memory_order_relaxed);
+    mIntervalMicros.store(static_cast<uint64_t>(config.mInterval.count()) * 1000, std::memory_order_relaxed);
+    mDeferMillis.store(config.mDeferDelay.count(), std::memory_order_relaxed);
+
+    mShedding.store(false, std::memory_order_relaxed);
+    mWindowStart.store(HETimerHelper::microsecondTimestamp64(), std::memory_order_relaxed);
+    mWindowMin.store(kNoSample, std::memory_order_relaxed);
+    mLastMinWait.store(0, std::memory_order_relaxed);
+    mEnterCount.store(0, std::memory_order_relaxed);
+    mRejectedSubmitted.store(0, std::memory_order_relaxed);
+    mRejectedQueued.store(0, std::memory_order_relaxed);
+    mDeferred.store(0, std::memory_order_relaxed);
+
+    mEnabled.store(config.mEnabled, std::memory_order_release);
+}
+
+TaskLoadShedStat LoadShedder::stat() const
+{
+    // 长时间没有样本时视为已退出 (下一次判断时才真正退出)
+    const auto now   = HETimerHelper::microsecondTimestamp64();
+    const auto stale = now - mWindowStart.load(std::memory_order_acquire) > 2 * mIntervalMicros.load(std::memory_order_relaxed);
+
+    TaskLoadShedStat stat;
+    stat.mShedding          = isEnabled() && mShedding.load(std::memory_order_acquire) && !stale;
+    stat.mMinWaitMicros     = mLastMinWait.load(std::memory_order_relaxed);
+    stat.mEnterCount        = mEnterCount.load(std::memory_order_relaxed);
+    stat.mRejectedSubmitted = mRejectedSubmitted.load(std::memory_order_relaxed);
+    stat.mRejectedQueued    = mRejectedQueued.load(std::memory_order_relaxed);
+    stat.mDeferred          = mDeferred.load(std::memory_order_relaxed);
+    return stat;
+}
+
+void LoadShedder::_record(uint64_t waitMicros)
+{
+    // 窗口内最小值， 大多数情况下只有一次读
+    auto current = mWindowMin.load(std::memory_order_relaxed);
+    while (waitMicros < current && !mWindowMin.compare_exchange_weak(current, waitMicros, std::memory_order_relaxed))
+    {
+    }
+
+    const auto now   = HETimerHelper::microsecondTimestamp64();
+    auto       start = mWindowStart.load(std::memory_order_acquire);
+    if (now - start < mIntervalMicros.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    // 只由一个线程结算窗口
+    if (!mWindowStart.compare_exchange_strong(start, now, std::memory_order_acq_rel))
+    {
+        return;
+    }
+    const auto minWait = mWindowMin.exchange(kNoSample, std::memory_order_acq_rel);
+    if (minWait == kNoSample)
+    {
+        return;
+    }
+    _setShedding(minWait > mTargetMicros.load(std::memory_order_relaxed), minWait);
+}
+
+bool LoadShedder::_checkStale()
+{
+    const auto now = HETimerHelper::microsecondTimestamp64();
+    if (now - mWindowStart.load(std::memory_order_acquire) <= 2 * mIntervalMicros.load(std::memory_order_relaxed))
+    {
+        return true;
+    }
+    _setShedding(false, 0);
+    return false;
+}
+
+void LoadShedder::_setShedding(bool shedding, uint64_t minWait)
+{
+    mLastMinWait.store(minWait, std::memory_order_relaxed);
+    const auto previous = mShedding.exchange(shedding, std::memory_order_acq_rel);
+    if (shedding && !previous)
+    {
+        mEnterCount.fetch_add(1, std::memory_order_relaxed);
+        LOGI("[TASK]LoadShedder enter shedding, min wait: %llu us", ( unsigned long long )minWait);
+    }
+    else if (!shedding && previous)
+    {
+        LOGI("[TASK]LoadShedder exit shedding, min wait: %llu us", ( unsigned long long )minWait);
+    }
+}
+
+TaskSubmitResult LoadShedder::shed(const TaskOperatorPtr& task, const std::weak_ptr<IThreadPool>& pool, bool queued)
+{
+    if (static_cast<TaskShedAction>(mAction.load(std::memory_order_relaxed)) == TaskShedAction::TSA_Defer)
+    {
+        mDeferred.fetch_add(1, std::memory_order_relaxed);
+
+        // 到期后重新投递， 仍在降载则继续延后； 线程池已释放时丢弃
+        const auto delay = std::chrono::milliseconds(mDeferMillis.load(std::memory_order_relaxed));
+        TimerManager::GetInstance().addTimer(delay, [pool, task]() {
+            auto threadPool = pool.lock();
+            if (threadPool)
+            {
+                threadPool->execute(task, TaskQueuePriority::TQP_Low);
+            }
+            else
+            {
+                QueueCapacity::discard(task);
+            }
+        });
+        return TaskSubmitResult::TSR_Deferred;
+    }
+
+    (queued ? mRejectedQueued : mRejectedSubmitted).fetch_add(1, std::memory_order_relaxed);
+    QueueCapacity::discard(task);
+    return TaskSubmitResult::TSR_Shed;
+}
+
+}  // namespace task
@@ -0,0 +1,88 @@
+// 线程池降载控制
+// 参考 CoDel： 以观察窗口内的最小排队延迟判断过载 (短暂的突发不会触发)
+// 工作线程执行完普通/高优先级任务后记录其排队延迟， 窗口到期时由一个线程结算是否降载
+// 长时间没有样本 (队列已排空) 时自动退出降载
+// 未开启时记录与判断只有一次relaxed读
+#ifndef __LOAD_SHEDDER_H__
+#define __LOAD_SHEDDER_H__
+
+#include "TaskQueueDefine.h"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace task
+{
+class IThreadPool;
+class LoadShedder final
+{
+public:
+    LoadShedder() = default;
+    ~LoadShedder() = default;
+
+    // 更新配置， 重置状态与统计
+    void             configure(const TaskLoadShedding& config);
+    TaskLoadShedStat stat() const;
+
+    inline bool isEnabled() const
+    {
+        return mEnabled.load(std::memory_order_relaxed);
+    }
+
+    // 出队时是否同样降载
+    inline bool shedQueued() const
+    {
+        return isEnabled() && mShedQueued.load(std::memory_order_relaxed);
+    }
+
+    // 记录一次排队延迟 (只记录普通/高优先级任务)
+    inline void onWait(uint64_t waitMicros)
+    {
+        if (isEnabled())
+        {
+            _record(waitMicros);
+        }
+    }
+
+    // 当前是否处于降载
+    inline bool isShedding()
+    {
+        return isEnabled() && mShedding.load(std::memory_order_acquire) && _checkStale();
+    }
+
+    // 降载一个低优先级任务： 拒绝 或 延后投递到线程池， queued 表示出队时降载
+    TaskSubmitResult shed(const TaskOperatorPtr& task, const std::weak_ptr<IThreadPool>& pool, bool queued);
+
+private:
+    void _record(uint64_t waitMicros);
+    // 降载期间长时间没有样本时退出， 返回是否仍在降载
+    bool _checkStale();
+    void _setShedding(bool shedding, uint64_t minWait);
+
+private:
+    static constexpr uint64_t kNoSample = std::numeric_limits<uint64_t>::max();
+
+    std::atomic<bool>     mEnabled{ false };
+    std::atomic<bool>     mShedQueued{ false };
+    std::atomic<uint8_t>  mAction{ static_cast<uint8_t>(TaskShedAction::TSA_Reject) };
+    std::atomic<uint64_t> mTargetMicros{ 0 };
+    std::atomic<uint64_t> mIntervalMicros{ 0 };
+    std::atomic<int64_t>  mDeferMillis{ 0 };
+
+    // 控制器状态
+    std::atomic<bool>     mShedding{ false };
+    std::atomic<uint64_t> mWindowStart{ 0 };       // 当前窗口开始时间 (微秒)
+    std::atomic<uint64_t> mWindowMin{ kNoSample };  // 当前窗口内的最小排队延迟
+    std::atomic<uint64_t> mLastMinWait{ 0 };
+
+    // 统计
+    std::atomic<uint64_t> mEnterCount{ 0 };
+    std::atomic<uint64_t> mRejectedSubmitted{ 0 };
+    std::atomic<uint64_t> mRejectedQueued{ 0 };
+    std::atomic<uint64_t> mDeferred{ 0 };
+};
+
+}  // namespace task
+
+#endif  // __LOAD_SHEDDER_H__
@@ -0,0 +1,126 @@
+#include "ParallelLoop.h"
+#include "IThreadPool.h"
+#include "TaskOperator.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace task
+{
+void ParallelLoop::run(size_t begin, size_t end, const RangeFunc& func, const TaskParallelOptions& options)
+{
+    if (end <= begin || !func)
+    {
+        return;
+    }
+
+    const size_t count   = end - begin;
+    size_t       workers = ParallelLoop::workers(options);
+
+    const size_t grain  = options.mGrain > 0 ? options.mGrain : std::max<size_t>(1, count / ((workers + 1) * kChunksPerWorker));
+    const size_t align  = options.mAlign > 0 ? options.mAlign : (grain >= kCacheLineIndices ? kCacheLineIndices : 1);
+    const size_t chunks = count / grain + (count % grain != 0 ? 1 : 0);
+    workers             = std::min(workers, chunks - 1);
+
+    // 只有一个块： 直接在调用线程执行
+    if (workers == 0)
+    {
+        func(begin, end);
+        return;
+    }
+
+    auto loop = std::make_shared<ParallelLoop>(begin, end, grain, align, workers + 1, func);
+
+    std::vector<TaskOperatorPtr> helpers;
+    helpers.reserve(workers);
+    for (size_t i = 0; i < workers; ++i)
+    {
+        helpers.push_back(std::make_shared<TaskOperator>([loop](const TaskOperatorPtr&) { loop->_work(); }));
+    }
+    IThreadPool::parallelThreadPool()->executeBulk(helpers, options.mPriority);
+
+    loop->_work();
+    loop->_wait();
+}
+
+size_t ParallelLoop::workers(const TaskParallelOptions& options)
+{
+    const auto& pool = IThreadPool::parallelThreadPool();
+    if (pool == nullptr || pool->getData() == nullptr || pool->isShutdown())
+    {
+        return 0;
+    }
+
+    auto workers = static_cast<size_t>(std::max(0, pool->getData()->mMaxThreads.load(std::memory_order_acquire)));
+    if (options.mMaxWorkers > 0)
+    {
+        workers = std::min<size_t>(workers, options.mMaxWorkers);
+    }
+    return workers;
+}
+
+ParallelLoop::ParallelLoop(size_t begin, size_t end, size_t grain, size_t align, size_t participants, const RangeFunc& func)
+    : mEnd(end)
+    , mCount(end - begin)
+    , mGrain(grain)
+    , mAlign(align)
+    , mParticipants(participants)
+    , mFunc(func)
+    , mNext(begin)
+{
+}
+
+void ParallelLoop::_work()
+{
+    size_t first = 0;
+    size_t last  = 0;
+    while (_claim(first, last))
+    {
+        mFunc(first, last);
+
+        const size_t executed = last - first;
+        if (mDone.fetch_add(executed, std::memory_order_acq_rel) + executed == mCount)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFinished = true;
+            mCond.notify_all();
+        }
+    }
+}
+
+bool ParallelLoop::_claim(size_t& first, size_t& last)
+{
+    first = mNext.load(std::memory_order_relaxed);
+    while (first < mEnd)
+    {
+        const size_t remaining = mEnd - first;
+        const size_t size      = std::max(mGrain, remaining / (2 * mParticipants));
+        last                   = size >= remaining ? mEnd : first + size;
+
+        // 块边界向上对齐， 对齐后超出区间时领取剩余全部
+        if (mAlign > 1 && last < mEnd && last % mAlign != 0)
+        {
+            const size_t pad = mAlign - last % mAlign;
+            last             = mEnd - last <= pad ? mEnd : last + pad;
+        }
+
+        if (mNext.compare_exchange_weak(first, last, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ParallelLoop::_wait()
+{
+    if (mDone.load(std::memory_order_acquire) == mCount)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCond.wait(lock, [this]() { return mFinished; });
+}
+
+}  // namespace task
@@ -0,0 +1,60 @@
+// 并行循环 (parallelFor)
+// 一次循环只向并行线程池批量投递 min(块数-1, 线程数) 个协助任务， 调用线程与协助任务从共享游标CAS领取块
+// 块大小 = max(最小块, 剩余元素 / (2 * 参与线程数))， 块边界向上对齐； 执行完的元素数达到总数时唤醒调用线程
+// 协助任务持有循环状态的引用， 领取到块才访问调用方的函数： 领取成功说明调用线程仍在等待， 函数一定有效
+// 协助任务开始执行时已没有剩余块则直接返回 (调用线程可能早已返回)
+#ifndef __PARALLEL_LOOP_H__
+#define __PARALLEL_LOOP_H__
+
+#include "TaskQueueDefine.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+namespace task
+{
+class ParallelLoop final
+{
+public:
+    using RangeFunc = std::function<void(size_t first, size_t last)>;
+
+    // 执行 [begin, end)， 全部块执行完后返回
+    static void run(size_t begin, size_t end, const RangeFunc& func, const TaskParallelOptions& options);
+
+    // 可参与的工作线程数 (不含调用线程)： 并行线程池最大线程数， 不超过 mMaxWorkers， 线程池关闭后为0
+    static size_t workers(const TaskParallelOptions& options);
+
+    ParallelLoop(size_t begin, size_t end, size_t grain, size_t align, size_t participants, const RangeFunc& func);
+
+private:
+    // 领取并执行块， 直到没有剩余块
+    void _work();
+    // 领取一个块， 没有剩余块时返回false
+    bool _claim(size_t& first, size_t& last);
+    // 等待其他线程领取的块执行完
+    void _wait();
+
+    static constexpr size_t kCacheLineIndices = 64;  // 自动对齐的下标倍数 (任意元素大小都是缓存行的整数倍)
+    static constexpr size_t kChunksPerWorker  = 8;   // 自动最小块： 每个参与线程至少分到的块数
+
+private:
+    const size_t     mEnd;
+    const size_t     mCount;
+    const size_t     mGrain;
+    const size_t     mAlign;
+    const size_t     mParticipants;  // 含调用线程
+    const RangeFunc& mFunc;
+
+    alignas(64) std::atomic<size_t> mNext;  // 下一个未领取的下标
+    alignas(64) std::atomic<size_t> mDone{ 0 };  // 已执行完的元素数
+
+    std::mutex              mMutex;
+    std::condition_variable mCond;
+    bool                    mFinished{ false };
+};
+
+}  // namespace task
+
+#endif  // __PARALLEL_LOOP_H__
@@ -0,0 +1,385 @@
+#include "PipelineImpl.h"
+#include "TaskOperator.h"
+#include "TaskQueue.h"
+#include "TaskQueueDefine.h"
+#include <memory>
+#include "common/LogHelper.h"
+namespace task
+{
+// 流水线任务： 输入任务、串行阶段的排空任务、并行阶段的单个数据项
+class PipelineOperator : public TaskOperator
+{
+public:
+    enum Kind : uint8_t
+    {
+        PK_Source = 0,
+        PK_Serial,
+        PK_Parallel,
+    };
+
+    PipelineOperator(const std::shared_ptr<PipelineImpl>& pipeline, Kind kind, size_t index, uint64_t seq = 0,
+                     PipelineImpl::Item&& item = PipelineImpl::Item())
+        : mPipeline(pipeline)
+        , mKind(kind)
+        , mIndex(index)
+        , mSeq(seq)
+        , mItem(std::move(item))
+    {
+    }
+    ~PipelineOperator() = default;
+
+    virtual void operator()() override
+    {
+        recordRunStart();
+        _dispatch(false);
+        recordRunEnd();
+    }
+
+    // 数据项随流水线流转， 不随队列一起取消
+    virtual void cancel() override {}
+
+    // 被丢弃时跳过用户函数， 数据项按过滤处理
+    virtual void discard() override
+    {
+        _dispatch(true);
+    }
+
+private:
+    void _dispatch(bool discarded)
+    {
+        switch (mKind)
+        {
+            case PK_Source:
+                mPipeline->onSource(discarded);
+                break;
+            case PK_Serial:
+                mPipeline->onSerial(mIndex, discarded);
+                break;
+            case PK_Parallel:
+                mPipeline->onParallel(mIndex, mSeq, mItem, discarded);
+                break;
+        }
+    }
+
+private:
+    std::shared_ptr<PipelineImpl> mPipeline;  // 任务执行完前流水线不会释放 (排空任务在通知结束后仍会访问阶段)
+    Kind                          mKind;
+    size_t                        mIndex;
+    uint64_t                      mSeq;
+    PipelineImpl::Item            mItem;
+};
+
+bool PipelineImpl::setSource(SourceFunc&& f, const TaskQueuePtr& queue)
+{
+    if (!f || queue == nullptr || mRunning.load(std::memory_order_acquire))
+    {
+        LOGE("[TASK]PipelineImpl::setSource failed, running: %d", mRunning.load());
+        return false;
+    }
+
+    mSource      = std::move(f);
+    mSourceQueue = queue;
+    return true;
+}
+
+bool PipelineImpl::addStage(TaskPipelineMode mode, StageFunc&& f, const TaskQueuePtr& queue)
+{
+    if (!f || queue == nullptr || mRunning.load(std::memory_order_acquire))
+    {
+        LOGE("[TASK]PipelineImpl::addStage failed, running: %d", mRunning.load());
+        return false;
+    }
+
+    auto stage    = std::make_unique<Stage>();
+    stage->mMode  = mode;
+    stage->mFunc  = std::move(f);
+    stage->mQueue = queue;
+    mStages.push_back(std::move(stage));
+    return true;
+}
+
+bool PipelineImpl::run(size_t maxTokens, const TaskOperatorPtr& notifyTask, const TaskQueuePtr& notifyQueue)
+{
+    if (!mSource || maxTokens == 0)
+    {
+        LOGE("[TASK]PipelineImpl::run failed, source: %d, tokens: %zu", mSource ? 1 : 0, maxTokens);
+        return false;
+    }
+
+    // 同一时刻只允许一次运行
+    if (mRunning.exchange(true, std::memory_order_acq_rel))
+    {
+        LOGE("[TASK]PipelineImpl::run failed, pipeline is running");
+        return false;
+    }
+
+    // 重置有序阶段的序号 (上次运行已全部处理完， 积压为空)
+    // 不重置 mBusy： 上次的排空任务可能还未退出， 由它处理本次先到的数据项
+    for (auto& stage : mStages)
+    {
+        std::lock_guard<std::mutex> lock(stage->mMutex);
+        stage->mNextSeq = 0;
+    }
+    mNotifyTask  = notifyTask;
+    mNotifyQueue = notifyQueue;
+
+    // 运行期间持有自身， 用户释放TaskPipeline后仍能执行完成
+    mRunningSelf = shared_from_this();
+    {
+        std::lock_guard<std::mutex> lock(mSourceMutex);
+        mSourceBusy = true;
+        mExhausted  = false;
+        mTokens     = maxTokens;
+        mInFlight   = 0;
+        mNextSeq    = 0;
+    }
+    mSourceQueue->async(std::make_shared<PipelineOperator>(shared_from_this(), PipelineOperator::PK_Source, 0));
+    return true;
+}
+
+void PipelineImpl::stop()
+{
+    bool finish = false;
+    {
+        std::lock_guard<std::mutex> lock(mSourceMutex);
+        if (!mRunning.load(std::memory_order_acquire) || mExhausted)
+        {
+            return;
+        }
+        mExhausted = true;
+        finish     = !mSourceBusy && mInFlight == 0;
+    }
+    if (finish)
+    {
+        _finishRun();
+    }
+}
+
+void PipelineImpl::onSource(bool discarded)
+{
+    while (true)
+    {
+        bool produce = false;
+        bool finish  = false;
+        {
+            std::lock_guard<std::mutex> lock(mSourceMutex);
+            if (discarded)
+            {
+                mExhausted = true;
+            }
+            if (!mExhausted && mTokens > 0)
+            {
+                mTokens--;
+                mInFlight++;
+                produce = true;
+            }
+            else
+            {
+                // 令牌用完时由归还令牌的线程重新投递输入任务
+                mSourceBusy = false;
+                finish      = mExhausted && mInFlight == 0;
+            }
+        }
+        if (!produce)
+        {
+            if (finish)
+            {
+                _finishRun();
+            }
+            return;
+        }
+
+        Item item;
+        if (!mSource(item))
+        {
+            {
+                std::lock_guard<std::mutex> lock(mSourceMutex);
+                mExhausted  = true;
+                mSourceBusy = false;
+                mTokens++;
+                mInFlight--;
+                finish = mInFlight == 0;
+            }
+            if (finish)
+            {
+                _finishRun();
+            }
+            return;
+        }
+
+        _deliver(0, mNextSeq++, std::move(item));
+    }
+}
+
+void PipelineImpl::onSerial(size_t index, bool discarded)
+{
+    auto&    stage = *mStages[index];
+    uint64_t seq   = 0;
+    Item     item;
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(stage.mMutex);
+            if (!_takeReady(stage, seq, item))
+            {
+                stage.mBusy = false;
+                return;
+            }
+        }
+
+        Item out;
+        if (!discarded && item.has_value())
+        {
+            out = stage.mFunc(std::move(item));
+        }
+        item.reset();
+        _deliver(index + 1, seq, std::move(out));
+    }
+}
+
+void PipelineImpl::onParallel(size_t index, uint64_t seq, Item& item, bool discarded)
+{
+    Item out;
+    if (!discarded)
+    {
+        out = mStages[index]->mFunc(std::move(item));
+    }
+    item.reset();
+    _deliver(index + 1, seq, std::move(out));
+}
+
+void PipelineImpl::_deliver(size_t index, uint64_t seq, Item&& item)
+{
+    for (; index < mStages.size(); ++index)
+    {
+        auto& stage = *mStages[index];
+
+        // 被过滤的数据项只需要经过有序阶段 (占住序号)
+        if (!item.has_value() && stage.mMode != TaskPipelineMode::TPM_SerialInOrder)
+        {
+            continue;
+        }
+
+        if (stage.mMode == TaskPipelineMode::TPM_Parallel)
+        {
+            stage.mQueue->async(std::make_shared<PipelineOperator>(shared_from_this(), PipelineOperator::PK_Parallel, index, seq, std::move(item)));
+            return;
+        }
+
+        bool schedule = false;
+        {
+            std::lock_guard<std::mutex> lock(stage.mMutex);
+            if (stage.mMode == TaskPipelineMode::TPM_SerialInOrder)
+            {
+                stage.mOrdered.emplace(seq, std::move(item));
+                schedule = !stage.mBusy && stage.mOrdered.begin()->first == stage.mNextSeq;
+            }
+            else
+            {
+                stage.mArrived.emplace_back(seq, std::move(item));
+                schedule = !stage.mBusy;
+            }
+            if (schedule)
+            {
+                stage.mBusy = true;
+            }
+        }
+        if (schedule)
+        {
+            stage.mQueue->async(std::make_shared<PipelineOperator>(shared_from_this(), PipelineOperator::PK_Serial, index));
+        }
+        return;
+    }
+
+    _release();
+}
+
+bool PipelineImpl::_takeReady(Stage& stage, uint64_t& seq, Item& item)
+{
+    if (stage.mMode == TaskPipelineMode::TPM_SerialInOrder)
+    {
+        auto it = stage.mOrdered.begin();
+        if (it == stage.mOrdered.end() || it->first != stage.mNextSeq)
+        {
+            return false;
+        }
+        seq  = it->first;
+        item = std::move(it->second);
+        stage.mOrdered.erase(it);
+        stage.mNextSeq++;
+        return true;
+    }
+
+    if (stage.mArrived.empty())
+    {
+        return false;
+    }
+    seq  = stage.mArrived.front().first;
+    item = std::move(stage.mArrived.front().second);
+    stage.mArrived.pop_front();
+    return true;
+}
+
+void PipelineImpl::_release()
+{
+    bool finish = false;
+    bool kick   = false;
+    {
+        std::lock_guard<std::mutex> lock(mSourceMutex);
+        mTokens++;
+        mInFlight--;
+        if (!mSourceBusy)
+        {
+            finish = mExhausted && mInFlight == 0;
+            kick   = !mExhausted;
+            if (kick)
+            {
+                mSourceBusy = true;
+            }
+        }
+    }
+
+    if (kick)
+    {
+        mSourceQueue->async(std::make_shared<PipelineOperator>(shared_from_this(), PipelineOperator::PK_Source, 0));
+    }
+    else if (finish)
+    {
+        _finishRun();
+    }
+}
+
+void PipelineImpl::_finishRun()
+{
+    // 局部变量延长生命周期到函数结束
+    auto self        = std::move(mRunningSelf);
+    auto notifyTask  = std::move(mNotifyTask);
+    auto notifyQueue = std::move(mNotifyQueue);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRunning.store(false, std::memory_order_release);
+    }
+    mCond.notify_all();
+
+    if (notifyTask && notifyQueue)
+    {
+        notifyQueue->async(notifyTask);
+    }
+}
+
+bool PipelineImpl::wait(std::chrono::milliseconds t)
+{
+    auto predicate = [this] { return !mRunning.load(std::memory_order_acquire); };
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (t != std::chrono::milliseconds(-1))
+    {
+        return mCond.wait_for(lock, t, predicate);
+    }
+
+    mCond.wait(lock, predicate);
+    return true;
+}
+
+}  // namespace task
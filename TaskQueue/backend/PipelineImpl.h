@@ -0,0 +1,100 @@
+#ifndef __PIPELINE_IMPL_H__
+#define __PIPELINE_IMPL_H__
+
+#include "TaskQueueDefine.h"
+#include <any>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+namespace task
+{
+// 流水线实现
+// 令牌、在途数据项与输入阶段状态由 mSourceMutex 保护； 每个串行阶段一把锁， 只保护积压项与排空状态
+// 所有投递都在锁外进行： 队列拒绝/丢弃流水线任务时 (容量限制、线程池关闭) 在提交线程回调， 数据项按过滤处理， 流水线不会卡住
+class PipelineImpl : public std::enable_shared_from_this<PipelineImpl>
+{
+public:
+    using Item       = std::any;
+    using SourceFunc = std::function<bool(Item& item)>;
+    using StageFunc  = std::function<Item(Item&& item)>;
+
+    PipelineImpl()  = default;
+    ~PipelineImpl() = default;
+
+    bool setSource(SourceFunc&& f, const TaskQueuePtr& queue);
+    bool addStage(TaskPipelineMode mode, StageFunc&& f, const TaskQueuePtr& queue);
+
+    // 运行流水线， notifyTask 不为空时， 结束后在notifyQueue上异步通知
+    bool run(size_t maxTokens, const TaskOperatorPtr& notifyTask, const TaskQueuePtr& notifyQueue);
+
+    // 停止读取输入
+    void stop();
+
+    // 等待本次运行结束
+    bool wait(std::chrono::milliseconds t = std::chrono::milliseconds(-1));
+
+    size_t stageCount() const
+    {
+        return mStages.size();
+    }
+
+    // 由流水线任务在执行线程上回调， discarded 表示任务被队列丢弃 (不调用用户函数， 数据项按过滤处理)
+    void onSource(bool discarded);
+    void onSerial(size_t index, bool discarded);
+    void onParallel(size_t index, uint64_t seq, Item& item, bool discarded);
+
+private:
+    struct Stage
+    {
+        TaskPipelineMode mMode{ TaskPipelineMode::TPM_Parallel };
+        StageFunc        mFunc;
+        TaskQueuePtr     mQueue;
+
+        // 串行阶段
+        std::mutex                            mMutex;
+        bool                                  mBusy{ false };  // 已投递排空任务
+        uint64_t                              mNextSeq{ 0 };   // 有序阶段下一个处理的序号
+        std::map<uint64_t, Item>              mOrdered;        // 有序阶段的积压项 (按序号)
+        std::deque<std::pair<uint64_t, Item>> mArrived;        // 无序阶段的积压项 (按到达顺序)
+    };
+
+    // 把数据项交给第 index 个阶段， 所有阶段处理完后归还令牌
+    void _deliver(size_t index, uint64_t seq, Item&& item);
+    // 取出串行阶段下一个可处理的积压项 【持有阶段锁】
+    bool _takeReady(Stage& stage, uint64_t& seq, Item& item);
+    // 数据项离开流水线
+    void _release();
+    void _finishRun();
+
+private:
+    SourceFunc                          mSource;
+    TaskQueuePtr                        mSourceQueue;
+    std::vector<std::unique_ptr<Stage>> mStages;
+
+    std::atomic<bool>             mRunning{ false };
+    std::shared_ptr<PipelineImpl> mRunningSelf;  // 运行期间保证流水线的生命周期
+    TaskOperatorPtr               mNotifyTask;
+    TaskQueuePtr                  mNotifyQueue;
+
+    std::mutex mSourceMutex;
+    bool       mSourceBusy{ false };  // 已投递输入任务
+    bool       mExhausted{ false };   // 输入结束或已停止
+    size_t     mTokens{ 0 };          // 可用令牌
+    size_t     mInFlight{ 0 };        // 在流水线中的数据项
+    uint64_t   mNextSeq{ 0 };         // 下一个数据项的序号 (只由输入任务访问)
+
+    std::mutex              mMutex;
+    std::condition_variable mCond;
+};
+
+}  // namespace task
+
+#endif  // __PIPELINE_IMPL_H__
@@ -0,0 +1,101 @@
+#include "QueueCapacity.h"
+#include "QueueStat.h"
+#include "TaskCategoryRegistry.h"
+#include "TaskOperator.h"
+#include "TimerManager.h"
+#include "WorkThreadBase.h"
+
+namespace task
+{
+void QueueCapacity::set(const TaskCapacity& capacity)
+{
+    // 先清零统计再生效， 避免新设置的统计混入旧值
+    for (auto& counter : mCounters)
+    {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    mPolicy.store(static_cast<uint8_t>(capacity.mPolicy), std::memory_order_relaxed);
+    mBlockTimeout.store(capacity.mBlockTimeout.count(), std::memory_order_relaxed);
+    mMaxPending.store(capacity.mMaxPending, std::memory_order_release);
+
+    // 放宽或取消限制时， 唤醒阻塞的提交方重新判断
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCond.notify_all();
+}
+
+TaskCapacity QueueCapacity::capacity() const
+{
+    TaskCapacity capacity;
+    capacity.mMaxPending   = mMaxPending.load(std::memory_order_acquire);
+    capacity.mPolicy       = static_cast<TaskOverflowPolicy>(mPolicy.load(std::memory_order_relaxed));
+    capacity.mBlockTimeout = std::chrono::milliseconds(mBlockTimeout.load(std::memory_order_relaxed));
+    return capacity;
+}
+
+TaskOverflowStat QueueCapacity::stat() const
+{
+    TaskOverflowStat stat;
+    stat.mAccepted   = mCounters[C_Accepted].load(std::memory_order_relaxed);
+    stat.mBlocked    = mCounters[C_Blocked].load(std::memory_order_relaxed);
+    stat.mRejected   = mCounters[C_Rejected].load(std::memory_order_relaxed);
+    stat.mTimedOut   = mCounters[C_TimedOut].load(std::memory_order_relaxed);
+    stat.mDropped    = mCounters[C_Dropped].load(std::memory_order_relaxed);
+    stat.mCallerRuns = mCounters[C_CallerRuns].load(std::memory_order_relaxed);
+    return stat;
+}
+
+static thread_local bool sIsIoThread = false;
+
+void QueueCapacity::markIoThread()
+{
+    sIsIoThread = true;
+}
+
+bool QueueCapacity::_canBlock()
+{
+    return WorkThreadBase::current() == nullptr && !TimerManager::isTimerThread() && !sIsIoThread;
+}
+
+void QueueCapacity::discard(const TaskOperatorPtr& task)
+{
+    if (task == nullptr)
+    {
+        return;
+    }
+    // 丢弃后周期任务可能立即再次投递 (入队时重新设置队列统计)， 先取出
+    auto queueStat = task->queueStat();
+    task->discard();
+    if (queueStat)
+    {
+        queueStat->recordCancel();
+    }
+}
+
+void QueueCapacity::runInCaller(const TaskOperatorPtr& task)
+{
+    WorkThreadBase::runTask(task);
+
+    // 与工作线程一致： 未执行的任务计入取消数， 执行的任务计入队列与类别统计 (不计入线程统计)
+    const auto& queueStat = task->queueStat();
+    if (!task->hasRunRecord())
+    {
+        if (queueStat && task->isCancelled())
+        {
+            queueStat->recordCancel();
+        }
+        task->onRecorded();
+        return;
+    }
+
+    if (queueStat)
+    {
+        queueStat->record(*task);
+    }
+    if (task->category() != kNoTaskCategory && TaskCategoryRegistry::isAlive())
+    {
+        TaskCategoryRegistry::GetInstance().record(*task);
+    }
+    task->onRecorded();
+}
+
+}  // namespace task
@@ -0,0 +1,226 @@
+// 队列容量限制
+// 设置上限后， 提交方入队前调用admit按溢出策略处理， 消费方出队后调用onDequeue唤醒阻塞的提交方
+// admit 接受时原子地预留一个空位 (记录在任务上)， 出队/丢弃时归还， 并发提交不会超出上限； 设置上限前已排队的任务不占用空位
+// 已预留空位的任务 (速率限制暂存前预留) 直接接受； 必须投递的任务 (isMandatory) 不受上限限制， 仍占用空位， 可能使排队任务数超出上限
+// 未设置上限时admit只有一次relaxed读； 统计只记录设置上限后的提交
+// 工作线程、 定时器线程 与 IO线程 (文件IO/就绪监听) 不阻塞 (阻塞可能使线程池无法出队而死锁)， TOP_Block 退化为拒绝
+// TOP_CallerRuns 在串行队列 (会与队列的工作线程并发执行) 及上述内部线程 (用户任务会拖住其他任务、 定时器与IO完成) 上退化为拒绝
+#ifndef __QUEUE_CAPACITY_H__
+#define __QUEUE_CAPACITY_H__
+
+#include "TaskOperator.h"
+#include "TaskQueueDefine.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace task
+{
+class QueueCapacity final
+{
+public:
+    QueueCapacity() = default;
+    ~QueueCapacity() = default;
+
+    // 设置容量限制， 统计清零
+    void set(const TaskCapacity& capacity);
+    // 取消容量限制， 统计清零
+    void reset()
+    {
+        set(TaskCapacity());
+    }
+
+    TaskCapacity     capacity() const;
+
+    // 是否设置了容量限制
+    inline bool isLimited() const
+    {
+        return mMaxPending.load(std::memory_order_relaxed) > 0;
+    }
+    TaskOverflowStat stat() const;
+
+    // 判断新任务能否入队， serial 为串行队列 (任务不能在提交线程执行)
+    // dropOldest() 丢弃一个最早入队的任务 (出队后调用onDequeue与discard)， 没有可丢弃的任务时返回false
+    // TSR_Accepted: 入队； TSR_DroppedOldest: 丢弃旧任务后入队； 两者都已为任务预留空位
+    // TSR_CallerRan: 由调用方在当前线程执行 (runInCaller)； 其他: 拒绝 (discard)
+    template <typename DropOldest>
+    TaskSubmitResult admit(const TaskOperatorPtr& task, bool serial, DropOldest&& dropOldest)
+    {
+        const auto maxPending = mMaxPending.load(std::memory_order_relaxed);
+        if (maxPending == 0)
+        {
+            return TaskSubmitResult::TSR_Accepted;
+        }
+        // 速率限制暂存前已预留空位
+        if (task->holdsSlot())
+        {
+            return TaskSubmitResult::TSR_Accepted;
+        }
+        if (task->isMandatory())
+        {
+            mReserved.fetch_add(1, std::memory_order_seq_cst);
+            task->setHoldsSlot(true);
+            _count(C_Accepted);
+            return TaskSubmitResult::TSR_Accepted;
+        }
+        if (_tryReserve(task, maxPending))
+        {
+            _count(C_Accepted);
+            return TaskSubmitResult::TSR_Accepted;
+        }
+
+        switch (static_cast<TaskOverflowPolicy>(mPolicy.load(std::memory_order_relaxed)))
+        {
+            case TaskOverflowPolicy::TOP_Block:
+                return _block(task);
+            case TaskOverflowPolicy::TOP_DropOldest:
+                // 丢弃后空位可能被并发提交的任务抢走， 继续丢弃； 没有可丢弃的任务 (空位都被正在提交的任务占用) 时拒绝
+                while (dropOldest())
+                {
+                    _count(C_Dropped);
+                    if (_tryReserve(task, maxPending))
+                    {
+                        return TaskSubmitResult::TSR_DroppedOldest;
+                    }
+                }
+                _count(C_Rejected);
+                return TaskSubmitResult::TSR_Rejected;
+            case TaskOverflowPolicy::TOP_CallerRuns:
+                if (serial || !_canBlock())
+                {
+                    _count(C_Rejected);
+                    return TaskSubmitResult::TSR_Rejected;
+                }
+                _count(C_CallerRuns);
+                return TaskSubmitResult::TSR_CallerRan;
+            default:
+                _count(C_Rejected);
+                return TaskSubmitResult::TSR_Rejected;
+        }
+    }
+
+    // 消费方出队 (或丢弃) 一个任务： 归还其占用的空位， 有阻塞的提交方时唤醒一个
+    inline void onDequeue(const TaskOperatorPtr& task)
+    {
+        if (task->holdsSlot())
+        {
+            task->setHoldsSlot(false);
+            mReserved.fetch_sub(1, std::memory_order_seq_cst);
+        }
+        if (mWaiters.load(std::memory_order_seq_cst) > 0)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mCond.notify_one();
+        }
+    }
+
+    // 被拒绝/丢弃的任务： 标记取消并唤醒等待方， 计入队列取消数
+    static void discard(const TaskOperatorPtr& task);
+
+    // 在提交线程执行任务， 记录到任务归属队列与任务类别
+    static void runInCaller(const TaskOperatorPtr& task);
+
+    // 标记当前线程为内部IO线程， 在线程入口调用： 之后本线程提交任务时不阻塞、 不执行用户任务
+    static void markIoThread();
+
+private:
+    enum Counter : size_t
+    {
+        C_Accepted = 0,
+        C_Blocked,
+        C_Rejected,
+        C_TimedOut,
+        C_Dropped,
+        C_CallerRuns,
+        C_Count,
+    };
+
+    inline void _count(Counter counter)
+    {
+        mCounters[counter].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 当前线程能否阻塞等待或执行用户任务 (工作线程/定时器线程/IO线程不能)
+    static bool _canBlock();
+
+    // 未满时预留一个空位
+    inline bool _tryReserve(const TaskOperatorPtr& task, uint32_t maxPending)
+    {
+        auto reserved = mReserved.load(std::memory_order_seq_cst);
+        do
+        {
+            if (reserved >= maxPending)
+            {
+                return false;
+            }
+        } while (!mReserved.compare_exchange_weak(reserved, reserved + 1, std::memory_order_seq_cst));
+        task->setHoldsSlot(true);
+        return true;
+    }
+
+    TaskSubmitResult _block(const TaskOperatorPtr& task)
+    {
+        if (!_canBlock())
+        {
+            _count(C_Rejected);
+            return TaskSubmitResult::TSR_Rejected;
+        }
+
+        const auto timeout  = std::chrono::milliseconds(mBlockTimeout.load(std::memory_order_relaxed));
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWaiters.fetch_add(1, std::memory_order_seq_cst);
+        while (true)
+        {
+            // 等待期间上限可能被放宽或取消
+            const auto maxPending = mMaxPending.load(std::memory_order_relaxed);
+            if (maxPending == 0 || _tryReserve(task, maxPending))
+            {
+                break;
+            }
+
+            auto slice = kWaitSlice;
+            if (timeout.count() >= 0)
+            {
+                const auto now = std::chrono::steady_clock::now();
+                if (now >= deadline)
+                {
+                    mWaiters.fetch_sub(1, std::memory_order_seq_cst);
+                    _count(C_TimedOut);
+                    return TaskSubmitResult::TSR_TimedOut;
+                }
+                slice = std::min<std::chrono::steady_clock::duration>(slice, deadline - now);
+            }
+            // 分片等待， 出队与等待之间的竞争最多延迟一个分片
+            mCond.wait_for(lock, slice);
+        }
+        mWaiters.fetch_sub(1, std::memory_order_seq_cst);
+        _count(C_Blocked);
+        return TaskSubmitResult::TSR_Accepted;
+    }
+
+private:
+    static constexpr std::chrono::steady_clock::duration kWaitSlice = std::chrono::milliseconds(10);
+
+    std::atomic<uint32_t> mMaxPending{ 0 };
+    std::atomic<uint8_t>  mPolicy{ static_cast<uint8_t>(TaskOverflowPolicy::TOP_Reject) };
+    std::atomic<int64_t>  mBlockTimeout{ -1 };
+
+    std::array<std::atomic<uint64_t>, C_Count> mCounters{};
+
+    std::atomic<uint32_t> mReserved{ 0 };  // 已预留的空位 (排队中的任务 + 正在入队的任务)
+
+    std::atomic<int32_t>    mWaiters{ 0 };
+    std::mutex              mMutex;
+    std::condition_variable mCond;
+};
+
+}  // namespace task
+
+#endif  // __QUEUE_CAPACITY_H__
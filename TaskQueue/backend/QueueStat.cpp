@@ -0,0 +1,97 @@
+#include "QueueStat.h"
+#include "QueueStatRegistry.h"
+#include "TaskOperator.h"
+#include "TaskQueueTracer.h"
+
+namespace task
+{
+TaskLatencySummary latencySummary(const LatencyHistogram::Snapshot& snapshot)
+{
+    TaskLatencySummary summary;
+    summary.mCount = snapshot.mCount;
+    summary.mMean  = snapshot.mean();
+    summary.mP50   = snapshot.percentile(50.0);
+    summary.mP99   = snapshot.percentile(99.0);
+    summary.mP999  = snapshot.percentile(99.9);
+    summary.mMax   = snapshot.mMax;
+    return summary;
+}
+
+TaskQueueMetrics queueMetrics(const std::string& label, uint32_t queueCount, const QueueStat::Totals& totals)
+{
+    TaskQueueMetrics metrics;
+    metrics.mLabel      = label;
+    metrics.mQueueCount = queueCount;
+    metrics.mSubmitted  = totals.mSubmitted;
+    metrics.mCompleted  = totals.mCompleted;
+    metrics.mCancelled  = totals.mCancelled;
+
+    // 各计数分别读取， 可能短暂不一致
+    const auto finished = totals.mCompleted + totals.mCancelled;
+    metrics.mInFlight   = totals.mSubmitted > finished ? totals.mSubmitted - finished : 0;
+    metrics.mLatency.mRun  = latencySummary(totals.mRun);
+    metrics.mLatency.mWait = latencySummary(totals.mWait);
+    return metrics;
+}
+
+void QueueStat::Totals::merge(const Totals& other)
+{
+    mSubmitted += other.mSubmitted;
+    mCompleted += other.mCompleted;
+    mCancelled += other.mCancelled;
+    mRun.merge(other.mRun);
+    mWait.merge(other.mWait);
+}
+
+QueueStat::~QueueStat()
+{
+    if (mRegistered && QueueStatRegistry::isAlive())
+    {
+        QueueStatRegistry::GetInstance().retire(*this);
+    }
+}
+
+void QueueStat::record(const TaskOperator& task)
+{
+    mCounters.add(C_Completed);
+    mRunLatency.record(task.taskRunDurationMicros());
+    mWaitLatency.record(task.taskWaitDurationMicros());
+}
+
+void QueueStat::setLabel(const std::string& label)
+{
+    mLabel      = label;
+    mTraceLabel = TaskQueueTracer::GetInstance().internLabel(label);
+    mRegistered = true;
+}
+
+TaskLatencyStat QueueStat::latencyStat() const
+{
+    LatencyHistogram::Snapshot run;
+    LatencyHistogram::Snapshot wait;
+    mRunLatency.snapshot(run);
+    mWaitLatency.snapshot(wait);
+
+    TaskLatencyStat stat;
+    stat.mRun  = latencySummary(run);
+    stat.mWait = latencySummary(wait);
+    return stat;
+}
+
+TaskQueueMetrics QueueStat::metrics() const
+{
+    Totals totals;
+    collect(totals);
+    return queueMetrics(mLabel, 1, totals);
+}
+
+void QueueStat::collect(Totals& totals) const
+{
+    totals.mSubmitted += mCounters.sum(C_Submitted);
+    totals.mCompleted += mCounters.sum(C_Completed);
+    totals.mCancelled += mCounters.sum(C_Cancelled);
+    mRunLatency.snapshot(totals.mRun);
+    mWaitLatency.snapshot(totals.mWait);
+}
+
+}  // namespace task
@@ -0,0 +1,90 @@
+// 队列统计
+// 由队列创建并在入队时挂到任务上， 工作线程执行完成后记录， 队列释放后仍在执行的任务可以安全记录
+// 计数 (入队/完成/取消) 为按CPU分片的relaxed计数器， 耗时为无锁直方图
+#ifndef __QUEUE_STAT_H__
+#define __QUEUE_STAT_H__
+
+#include "TaskQueueDefine.h"
+#include "common/LatencyHistogram.h"
+#include "common/StripedCounter.h"
+#include <string>
+
+namespace task
+{
+// 快照转换为对外的分布摘要
+TaskLatencySummary latencySummary(const LatencyHistogram::Snapshot& snapshot);
+
+class QueueStat final
+{
+public:
+    // 累计值， 用于合并同名队列
+    struct Totals
+    {
+        uint64_t                   mSubmitted{ 0 };
+        uint64_t                   mCompleted{ 0 };
+        uint64_t                   mCancelled{ 0 };
+        LatencyHistogram::Snapshot mRun;
+        LatencyHistogram::Snapshot mWait;
+
+        void merge(const Totals& other);
+    };
+
+    QueueStat() = default;
+    ~QueueStat();
+
+    // 任务入队
+    void recordSubmit()
+    {
+        mCounters.add(C_Submitted);
+    }
+
+    // 任务出队时已取消， 未执行
+    void recordCancel()
+    {
+        mCounters.add(C_Cancelled);
+    }
+
+    // 记录一次执行 (多线程并发调用， 无锁)
+    void record(const TaskOperator& task);
+
+    TaskLatencyStat  latencyStat() const;
+    TaskQueueMetrics metrics() const;
+
+    // 累加到totals
+    void collect(Totals& totals) const;
+
+    // 队列标签 (队列创建时设置一次)
+    void               setLabel(const std::string& label);
+    const std::string& label() const
+    {
+        return mLabel;
+    }
+    uint32_t traceLabel() const
+    {
+        return mTraceLabel;
+    }
+
+private:
+    enum Counter : size_t
+    {
+        C_Submitted = 0,
+        C_Completed,
+        C_Cancelled,
+        C_Count,
+    };
+
+    std::string mLabel;
+    uint32_t    mTraceLabel{ 0 };  // 轨迹记录中的标签ID
+    bool        mRegistered{ false };
+
+    StripedCounter<C_Count> mCounters;
+    LatencyHistogram        mRunLatency;
+    LatencyHistogram        mWaitLatency;
+};
+
+// 生成对外的队列指标
+TaskQueueMetrics queueMetrics(const std::string& label, uint32_t queueCount, const QueueStat::Totals& totals);
+
+}  // namespace task
+
+#endif  // __QUEUE_STAT_H__
@@ -0,0 +1,71 @@
+#include "QueueStatRegistry.h"
+#include <algorithm>
+
+namespace task
+{
+std::atomic<bool> QueueStatRegistry::sAlive{ false };
+
+QueueStatRegistry::QueueStatRegistry()
+{
+    sAlive.store(true, std::memory_order_release);
+}
+
+QueueStatRegistry::~QueueStatRegistry()
+{
+    sAlive.store(false, std::memory_order_release);
+}
+
+void QueueStatRegistry::add(const std::shared_ptr<QueueStat>& stat)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStats.erase(std::remove_if(mStats.begin(), mStats.end(), [](const std::weak_ptr<QueueStat>& item) { return item.expired(); }),
+                 mStats.end());
+    mStats.push_back(stat);
+}
+
+void QueueStatRegistry::retire(const QueueStat& stat)
+{
+    QueueStat::Totals totals;
+    stat.collect(totals);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRetired[stat.label()].merge(totals);
+}
+
+std::vector<TaskQueueMetrics> QueueStatRegistry::snapshot()
+{
+    // 存活的统计在锁外释放 (最后一个引用释放时会调用retire)
+    std::vector<std::shared_ptr<QueueStat>>                     stats;
+    std::map<std::string, std::pair<uint32_t, QueueStat::Totals>> merged;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& item : mStats)
+        {
+            if (auto stat = item.lock())
+            {
+                stats.push_back(std::move(stat));
+            }
+        }
+        for (auto& item : mRetired)
+        {
+            merged[item.first].second = item.second;
+        }
+    }
+
+    for (auto& stat : stats)
+    {
+        auto& entry = merged[stat->label()];
+        entry.first++;
+        stat->collect(entry.second);
+    }
+
+    std::vector<TaskQueueMetrics> result;
+    result.reserve(merged.size());
+    for (auto& item : merged)
+    {
+        result.push_back(queueMetrics(item.first, item.second.first, item.second.second));
+    }
+    return result;
+}
+
+}  // namespace task
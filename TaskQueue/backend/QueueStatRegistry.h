@@ -0,0 +1,51 @@
+// 队列统计注册表
+// 队列设置标签时注册， 按标签合并同名队列； 队列统计释放时累计值并入同名记录， 快照包含已释放的队列
+#ifndef __QUEUE_STAT_REGISTRY_H__
+#define __QUEUE_STAT_REGISTRY_H__
+
+#include "QueueStat.h"
+#include "common/HESingleton.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace task
+{
+class QueueStatRegistry : public task::HESingleton<QueueStatRegistry>
+{
+    friend class task::HESingleton<QueueStatRegistry>;
+
+public:
+    ~QueueStatRegistry();
+
+    void add(const std::shared_ptr<QueueStat>& stat);
+
+    // 队列统计析构时调用， 累计值并入同名记录
+    void retire(const QueueStat& stat);
+
+    // 所有队列指标， 按标签排序
+    std::vector<TaskQueueMetrics> snapshot();
+
+    // 静态析构后为false
+    static bool isAlive()
+    {
+        return sAlive.load(std::memory_order_acquire);
+    }
+
+private:
+    QueueStatRegistry();
+
+private:
+    std::mutex                              mMutex;
+    std::vector<std::weak_ptr<QueueStat>>   mStats;
+    std::map<std::string, QueueStat::Totals> mRetired;
+
+    static std::atomic<bool> sAlive;
+};
+
+}  // namespace task
+
+#endif  // __QUEUE_STAT_REGISTRY_H__
@@ -0,0 +1,100 @@
+#include "QueueSuspender.h"
+#include "TaskOperator.h"
+#include <algorithm>
+#include <iterator>
+
+namespace task
+{
+QueueSuspender::~QueueSuspender()
+{
+    for (auto& task : mHeld)
+    {
+        task->discard();
+    }
+}
+
+void QueueSuspender::suspend()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSuspendCount.fetch_add(1, std::memory_order_seq_cst);
+    mHolding.store(true, std::memory_order_relaxed);
+}
+
+bool QueueSuspender::resume(const Flush& flush)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mSuspendCount.load(std::memory_order_relaxed) == 0)
+        {
+            return false;
+        }
+        if (mSuspendCount.fetch_sub(1, std::memory_order_seq_cst) > 1)
+        {
+            return true;
+        }
+
+        // 正在恢复的线程负责取出
+        mFlushAgain = true;
+        if (mFlushing)
+        {
+            return true;
+        }
+        mFlushing = true;
+    }
+
+    std::vector<TaskOperatorPtr> tasks;
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            // 再次挂起时剩余的任务留到下次恢复
+            if (mSuspendCount.load(std::memory_order_relaxed) > 0 || (!mFlushAgain && mHeld.empty()))
+            {
+                mFlushing = false;
+                mHolding.store(mSuspendCount.load(std::memory_order_relaxed) > 0, std::memory_order_relaxed);
+                return true;
+            }
+            mFlushAgain = false;
+            tasks.swap(mHeld);
+        }
+
+        // 不持锁入队： 入队可能阻塞 (容量限制)， 或在当前线程执行任务再次提交
+        flush(tasks);
+        tasks.clear();
+    }
+}
+
+bool QueueSuspender::hold(const TaskOperatorPtr& task)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mSuspendCount.load(std::memory_order_relaxed) == 0 && !mFlushing)
+    {
+        return false;
+    }
+    mHeld.push_back(task);
+    return true;
+}
+
+void QueueSuspender::removeCancelled(std::vector<TaskOperatorPtr>& removed)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = std::stable_partition(mHeld.begin(), mHeld.end(),
+                                    [](const TaskOperatorPtr& task) { return !task->isCancelled(); });
+    removed.insert(removed.end(), std::make_move_iterator(it), std::make_move_iterator(mHeld.end()));
+    mHeld.erase(it, mHeld.end());
+}
+
+void QueueSuspender::clear(std::vector<TaskOperatorPtr>& removed)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    removed.insert(removed.end(), std::make_move_iterator(mHeld.begin()), std::make_move_iterator(mHeld.end()));
+    mHeld.clear();
+}
+
+size_t QueueSuspender::heldCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mHeld.size();
+}
+
+}  // namespace task
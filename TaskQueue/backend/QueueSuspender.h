@@ -0,0 +1,69 @@
+// 队列挂起/恢复
+// 挂起可嵌套， resume次数与suspend相同时恢复； 未挂起时判断只有一次relaxed读
+// 挂起期间提交的任务按提交顺序暂存， 不投递到线程池； 恢复时一次取出， 由调用方批量入队
+// 批量入队时不持锁， 期间新提交的任务继续暂存， 全部取出后才真正恢复， 保持提交顺序
+#ifndef __QUEUE_SUSPENDER_H__
+#define __QUEUE_SUSPENDER_H__
+
+#include "TaskQueueDefine.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace task
+{
+class QueueSuspender final
+{
+public:
+    using Flush = std::function<void(std::vector<TaskOperatorPtr>&)>;
+
+    QueueSuspender() = default;
+    // 释放时仍暂存的任务不会再入队， 标记丢弃 (唤醒同步等待方/任务组)
+    ~QueueSuspender();
+
+    // 已挂起或正在恢复 (暂存任务尚未全部取出)
+    inline bool isHolding() const
+    {
+        return mHolding.load(std::memory_order_relaxed);
+    }
+
+    // 已挂起 (恢复过程中返回false)
+    inline bool isSuspended() const
+    {
+        return mSuspendCount.load(std::memory_order_seq_cst) > 0;
+    }
+
+    void suspend();
+
+    // 挂起计数减一， 归零时调用flush取出暂存任务 (暂存为空时也调用一次)， 直到取空或再次挂起
+    // 返回false表示未挂起
+    bool resume(const Flush& flush);
+
+    // 挂起/恢复期间暂存任务， 返回false表示未挂起， 由调用方直接入队
+    bool hold(const TaskOperatorPtr& task);
+
+    // 移除暂存的已取消任务， 放入removed由调用方丢弃 (唤醒等待方)
+    void removeCancelled(std::vector<TaskOperatorPtr>& removed);
+
+    // 取出全部暂存任务 (队列释放时)， 放入removed由调用方丢弃
+    void clear(std::vector<TaskOperatorPtr>& removed);
+
+    // 当前暂存的任务数
+    size_t heldCount() const;
+
+private:
+    std::atomic<bool>    mHolding{ false };  // mSuspendCount > 0 || mFlushing
+    std::atomic<int32_t> mSuspendCount{ 0 };  // 持锁修改
+
+    mutable std::mutex           mMutex;
+    bool                         mFlushing{ false };    // 有线程正在取出暂存任务
+    bool                         mFlushAgain{ false };  // 取出期间再次挂起并恢复， 需要再调用一次flush
+    std::vector<TaskOperatorPtr> mHeld;
+};
+
+}  // namespace task
+
+#endif  // __QUEUE_SUSPENDER_H__
@@ -0,0 +1,159 @@
+#include "RateLimiter.h"
+#include "TaskOperator.h"
+#include "common/HETimerHelper.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace task
+{
+RateLimiter::~RateLimiter()
+{
+    for (auto& task : mPending)
+    {
+        task->discard();
+    }
+}
+
+void RateLimiter::configure(const TaskRateLimit& limit, std::vector<TaskOperatorPtr>& ready)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    const bool enabled = limit.mRate > 0;
+    mRate       = enabled ? limit.mRate : 0;
+    mBurst      = std::max<uint32_t>(1, limit.mBurst);
+    mTokens     = mBurst;
+    mLastRefill = HETimerHelper::microsecondTimestamp64();
+    mImmediate  = 0;
+    mDelayed    = 0;
+    mRejected   = 0;
+    mEnabled.store(enabled, std::memory_order_relaxed);
+
+    // 取消限制： 暂存的任务立即入队； 仍在限速时由已有的释放定时器按新速率处理
+    if (!enabled)
+    {
+        ready.insert(ready.end(), mPending.begin(), mPending.end());
+        mPending.clear();
+    }
+}
+
+bool RateLimiter::acquire(const TaskOperatorPtr& task, std::chrono::milliseconds& armDelay)
+{
+    armDelay = std::chrono::milliseconds(-1);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mRate <= 0)
+    {
+        // 并发设置为不限制
+        return true;
+    }
+
+    // 已有暂存任务时排在其后， 保持提交顺序
+    _refill(HETimerHelper::microsecondTimestamp64());
+    if (mPending.empty() && mTokens >= 1)
+    {
+        mTokens -= 1;
+        ++mImmediate;
+        return true;
+    }
+
+    mPending.push_back(task);
+    ++mDelayed;
+    if (!mTimerArmed)
+    {
+        mTimerArmed = true;
+        armDelay    = _nextDelay();
+    }
+    return false;
+}
+
+void RateLimiter::release(std::vector<TaskOperatorPtr>& ready, std::vector<TaskOperatorPtr>& cancelled, std::chrono::milliseconds& armDelay)
+{
+    armDelay = std::chrono::milliseconds(-1);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mTimerArmed = false;
+    if (mPending.empty())
+    {
+        return;
+    }
+
+    _refill(HETimerHelper::microsecondTimestamp64());
+    while (!mPending.empty())
+    {
+        auto& task = mPending.front();
+        if (task->isCancelled())
+        {
+            cancelled.push_back(std::move(task));
+            mPending.pop_front();
+            continue;
+        }
+        if (mTokens < 1)
+        {
+            break;
+        }
+        mTokens -= 1;
+        ready.push_back(std::move(task));
+        mPending.pop_front();
+    }
+
+    if (!mPending.empty())
+    {
+        mTimerArmed = true;
+        armDelay    = _nextDelay();
+    }
+}
+
+void RateLimiter::refund(bool released)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mTokens = std::min(mBurst, mTokens + 1);
+    if (released)
+    {
+        ++mRejected;
+    }
+}
+
+void RateLimiter::removeCancelled(std::vector<TaskOperatorPtr>& removed)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = std::stable_partition(mPending.begin(), mPending.end(),
+                                    [](const TaskOperatorPtr& task) { return !task->isCancelled(); });
+    removed.insert(removed.end(), std::make_move_iterator(it), std::make_move_iterator(mPending.end()));
+    mPending.erase(it, mPending.end());
+}
+
+void RateLimiter::clear(std::vector<TaskOperatorPtr>& removed)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    removed.insert(removed.end(), std::make_move_iterator(mPending.begin()), std::make_move_iterator(mPending.end()));
+    mPending.clear();
+}
+
+TaskRateLimitStat RateLimiter::stat() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    TaskRateLimitStat stat;
+    stat.mImmediate = mImmediate;
+    stat.mDelayed   = mDelayed;
+    stat.mPending   = mPending.size();
+    stat.mRejected  = mRejected;
+    return stat;
+}
+
+void RateLimiter::_refill(uint64_t now)
+{
+    if (now > mLastRefill)
+    {
+        mTokens     = std::min(mBurst, mTokens + static_cast<double>(now - mLastRefill) * mRate / 1000000.0);
+        mLastRefill = now;
+    }
+}
+
+std::chrono::milliseconds RateLimiter::_nextDelay() const
+{
+    // 定时器精度为1ms， 向上取整， 至少1ms
+    const double micros = (1 - mTokens) * 1000000.0 / mRate;
+    return std::chrono::milliseconds(std::max<int64_t>(1, static_cast<int64_t>(std::ceil(micros / 1000.0))));
+}
+
+}  // namespace task
@@ -0,0 +1,78 @@
+// 队列速率限制 (令牌桶)
+// 提交时有令牌且没有暂存任务则直接入队， 否则按提交顺序暂存
+// 暂存任务由定时器在令牌恢复时取出入队， 工作线程不会为限速而休眠
+// 暂存数由队列的容量限制约束 (暂存前预留空位)； 取得令牌后未能入队时归还令牌
+// 同一时刻最多只有一个释放定时器； 未开启时判断只有一次relaxed读
+#ifndef __RATE_LIMITER_H__
+#define __RATE_LIMITER_H__
+
+#include "TaskQueueDefine.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace task
+{
+class RateLimiter final
+{
+public:
+    RateLimiter() = default;
+    // 释放时仍暂存的任务不会再入队， 标记丢弃 (唤醒同步等待方/任务组)
+    ~RateLimiter();
+
+    inline bool isEnabled() const
+    {
+        return mEnabled.load(std::memory_order_relaxed);
+    }
+
+    // 更新速率， 令牌填满， 统计清零
+    // 取消限制时暂存的任务全部放入ready， 由调用方立即入队
+    void configure(const TaskRateLimit& limit, std::vector<TaskOperatorPtr>& ready);
+
+    // 提交一个任务， 返回true表示取得令牌可直接入队； 否则已暂存
+    // armDelay >= 0 时调用方需要添加释放定时器
+    bool acquire(const TaskOperatorPtr& task, std::chrono::milliseconds& armDelay);
+
+    // 释放定时器到期， 按令牌数取出暂存任务放入ready； 已取消的任务不消耗令牌， 放入cancelled由调用方丢弃
+    // 仍有暂存任务时 armDelay >= 0， 调用方需要再次添加释放定时器
+    void release(std::vector<TaskOperatorPtr>& ready, std::vector<TaskOperatorPtr>& cancelled, std::chrono::milliseconds& armDelay);
+
+    // 取得令牌的任务未被队列接受 (已丢弃)， 归还令牌； released 为暂存后入队的任务， 计入被拒绝数
+    void refund(bool released);
+
+    // 移除暂存的已取消任务， 放入removed由调用方丢弃 (唤醒等待方)
+    void removeCancelled(std::vector<TaskOperatorPtr>& removed);
+
+    // 取出全部暂存任务 (队列释放时)， 放入removed由调用方丢弃
+    void clear(std::vector<TaskOperatorPtr>& removed);
+
+    TaskRateLimitStat stat() const;
+
+private:
+    // 按经过的时间补充令牌 【持锁调用】
+    void _refill(uint64_t now);
+    // 下一个令牌恢复需要的时间 【持锁调用】
+    std::chrono::milliseconds _nextDelay() const;
+
+private:
+    std::atomic<bool> mEnabled{ false };
+
+    mutable std::mutex          mMutex;
+    double                      mRate{ 0 };
+    double                      mBurst{ 1 };
+    double                      mTokens{ 0 };
+    uint64_t                    mLastRefill{ 0 };  // 上次补充令牌的时间 (微秒)
+    bool                        mTimerArmed{ false };
+    std::deque<TaskOperatorPtr> mPending;
+
+    uint64_t mImmediate{ 0 };
+    uint64_t mDelayed{ 0 };
+    uint64_t mRejected{ 0 };
+};
+
+}  // namespace task
+
+#endif  // __RATE_LIMITER_H__
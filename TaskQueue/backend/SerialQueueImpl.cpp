@@ -4,12 +4,52 @@
 #include "TaskOperatorBackend.h"
 #include "common/LogHelper.h"
 #include "TaskQueueDefine.h"
+#include "WorkThreadBase.h"
 
 #include <cassert>
 #include <cstdio>
 #include <memory>
 namespace task
 {
+// 非独占串行队列的转发任务： 每次从队列中取出一个任务执行
+// 本身不记录耗时， 由_processTask记录实际执行的任务
+// 只持有队列的弱引用， 队列释放后线程池中剩余的转发任务不再访问队列
+class SerialDrainOperator : public TaskOperator
+{
+public:
+    SerialDrainOperator() = default;
+
+    inline void bind(const std::weak_ptr<SerialQueueImpl>& queue)
+    {
+        mQueue = queue;
+    }
+
+    virtual void operator()() override
+    {
+        auto queue = mQueue.lock();
+        if (queue)
+        {
+            queue->_processTask();
+        }
+    }
+
+private:
+    std::weak_ptr<SerialQueueImpl> mQueue;
+};
+
+std::shared_ptr<SerialQueueImpl> SerialQueueImpl::create(const std::string&   label,
+                                                         bool                 isExclusive,
+                                                         const ThreadPoolPtr& threadPool,
+                                                         WorkThreadPriority   prio)
+{
+    auto queue = std::make_shared<SerialQueueImpl>(label, isExclusive, threadPool, prio);
+    if (queue->mSerialTask)
+    {
+        std::static_pointer_cast<SerialDrainOperator>(queue->mSerialTask)->bind(queue);
+    }
+    return queue;
+}
+
 SerialQueueImpl::SerialQueueImpl(const std::string&   label,
                                  bool                 isExclusive,
                                  const ThreadPoolPtr& threadPool,
@@ -17,7 +57,7 @@ SerialQueueImpl::SerialQueueImpl(const std::string&   label,
     : IQueueImpl(TaskQueueType::TQT_Serial, threadPool)
     , mIsExclusive(isExclusive)
 {
-    LOGE("[TASK]SerialQueueImpl::SerialQueueImpl, label: %s, isExclusive: %d, prio: %d", label.c_str(), isExclusive, prio);
+    LOGD("[TASK]SerialQueueImpl::SerialQueueImpl, label: %s, isExclusive: %d, prio: %d", label.c_str(), isExclusive, prio);
     if (mIsExclusive)
     {
         mThreadId = _threadPool()->attachOneThread(label, prio);
@@ -25,15 +65,14 @@ SerialQueueImpl::SerialQueueImpl(const std::string&   label,
     else
     {
         // 非独占模式下，创建一个串行任务
-        mSerialTask = std::make_shared<TaskOperator>([this](const TaskOperatorPtr& /*task*/) {
-            _processTask();
-        });
+        mSerialTask = std::make_shared<SerialDrainOperator>();
     }
 }
 
 SerialQueueImpl::~SerialQueueImpl()
 {
-    LOGE("[TASK]SerialQueueImpl::~SerialQueueImpl, mIsExclusive: %d, mThreadId: %d\n", mIsExclusive, mThreadId);
+    LOGD("[TASK]SerialQueueImpl::~SerialQueueImpl, mIsExclusive: %d, mThreadId: %d\n", mIsExclusive, mThreadId);
+    _dropHeld();
     if (mIsExclusive && mThreadId >= 0)
     {
         _threadPool()->detachOneThread(mThreadId);
@@ -42,49 +81,70 @@ SerialQueueImpl::~SerialQueueImpl()
 
 void SerialQueueImpl::_processTask()
 {
-    // 1. 从队列中获取一个任务进行执行
+    // 线程池关闭时丢弃队列中的任务 (不再调度)
+    if (_threadPool()->isCancelling())
+    {
+        TaskOperatorPtr op;
+        while (mTasks.try_dequeue(op))
+        {
+            if (op)
+            {
+                mCapacity.onDequeue(op);
+                _threadPool()->dropOnShutdown(op);
+            }
+        }
+        mSyncFlag.clear();
+        return;
+    }
+
+    // 1. 从队列中获取一个任务进行执行 (挂起时不再取任务， 恢复时重新调度)
     TaskOperatorPtr op;
-    if (mTasks.try_dequeue(op) && op)
+    if (!isSuspended() && mTasks.try_dequeue(op) && op)
     {
-        (*op)();
+        mCapacity.onDequeue(op);
+        if (!op->isCancelled())
+        {
+            WorkThreadBase::runTask(op);
+        }
+        else
+        {
+            // 已取消的任务不执行， 唤醒等待方 (同步任务/任务组)
+            op->discard();
+        }
+
+        // 统计计入当前工作线程与本队列
+        auto worker = WorkThreadBase::current();
+        if (worker)
+        {
+            worker->recordTask(op);
+        }
+        op->onRecorded();
     }
 
     // 2. 处理队列中的下一个任务
-    if (mTasks.size_approx() > 0)
+    if (!isSuspended() && mTasks.size_approx() > 0)
     {
         _threadPool()->execute(mSerialTask);
     }
     else
     {
-        // 3.队列没有任务，重置同步标志位
+        // 3.队列没有任务或已挂起，重置同步标志位
         mSyncFlag.clear();
-        //重置后再检查一次， 确保无任务抛入
-        if (mTasks.size_approx() > 0 && !mSyncFlag.test_and_set())
+        //重置后再检查一次， 确保无任务抛入 (或已恢复)
+        if (!isSuspended() && mTasks.size_approx() > 0 && !mSyncFlag.test_and_set())
         {
             _threadPool()->execute(mSerialTask);
         }
     }
 }
 
-void SerialQueueImpl::async(const TaskOperatorPtr& task)
+TaskSubmitResult SerialQueueImpl::async(const TaskOperatorPtr& task)
 {
     assert(_threadPool());
     task->resetCallStartTime();
+    _onEnqueue(task);
 
-    if (mIsExclusive)
-    {
-        _threadPool()->execute(task, mThreadId);
-    }
-    else
-    {
-        mTasks.enqueue(task);
-        // 如果mSyncFlag为false, 则设置为true, 并执行任务,
-        // 注意：返回值为prev值
-        if (!mSyncFlag.test_and_set(std::memory_order_acq_rel))
-        {
-            _threadPool()->execute(mSerialTask);
-        }
-    }
+    return _enqueue(task);
 }
 
 void SerialQueueImpl::sync(const TaskOperatorPtr& task, std::chrono::milliseconds timeout)
@@ -94,43 +154,151 @@ void SerialQueueImpl::sync(const TaskOperatorPtr& task, std::chrono::millisecond
     task->resetCallStartTime();
 
     auto syncTask = std::make_shared<TaskBarrierOperator>(task);
-    if (mIsExclusive)
-    {
-        _threadPool()->execute(syncTask, mThreadId);
+    _onEnqueue(syncTask);
+
+    // 被拒绝时同步任务已唤醒， 不会等待
+    _enqueue(syncTask);
+
+    if(!syncTask->wait(timeout)) {
+        //超时 取消任务
+        syncTask->cancel();
     }
-    else
+
+}
+
+TaskSubmitResult SerialQueueImpl::_enqueue(const TaskOperatorPtr& task)
+{
+    if (mIsExclusive)
     {
-        mTasks.enqueue(syncTask);
-        if (!mSyncFlag.test_and_set(std::memory_order_acq_rel))
+        if (_holdIfSuspended(task))
         {
-            _threadPool()->execute(mSerialTask);
+            return TaskSubmitResult::TSR_Suspended;
         }
+        return _threadPool()->execute(task, mThreadId);
     }
-    
-    if(!syncTask->wait(timeout)) {
-        //超时 取消任务
-        syncTask->cancel();
+
+    // 线程池已关闭
+    if (_threadPool()->isShutdown())
+    {
+        _threadPool()->dropOnShutdown(task);
+        return TaskSubmitResult::TSR_Shutdown;
+    }
+
+    auto result = _admit(task);
+    if (result == TaskSubmitResult::TSR_Rejected || result == TaskSubmitResult::TSR_TimedOut)
+    {
+        return result;
     }
 
+    mTasks.enqueue(task);
+    // 挂起时暂存在队列中， 由恢复时调度
+    if (isSuspended())
+    {
+        return result == TaskSubmitResult::TSR_Accepted ? TaskSubmitResult::TSR_Suspended : result;
+    }
+    // 如果mSyncFlag为false, 则设置为true, 并执行任务,
+    // 注意：返回值为prev值
+    if (!mSyncFlag.test_and_set(std::memory_order_acq_rel))
+    {
+        _threadPool()->execute(mSerialTask);
+    }
+    return result;
 }
 
-void SerialQueueImpl::after(std::chrono::milliseconds delay, const TaskOperatorPtr& task)
+TaskSubmitResult SerialQueueImpl::_admit(const TaskOperatorPtr& task)
 {
-    assert(_threadPool());
-    task->resetCallStartTime();
+    auto result = mCapacity.admit(task, true, [this]() {
+        TaskOperatorPtr oldest;
+        if (!mTasks.try_dequeue(oldest) || oldest == nullptr)
+        {
+            return false;
+        }
+        mCapacity.onDequeue(oldest);
+        QueueCapacity::discard(oldest);
+        return true;
+    });
+    switch (result)
+    {
+        case TaskSubmitResult::TSR_Rejected:
+        case TaskSubmitResult::TSR_TimedOut:
+            QueueCapacity::discard(task);
+            break;
+        default:
+            break;
+    }
+    return result;
+}
 
-    auto delayTask = std::make_shared<TaskDelayOperator>(delay, task);
+TaskSubmitResult SerialQueueImpl::_reserve(const TaskOperatorPtr& task)
+{
+    return mIsExclusive ? _threadPool()->reserve(task, mThreadId) : _admit(task);
+}
+
+void SerialQueueImpl::_unreserve(const TaskOperatorPtr& task)
+{
     if (mIsExclusive)
     {
-        _threadPool()->execute(delayTask, mThreadId);
+        _threadPool()->unreserve(task, mThreadId);
     }
     else
     {
-        mTasks.enqueue(delayTask);
-        if (!mSyncFlag.test_and_set(std::memory_order_acq_rel))
+        mCapacity.onDequeue(task);
+    }
+}
+
+void SerialQueueImpl::_flushSuspended(std::vector<TaskOperatorPtr>& tasks)
+{
+    if (mIsExclusive)
+    {
+        if (!tasks.empty())
         {
-            _threadPool()->execute(mSerialTask);
+            _threadPool()->executeBulk(tasks, mThreadId);
         }
+        return;
     }
+
+    // 非独占队列的任务暂存在自身队列中， 重新调度转发任务即可
+    if (mTasks.size_approx() > 0 && !mSyncFlag.test_and_set(std::memory_order_acq_rel))
+    {
+        _threadPool()->execute(mSerialTask);
+    }
+}
+
+bool SerialQueueImpl::setCapacity(const TaskCapacity& capacity)
+{
+    if (mIsExclusive)
+    {
+        if (mThreadId < 0)
+        {
+            return false;
+        }
+        _threadPool()->setCapacity(mThreadId, capacity);
+        return true;
+    }
+
+    mCapacity.set(capacity);
+    return true;
+}
+
+TaskOverflowStat SerialQueueImpl::overflowStat() const
+{
+    if (mIsExclusive)
+    {
+        return mThreadId >= 0 ? _threadPool()->overflowStat(mThreadId) : TaskOverflowStat();
+    }
+    return mCapacity.stat();
+}
+
+TaskOperatorPtr SerialQueueImpl::after(std::chrono::milliseconds delay, const TaskOperatorPtr& task)
+{
+    assert(_threadPool());
+    task->resetCallStartTime();
+    return _scheduleAfter(delay, task);
+}
+
+TaskOperatorPtr SerialQueueImpl::every(std::chrono::milliseconds interval, std::chrono::milliseconds leeway, const TaskOperatorPtr& task)
+{
+    assert(_threadPool());
+    return _scheduleEvery(interval, leeway, task);
 }
 }  // namespace task
\ No newline at end of file
@@ -3,6 +3,7 @@
 #define __SERIAL_TASK_QUEUE_IMPL_H__
 
 #include "IQueueImpl.h"
+#include "QueueCapacity.h"
 #include "QueueDefine.h"
 #include "TaskQueueDefine.h"
 namespace task
@@ -13,19 +14,42 @@ public:
     SerialQueueImpl(const std::string& label, bool isExclusive, const ThreadPoolPtr& threadPool, WorkThreadPriority prio);
     ~SerialQueueImpl();
 
-    virtual void async(const TaskOperatorPtr& task) override;
+    // 创建串行队列 (非独占队列的转发任务持有队列的弱引用)
+    static std::shared_ptr<SerialQueueImpl> create(const std::string&   label,
+                                                   bool                 isExclusive,
+                                                   const ThreadPoolPtr& threadPool,
+                                                   WorkThreadPriority   prio);
+
+    virtual TaskSubmitResult async(const TaskOperatorPtr& task) override;
     virtual void sync(const TaskOperatorPtr& task, std::chrono::milliseconds timeout = std::chrono::milliseconds(-1)) override;
-    virtual void after(std::chrono::milliseconds delay, const TaskOperatorPtr& task) override;
+    virtual TaskOperatorPtr after(std::chrono::milliseconds delay, const TaskOperatorPtr& task) override;
+    virtual TaskOperatorPtr every(std::chrono::milliseconds interval, std::chrono::milliseconds leeway, const TaskOperatorPtr& task) override;
+
+    // 独占队列限制独占线程的任务队列， 非独占队列限制自身的任务队列
+    virtual bool             setCapacity(const TaskCapacity& capacity) override;
+    virtual TaskOverflowStat overflowStat() const override;
+
+protected:
+    virtual void _flushSuspended(std::vector<TaskOperatorPtr>& tasks) override;
+    virtual TaskSubmitResult _reserve(const TaskOperatorPtr& task) override;
+    virtual void             _unreserve(const TaskOperatorPtr& task) override;
 
 private:
+    friend class SerialDrainOperator;
     void _processTask();
 
+    // 入队并调度 (独占线程 或 转发任务)
+    TaskSubmitResult _enqueue(const TaskOperatorPtr& task);
+    // 非独占队列的容量判断， 被拒绝时丢弃任务； 返回TSR_Accepted/TSR_DroppedOldest时已预留空位
+    TaskSubmitResult _admit(const TaskOperatorPtr& task);
+
 private:
     bool                mIsExclusive{ false };
     int32_t             mThreadId{ -1 };
     std::atomic_flag    mSyncFlag;   // 同步标志位
 
     WorkQueue           mTasks;         // 串行任务队列
+    QueueCapacity       mCapacity;      // 串行任务队列容量限制 (非独占)
     TaskOperatorPtr     mSerialTask;    // 当前正在执行的任务
 
 };
@@ -4,10 +4,12 @@
 #include "SysUtils.h"
 #include "common/LogHelper.h"
 #include "TaskQueueReporter.h"
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 namespace task
 {
@@ -21,8 +23,7 @@ void SerialThreadPool::registerWorkThread(const std::shared_ptr<WorkThreadBase>&
 
     task::WriteLock lock(mExclusiveThreadsLock);
     mExclusiveThreads[thread->threadId()] = thread;
-    TaskQueueReporter::GetInstance().notifyReport(TaskQueueReporterType::TQRT_ThreadCountChanged,
-                                                  _threadPoolInfo("threadid:" + std::to_string(thread->threadId()) + " created"));
+    TaskQueueReporter::GetInstance().notifyReport(_threadCountEvent(TaskQueueReportReason::TQRR_ThreadCreated, thread->threadId()));
 }
 
 void SerialThreadPool::unregisterWorkThread(const std::shared_ptr<WorkThreadBase>& thread)
@@ -36,40 +37,33 @@ void SerialThreadPool::unregisterWorkThread(const std::shared_ptr<WorkThreadBase
     task::WriteLock lock(mExclusiveThreadsLock);
     mExpiredThreads.push_back(thread);
     mExclusiveThreads.erase(thread->threadId());
+    _retireLatency(thread);
     // 释放一条线程
-    TaskQueueReporter::GetInstance().notifyReport(TaskQueueReporterType::TQRT_ThreadCountChanged,
-                                                  _threadPoolInfo("threadid:" + std::to_string(thread->threadId()) + " released"));
+    TaskQueueReporter::GetInstance().notifyReport(_threadCountEvent(TaskQueueReportReason::TQRR_ThreadReleased, thread->threadId()));
 }
 
 int32_t SerialThreadPool::attachOneThread(const std::string& name, WorkThreadPriority prio)
 {
+    if (isShutdown())
+    {
+        LOGW("[TASK]SerialThreadPool::attachOneThread, pool is shutdown, name: %s \n", name.c_str());
+        return -1;
+    }
+
     int32_t index = -1;
     {
         task::WriteLock lock(mExclusiveThreadsLock);
-        for (auto it = mExclusiveThreads.begin(); it != mExclusiveThreads.end();)
+        for (auto& item : mExclusiveThreads)
         {
-            // 卡顿检查
-            if (it->second && it->second->isBlocked())
-            {
-                TaskQueueReporter::GetInstance().notifyReport(TaskQueueReporterType::TQRT_TaskDurationExceedThreshold, it->second->blockedInfo());
-                LOGE("[TASK]SerialThreadPool::attachOneThread, threadId: %d is blocked, blockedInfo: %s \n", it->second->threadId(), it->second->blockedInfo().c_str());
-                // 尝试cancel 与 删除
-                it->second->cancel();
-                it = mExclusiveThreads.erase(it);  // erase返回下一个有效迭代器
-                continue;                          // 跳过当前循环，继续下一个元素
-            }
-
             // 非active且没有running (可能存在线程卡住一直running的情况，此时切换线程)
-            if (it->second && !it->second->isActive() && !it->second->isRunning())
+            if (item.second && !item.second->isActive() && !item.second->isRunning())
             {
-                it->second->setActive(true);
-                it->second->setName(name);
-                it->second->setPriority(prio);
-                index = it->second->threadId();
+                item.second->setActive(true);
+                item.second->setName(name);
+                item.second->setPriority(prio);
+                index = item.second->threadId();
                 break;
             }
-
-            ++it;  // 手动递增迭代器
         }
     }
 
@@ -79,8 +73,8 @@ int32_t SerialThreadPool::attachOneThread(const std::string& name, WorkThreadPri
         // 已经达到最大线程数量限制
         if (mExclusiveThreads.size() >= SysUtils::cpuCount())
         {
-            LOGE("[TASK]SerialThreadPool::attachOneThread, reach max thread count, max: %d \n", SysUtils::cpuCount());
-            TaskQueueReporter::GetInstance().notifyReport(TaskQueueReporterType::TQRT_ThreadCountChanged, _threadPoolInfo("reach_max_thread_count"));
+            LOGW("[TASK]SerialThreadPool::attachOneThread, reach max thread count, max: %d \n", SysUtils::cpuCount());
+            TaskQueueReporter::GetInstance().notifyReport(_threadCountEvent(TaskQueueReportReason::TQRR_MaxThreadsArrived));
 #ifdef _DEBUG
             assert(false);
 #endif
@@ -93,18 +87,19 @@ int32_t SerialThreadPool::attachOneThread(const std::string& name, WorkThreadPri
         thread->setName(name);
         index                    = thread->threadId();
         mExclusiveThreads[index] = std::static_pointer_cast<WorkThreadBase>(thread);
+        TaskQueueReporter::GetInstance().notifyReport(_threadCountEvent(TaskQueueReportReason::TQRR_ThreadCreated, index));
 
-        LOGE("[TASK]SerialThreadPool::attachOneThread, create new thread, threadId: %d \n", index);
+        LOGD("[TASK]SerialThreadPool::attachOneThread, create new thread, threadId: %d \n", index);
     }
 
-    LOGE("[TASK]SerialThreadPool::attachOneThread, name: %s, prio: %d, threadId: %d \n", name.c_str(), prio, index);
+    LOGD("[TASK]SerialThreadPool::attachOneThread, name: %s, prio: %d, threadId: %d \n", name.c_str(), prio, index);
 
     return index;
 }
 
 void SerialThreadPool::detachOneThread(int32_t threadID)
 {
-    LOGE("[TASK]SerialThreadPool::detachOneThread, threadID: %d\n", threadID);
+    LOGD("[TASK]SerialThreadPool::detachOneThread, threadID: %d\n", threadID);
     task::WriteLock lock(mExclusiveThreadsLock);
     auto            it = mExclusiveThreads.find(threadID);
     if (it != mExclusiveThreads.end())
@@ -113,36 +108,259 @@ void SerialThreadPool::detachOneThread(int32_t threadID)
     }
 }
 
-void SerialThreadPool::execute(const TaskOperatorPtr& task, int32_t threadId)
+TaskShutdownStat SerialThreadPool::shutdown(std::chrono::milliseconds timeout, TaskShutdownPolicy policy)
+{
+    TaskShutdownStat stat;
+    if (!_beginShutdown(policy))
+    {
+        LOGW("[TASK]SerialThreadPool::shutdown, already shutdown\n");
+        return stat;
+    }
+    LOGD("[TASK]SerialThreadPool::shutdown, timeout: %lld, policy: %d\n", ( long long )timeout.count(), policy);
+
+    const auto start    = std::chrono::steady_clock::now();
+    const auto timedOut = [&start, timeout]() { return timeout.count() >= 0 && std::chrono::steady_clock::now() - start >= timeout; };
+
+    // 1. 取消或等待排队中的任务
+    if (policy == TaskShutdownPolicy::TSP_Cancel)
+    {
+        _cancelPending();
+    }
+    while (!_isDrained())
+    {
+        if (timedOut())
+        {
+            stat.mTimedOut = true;
+            _setShutdownState(SS_Cancelling);
+            _cancelPending();
+            break;
+        }
+        std::this_thread::sleep_for(kShutdownPollInterval);
+    }
+
+    // 2. 通知所有线程退出， 等待正在执行的任务结束
+    _setShutdownState(SS_Stopped);
+    while (_stopThreads() > 0 && !timedOut())
+    {
+        std::this_thread::sleep_for(kShutdownPollInterval);
+    }
+
+    // 3. 回收已退出的线程， 清理退出期间入队的任务
+    std::vector<std::shared_ptr<WorkThreadBase>> expiredThreads;
+    {
+        task::WriteLock lock(mExclusiveThreadsLock);
+        expiredThreads.swap(mExpiredThreads);
+        stat.mBusyThreads = static_cast<uint32_t>(mExclusiveThreads.size());
+    }
+    stat.mJoinedThreads = static_cast<uint32_t>(expiredThreads.size());
+    std::vector<TaskOperatorPtr> tasks;
+    for (auto& thread : expiredThreads)
+    {
+        thread->takePending(tasks);
+    }
+    expiredThreads.clear();
+    for (auto& task : tasks)
+    {
+        dropOnShutdown(task);
+    }
+    _cancelPending();
+
+    stat.mTimedOut = stat.mTimedOut || stat.mBusyThreads > 0;
+    stat.mDropped  = _shutdownDropped();
+    LOGD("[TASK]SerialThreadPool::shutdown, dropped: %llu, joined: %u, busy: %u\n", ( unsigned long long )stat.mDropped,
+         stat.mJoinedThreads, stat.mBusyThreads);
+    return stat;
+}
+
+void SerialThreadPool::_cancelPending()
+{
+    std::vector<TaskOperatorPtr> tasks;
+    {
+        task::ReadLock lock(mExclusiveThreadsLock);
+        for (auto& item : mExclusiveThreads)
+        {
+            item.second->takePending(tasks);
+        }
+    }
+
+    // 不持锁丢弃， 唤醒的等待方可能再次提交任务
+    for (auto& task : tasks)
+    {
+        dropOnShutdown(task);
+    }
+}
+
+bool SerialThreadPool::_isDrained() const
+{
+    task::ReadLock lock(mExclusiveThreadsLock);
+    for (auto& item : mExclusiveThreads)
+    {
+        if (item.second->pendingCount() > 0 || item.second->isRunning())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int32_t SerialThreadPool::_stopThreads()
+{
+    task::ReadLock lock(mExclusiveThreadsLock);
+    for (auto& item : mExclusiveThreads)
+    {
+        item.second->cancel();
+        item.second->wake();
+    }
+    return static_cast<int32_t>(mExclusiveThreads.size());
+}
+
+void SerialThreadPool::checkBlocked()
+{
+    std::vector<std::shared_ptr<WorkThreadBase>> blockedThreads;
+    {
+        task::ReadLock lock(mExclusiveThreadsLock);
+        for (auto& item : mExclusiveThreads)
+        {
+            if (item.second && item.second->isBlocked() && item.second->markBlocked())
+            {
+                blockedThreads.push_back(item.second);
+            }
+        }
+    }
+
+    for (auto& thread : blockedThreads)
+    {
+        auto event = thread->blockedEvent();
+        thread->captureStack(event);
+        TaskQueueReporter::GetInstance().notifyReport(event);
+        LOGW("[TASK]SerialThreadPool::checkBlocked, threadId: %d is blocked, %llu ms", thread->threadId(),
+             ( unsigned long long )event.mBlockedMillis);
+    }
+}
+
+TaskSubmitResult SerialThreadPool::execute(const TaskOperatorPtr& task, int32_t threadId)
 {
+    if (isShutdown())
+    {
+        dropOnShutdown(task);
+        return TaskSubmitResult::TSR_Shutdown;
+    }
+
     std::vector<std::shared_ptr<WorkThreadBase>> expiredThreads;
+    std::shared_ptr<WorkThreadBase>              thread;
     {
         task::ReadLock lock(mExclusiveThreadsLock);
         auto           it = mExclusiveThreads.find(threadId);
         if (it != mExclusiveThreads.end())
         {
-            it->second->commit(task);
+            thread = it->second;
         }
 
         // 删除上一帧结束的线程对象
         expiredThreads.swap(mExpiredThreads);
     }
+
+    // 提交可能因队列已满而阻塞， 不持有锁
+    if (thread == nullptr)
+    {
+        QueueCapacity::discard(task);
+        return TaskSubmitResult::TSR_Rejected;
+    }
+    return thread->commit(task);
+}
+
+void SerialThreadPool::executeBulk(std::vector<TaskOperatorPtr>& tasks, int32_t threadId)
+{
+    if (isShutdown())
+    {
+        for (auto& task : tasks)
+        {
+            dropOnShutdown(task);
+        }
+        return;
+    }
+
+    std::shared_ptr<WorkThreadBase> thread;
+    {
+        task::ReadLock lock(mExclusiveThreadsLock);
+        auto           it = mExclusiveThreads.find(threadId);
+        if (it != mExclusiveThreads.end())
+        {
+            thread = it->second;
+        }
+    }
+
+    if (thread == nullptr)
+    {
+        for (auto& task : tasks)
+        {
+            QueueCapacity::discard(task);
+        }
+        return;
+    }
+    thread->commitBulk(tasks);
+}
+
+void SerialThreadPool::setCapacity(int32_t threadId, const TaskCapacity& capacity)
+{
+    task::ReadLock lock(mExclusiveThreadsLock);
+    auto           it = mExclusiveThreads.find(threadId);
+    if (it != mExclusiveThreads.end() && it->second)
+    {
+        it->second->setCapacity(capacity);
+    }
+}
+
+TaskOverflowStat SerialThreadPool::overflowStat(int32_t threadId) const
+{
+    task::ReadLock lock(mExclusiveThreadsLock);
+    auto           it = mExclusiveThreads.find(threadId);
+    if (it != mExclusiveThreads.end() && it->second)
+    {
+        return it->second->overflowStat();
+    }
+    return TaskOverflowStat();
+}
+
+TaskSubmitResult SerialThreadPool::reserve(const TaskOperatorPtr& task, int32_t threadId)
+{
+    std::shared_ptr<WorkThreadBase> thread;
+    {
+        task::ReadLock lock(mExclusiveThreadsLock);
+        auto           it = mExclusiveThreads.find(threadId);
+        if (it != mExclusiveThreads.end())
+        {
+            thread = it->second;
+        }
+    }
+
+    // 阻塞等待空位时不持有锁； 线程不存在时由入队处理
+    return thread ? thread->reserve(task) : TaskSubmitResult::TSR_Accepted;
+}
+
+void SerialThreadPool::unreserve(const TaskOperatorPtr& task, int32_t threadId)
+{
+    task::ReadLock lock(mExclusiveThreadsLock);
+    auto           it = mExclusiveThreads.find(threadId);
+    if (it != mExclusiveThreads.end() && it->second)
+    {
+        it->second->unreserve(task);
+    }
 }
 
 // 此方法调用处已在锁保护范围内
-std::string SerialThreadPool::_threadPoolInfo(std::string reason) const
+ThreadCountChangedEvent SerialThreadPool::_threadCountEvent(TaskQueueReportReason reason, int32_t threadId) const
 {
-    std::string info = "SerialPool: t_cnt: "
-                       + std::to_string(mExclusiveThreads.size())
-                       + ", active: "
-                       + std::to_string(_activeThreadCount())
-                       + ", max: "
-                       + std::to_string(SysUtils::cpuCount())
-                       + ", reason: "
-                       + reason;
+    const auto active = static_cast<uint32_t>(_activeThreadCount());
 
-    LOGE("[TASK] %s", info.c_str());
-    return info;
+    ThreadCountChangedEvent event;
+    event.mPoolType = TaskQueueType::TQT_Serial;
+    event.mReason   = reason;
+    event.mThreadId = threadId;
+    event.mActive   = active;
+    event.mIdle     = static_cast<uint32_t>(mExclusiveThreads.size()) - active;
+    event.mMax      = static_cast<uint32_t>(SysUtils::cpuCount());
+    return event;
 }
 
 int32_t SerialThreadPool::_activeThreadCount() const
@@ -159,4 +377,16 @@ int32_t SerialThreadPool::_activeThreadCount() const
     return _cnt;
 }
 
-}  // namespace task
\ No newline at end of file
+void SerialThreadPool::_collectLatency(LatencyHistogram::Snapshot& run, LatencyHistogram::Snapshot& wait)
+{
+    task::ReadLock lock(mExclusiveThreadsLock);
+    for (auto& item : mExclusiveThreads)
+    {
+        if (item.second)
+        {
+            item.second->collectLatency(run, wait);
+        }
+    }
+}
+
+}  // namespace task
@@ -2,12 +2,14 @@
 #define EXCLUSIVE_THREAD_POOL_H
 
 #include "IThreadPool.h"
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
 #include "TaskQueueDefine.h"
+#include "TaskQueueReporter.h"
 #include "common/ThreadRWLock.hpp"
 namespace task
 {
@@ -19,21 +21,46 @@ public:
     virtual void registerWorkThread(const std::shared_ptr<WorkThreadBase>& thread) override;
     virtual void unregisterWorkThread(const std::shared_ptr<WorkThreadBase>& thread) override;
 
-    virtual void execute(const TaskOperatorPtr& task, int32_t threadId) override;
+    virtual TaskSubmitResult execute(const TaskOperatorPtr& task, int32_t threadId) override;
+    virtual void             executeBulk(std::vector<TaskOperatorPtr>& tasks, int32_t threadId) override;
 
     // 获取对应优先级的独占线程
     virtual int32_t attachOneThread(const std::string& name, WorkThreadPriority priority = WorkThreadPriority::WTP_Normal) override;
     virtual void    detachOneThread(int32_t threadID) override;
 
+    // 独占线程的任务队列容量限制
+    virtual void             setCapacity(int32_t threadId, const TaskCapacity& capacity) override;
+    virtual TaskOverflowStat overflowStat(int32_t threadId) const override;
+    virtual TaskSubmitResult reserve(const TaskOperatorPtr& task, int32_t threadId) override;
+    virtual void             unreserve(const TaskOperatorPtr& task, int32_t threadId) override;
+
+    // 关闭线程池， 所有独占线程退出 (之后 attachOneThread 返回-1)
+    virtual TaskShutdownStat shutdown(std::chrono::milliseconds timeout, TaskShutdownPolicy policy) override;
+
+    // 卡住的线程上报堆栈 (attachOneThread 不会复用正在执行的线程)
+    virtual void checkBlocked() override;
+
+protected:
+    virtual void _collectLatency(LatencyHistogram::Snapshot& run, LatencyHistogram::Snapshot& wait) override;
+
 private:
-    std::string _threadPoolInfo(std::string reason) const;
-    int32_t     _activeThreadCount() const;
+    ThreadCountChangedEvent _threadCountEvent(TaskQueueReportReason reason, int32_t threadId = -1) const;
+    int32_t                 _activeThreadCount() const;
+
+    // 关闭时取消所有独占线程中排队的任务
+    void _cancelPending();
+    // 所有独占线程的排队任务已执行完
+    bool _isDrained() const;
+    // 通知所有独占线程退出， 返回仍未退出的线程数
+    int32_t _stopThreads();
 
 private:
     // 独占线程集合
     std::shared_ptr<task::ThreadRWLock>                          mExclusiveThreadsLock;
     std::unordered_map<int32_t, std::shared_ptr<WorkThreadBase>> mExclusiveThreads;
     std::vector<std::shared_ptr<WorkThreadBase>>                 mExpiredThreads;  //延迟生命周期到下一次execute
+
+    static constexpr std::chrono::milliseconds kShutdownPollInterval{ 1 };
 };
 
 }  // namespace task
@@ -0,0 +1,84 @@
+#include "TaskCategoryRegistry.h"
+#include "TaskOperator.h"
+#include "common/LogHelper.h"
+
+namespace task
+{
+std::atomic<bool> TaskCategoryRegistry::sAlive{ false };
+
+TaskCategoryRegistry::TaskCategoryRegistry()
+{
+    sAlive.store(true, std::memory_order_release);
+}
+
+TaskCategoryRegistry::~TaskCategoryRegistry()
+{
+    sAlive.store(false, std::memory_order_release);
+}
+
+TaskCategory TaskCategoryRegistry::intern(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto                        it = mIds.find(name);
+    if (it != mIds.end())
+    {
+        return it->second;
+    }
+
+    // 0 为未分类
+    const auto id = mStorage.size() + 1;
+    if (id >= kMaxCategories)
+    {
+        LOGW("[TASK]TaskCategoryRegistry::intern, too many categories, name: %s", name.c_str());
+        return kNoTaskCategory;
+    }
+
+    auto category   = std::make_unique<Category>();
+    category->mName = name;
+    mCategories[id].store(category.get(), std::memory_order_release);
+    mStorage.push_back(std::move(category));
+    mIds.emplace(name, static_cast<TaskCategory>(id));
+    return static_cast<TaskCategory>(id);
+}
+
+void TaskCategoryRegistry::record(const TaskOperator& task)
+{
+    const auto id = task.category();
+    if (id == kNoTaskCategory || id >= kMaxCategories)
+    {
+        return;
+    }
+
+    auto* category = mCategories[id].load(std::memory_order_acquire);
+    if (category == nullptr)
+    {
+        return;
+    }
+    category->mCounters.add(C_Count);
+    category->mCounters.add(C_Run, task.taskRunDurationMicros());
+    category->mCounters.add(C_Wait, task.taskWaitDurationMicros());
+    category->mCounters.add(C_Cpu, task.taskCpuDurationMicros());
+}
+
+std::vector<TaskCategoryStat> TaskCategoryRegistry::snapshot()
+{
+    std::lock_guard<std::mutex>   lock(mMutex);
+    std::vector<TaskCategoryStat> stats;
+    stats.reserve(mStorage.size());
+    for (size_t i = 0; i < mStorage.size(); ++i)
+    {
+        const auto& category = *mStorage[i];
+
+        TaskCategoryStat stat;
+        stat.mName       = category.mName;
+        stat.mCategory   = static_cast<TaskCategory>(i + 1);
+        stat.mCount      = category.mCounters.sum(C_Count);
+        stat.mRunMicros  = category.mCounters.sum(C_Run);
+        stat.mWaitMicros = category.mCounters.sum(C_Wait);
+        stat.mCpuMicros  = category.mCounters.sum(C_Cpu);
+        stats.push_back(std::move(stat));
+    }
+    return stats;
+}
+
+}  // namespace task
@@ -0,0 +1,73 @@
+// 任务类别注册表
+// 类别名称注册为ID (同名返回同一ID)， 工作线程按ID无锁累加 (按CPU分片的relaxed计数器)， 读取时求和
+// 未分类的任务不经过注册表
+#ifndef __TASK_CATEGORY_REGISTRY_H__
+#define __TASK_CATEGORY_REGISTRY_H__
+
+#include "TaskQueueDefine.h"
+#include "common/HESingleton.h"
+#include "common/StripedCounter.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace task
+{
+class TaskCategoryRegistry : public task::HESingleton<TaskCategoryRegistry>
+{
+    friend class task::HESingleton<TaskCategoryRegistry>;
+
+public:
+    static constexpr size_t kMaxCategories = 256;  // 包含 kNoTaskCategory
+
+    ~TaskCategoryRegistry();
+
+    // 注册类别， 超出上限返回 kNoTaskCategory
+    TaskCategory intern(const std::string& name);
+
+    // 记录一次执行 (多线程并发调用， 无锁)
+    void record(const TaskOperator& task);
+
+    // 所有类别的累计值， 按ID排序
+    std::vector<TaskCategoryStat> snapshot();
+
+    // 静态析构后为false
+    static bool isAlive()
+    {
+        return sAlive.load(std::memory_order_acquire);
+    }
+
+private:
+    TaskCategoryRegistry();
+
+    enum Counter : size_t
+    {
+        C_Count = 0,
+        C_Run,
+        C_Wait,
+        C_Cpu,
+        C_Total,
+    };
+
+    struct Category
+    {
+        std::string              mName;
+        StripedCounter<C_Total> mCounters;
+    };
+
+private:
+    std::mutex                                    mMutex;
+    std::unordered_map<std::string, TaskCategory> mIds;
+    std::vector<std::unique_ptr<Category>>        mStorage;
+    std::array<std::atomic<Category*>, kMaxCategories> mCategories{};  // 按ID查找， 注册后不再变化
+
+    static std::atomic<bool> sAlive;
+};
+
+}  // namespace task
+
+#endif  // __TASK_CATEGORY_REGISTRY_H__
@@ -1,4 +1,5 @@
 // 操作基类
+// 包装任务继承原始任务的类别， 类别统计按实际入队的包装任务记录
 #ifndef __TASK_OPERATOR_BACKEND_H__
 #define __TASK_OPERATOR_BACKEND_H__
 
@@ -9,7 +10,7 @@
 #include "../TaskQueueDefine.h"
 #include "../common/LWBarrier.h"
 #include "Consumable.h"
-// 注意：TimerManager.h暂未包含，避免循环依赖
+#include "TimerManager.h"
 namespace task
 {
 // 处理同步任务
@@ -19,6 +20,7 @@ public:
     explicit TaskBarrierOperator(const TaskOperatorPtr& op)
         : mRealTask(op)
     {
+        setCategory(op ? op->category() : kNoTaskCategory);
     }
     ~TaskBarrierOperator() = default;
 
@@ -27,7 +29,6 @@ public:
         //此处只能确保任务还没有执行时，选择了取消，然后不执行任务
         //所以 如果要 完全确保 在执行中 取消了， 外层调用时， lambda捕获 需要延长 捕获对象生命周期 直到执行完成
         if(mCancaled.load()) {
-            mRealTask = nullptr;
             mBarrier.notify();
             return;
         }
@@ -47,43 +48,47 @@ public:
         return mBarrier.wait(timeout);
     }
 
-    //取消执行
+    //取消执行， 同时取消原始任务 (释放其捕获的资源)
     void cancel() override
     {
         mCancaled.store(true);
+        if (mRealTask)
+        {
+            mRealTask->cancel();
+        }
+    }
+
+    // 被丢弃时不再执行， 唤醒同步等待方
+    void discard() override
+    {
+        mCancaled.store(true);
+        mRealTask = nullptr;
+        mBarrier.notify();
     }
 
 
 private:
     TaskOperatorPtr mRealTask;
     LWBarrier       mBarrier;
-    std::atomic<bool> mCancaled;
+    std::atomic<bool> mCancaled{ false };
 };
 
-// 延时任务 - 优化版本，不再阻塞线程
+// 延时任务
+// 由TimerManager计时， 到期后才投递到目标队列， 不占用工作线程
 class TaskDelayOperator : public TaskOperator
 {
 public:
     TaskDelayOperator(std::chrono::milliseconds delay, const TaskOperatorPtr& op)
         : mDelay(delay)
         , mRealTask(op)
-        , mTimerId(0)
+        , mTimerId(TimerManager::kInvalidTimerId)
     {
+        setCategory(op ? op->category() : kNoTaskCategory);
     }
-    ~TaskDelayOperator() {
-        // 确保定时任务被取消
-        if (mTimerId != 0) {
-            // 注意：这里需要包含TimerManager.h，暂时注释掉避免编译错误
-            // TimerManager::getInstance().cancelTask(mTimerId);
-        }
-    }
+    ~TaskDelayOperator() = default;
 
-    // 不再阻塞线程，而是通过定时器管理器调度
-    // 为了保持向后兼容性，暂时保留原有实现，但添加了优化标记
     virtual void operator()() override
     {
-        // TODO: 迁移到TimerManager后移除sleep_for调用
-        std::this_thread::sleep_for(mDelay);  // 临时保留，待完全迁移后移除
         recordRunStart();
         if (mRealTask)
         {
@@ -91,17 +96,121 @@ public:
         }
         recordRunEnd();
     }
-    
-    // 新增取消功能
-    void cancel() override{
-        // TODO: 实现通过TimerManager取消任务
-        
+
+    // 取消定时器， 任务不会再投递到队列
+    void cancel() override
+    {
+        TaskOperator::cancel();
+        TimerManager::GetInstance().cancelTimer(mTimerId.load(std::memory_order_acquire));
+        if (mRealTask)
+        {
+            mRealTask->cancel();
+        }
+    }
+
+    // 原始任务被取消时， 到期后也不再投递
+    bool isCancelled() const override
+    {
+        return TaskOperator::isCancelled() || (mRealTask && mRealTask->isCancelled());
+    }
+
+    void setTimerId(uint64_t timerId)
+    {
+        mTimerId.store(timerId, std::memory_order_release);
+    }
+
+    std::chrono::milliseconds delay() const
+    {
+        return mDelay;
     }
 
 private:
     std::chrono::milliseconds mDelay;
     TaskOperatorPtr           mRealTask;
-    uint64_t                 mTimerId;  // 定时器任务ID
+    std::atomic<uint64_t>     mTimerId;  // 定时器ID
+};
+
+// 周期任务
+// 由TimerManager按原始时间表计时， 每次到期投递自身； 上一次还未执行完时跳过本次
+class TaskPeriodicOperator : public TaskOperator
+{
+public:
+    TaskPeriodicOperator(std::chrono::milliseconds interval, std::chrono::milliseconds leeway, const TaskOperatorPtr& op)
+        : mInterval(interval)
+        , mLeeway(leeway)
+        , mRealTask(op)
+        , mTimerId(TimerManager::kInvalidTimerId)
+        , mPending(false)
+    {
+        setCategory(op ? op->category() : kNoTaskCategory);
+    }
+    ~TaskPeriodicOperator() = default;
+
+    virtual void operator()() override
+    {
+        recordRunStart();
+        if (mRealTask && !isCancelled())
+        {
+            (*mRealTask)();
+        }
+        recordRunEnd();
+    }
+
+    // 统计记录完成后才允许下一次投递 (入队会重置调用时间与队列统计)
+    void onRecorded() override
+    {
+        mPending.store(false, std::memory_order_release);
+    }
+
+    // 停止定时器， 之后不再投递
+    void cancel() override
+    {
+        TaskOperator::cancel();
+        TimerManager::GetInstance().cancelTimer(mTimerId.load(std::memory_order_acquire));
+        if (mRealTask)
+        {
+            mRealTask->cancel();
+        }
+    }
+
+    bool isCancelled() const override
+    {
+        return TaskOperator::isCancelled() || (mRealTask && mRealTask->isCancelled());
+    }
+
+    // 本次投递被丢弃， 周期任务继续， 下一次到期重新投递
+    void discard() override
+    {
+        mPending.store(false, std::memory_order_release);
+    }
+
+    // 标记为等待执行， 返回false表示上一次投递还未执行完
+    bool tryMarkPending()
+    {
+        return !mPending.exchange(true, std::memory_order_acq_rel);
+    }
+
+    void setTimerId(uint64_t timerId)
+    {
+        mTimerId.store(timerId, std::memory_order_release);
+    }
+
+    std::chrono::milliseconds interval() const
+    {
+        return mInterval;
+    }
+
+    std::chrono::milliseconds leeway() const
+    {
+        return mLeeway;
+    }
+
+private:
+    std::chrono::milliseconds mInterval;
+    std::chrono::milliseconds mLeeway;
+    TaskOperatorPtr           mRealTask;
+    std::atomic<uint64_t>     mTimerId;  // 定时器ID
+    std::atomic<bool>         mPending;  // 已投递还未执行
 };
 
 // consumable 操作对象
@@ -110,8 +219,14 @@ class ConsumableOperator : public TaskOperator
 public:
     ConsumableOperator(const TaskOperatorPtr& op, const ConsumablePtr& consumable)
         : mConsumable(consumable)
-        , mRealTask(op) 
+        , mRealTask(op)
     {
+        setCategory(op ? op->category() : kNoTaskCategory);
+        if (op && op->hasDeadline())
+        {
+            // 任务组中的任务同样进入EDF通道， 错过截止时间被丢弃时归还计数
+            setDeadline(op->deadlineBudget(), op->dropIfMissed());
+        }
     }
     ~ConsumableOperator() = default;
 
@@ -125,14 +240,40 @@ public:
         // 释放资源
         if (mConsumable)
         {
-            LOGE("[TASK] Consumable release before" );
+            LOGD("[TASK] Consumable release before" );
             mConsumable->release();
 
-            LOGE("[TASK] Consumable release end" );
+            LOGD("[TASK] Consumable release end" );
         }
         recordRunEnd();
     }
 
+    // 取消原始任务， 出队时跳过并归还计数 (discard)
+    void cancel() override
+    {
+        TaskOperator::cancel();
+        if (mRealTask)
+        {
+            mRealTask->cancel();
+        }
+    }
+
+    bool isCancelled() const override
+    {
+        return TaskOperator::isCancelled() || (mRealTask && mRealTask->isCancelled());
+    }
+
+    // 被丢弃时归还计数， 任务组的等待不会卡住
+    void discard() override
+    {
+        TaskOperator::cancel();
+        if (mConsumable)
+        {
+            mConsumable->release();
+            mConsumable = nullptr;
+        }
+    }
+
 private:
     ConsumablePtr   mConsumable;
     TaskOperatorPtr mRealTask;
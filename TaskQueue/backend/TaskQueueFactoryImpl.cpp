@@ -1,10 +1,18 @@
 #include "TaskQueueFactoryImpl.h"
 #include "GroupImpl.h"
+#include "GraphImpl.h"
+#include "PipelineImpl.h"
+#include "IFileIoImpl.h"
 #include "IQueueImpl.h"
 #include "IThreadPool.h"
+#include "QueueStatRegistry.h"
+#include "TaskCategoryRegistry.h"
 #include "SerialQueueImpl.h"
 #include "ConcurrencyQueueImpl.h"
 #include "TaskGroup.h"
+#include "TaskGraph.h"
+#include "TaskPipeline.h"
+#include "TaskFileIo.h"
 #include <array>
 #include <cassert>
 #include <cstdint>
@@ -26,24 +34,24 @@ static std::array<TaskQueuePtr, uint32_t(TaskQueuePriority::TQP_Count)> sParalle
 
 // 全局串行队列【方便抛一个任务类型，不用创建队列】
 static TaskQueuePtr sSerialQueue = std::make_shared<TaskQueue>("queue.global_serial",
-                                                               std::make_shared<SerialQueueImpl>("queue.global_serial.backend",
-                                                                                                 false,
-                                                                                                 IThreadPool::parallelThreadPool(),
-                                                                                                 WorkThreadPriority::WTP_Normal));
+                                                               SerialQueueImpl::create("queue.global_serial.backend",
+                                                                                       false,
+                                                                                       IThreadPool::parallelThreadPool(),
+                                                                                       WorkThreadPriority::WTP_Normal));
 
 // 创建串行队列
 TaskQueuePtr TaskQueueFactoryImpl::createSerialQueue(const std::string& label, WorkThreadPriority priority, bool isExclusive)
 {
-    LOGE("[HY] TaskQueueFactoryImpl::%s, label: %s, priority: %d, isExclusive: %d\n", __func__, label.c_str(), priority, isExclusive);
+    LOGD("[HY] TaskQueueFactoryImpl::%s, label: %s, priority: %d, isExclusive: %d\n", __func__, label.c_str(), priority, isExclusive);
     auto threadPool   = isExclusive ? IThreadPool::serialThreadPool() : IThreadPool::parallelThreadPool();
-    auto backendQueue = std::make_shared<SerialQueueImpl>(label, isExclusive, threadPool, priority);
+    auto backendQueue = SerialQueueImpl::create(label, isExclusive, threadPool, priority);
     return std::make_shared<TaskQueue>(label, backendQueue);
 }
 
 // 创建并行队列
 TaskQueuePtr TaskQueueFactoryImpl::createConcurrencyQueue(const std::string& label, TaskQueuePriority priority)
 {
-    LOGE("[HY] TaskQueueFactoryImpl::%s, label: %s, priority: %d\n", __func__, label.c_str(), priority);
+    LOGD("[HY] TaskQueueFactoryImpl::%s, label: %s, priority: %d\n", __func__, label.c_str(), priority);
     return std::make_shared<TaskQueue>(label,
                                        std::make_shared<ConcurrencyQueueImpl>(priority, IThreadPool::parallelThreadPool()));
 }
@@ -65,4 +73,82 @@ TaskGroupPtr TaskQueueFactoryImpl::createTaskGroup()
     return std::make_shared<TaskGroup>(
         std::make_shared<GroupImpl>(IThreadPool::parallelThreadPool()));
 }
+
+TaskGraphPtr TaskQueueFactoryImpl::createTaskGraph()
+{
+    return std::make_shared<TaskGraph>(std::make_shared<GraphImpl>());
+}
+
+TaskPipelinePtr TaskQueueFactoryImpl::createTaskPipeline()
+{
+    return std::make_shared<TaskPipeline>(std::make_shared<PipelineImpl>());
+}
+
+TaskFileIoPtr TaskQueueFactoryImpl::createTaskFileIo(TaskFileIoBackend backend)
+{
+    return std::make_shared<TaskFileIo>(IFileIoImpl::create(backend));
+}
+
+TaskDeadlineStat TaskQueueFactoryImpl::deadlineStat()
+{
+    auto data = IThreadPool::parallelThreadPool()->getData();
+    return data ? data->mDeadlineQueue.stat() : TaskDeadlineStat{};
+}
+
+void TaskQueueFactoryImpl::setPoolCapacity(const TaskCapacity& capacity)
+{
+    auto data = IThreadPool::parallelThreadPool()->getData();
+    if (data)
+    {
+        data->mCapacity.set(capacity);
+    }
+}
+
+TaskOverflowStat TaskQueueFactoryImpl::poolOverflowStat()
+{
+    auto data = IThreadPool::parallelThreadPool()->getData();
+    return data ? data->mCapacity.stat() : TaskOverflowStat{};
+}
+
+void TaskQueueFactoryImpl::setLoadShedding(const TaskLoadShedding& config)
+{
+    auto data = IThreadPool::parallelThreadPool()->getData();
+    if (data)
+    {
+        data->mShedder.configure(config);
+    }
+}
+
+TaskLoadShedStat TaskQueueFactoryImpl::loadShedStat()
+{
+    auto data = IThreadPool::parallelThreadPool()->getData();
+    return data ? data->mShedder.stat() : TaskLoadShedStat{};
+}
+
+TaskLatencyStat TaskQueueFactoryImpl::poolLatencyStat(TaskQueueType type)
+{
+    const auto& pool = (type == TaskQueueType::TQT_Serial) ? IThreadPool::serialThreadPool() : IThreadPool::parallelThreadPool();
+    return pool->latencyStat();
+}
+
+TaskShutdownStat TaskQueueFactoryImpl::shutdownPool(TaskQueueType type, std::chrono::milliseconds timeout, TaskShutdownPolicy policy)
+{
+    const auto& pool = (type == TaskQueueType::TQT_Serial) ? IThreadPool::serialThreadPool() : IThreadPool::parallelThreadPool();
+    return pool->shutdown(timeout, policy);
+}
+
+std::vector<TaskQueueMetrics> TaskQueueFactoryImpl::queueMetrics()
+{
+    return QueueStatRegistry::GetInstance().snapshot();
+}
+
+TaskCategory TaskQueueFactoryImpl::registerTaskCategory(const std::string& name)
+{
+    return TaskCategoryRegistry::GetInstance().intern(name);
+}
+
+std::vector<TaskCategoryStat> TaskQueueFactoryImpl::taskCategoryStats()
+{
+    return TaskCategoryRegistry::GetInstance().snapshot();
+}
 }  // namespace task
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "TaskQueueDefine.h"
 #include "TaskQueue.h"
+#include <vector>
 namespace task
 {
 class TaskQueueFactoryImpl
@@ -19,6 +20,30 @@ public:
     TaskQueuePtr& getSerialQueue();
 
     TaskGroupPtr createTaskGroup();
+
+    TaskGraphPtr createTaskGraph();
+
+    TaskPipelinePtr createTaskPipeline();
+
+    TaskFileIoPtr createTaskFileIo(TaskFileIoBackend backend);
+
+    TaskDeadlineStat deadlineStat();
+
+    void             setPoolCapacity(const TaskCapacity& capacity);
+    TaskOverflowStat poolOverflowStat();
+
+    void             setLoadShedding(const TaskLoadShedding& config);
+    TaskLoadShedStat loadShedStat();
+
+    TaskLatencyStat poolLatencyStat(TaskQueueType type);
+
+    TaskShutdownStat shutdownPool(TaskQueueType type, std::chrono::milliseconds timeout, TaskShutdownPolicy policy);
+
+    std::vector<TaskQueueMetrics> queueMetrics();
+
+    TaskCategory registerTaskCategory(const std::string& name);
+
+    std::vector<TaskCategoryStat> taskCategoryStats();
 };
 
 }  // namespace task
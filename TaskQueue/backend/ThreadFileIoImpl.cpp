@@ -0,0 +1,102 @@
+#include "ThreadFileIoImpl.h"
+#include "QueueCapacity.h"
+#include "common/LogHelper.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+namespace task
+{
+ThreadFileIoImpl::ThreadFileIoImpl()
+{
+    mThreads.reserve(kThreadCount);
+    for (size_t i = 0; i < kThreadCount; ++i)
+    {
+        mThreads.emplace_back(&ThreadFileIoImpl::_run, this);
+    }
+}
+
+ThreadFileIoImpl::~ThreadFileIoImpl()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopped = true;
+    }
+    mCond.notify_all();
+    for (auto& thread : mThreads)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+}
+
+bool ThreadFileIoImpl::submit(RequestPtr&& request)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mStopped)
+        {
+            return false;
+        }
+        mPending.push_back(std::move(request));
+        mSubmitted.fetch_add(1, std::memory_order_relaxed);
+    }
+    mCond.notify_one();
+    return true;
+}
+
+void ThreadFileIoImpl::_run()
+{
+    LOGD("[TASK]ThreadFileIoImpl::run");
+    QueueCapacity::markIoThread();
+    while (true)
+    {
+        RequestPtr request;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCond.wait(lock, [this] { return mStopped || !mPending.empty(); });
+            // 停止后仍执行完已提交的请求
+            if (mPending.empty())
+            {
+                return;
+            }
+            request = std::move(mPending.front());
+            mPending.pop_front();
+        }
+
+        const auto result = _execute(*request);
+        _complete(std::move(request), result);
+    }
+}
+
+int64_t ThreadFileIoImpl::_execute(const Request& request)
+{
+    ssize_t result = -1;
+    do
+    {
+        switch (request.mOp)
+        {
+            case FO_Read:
+                result = ::pread(request.mFd, request.mBuf, request.mLen, static_cast<off_t>(request.mOffset));
+                break;
+            case FO_Write:
+                result = ::pwrite(request.mFd, request.mBuf, request.mLen, static_cast<off_t>(request.mOffset));
+                break;
+            case FO_Fsync:
+                result = ::fsync(request.mFd);
+                break;
+            case FO_Fdatasync:
+#if defined(__APPLE__)
+                result = ::fsync(request.mFd);
+#else
+                result = ::fdatasync(request.mFd);
+#endif
+                break;
+        }
+    } while (result < 0 && errno == EINTR);
+
+    return result < 0 ? -static_cast<int64_t>(errno) : static_cast<int64_t>(result);
+}
+
+}  // namespace task
@@ -0,0 +1,44 @@
+#ifndef __THREAD_FILE_IO_IMPL_H__
+#define __THREAD_FILE_IO_IMPL_H__
+
+#include "IFileIoImpl.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+namespace task
+{
+// 线程池异步文件IO (io_uring 不可用时回退)
+// 独立的IO线程执行阻塞的 pread/pwrite/fsync， 不占用并行线程池的工作线程， 磁盘变慢时不会触发卡顿检测
+class ThreadFileIoImpl : public IFileIoImpl
+{
+public:
+    ThreadFileIoImpl();
+    ~ThreadFileIoImpl();
+
+    virtual bool submit(RequestPtr&& request) override;
+
+    virtual TaskFileIoBackend backend() const override
+    {
+        return TaskFileIoBackend::TFB_ThreadPool;
+    }
+
+private:
+    static constexpr size_t kThreadCount = 4;
+
+    void _run();
+
+    static int64_t _execute(const Request& request);
+
+private:
+    std::mutex               mMutex;
+    std::condition_variable  mCond;
+    std::deque<RequestPtr>   mPending;
+    bool                     mStopped{ false };
+    std::vector<std::thread> mThreads;
+};
+
+}  // namespace task
+
+#endif  // __THREAD_FILE_IO_IMPL_H__
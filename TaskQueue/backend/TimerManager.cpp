@@ -0,0 +1,474 @@
+#include "TimerManager.h"
+#include "common/LogHelper.h"
+#include <algorithm>
+#include <cassert>
+#include <memory>
+namespace task
+{
+// 下标大于idx的非空槽位
+static inline uint64_t bitsAbove(uint64_t bitmap, uint32_t idx)
+{
+    return idx >= 63 ? 0 : (bitmap & (~0ULL << (idx + 1)));
+}
+
+TimerManager::TimerManager()
+    : mStartTime(std::chrono::steady_clock::now())
+{
+    for (auto& level : mWheel)
+    {
+        level.fill(kNil);
+    }
+}
+
+TimerManager::~TimerManager()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopped = true;
+    }
+    mCond.notify_all();
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+}
+
+uint64_t TimerManager::addTimer(std::chrono::milliseconds delay, Callback&& callback)
+{
+    if (delay.count() < 0)
+    {
+        delay = std::chrono::milliseconds(0);
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    return _addTimer(_expireTick(delay), 0, 0, std::move(callback));
+}
+
+uint64_t TimerManager::addPeriodicTimer(std::chrono::milliseconds interval,
+                                        std::chrono::milliseconds leeway,
+                                        Callback&&                callback)
+{
+    const auto periodMs = std::max<int64_t>(interval.count(), 1);
+    const auto slackMs  = std::max<int64_t>(leeway.count(), 0);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    return _addTimer(_expireTick(std::chrono::milliseconds(periodMs)),
+                     static_cast<uint32_t>(std::min<int64_t>(periodMs, UINT32_MAX)),
+                     static_cast<uint32_t>(std::min<int64_t>(slackMs, UINT32_MAX)),
+                     std::move(callback));
+}
+
+uint64_t TimerManager::_addTimer(uint64_t deadline, uint32_t interval, uint32_t leeway, Callback&& callback)
+{
+    if (mStopped)
+    {
+        return kInvalidTimerId;
+    }
+
+    // 第一次使用时启动定时器线程
+    if (!mThread.joinable())
+    {
+        mThread = std::thread(&TimerManager::_run, this);
+    }
+
+    auto  index     = _allocNode();
+    auto& node      = mNodes[index];
+    node.mDeadline  = deadline;
+    node.mInterval  = interval;
+    node.mLeeway    = leeway;
+    node.mExpire    = _applyLeeway(deadline, leeway);
+    node.mCallback  = std::make_shared<Callback>(std::move(callback));
+    _insert(index);
+    mTimerCount++;
+
+    const uint64_t timerId = (static_cast<uint64_t>(node.mGeneration) << 32) | static_cast<uint32_t>(index);
+
+    // 比定时器线程计划唤醒时间更早，需要唤醒重新计算
+    if (_nextExpireTick() < mWakeTick)
+    {
+        mCond.notify_one();
+    }
+    return timerId;
+}
+
+bool TimerManager::cancelTimer(uint64_t timerId)
+{
+    if (timerId == kInvalidTimerId)
+    {
+        return false;
+    }
+
+    const auto index      = static_cast<int32_t>(timerId & 0xFFFFFFFFULL);
+    const auto generation = static_cast<uint32_t>(timerId >> 32);
+
+    // 回调在锁外释放， 避免捕获对象析构时重入定时器
+    CallbackPtr released;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (index < 0 || index >= static_cast<int32_t>(mNodes.size()))
+        {
+            return false;
+        }
+
+        auto& node = mNodes[index];
+        if (node.mList == NL_Free || node.mGeneration != generation)
+        {
+            return false;
+        }
+
+        released = std::move(node.mCallback);
+        _unlink(index);
+        _freeNode(index);
+        mTimerCount--;
+    }
+    return true;
+}
+
+size_t TimerManager::timerCount()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mTimerCount;
+}
+
+uint64_t TimerManager::wakeupCount()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mWakeupCount;
+}
+
+static thread_local bool sIsTimerThread = false;
+
+bool TimerManager::isTimerThread()
+{
+    return sIsTimerThread;
+}
+
+void TimerManager::_run()
+{
+    LOGD("[TASK]TimerManager::run");
+    sIsTimerThread = true;
+    std::vector<CallbackPtr> firing;
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (!mStopped)
+    {
+        mWakeTick = 0;  // 处理中， 新增定时器无需唤醒
+        _advance(_nowTick());
+
+        if (!mExpired.empty())
+        {
+            mWakeupCount++;
+            // 回调只做投递， 在锁外执行
+            firing.swap(mExpired);
+            lock.unlock();
+            for (auto& callback : firing)
+            {
+                if (callback && *callback)
+                {
+                    (*callback)();
+                }
+            }
+            firing.clear();
+            lock.lock();
+            continue;
+        }
+
+        mWakeTick = _nextExpireTick();
+        if (mWakeTick == UINT64_MAX)
+        {
+            mCond.wait(lock);
+        }
+        else
+        {
+            mCond.wait_until(lock, mStartTime + std::chrono::milliseconds(mWakeTick));
+        }
+    }
+    LOGD("[TASK]TimerManager::run exit");
+}
+
+uint64_t TimerManager::_nowTick() const
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - mStartTime).count());
+}
+
+uint64_t TimerManager::_expireTick(std::chrono::milliseconds delay) const
+{
+    // 向上取整， 保证不会提前触发
+    const auto expire = std::chrono::steady_clock::now() - mStartTime + delay;
+    const auto tick   = std::chrono::duration_cast<std::chrono::milliseconds>(expire);
+    return static_cast<uint64_t>(tick.count()) + (tick < expire ? 1 : 0);
+}
+
+uint64_t TimerManager::_applyLeeway(uint64_t deadline, uint32_t leeway) const
+{
+    if (leeway == 0)
+    {
+        return deadline;
+    }
+
+    const uint64_t limit = deadline + leeway;
+
+    // 窗口在第0层范围内时， 优先合并到窗口内已有定时器的tick
+    if (deadline > mCurrentTick && (limit >> kSlotBits) == (mCurrentTick >> kSlotBits))
+    {
+        const uint32_t first  = static_cast<uint32_t>(deadline) & kSlotMask;
+        const uint32_t last   = static_cast<uint32_t>(limit) & kSlotMask;
+        const uint64_t window = (last == 63 ? ~0ULL : ((1ULL << (last + 1)) - 1)) & (~0ULL << first);
+        const uint64_t used   = mBitmap[0] & window;
+        if (used != 0)
+        {
+            return (limit & ~static_cast<uint64_t>(kSlotMask)) + static_cast<uint64_t>(__builtin_ctzll(used));
+        }
+    }
+
+    // 否则对齐到窗口内低位0最多的tick (与linux timer slack相同)， 不同定时器容易落到同一tick
+    const uint64_t diff = deadline ^ limit;
+    const uint64_t mask = (1ULL << (63 - __builtin_clzll(diff))) - 1;
+    return limit & ~mask;
+}
+
+uint64_t TimerManager::_nextExpireTick() const
+{
+    if (mDue != kNil)
+    {
+        return mCurrentTick;
+    }
+
+    // 低层的定时器一定早于高层， 找到第一个非空槽位即可
+    for (uint32_t level = 0; level < kLevelCount; ++level)
+    {
+        const uint32_t shift = kSlotBits * level;
+        const uint32_t index = static_cast<uint32_t>(mCurrentTick >> shift) & kSlotMask;
+        const uint64_t above = bitsAbove(mBitmap[level], index);
+        if (above != 0)
+        {
+            // 第0层为到期时间， 其他层为该槽位需要下沉的时间
+            const uint32_t slot = static_cast<uint32_t>(__builtin_ctzll(above));
+            const uint64_t base = (mCurrentTick >> (shift + kSlotBits)) << (shift + kSlotBits);
+            return base + (static_cast<uint64_t>(slot) << shift);
+        }
+    }
+
+    if (mOverflow != kNil)
+    {
+        const uint32_t shift = kSlotBits * kLevelCount;
+        return ((mCurrentTick >> shift) + 1) << shift;
+    }
+    return UINT64_MAX;
+}
+
+void TimerManager::_advance(uint64_t now)
+{
+    // 直接跳到下一个有定时器的tick， 中间的空槽位不需要逐个处理
+    while (true)
+    {
+        const auto next = _nextExpireTick();
+        if (next == UINT64_MAX || next > now)
+        {
+            break;
+        }
+
+        if (next > mCurrentTick)
+        {
+            mCurrentTick = next;
+        }
+        _cascade();
+
+        const auto slot = static_cast<uint32_t>(mCurrentTick) & kSlotMask;
+        mBitmap[0] &= ~(1ULL << slot);
+        _collect(mWheel[0][slot], now);
+        _collect(mDue, now);
+    }
+
+    if (now > mCurrentTick)
+    {
+        mCurrentTick = now;
+    }
+}
+
+void TimerManager::_cascade()
+{
+    auto reinsert = [this](int32_t& head) {
+        auto index = head;
+        head       = kNil;
+        while (index != kNil)
+        {
+            auto next                = mNodes[index].mNext;
+            mNodes[index].mPrev      = kNil;
+            mNodes[index].mNext      = kNil;
+            _insert(index);
+            index = next;
+        }
+    };
+
+    // 从高到低， 上层下沉的定时器可以继续下沉
+    const uint32_t overflowShift = kSlotBits * kLevelCount;
+    if ((mCurrentTick & ((1ULL << overflowShift) - 1)) == 0 && mOverflow != kNil)
+    {
+        reinsert(mOverflow);
+    }
+
+    for (uint32_t level = kLevelCount - 1; level > 0; --level)
+    {
+        const uint32_t shift = kSlotBits * level;
+        if ((mCurrentTick & ((1ULL << shift) - 1)) != 0)
+        {
+            continue;
+        }
+
+        const uint32_t slot = static_cast<uint32_t>(mCurrentTick >> shift) & kSlotMask;
+        if (mWheel[level][slot] != kNil)
+        {
+            mBitmap[level] &= ~(1ULL << slot);
+            reinsert(mWheel[level][slot]);
+        }
+    }
+}
+
+void TimerManager::_collect(int32_t& head, uint64_t now)
+{
+    auto index = head;
+    head       = kNil;
+    while (index != kNil)
+    {
+        auto& node = mNodes[index];
+        auto  next = node.mNext;
+        if (node.mInterval == 0)
+        {
+            mExpired.push_back(std::move(node.mCallback));
+            _freeNode(index);
+            mTimerCount--;
+        }
+        else
+        {
+            mExpired.push_back(node.mCallback);
+
+            // 下一次到期时间按原始时间表计算， 错过的周期直接跳过
+            auto deadline = node.mDeadline + node.mInterval;
+            if (deadline <= now)
+            {
+                deadline += ((now - deadline) / node.mInterval + 1) * node.mInterval;
+            }
+            node.mDeadline = deadline;
+            node.mExpire   = _applyLeeway(deadline, node.mLeeway);
+            node.mPrev     = kNil;
+            node.mNext     = kNil;
+            _insert(index);
+        }
+        index = next;
+    }
+}
+
+int32_t TimerManager::_allocNode()
+{
+    if (mFreeList != kNil)
+    {
+        auto index = mFreeList;
+        mFreeList  = mNodes[index].mNext;
+        mNodes[index].mNext = kNil;
+        return index;
+    }
+
+    mNodes.emplace_back();
+    return static_cast<int32_t>(mNodes.size() - 1);
+}
+
+void TimerManager::_freeNode(int32_t index)
+{
+    auto& node     = mNodes[index];
+    node.mCallback = nullptr;
+    node.mList     = NL_Free;
+    node.mPrev     = kNil;
+    // 代数递增， 旧的定时器ID失效 (跳过0， 保证ID不为kInvalidTimerId)
+    if (++node.mGeneration == 0)
+    {
+        node.mGeneration = 1;
+    }
+    node.mNext = mFreeList;
+    mFreeList  = index;
+}
+
+int32_t& TimerManager::_listHead(int8_t list, uint8_t slot)
+{
+    if (list == NL_Overflow)
+    {
+        return mOverflow;
+    }
+    if (list == NL_Due)
+    {
+        return mDue;
+    }
+    assert(list >= 0 && list < static_cast<int8_t>(kLevelCount));
+    return mWheel[list][slot];
+}
+
+void TimerManager::_pushFront(int32_t& head, int32_t index)
+{
+    auto& node = mNodes[index];
+    node.mPrev = kNil;
+    node.mNext = head;
+    if (head != kNil)
+    {
+        mNodes[head].mPrev = index;
+    }
+    head = index;
+}
+
+void TimerManager::_insert(int32_t index)
+{
+    auto&          node   = mNodes[index];
+    const uint64_t expire = node.mExpire;
+    if (expire <= mCurrentTick)
+    {
+        node.mList = NL_Due;
+        _pushFront(mDue, index);
+        return;
+    }
+
+    // 与当前tick高位相同的最低一层
+    for (uint32_t level = 0; level < kLevelCount; ++level)
+    {
+        const uint32_t upperShift = kSlotBits * (level + 1);
+        if ((expire >> upperShift) == (mCurrentTick >> upperShift))
+        {
+            const auto slot = static_cast<uint8_t>((expire >> (kSlotBits * level)) & kSlotMask);
+            node.mList      = static_cast<int8_t>(level);
+            node.mSlot      = slot;
+            _pushFront(mWheel[level][slot], index);
+            mBitmap[level] |= (1ULL << slot);
+            return;
+        }
+    }
+
+    node.mList = NL_Overflow;
+    _pushFront(mOverflow, index);
+}
+
+void TimerManager::_unlink(int32_t index)
+{
+    auto&    node = mNodes[index];
+    int32_t& head = _listHead(node.mList, node.mSlot);
+    if (node.mPrev != kNil)
+    {
+        mNodes[node.mPrev].mNext = node.mNext;
+    }
+    else
+    {
+        head = node.mNext;
+    }
+
+    if (node.mNext != kNil)
+    {
+        mNodes[node.mNext].mPrev = node.mPrev;
+    }
+
+    if (node.mList >= 0 && node.mList < static_cast<int8_t>(kLevelCount) && head == kNil)
+    {
+        mBitmap[node.mList] &= ~(1ULL << node.mSlot);
+    }
+    node.mPrev = kNil;
+    node.mNext = kNil;
+}
+
+}  // namespace task
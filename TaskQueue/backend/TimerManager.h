@@ -0,0 +1,129 @@
+// 定时器管理
+// 独立定时器线程 + 分层时间轮， 到期后回调 (回调中只做投递， 不执行耗时操作)
+// 时间轮： 4层， 每层64个槽， tick为1ms， 覆盖约4.6小时， 超出部分放入溢出链表
+// 插入/取消均为O(1)， 定时器节点复用， 定时器ID = 代数(高32位) + 节点下标(低32位)
+// 周期定时器按原始时间表计算下一次到期时间(不累计漂移)， leeway内对齐到相同tick， 合并唤醒
+#ifndef __TIMER_MANAGER_H__
+#define __TIMER_MANAGER_H__
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/HESingleton.h"
+
+namespace task
+{
+class TimerManager : public task::HESingleton<TimerManager>
+{
+    friend class task::HESingleton<TimerManager>;
+
+public:
+    using Callback = std::function<void()>;
+
+    static constexpr uint64_t kInvalidTimerId = 0;
+
+public:
+    ~TimerManager();
+
+    // 添加一次性定时器， 返回定时器ID
+    uint64_t addTimer(std::chrono::milliseconds delay, Callback&& callback);
+
+    // 添加周期定时器， 返回定时器ID， 需要cancelTimer停止
+    // leeway: 允许延后触发的时间， 与其他定时器合并到同一次唤醒
+    uint64_t addPeriodicTimer(std::chrono::milliseconds interval, std::chrono::milliseconds leeway, Callback&& callback);
+
+    // 取消定时器， 已经触发或不存在返回false
+    bool cancelTimer(uint64_t timerId);
+
+    // 未触发的定时器数量 (包含周期定时器)
+    size_t timerCount();
+
+    // 定时器线程触发回调的唤醒次数
+    uint64_t wakeupCount();
+
+    // 当前是否在定时器线程 (回调中不能阻塞)
+    static bool isTimerThread();
+
+private:
+    TimerManager();
+
+    static constexpr uint32_t kSlotBits   = 6;
+    static constexpr uint32_t kSlotCount  = 1 << kSlotBits;
+    static constexpr uint32_t kSlotMask   = kSlotCount - 1;
+    static constexpr uint32_t kLevelCount = 4;
+    static constexpr int32_t  kNil        = -1;
+
+    // 定时器节点所在链表
+    enum NodeList : int8_t
+    {
+        NL_Free     = -1,
+        NL_Overflow = kLevelCount,      // 超出时间轮范围
+        NL_Due      = kLevelCount + 1,  // 已到期，等待回调
+    };
+
+    using CallbackPtr = std::shared_ptr<Callback>;
+
+    struct TimerNode
+    {
+        uint64_t    mExpire{ 0 };    // 实际触发tick (deadline + leeway内对齐)
+        uint64_t    mDeadline{ 0 };  // 原始时间表上的到期tick
+        uint32_t    mInterval{ 0 };  // 周期， 0为一次性定时器
+        uint32_t    mLeeway{ 0 };
+        CallbackPtr mCallback{ nullptr };  // 周期定时器每次触发共享同一个回调
+        uint32_t mGeneration{ 1 };  // 节点复用代数， 防止取消到已复用的节点
+        int32_t  mPrev{ kNil };
+        int32_t  mNext{ kNil };
+        int8_t   mList{ NL_Free };  // 所在层级(0 ~ kLevelCount-1) 或 NodeList
+        uint8_t  mSlot{ 0 };
+    };
+
+    void _run();
+
+    uint64_t _addTimer(uint64_t deadline, uint32_t interval, uint32_t leeway, Callback&& callback);
+    uint64_t _applyLeeway(uint64_t deadline, uint32_t leeway) const;  // [deadline, deadline + leeway]内选择触发tick
+
+    uint64_t _nowTick() const;
+    uint64_t _expireTick(std::chrono::milliseconds delay) const;
+    uint64_t _nextExpireTick() const;  // 下一次需要处理的tick， 没有定时器返回UINT64_MAX
+    void     _advance(uint64_t now);   // 推进时间轮到now， 到期回调放入mExpired
+    void     _cascade();               // 当前tick跨越上层边界时， 将上层槽位重新分配到下层
+    void     _collect(int32_t& head, uint64_t now);  // 回收链表中的所有节点， 回调放入mExpired， 周期定时器重新插入
+
+    int32_t _allocNode();
+    void    _freeNode(int32_t index);
+    void    _insert(int32_t index);
+    void    _unlink(int32_t index);
+    void    _pushFront(int32_t& head, int32_t index);
+    int32_t& _listHead(int8_t list, uint8_t slot);
+
+private:
+    std::mutex              mMutex;
+    std::condition_variable mCond;
+    std::thread             mThread;
+    bool                    mStopped{ false };
+
+    const std::chrono::steady_clock::time_point mStartTime;  // tick 0 对应的时间
+    uint64_t                                    mCurrentTick{ 0 };
+    uint64_t                                    mWakeTick{ UINT64_MAX };  // 定时器线程计划唤醒的tick
+
+    std::array<std::array<int32_t, kSlotCount>, kLevelCount> mWheel;
+    std::array<uint64_t, kLevelCount>                        mBitmap{};  // 非空槽位标记， 快速查找下一个到期槽
+    int32_t                                                  mOverflow{ kNil };
+    int32_t                                                  mDue{ kNil };
+
+    std::vector<TimerNode> mNodes;
+    int32_t                mFreeList{ kNil };
+    size_t                   mTimerCount{ 0 };
+    uint64_t                 mWakeupCount{ 0 };
+    std::vector<CallbackPtr> mExpired;  // 到期回调， 在锁外执行
+};
+
+}  // namespace task
+
+#endif  // __TIMER_MANAGER_H__
@@ -0,0 +1,356 @@
+#include "UringFileIoImpl.h"
+#include "QueueCapacity.h"
+#include "common/LogHelper.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define TASK_HAS_IO_URING 1
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace task
+{
+#if defined(TASK_HAS_IO_URING)
+static constexpr uint64_t kWakeTag  = 0;           // 唤醒请求的 user_data (用户请求为 Request 指针)
+static constexpr size_t   kMaxIoLen = 0x7ffff000;  // 单次读写上限， 与 read/write 系统调用一致
+
+static inline int uringSetup(unsigned entries, io_uring_params* params)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+static inline int uringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+static inline int uringRegister(int fd, unsigned opcode, void* arg, unsigned count)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+#endif
+
+UringFileIoImpl::UringFileIoImpl()
+{
+    if (!_setup())
+    {
+        _teardown();
+        return;
+    }
+    mThread = std::thread(&UringFileIoImpl::_run, this);
+}
+
+UringFileIoImpl::~UringFileIoImpl()
+{
+    if (!mThread.joinable())
+    {
+        _teardown();
+        return;
+    }
+
+    // 执行完已提交的请求后退出
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopped = true;
+    }
+#if defined(TASK_HAS_IO_URING)
+    uint64_t value = 1;
+    (void)::write(mWakeFd, &value, sizeof(value));
+#endif
+    mThread.join();
+    _teardown();
+}
+
+bool UringFileIoImpl::submit(RequestPtr&& request)
+{
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mStopped || !isReady())
+        {
+            return false;
+        }
+        mPending.push_back(std::move(request));
+        mSubmitted.fetch_add(1, std::memory_order_relaxed);
+        wake      = mSleeping;
+        mSleeping = false;
+    }
+
+#if defined(TASK_HAS_IO_URING)
+    if (wake)
+    {
+        uint64_t value = 1;
+        (void)::write(mWakeFd, &value, sizeof(value));
+    }
+#endif
+    return true;
+}
+
+bool UringFileIoImpl::_setup()
+{
+#if defined(TASK_HAS_IO_URING)
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    mRingFd = uringSetup(kQueueDepth, &params);
+    if (mRingFd < 0)
+    {
+        LOGE("[TASK]UringFileIoImpl::_setup io_uring_setup failed, errno: %d", errno);
+        return false;
+    }
+
+    // 确认读/写/fsync 操作可用 (IORING_OP_READ/WRITE 需要 5.6 以上内核)
+    const size_t probeSize = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+    auto         probe     = static_cast<io_uring_probe*>(calloc(1, probeSize));
+    bool         supported = probe != nullptr && uringRegister(mRingFd, IORING_REGISTER_PROBE, probe, 256) == 0;
+    for (auto op : { IORING_OP_READ, IORING_OP_WRITE, IORING_OP_FSYNC })
+    {
+        supported = supported && probe->last_op >= op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED) != 0;
+    }
+    free(probe);
+    if (!supported)
+    {
+        LOGE("[TASK]UringFileIoImpl::_setup io_uring read/write/fsync not supported");
+        return false;
+    }
+
+    mSqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        mSqRingSize = mCqRingSize = std::max(mSqRingSize, mCqRingSize);
+    }
+
+    mSqRing = ::mmap(nullptr, mSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd, IORING_OFF_SQ_RING);
+    if (mSqRing == MAP_FAILED)
+    {
+        mSqRing = nullptr;
+        LOGE("[TASK]UringFileIoImpl::_setup mmap sq ring failed, errno: %d", errno);
+        return false;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        mCqRing = mSqRing;
+    }
+    else
+    {
+        mCqRing = ::mmap(nullptr, mCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd, IORING_OFF_CQ_RING);
+        if (mCqRing == MAP_FAILED)
+        {
+            mCqRing = nullptr;
+            LOGE("[TASK]UringFileIoImpl::_setup mmap cq ring failed, errno: %d", errno);
+            return false;
+        }
+    }
+
+    mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    auto sqes = ::mmap(nullptr, mSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+    {
+        LOGE("[TASK]UringFileIoImpl::_setup mmap sqes failed, errno: %d", errno);
+        return false;
+    }
+    mSqes = static_cast<io_uring_sqe*>(sqes);
+
+    auto sq    = static_cast<char*>(mSqRing);
+    auto cq    = static_cast<char*>(mCqRing);
+    mSqHead    = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    mSqTail    = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    mSqMask    = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    mSqEntries = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+    mSqArray   = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    mCqHead    = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    mCqTail    = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    mCqMask    = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    mCqes      = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    // 阻塞的 eventfd： 非阻塞 fd 上的读取会直接以 EAGAIN 完成， 不会等待
+    mWakeFd = ::eventfd(0, EFD_CLOEXEC);
+    if (mWakeFd < 0)
+    {
+        LOGE("[TASK]UringFileIoImpl::_setup eventfd failed, errno: %d", errno);
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void UringFileIoImpl::_teardown()
+{
+#if defined(TASK_HAS_IO_URING)
+    if (mSqes != nullptr)
+    {
+        ::munmap(mSqes, mSqesSize);
+        mSqes = nullptr;
+    }
+    if (mCqRing != nullptr && mCqRing != mSqRing)
+    {
+        ::munmap(mCqRing, mCqRingSize);
+    }
+    mCqRing = nullptr;
+    if (mSqRing != nullptr)
+    {
+        ::munmap(mSqRing, mSqRingSize);
+        mSqRing = nullptr;
+    }
+    if (mWakeFd >= 0)
+    {
+        ::close(mWakeFd);
+        mWakeFd = -1;
+    }
+    if (mRingFd >= 0)
+    {
+        ::close(mRingFd);
+        mRingFd = -1;
+    }
+#endif
+}
+
+void UringFileIoImpl::_run()
+{
+#if defined(TASK_HAS_IO_URING)
+    LOGD("[TASK]UringFileIoImpl::run");
+    QueueCapacity::markIoThread();
+    std::deque<RequestPtr> backlog;  // 超出队列深度或提交队列已满， 等待下一轮提交
+    size_t                 inFlight  = 0;
+    bool                   wakeArmed = false;
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (auto& request : mPending)
+            {
+                backlog.push_back(std::move(request));
+            }
+            mPending.clear();
+            if (mStopped && backlog.empty() && inFlight == 0)
+            {
+                break;
+            }
+        }
+
+        if (!wakeArmed)
+        {
+            wakeArmed = _push(nullptr);
+        }
+        size_t batch = 0;
+        while (!backlog.empty() && inFlight < kQueueDepth && _push(backlog.front().get()))
+        {
+            // 完成前由内核的 user_data 持有请求
+            backlog.front().release();
+            backlog.pop_front();
+            inFlight++;
+            batch++;
+        }
+        if (batch > 0)
+        {
+            mBatches.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // 没有新请求时在内核中等待至少一个完成事件 (包括唤醒)
+        bool wait = false;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            wait      = mPending.empty();
+            mSleeping = wait;
+        }
+
+        const unsigned toSubmit = *mSqTail - __atomic_load_n(mSqHead, __ATOMIC_ACQUIRE);
+        if (uringEnter(mRingFd, toSubmit, wait ? 1 : 0, wait ? IORING_ENTER_GETEVENTS : 0) < 0 && errno != EINTR
+            && errno != EAGAIN && errno != EBUSY)
+        {
+            LOGE("[TASK]UringFileIoImpl::_run io_uring_enter failed, errno: %d", errno);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mSleeping = false;
+        }
+        inFlight -= _reap(wakeArmed);
+    }
+#endif
+}
+
+bool UringFileIoImpl::_push(const Request* request)
+{
+#if defined(TASK_HAS_IO_URING)
+    const unsigned tail = *mSqTail;
+    if (tail - __atomic_load_n(mSqHead, __ATOMIC_ACQUIRE) >= mSqEntries)
+    {
+        return false;
+    }
+
+    const unsigned index = tail & mSqMask;
+    auto           sqe   = &mSqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    if (request == nullptr)
+    {
+        sqe->opcode    = IORING_OP_READ;
+        sqe->fd        = mWakeFd;
+        sqe->addr      = reinterpret_cast<uint64_t>(&mWakeValue);
+        sqe->len       = sizeof(mWakeValue);
+        sqe->user_data = kWakeTag;
+    }
+    else
+    {
+        switch (request->mOp)
+        {
+            case FO_Read:
+            case FO_Write:
+                sqe->opcode = request->mOp == FO_Read ? IORING_OP_READ : IORING_OP_WRITE;
+                sqe->addr   = reinterpret_cast<uint64_t>(request->mBuf);
+                sqe->len    = static_cast<uint32_t>(std::min(request->mLen, kMaxIoLen));
+                sqe->off    = request->mOffset;
+                break;
+            case FO_Fsync:
+            case FO_Fdatasync:
+                sqe->opcode      = IORING_OP_FSYNC;
+                sqe->fsync_flags = request->mOp == FO_Fdatasync ? IORING_FSYNC_DATASYNC : 0;
+                break;
+        }
+        sqe->fd        = request->mFd;
+        sqe->user_data = reinterpret_cast<uint64_t>(request);
+    }
+
+    mSqArray[index] = index;
+    __atomic_store_n(mSqTail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t UringFileIoImpl::_reap(bool& wakeArmed)
+{
+    size_t completed = 0;
+#if defined(TASK_HAS_IO_URING)
+    unsigned       head = *mCqHead;
+    const unsigned tail = __atomic_load_n(mCqTail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head)
+    {
+        const auto& cqe = mCqes[head & mCqMask];
+        if (cqe.user_data == kWakeTag)
+        {
+            wakeArmed = false;
+            continue;
+        }
+
+        RequestPtr request(reinterpret_cast<Request*>(cqe.user_data));
+        _complete(std::move(request), cqe.res);
+        completed++;
+    }
+    __atomic_store_n(mCqHead, head, __ATOMIC_RELEASE);
+#endif
+    return completed;
+}
+
+}  // namespace task
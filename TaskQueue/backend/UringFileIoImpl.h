@@ -0,0 +1,81 @@
+#ifndef __URING_FILE_IO_IMPL_H__
+#define __URING_FILE_IO_IMPL_H__
+
+#include "IFileIoImpl.h"
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+namespace task
+{
+// io_uring 异步文件IO (直接使用系统调用， 不依赖 liburing)
+// 提交线程只把请求放入待提交列表； 一个IO线程把积累的请求一次写入提交队列， 一次 io_uring_enter 批量提交并等待完成
+// IO线程在内核中等待时， 新请求通过 eventfd 唤醒 (提交队列中常驻一个读取 eventfd 的请求)
+// 同时在内核中的请求不超过 kQueueDepth， 超出部分留在待提交列表
+class UringFileIoImpl : public IFileIoImpl
+{
+public:
+    UringFileIoImpl();
+    ~UringFileIoImpl();
+
+    // io_uring 可用 (内核支持且读/写/fsync 操作都可用)
+    bool isReady() const
+    {
+        return mRingFd >= 0;
+    }
+
+    virtual bool submit(RequestPtr&& request) override;
+
+    virtual TaskFileIoBackend backend() const override
+    {
+        return TaskFileIoBackend::TFB_IoUring;
+    }
+
+private:
+    static constexpr uint32_t kQueueDepth = 256;
+
+    bool _setup();
+    void _teardown();
+    void _run();
+
+    // 写入一个提交项， 提交队列已满返回false 【IO线程】
+    bool _push(const Request* request);
+    // 收割完成事件， 返回完成的用户请求数 【IO线程】
+    size_t _reap(bool& wakeArmed);
+
+private:
+    int           mRingFd{ -1 };
+    int           mWakeFd{ -1 };
+    uint64_t      mWakeValue{ 0 };  // eventfd 读取缓冲区， 由内核写入
+
+    void*         mSqRing{ nullptr };
+    size_t        mSqRingSize{ 0 };
+    void*         mCqRing{ nullptr };
+    size_t        mCqRingSize{ 0 };
+    io_uring_sqe* mSqes{ nullptr };
+    size_t        mSqesSize{ 0 };
+
+    unsigned*     mSqHead{ nullptr };
+    unsigned*     mSqTail{ nullptr };
+    unsigned      mSqMask{ 0 };
+    unsigned      mSqEntries{ 0 };
+    unsigned*     mSqArray{ nullptr };
+    unsigned*     mCqHead{ nullptr };
+    unsigned*     mCqTail{ nullptr };
+    unsigned      mCqMask{ 0 };
+    io_uring_cqe* mCqes{ nullptr };
+
+    std::mutex              mMutex;
+    std::vector<RequestPtr> mPending;
+    bool                    mSleeping{ false };  // IO线程在内核中等待， 新请求需要唤醒
+    bool                    mStopped{ false };
+    std::thread             mThread;
+};
+
+}  // namespace task
+
+#endif  // __URING_FILE_IO_IMPL_H__
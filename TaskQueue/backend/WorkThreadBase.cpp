@@ -5,6 +5,9 @@
 #include <pthread.h>
 #include "common/HETimerHelper.h"
 #include "TaskQueueConstant.h"
+#include "QueueStat.h"
+#include "TaskCategoryRegistry.h"
+#include "common/ThreadStack.h"
 namespace task
 {
 int32_t WorkThreadBase::sId()
@@ -50,14 +53,14 @@ void WorkThreadBase::_changePriority()
             pri = -19;
             break;
         default:
-            LOGE("[TASK][HY]unknown thread priority");
+            LOGW("[TASK][HY]unknown thread priority");
     }
     // int nice(int inc);  //  adds inc to the nice value for the calling thread
     int old = nice(0);
     int ret = nice(pri - old);
     if (-1 == ret)
     {
-        LOGE("[TASK][HY]failed to set nice(%d), pri", ret);
+        LOGW("[TASK][HY]failed to set nice(%d), pri", ret);
     }
 #else
     int                max  = sched_get_priority_max(SCHED_FIFO);
@@ -79,7 +82,7 @@ void WorkThreadBase::_changePriority()
     int error = pthread_setschedparam(mThread.native_handle(), SCHED_FIFO, &sp);
     if (error != 0)
     {
-        LOGE("[TASK][HY]failed to set thread priority error: %d", error);
+        LOGW("[TASK][HY]failed to set thread priority error: %d", error);
     }
 #endif
 
@@ -95,46 +98,83 @@ std::shared_ptr<IThreadPool> WorkThreadBase::_getThreadPool()
     return nullptr;
 }
 
-void WorkThreadBase::_updateStat(const TaskOperatorPtr& op)
+static thread_local WorkThreadBase* sCurrentWorkThread = nullptr;
+// 线程池在工作线程上析构时， 由线程退出时释放本线程对象 (不能在执行中析构自身)
+static thread_local std::shared_ptr<WorkThreadBase> sRetainedWorkThread;
+
+void WorkThreadBase::retainIfCurrent(const std::shared_ptr<WorkThreadBase>& thread)
 {
-    //收集统计信息
-    std::lock_guard<std::mutex> lock(mStatMutex);
-    auto                        timDif = task::HETimerHelper::currentTimeMillis() - mTaskStat.mLastStatTime;
-    if (timDif > TaskQueueConstant::sOneMinuteMillisCount)
+    if (thread && thread.get() == sCurrentWorkThread)
     {
-        mTaskStat               = TaskStat{};
-        mTaskStat.mLastStatTime = task::HETimerHelper::currentTimeMillis();
+        sRetainedWorkThread = thread;
     }
-    mTaskStat.mTaskCount++;
-    mTaskStat.mAvgDuration += static_cast<int32_t>(op->taskRunDuration());
-    mTaskStat.mPeakDuration = std::max(mTaskStat.mPeakDuration, static_cast<int32_t>(op->taskRunDuration()));
-    mTaskStat.mAvgWaitDuration += static_cast<int32_t>(op->taskWaitDuration());
-    mTaskStat.mPeakWaitDuration = std::max(mTaskStat.mPeakWaitDuration, static_cast<int32_t>(op->taskWaitDuration()));
 }
 
-std::string WorkThreadBase::_statInfo()
+WorkThreadBase* WorkThreadBase::current()
+{
+    return sCurrentWorkThread;
+}
+
+void WorkThreadBase::_bindCurrent()
 {
-    std::lock_guard<std::mutex> lock(mStatMutex);
-    std::string                 info = "tname: "
-                       + mName
-                       + " stat: avgR:"
-                       + (mTaskStat.mTaskCount == 0 ? "0" : std::to_string(mTaskStat.mAvgDuration / mTaskStat.mTaskCount))
-                       + " peakR:"
-                       + std::to_string(mTaskStat.mPeakDuration)
-                       + " avgW:"
-                       + (mTaskStat.mTaskCount == 0 ? "0" : std::to_string(mTaskStat.mAvgWaitDuration / mTaskStat.mTaskCount))
-                       + " peakW:"
-                       + std::to_string(mTaskStat.mPeakWaitDuration);
-
-    if (mCurrTask != nullptr)
+    sCurrentWorkThread = this;
+}
+
+void WorkThreadBase::recordTask(const TaskOperatorPtr& op)
+{
+    if (op == nullptr)
     {
-        auto currTask = std::atomic_load(&mCurrTask);
-        if(currTask != nullptr)
+        return;
+    }
+
+    // 未执行的任务 (已取消 或 内部转发任务) 不计入耗时统计， 已取消的任务计入队列取消数
+    if (!op->hasRunRecord())
+    {
+        if (op->queueStat() && op->isCancelled())
         {
-            info += " tskInf:" + currTask->taskCostInfo();
+            op->queueStat()->recordCancel();
         }
+        return;
+    }
+
+    mRunLatency.record(op->taskRunDurationMicros());
+    mWaitLatency.record(op->taskWaitDurationMicros());
+
+    const auto& queueStat = op->queueStat();
+    if (queueStat)
+    {
+        queueStat->record(*op);
+    }
+
+    if (op->category() != kNoTaskCategory && TaskCategoryRegistry::isAlive())
+    {
+        TaskCategoryRegistry::GetInstance().record(*op);
     }
-    return info;
+}
+
+void WorkThreadBase::collectLatency(LatencyHistogram::Snapshot& run, LatencyHistogram::Snapshot& wait) const
+{
+    mRunLatency.snapshot(run);
+    mWaitLatency.snapshot(wait);
+}
+
+void WorkThreadBase::captureStack(TaskDurationExceedEvent& event)
+{
+    event.mStackDepth = static_cast<uint32_t>(ThreadStack::capture(mThread.native_handle(), event.mStack, kReportStackDepth));
+}
+
+void WorkThreadBase::_fillStatEvent(TaskDurationExceedEvent& event)
+{
+    LatencyHistogram::Snapshot run;
+    LatencyHistogram::Snapshot wait;
+    collectLatency(run, wait);
+
+    event.mThreadId     = threadId();
+    event.mTaskCount    = run.mCount;
+    event.mRunP99Micros = run.percentile(99.0);
+    TaskQueueReporter::copyName(event.mThreadName, mName);
+
+    event.mTaskId = mCurrTaskId.load(std::memory_order_relaxed);
 }
 
 }  // namespace task
\ No newline at end of file
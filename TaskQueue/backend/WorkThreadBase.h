@@ -7,9 +7,13 @@
 #include <string>
 #include <thread>
 #include <memory>
+#include <vector>
 #include "QueueDefine.h"
 #include "IThreadPool.h"
 #include "TaskOperator.h"
+#include "common/LatencyHistogram.h"
+#include "TaskQueueTracer.h"
+#include "TaskQueueReporter.h"
 namespace task
 {
 class WorkThreadBase : public std::enable_shared_from_this<WorkThreadBase>
@@ -67,25 +71,92 @@ public:
     virtual void setActive(bool /*active*/){};
 
     // 提交任务
-    virtual bool commit(const TaskOperatorPtr& /*task*/)
+    virtual TaskSubmitResult commit(const TaskOperatorPtr& /*task*/)
     {
-        return false;
+        return TaskSubmitResult::TSR_Rejected;
     };
-    virtual bool commit(TaskOperatorPtr&& /*task*/) noexcept
+    virtual TaskSubmitResult commit(TaskOperatorPtr&& /*task*/) noexcept
     {
-        return false;
+        return TaskSubmitResult::TSR_Rejected;
     };
+    // 批量提交， 默认逐个提交
+    virtual void commitBulk(std::vector<TaskOperatorPtr>& tasks)
+    {
+        for (auto& task : tasks)
+        {
+            commit(task);
+        }
+    }
+
+    // 排队中的任务数
+    virtual size_t pendingCount() const
+    {
+        return 0;
+    }
+    // 取出排队中的任务 (线程池关闭时)
+    virtual void takePending(std::vector<TaskOperatorPtr>& /*tasks*/) {}
+    // 唤醒等待中的线程 (退出时)
+    virtual void wake() {}
+
+    // 任务队列容量限制
+    virtual void             setCapacity(const TaskCapacity& /*capacity*/) {}
+    virtual TaskOverflowStat overflowStat() const
+    {
+        return TaskOverflowStat();
+    }
+    // 预留任务队列的空位 (速率限制暂存任务前)， 被拒绝时任务已丢弃
+    virtual TaskSubmitResult reserve(const TaskOperatorPtr& /*task*/)
+    {
+        return TaskSubmitResult::TSR_Accepted;
+    }
+    // 归还未入队任务预留的空位
+    virtual void unreserve(const TaskOperatorPtr& /*task*/) {}
 
     // 线程卡顿检查
     virtual bool isBlocked() const
     {
         return false;
     };
-    virtual std::string blockedInfo()
+    virtual TaskDurationExceedEvent blockedEvent()
+    {
+        return TaskDurationExceedEvent();
+    }
+
+    // 看门狗标记卡住的线程， 同一任务只标记一次， 返回是否为首次标记
+    inline bool markBlocked()
     {
-        return "";
+        bool expected = false;
+        return mBlocked.compare_exchange_strong(expected, true, std::memory_order_acq_rel);
     }
 
+    // 抓取本线程当前的堆栈到卡顿事件 (由看门狗线程调用)
+    void captureStack(TaskDurationExceedEvent& event);
+
+    // 执行任务， 开启轨迹时记录开始/结束 (只记录经过队列入队的任务)
+    static inline void runTask(const TaskOperatorPtr& op)
+    {
+        if (TaskQueueTracer::isEnabled() && op->queueStat())
+        {
+            TaskQueueTracer::GetInstance().trace(TaskTraceEventType::TTET_Start, *op);
+            (*op)();
+            TaskQueueTracer::GetInstance().trace(TaskTraceEventType::TTET_End, *op);
+            return;
+        }
+        (*op)();
+    }
+
+    // 当前线程对应的工作线程， 非工作线程返回nullptr
+    static WorkThreadBase* current();
+
+    // 线程池析构时调用： thread为当前线程时延长到线程退出再释放
+    static void retainIfCurrent(const std::shared_ptr<WorkThreadBase>& thread);
+
+    // 记录任务耗时到当前线程与任务归属队列 (只在本线程调用)
+    void recordTask(const TaskOperatorPtr& op);
+
+    // 累加本线程的耗时分布 (任意线程读取)
+    void collectLatency(LatencyHistogram::Snapshot& run, LatencyHistogram::Snapshot& wait) const;
+
 protected:
     // 获取全局线程ID
     static int32_t sId();
@@ -94,12 +165,20 @@ protected:
     void                         _changePriority();
     std::shared_ptr<IThreadPool> _getThreadPool();
 
-    void        _updateStat(const TaskOperatorPtr& op);
-    std::string _statInfo();
+    void _bindCurrent();
+
+    // 清除卡住标记， 返回之前是否被标记 (任务开始/结束时由本线程调用)
+    inline bool _clearBlocked()
+    {
+        return mBlocked.exchange(false, std::memory_order_acq_rel);
+    }
+
+    void _fillStatEvent(TaskDurationExceedEvent& event);  // 线程名称， 当前任务， 耗时统计
 
 protected:
     int32_t            mId{ 0 };             // 线程ID
-    bool               mIsRunning{ false };  //标记是否正在run， 可以统计是否当前线程卡在了一个操作上
+    std::atomic<bool>  mIsRunning{ false };  //标记是否正在run， 可以统计是否当前线程卡在了一个操作上
+    std::atomic<bool>  mBlocked{ false };    //已被看门狗标记为卡住
     bool               mPriorityChanged{ false };
     bool               mNameChanged{ false };
     std::atomic<bool>  mIsCancelled{ false };  //是否取消
@@ -109,18 +188,10 @@ protected:
     std::thread                mThread;
     std::weak_ptr<IThreadPool> mThreadPool;  //归属线程池, 弱引用
 
-    // 统计信息
-    struct TaskStat
-    {
-        int32_t mTaskCount{ 0 };         //任务数量
-        int32_t mAvgDuration{ 0 };       //平均任务耗时
-        int32_t mPeakDuration{ 0 };      //峰值任务耗时
-        int32_t mAvgWaitDuration{ 0 };   //平均等待耗时
-        int32_t mPeakWaitDuration{ 0 };  //峰值等待耗时
-        int64_t mLastStatTime{ 0 };      //上一次统计时间（一分钟重置）
-    } mTaskStat;
-    std::mutex      mStatMutex;
-    TaskOperatorPtr mCurrTask{ nullptr };  //当前执行的任务
+    // 统计信息 (微秒)， 只由本线程写入
+    LatencyHistogram      mRunLatency;         // 执行耗时
+    LatencyHistogram      mWaitLatency;        // 队列等待耗时
+    std::atomic<uint64_t> mCurrTaskId{ 0 };    // 当前执行的任务ID， 0为空闲 (看门狗线程读取， 不持有任务)
 };
 
 }  // namespace task
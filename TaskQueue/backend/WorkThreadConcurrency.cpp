@@ -1,4 +1,5 @@
 #include "WorkThreadConcurrency.h"
+#include "IoReactor.h"
 #include "common/LogHelper.h"
 #include "TaskQueueConstant.h"
 #include "TaskOperator.h"
@@ -14,24 +15,33 @@ WorkThreadConcurrency::WorkThreadConcurrency(const std::weak_ptr<IThreadPool>& t
 {
     mThread = std::thread(&WorkThreadConcurrency::_run, this);
     mName   = "parallel_" + std::to_string(threadId());
-    LOGE("[TASK] WorkThreadConcurrency::WorkThreadConcurrency, threadId: %d", threadId());
+    LOGD("[TASK] WorkThreadConcurrency::WorkThreadConcurrency, threadId: %d", threadId());
 }
 
 WorkThreadConcurrency::~WorkThreadConcurrency()
 {
-    LOGE("[TASK]WorkThreadConcurrency::~WorkThreadConcurrency, join before threadId: %d", threadId());
+    LOGD("[TASK]WorkThreadConcurrency::~WorkThreadConcurrency, join before threadId: %d", threadId());
     cancel();
     if (mThread.joinable())
     {
-        mThread.join();
+        // 最后一个引用在本线程退出时释放， 不能join自身
+        if (mThread.get_id() == std::this_thread::get_id())
+        {
+            mThread.detach();
+        }
+        else
+        {
+            mThread.join();
+        }
     }
-    LOGE("[TASK]WorkThreadConcurrency::~WorkThreadConcurrency, join after threadId: %d", threadId());
+    LOGD("[TASK]WorkThreadConcurrency::~WorkThreadConcurrency, join after threadId: %d", threadId());
 }
 
 void WorkThreadConcurrency::_run()
 {
-    LOGE("[TASK]WorkThreadConcurrency::run, threadId: %d, name: %s", threadId(), mName.c_str());
+    LOGD("[TASK]WorkThreadConcurrency::run, threadId: %d, name: %s", threadId(), mName.c_str());
     mNativeThreadId = std::this_thread::get_id();
+    _bindCurrent();
     while (!mIsCancelled.load(std::memory_order_acquire))
     {
         _changeName();
@@ -44,18 +54,30 @@ void WorkThreadConcurrency::_run()
     }
 
     // 线程结束，从线程池中移除, 结束自己
+    // 持有自身到函数结束， 线程池在本线程释放时不会在成员访问期间析构
+    auto self = weak_from_this().lock();
     auto pool = _getThreadPool();
-    if (pool)
+    if (pool && self)
     {
-        pool->unregisterWorkThread(shared_from_this());
+        _resumeBlocked(pool->getData());
+        pool->unregisterWorkThread(self);
     }
 
-    LOGE("[TASK]WorkThreadConcurrency::run, threadId: %d, exit, name: %s\n", threadId(), mName.c_str());
+    LOGD("[TASK]WorkThreadConcurrency::run, threadId: %d, exit, name: %s\n", threadId(), mName.c_str());
 }
 
 bool WorkThreadConcurrency::_parallel()
 {
-    auto& data = _getThreadPool()->getData();
+    // 线程池析构时唤醒线程退出， 此时线程池已不可用 (等待期间不持有线程池， 只持有线程池数据)
+    std::shared_ptr<IThreadPool::Data> data;
+    {
+        auto pool = _getThreadPool();
+        if (pool == nullptr)
+        {
+            return false;
+        }
+        data = pool->getData();
+    }
     assert(data);
     if (data == nullptr)
     {
@@ -65,7 +87,7 @@ bool WorkThreadConcurrency::_parallel()
 
     // 线程处于非执行状态，线程池空闲线程+1(所有线程同步看见 memory_order_seq_cst)
     data->mIdleThreads.fetch_add(1, std::memory_order_seq_cst);
-    LOGE("[Job] WorkThreadConcurrency::_parallel 11, threadId: %d, idle: %d, threadPool is ready", threadId(), data->mIdleThreads.load());
+    LOGT("[Job] WorkThreadConcurrency::_parallel 11, threadId: %d, idle: %d, threadPool is ready", threadId(), data->mIdleThreads.load());
 
     // 整个线程池数据，第一次尝试获取信号量【无锁】
     bool flag = data->mSemaphore.tryAcquire();
@@ -74,6 +96,11 @@ bool WorkThreadConcurrency::_parallel()
         // 自旋尝试10次
         flag = data->mSemaphore.spinAcquire(TaskQueueConstant::sMaxSpinCount);
     }
+    if (!flag && IoReactor::pollIdle() > 0)
+    {
+        // 睡眠前取一次就绪的IO事件， 投递的回调任务会释放信号量， 由自身执行
+        flag = data->mSemaphore.tryAcquire();
+    }
     if (!flag)
     {
         // 等待信号量 或 超时
@@ -90,10 +117,13 @@ bool WorkThreadConcurrency::_parallel()
     }
 
     // 处理同步死锁问题， 获取当前抛任务线程，是否为自身
-    if(data->mInputThreadID == mNativeThreadId)
+    // 线程池已达到最大线程数时无法切换线程 (例如单核只有一条工作线程， 或其余线程都在执行)， 由自身继续执行
+    // 否则本线程会一直休眠重试， 直到其他线程空闲或有其他线程提交任务
+    if(data->mInputThreadID == mNativeThreadId
+       && data->mActiveThreads.load(std::memory_order_acquire) < data->mMaxThreads.load(std::memory_order_acquire))
     {
-        LOGE("[Job] WorkThreadConcurrency::_parallel, threadId: %d, threadPool is deadlock", threadId());
-        LOGE("[Job] WorkThreadConcurrency::_parallel 22, threadId: %d, idle: %d, threadPool is ready", threadId(), data->mIdleThreads.load());
+        LOGT("[Job] WorkThreadConcurrency::_parallel, threadId: %d, threadPool is deadlock", threadId());
+        LOGT("[Job] WorkThreadConcurrency::_parallel 22, threadId: %d, idle: %d, threadPool is ready", threadId(), data->mIdleThreads.load());
 
         data->mIdleThreads.fetch_sub(1, std::memory_order_seq_cst);
 
@@ -110,50 +140,103 @@ bool WorkThreadConcurrency::_parallel()
     }
 
 
-    // 从高到低优先级 进行任务执行
+    // 优先执行EDF通道中截止时间最早的任务， 再从高到低优先级 进行任务执行
+    // EDF通道中错过截止时间被丢弃的任务， 同样消耗本次信号量
     TaskOperatorPtr op;
-    for (int i = ( int )TaskQueuePriority::TQP_High; i >= 0; --i)
+    int             priority = -1;  // 出队的优先级， EDF通道为-1
+    bool            dropped  = false;
+    if (!data->mDeadlineQueue.tryPop(op, task::HETimerHelper::millisecondTimestamp64(), dropped))
     {
-        if (data->mTaskQueues[i].try_dequeue(op) && op)
+        for (int i = ( int )TaskQueuePriority::TQP_High; i >= 0; --i)
         {
-            break;
+            if (data->mTaskQueues[i].try_dequeue(op) && op)
+            {
+                priority = i;
+                break;
+            }
         }
     }
 
     // 线程结束等待，线程池空闲线程-1
     data->mIdleThreads.fetch_sub(1, std::memory_order_seq_cst);
-    LOGE("[Job] WorkThreadConcurrency::_parallel 33, threadId: %d, idle: %d, threadPool is ready", threadId(), data->mIdleThreads.load());
+    LOGT("[Job] WorkThreadConcurrency::_parallel 33, threadId: %d, idle: %d, threadPool is ready", threadId(), data->mIdleThreads.load());
     if (op)
     {
-        LOGE("[Job] WorkThreadConcurrency::_parallel getJob, threadId: %d, task: %p", threadId(), op.get());
-        mCurrTask     = op;
+        LOGT("[Job] WorkThreadConcurrency::_parallel getJob, threadId: %d, task: %p", threadId(), op.get());
+        // 唤醒因线程池已满而阻塞的提交方
+        data->mCapacity.onDequeue(op);
+        _resumeBlocked(data);
+
+        // 错过截止时间被丢弃的任务不执行， 唤醒等待方 (同步任务/任务组/任务图)
+        if (dropped)
+        {
+            QueueCapacity::discard(op);
+            return true;
+        }
+
+        // 降载期间已排队的低优先级任务同样拒绝或延后
+        if (priority == ( int )TaskQueuePriority::TQP_Low && op->queueStat() && !op->isMandatory() && data->mShedder.shedQueued()
+            && data->mShedder.isShedding())
+        {
+            data->mShedder.shed(op, mThreadPool, true);
+            return true;
+        }
+
+        mCurrTaskId.store(op->taskId(), std::memory_order_relaxed);
         mStartRunTime = task::HETimerHelper::currentTimeMillis();
         mIsRunning    = true;
         if(!op->isCancelled()){
-            (*op)();
+            runTask(op);
+        }
+        else
+        {
+            // 已取消的任务不执行， 唤醒等待方 (同步任务/任务组)
+            op->discard();
         }
         mIsRunning = false;
 
         //收集统计信息
-        _updateStat(op);
+        recordTask(op);
+
+        // 以普通/高优先级任务的排队延迟判断是否过载
+        if (priority > ( int )TaskQueuePriority::TQP_Low && op->queueStat() && op->hasRunRecord())
+        {
+            data->mShedder.onWait(op->taskWaitDurationMicros());
+        }
+        op->onRecorded();
+
+        mCurrTaskId.store(0, std::memory_order_relaxed);
+
+        // 卡住的任务已结束
+        _resumeBlocked(data);
     }
 
     return true;
 }
 
+void WorkThreadConcurrency::_resumeBlocked(const std::shared_ptr<IThreadPool::Data>& data)
+{
+    // 看门狗可能在任务结束后才完成标记， 下一个任务开始 或 线程退出时再归还
+    if (_clearBlocked() && data)
+    {
+        data->mMaxThreads.fetch_sub(1, std::memory_order_acq_rel);
+        LOGD("[TASK]WorkThreadConcurrency::_resumeBlocked, threadId: %d, max: %d", threadId(), data->mMaxThreads.load());
+    }
+}
+
 bool WorkThreadConcurrency::isBlocked() const
 {
     // 运行超过5秒，为线程卡住
     return mIsRunning && (task::HETimerHelper::currentTimeMillis() - mStartRunTime > TaskQueueConstant::sBlockTimeoutThreshold);
 }
 
-std::string WorkThreadConcurrency::blockedInfo()
+TaskDurationExceedEvent WorkThreadConcurrency::blockedEvent()
 {
-    auto msg = _statInfo() + " tid: " + std::to_string(threadId())
-               + " blockT:" + std::to_string(task::HETimerHelper::currentTimeMillis() - mStartRunTime);
-
-    LOGE("[TASK] %s \n", msg.c_str());
-    return msg;
+    TaskDurationExceedEvent event;
+    _fillStatEvent(event);
+    event.mPoolType      = TaskQueueType::TQT_Parallel;
+    event.mBlockedMillis = task::HETimerHelper::currentTimeMillis() - mStartRunTime;
+    return event;
 }
 
 }  // namespace task
@@ -20,14 +20,17 @@ public:
 
     // 线程卡顿检查
     virtual bool        isBlocked() const override;
-    virtual std::string blockedInfo() override;
+    virtual TaskDurationExceedEvent blockedEvent() override;
 
 protected:
     void _run();
     bool _parallel();
 
+    // 清除卡住标记， 归还看门狗为本线程补偿的容量
+    void _resumeBlocked(const std::shared_ptr<IThreadPool::Data>& data);
+
 private:
-    int64_t mStartRunTime{ 0 };
+    std::atomic<int64_t> mStartRunTime{ 0 };
     std::thread::id mNativeThreadId;
 };
 
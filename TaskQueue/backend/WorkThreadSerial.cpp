@@ -19,24 +19,35 @@ WorkThreadSerial::WorkThreadSerial(const std::weak_ptr<IThreadPool>& threadPool)
     : WorkThreadBase(threadPool)
 {
     mThread = std::thread(&WorkThreadSerial::_run, this);
-    LOGE("[TASK]WorkThreadSerial::WorkThreadSerial, threadId: %d", threadId());
+    LOGD("[TASK]WorkThreadSerial::WorkThreadSerial, threadId: %d", threadId());
 }
 
 WorkThreadSerial::~WorkThreadSerial()
 {
-    LOGE("[TASK]WorkThreadSerial::~WorkThreadSerial, join before threadId: %d", threadId());
+    LOGD("[TASK]WorkThreadSerial::~WorkThreadSerial, join before threadId: %d", threadId());
     cancel();
+    // 唤醒等待中的线程， 否则要等到信号量超时才能退出
+    mSemaphore.release();
     if (mThread.joinable())
     {
-        mThread.join();
+        // 最后一个引用在本线程退出时释放， 不能join自身
+        if (mThread.get_id() == std::this_thread::get_id())
+        {
+            mThread.detach();
+        }
+        else
+        {
+            mThread.join();
+        }
     }
-    LOGE("[TASK]WorkThreadSerial::~WorkThreadSerial, join after threadId: %d", threadId());
+    LOGD("[TASK]WorkThreadSerial::~WorkThreadSerial, join after threadId: %d", threadId());
 }
 
 void WorkThreadSerial::_run()
 {
     // comm::HEThreadScopeMonitor monitor(getName(), comm::HEThreadMonitor::GetInstance().getCurrentThreadId());
-    LOGE("[TASK]WorkThreadSerial::run, threadId: %d, name: %s", threadId(), mName.c_str());
+    LOGD("[TASK]WorkThreadSerial::run, threadId: %d, name: %s", threadId(), mName.c_str());
+    _bindCurrent();
     while (!mIsCancelled.load(std::memory_order_acquire))
     {
         _changeName();
@@ -47,29 +58,114 @@ void WorkThreadSerial::_run()
     }
 
     // 线程结束，从线程池中移除, 结束自己
+    // 持有自身到函数结束， 线程池在本线程释放时不会在成员访问期间析构
+    auto self = weak_from_this().lock();
     auto pool = _getThreadPool();
-    if (pool)
+    if (pool && self)
     {
-        pool->unregisterWorkThread(shared_from_this());
+        pool->unregisterWorkThread(self);
     }
 
-    LOGE("[TASK]WorkThreadSerial::run, threadId: %d, exit, name: %s\n", threadId(), mName.c_str());
+    LOGD("[TASK]WorkThreadSerial::run, threadId: %d, exit, name: %s\n", threadId(), mName.c_str());
 }
 
-bool WorkThreadSerial::commit(const TaskOperatorPtr& task)
+TaskSubmitResult WorkThreadSerial::commit(const TaskOperatorPtr& task)
 {
-    bool ret = mWorkQueue.enqueue(task);
+    auto result = _admit(task);
+    if (result != TaskSubmitResult::TSR_Accepted && result != TaskSubmitResult::TSR_DroppedOldest)
+    {
+        return result;
+    }
+
+    if (!mWorkQueue.enqueue(task))
+    {
+        mCapacity.onDequeue(task);
+        QueueCapacity::discard(task);
+        return TaskSubmitResult::TSR_Rejected;
+    }
     mSemaphore.release();
     _monitorTask();
-    return ret;
+    return result;
 }
 
-bool WorkThreadSerial::commit(TaskOperatorPtr&& task) noexcept
+TaskSubmitResult WorkThreadSerial::commit(TaskOperatorPtr&& task) noexcept
 {
-    bool ret = mWorkQueue.enqueue(std::move(task));
+    auto result = _admit(task);
+    if (result != TaskSubmitResult::TSR_Accepted && result != TaskSubmitResult::TSR_DroppedOldest)
+    {
+        return result;
+    }
+
+    if (!mWorkQueue.enqueue(task))
+    {
+        mCapacity.onDequeue(task);
+        QueueCapacity::discard(task);
+        return TaskSubmitResult::TSR_Rejected;
+    }
     mSemaphore.release();
     _monitorTask();
-    return ret;
+    return result;
+}
+
+void WorkThreadSerial::commitBulk(std::vector<TaskOperatorPtr>& tasks)
+{
+    // 设置了容量限制时逐个按溢出策略处理
+    if (mCapacity.isLimited())
+    {
+        for (auto& task : tasks)
+        {
+            commit(task);
+        }
+        return;
+    }
+
+    if (!mWorkQueue.enqueue_bulk(tasks.begin(), tasks.size()))
+    {
+        for (auto& task : tasks)
+        {
+            QueueCapacity::discard(task);
+        }
+        return;
+    }
+    mSemaphore.release(static_cast<int>(tasks.size()));
+    _monitorTask();
+}
+
+void WorkThreadSerial::takePending(std::vector<TaskOperatorPtr>& tasks)
+{
+    TaskOperatorPtr op;
+    while (mWorkQueue.try_dequeue(op))
+    {
+        if (op)
+        {
+            mCapacity.onDequeue(op);
+            tasks.push_back(std::move(op));
+        }
+    }
+}
+
+TaskSubmitResult WorkThreadSerial::_admit(const TaskOperatorPtr& task)
+{
+    auto result = mCapacity.admit(task, true, [this]() {
+        TaskOperatorPtr oldest;
+        if (!mWorkQueue.try_dequeue(oldest) || oldest == nullptr)
+        {
+            return false;
+        }
+        mCapacity.onDequeue(oldest);
+        QueueCapacity::discard(oldest);
+        return true;
+    });
+    switch (result)
+    {
+        case TaskSubmitResult::TSR_Rejected:
+        case TaskSubmitResult::TSR_TimedOut:
+            QueueCapacity::discard(task);
+            break;
+        default:
+            break;
+    }
+    return result;
 }
 
 void WorkThreadSerial::_exclusive()
@@ -81,17 +177,28 @@ void WorkThreadSerial::_exclusive()
     TaskOperatorPtr op;
     if (mWorkQueue.try_dequeue(op) && op)
     {
-        mCurrTask     = op;
+        mCapacity.onDequeue(op);
+        // 独占线程卡住时只上报， 不补偿 (串行队列的任务不能转到其他线程)， 新任务开始时清除标记
+        _clearBlocked();
+        mCurrTaskId.store(op->taskId(), std::memory_order_relaxed);
         mStartRunTime = task::HETimerHelper::currentTimeMillis();
         mIsRunning    = true;
         if(!op->isCancelled())
         {
-            (*op)();
+            runTask(op);
+        }
+        else
+        {
+            // 已取消的任务不执行， 唤醒等待方 (同步任务/任务组)
+            op->discard();
         }
         mIsRunning = false;
 
         //收集统计信息
-        _updateStat(op);
+        recordTask(op);
+        op->onRecorded();
+
+        mCurrTaskId.store(0, std::memory_order_relaxed);
     }
 }
 
@@ -100,7 +207,8 @@ void WorkThreadSerial::setActive(bool active)
     mIsActive = active;
     if (!active)
     {
-        mCurrTask = nullptr;
+        mCurrTaskId.store(0, std::memory_order_relaxed);
+        mCapacity.reset();
     }
 }
 
@@ -115,10 +223,14 @@ void WorkThreadSerial::_monitorTask()
     //1. 监控任务队列数量
     if (mWorkQueue.size_approx() >= TaskQueueConstant::sMaxTaskQueueCount)
     {
-        TaskQueueReporter::GetInstance().notifyReportLimit(TaskQueueConstant::sMaxReportCountThreshold,
-                                                           mReportCount,
-                                                           TaskQueueReporterType::TQRT_TaskCountExceedThreshold,
-                                                           blockedInfo());
+        TaskQueueReporter::GetInstance().notifyReportLimit(TaskQueueConstant::sMaxReportCountThreshold, mReportCount, [this]() {
+            TaskCountExceedEvent event;
+            event.mPoolType     = TaskQueueType::TQT_Serial;
+            event.mThreadId     = threadId();
+            event.mPendingCount = mWorkQueue.size_approx();
+            TaskQueueReporter::copyName(event.mThreadName, mName);
+            return TaskQueueReportEvent(event);
+        });
     }
     else
     {
@@ -126,16 +238,13 @@ void WorkThreadSerial::_monitorTask()
     }
 }
 
-std::string WorkThreadSerial::blockedInfo()
+TaskDurationExceedEvent WorkThreadSerial::blockedEvent()
 {
-    auto msg = _statInfo()
-               + " tskcnt:"
-               + std::to_string(mWorkQueue.size_approx())
-               + " blkTime:"
-               + std::to_string(task::HETimerHelper::currentTimeMillis() - mStartRunTime);
-
-    LOGE("[TASK] ", msg.c_str());
-    return msg;
+    TaskDurationExceedEvent event;
+    _fillStatEvent(event);
+    event.mPoolType      = TaskQueueType::TQT_Serial;
+    event.mBlockedMillis = task::HETimerHelper::currentTimeMillis() - mStartRunTime;
+    return event;
 }
 
 }  // namespace task
\ No newline at end of file
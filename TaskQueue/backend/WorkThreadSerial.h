@@ -2,7 +2,9 @@
 #define WORK_THREAD_SERIAL_H
 
 #include "WorkThreadBase.h"
+#include "QueueCapacity.h"
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 namespace task
@@ -20,23 +22,56 @@ public:
     }
     virtual void setActive(bool active) override;
 
-    // 提交任务
-    virtual bool        commit(const TaskOperatorPtr& task) override;
-    virtual bool        commit(TaskOperatorPtr&& task) noexcept override;
+    // 提交任务， 设置了容量限制时队列已满按溢出策略处理
+    virtual TaskSubmitResult commit(const TaskOperatorPtr& task) override;
+    virtual TaskSubmitResult commit(TaskOperatorPtr&& task) noexcept override;
+    // 批量提交， 未设置容量限制时一次入队
+    virtual void commitBulk(std::vector<TaskOperatorPtr>& tasks) override;
+
+    virtual size_t pendingCount() const override
+    {
+        return mWorkQueue.size_approx();
+    }
+    virtual void takePending(std::vector<TaskOperatorPtr>& tasks) override;
+    virtual void wake() override
+    {
+        mSemaphore.release();
+    }
+
+    // 线程归还 (setActive(false)) 时取消限制
+    virtual void             setCapacity(const TaskCapacity& capacity) override
+    {
+        mCapacity.set(capacity);
+    }
+    virtual TaskOverflowStat overflowStat() const override
+    {
+        return mCapacity.stat();
+    }
+    virtual TaskSubmitResult reserve(const TaskOperatorPtr& task) override
+    {
+        return _admit(task);
+    }
+    virtual void unreserve(const TaskOperatorPtr& task) override
+    {
+        mCapacity.onDequeue(task);
+    }
     virtual bool        isBlocked() const override;
-    virtual std::string blockedInfo() override;
+    virtual TaskDurationExceedEvent blockedEvent() override;
 
 protected:
     void _run();
     void _exclusive();
     void _monitorTask();
+    // 容量判断， 返回TSR_Accepted/TSR_DroppedOldest时由调用方入队
+    TaskSubmitResult _admit(const TaskOperatorPtr& task);
 
 private:
     bool      mIsActive{ false };  //是否为活跃线程
     WorkQueue mWorkQueue;          //线程任务队列
     Semaphore mSemaphore;          // 独占线程通知
-    int32_t   mReportCount{ 0 };
-    int64_t   mStartRunTime{ 0 };
+    QueueCapacity mCapacity;       // 任务队列容量限制
+    std::atomic<int32_t> mReportCount{ 0 };
+    std::atomic<int64_t> mStartRunTime{ 0 };
 };
 
 }  // namespace task
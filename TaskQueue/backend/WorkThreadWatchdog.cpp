@@ -0,0 +1,84 @@
+#include "WorkThreadWatchdog.h"
+#include "IThreadPool.h"
+#include "TaskQueueConstant.h"
+#include "common/LogHelper.h"
+#include <algorithm>
+#include <chrono>
+#include <pthread.h>
+
+namespace task
+{
+WorkThreadWatchdog::WorkThreadWatchdog()
+{
+    mThread = std::thread(&WorkThreadWatchdog::_run, this);
+}
+
+WorkThreadWatchdog::~WorkThreadWatchdog()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopped = true;
+    }
+    mCond.notify_one();
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+}
+
+void WorkThreadWatchdog::watch(const std::shared_ptr<IThreadPool>& pool)
+{
+    if (pool == nullptr)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPools.push_back(pool);
+}
+
+void WorkThreadWatchdog::_run()
+{
+#ifdef __APPLE__
+    // linux 下新线程继承创建者的名称， 补偿的工作线程由本线程创建， 不设置名称
+    pthread_setname_np("task_watchdog");
+#endif
+    LOGD("[TASK]WorkThreadWatchdog::run");
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (!mStopped)
+    {
+        mCond.wait_for(lock, std::chrono::milliseconds(TaskQueueConstant::sWatchdogInterval), [this]() { return mStopped; });
+        if (mStopped)
+        {
+            break;
+        }
+
+        lock.unlock();
+        _check();
+        lock.lock();
+    }
+}
+
+void WorkThreadWatchdog::_check()
+{
+    std::vector<std::shared_ptr<IThreadPool>> pools;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPools.erase(std::remove_if(mPools.begin(), mPools.end(), [](const std::weak_ptr<IThreadPool>& item) { return item.expired(); }),
+                     mPools.end());
+        for (auto& item : mPools)
+        {
+            if (auto pool = item.lock())
+            {
+                pools.push_back(pool);
+            }
+        }
+    }
+
+    for (auto& pool : pools)
+    {
+        pool->checkBlocked();
+    }
+}
+
+}  // namespace task
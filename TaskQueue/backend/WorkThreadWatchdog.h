@@ -0,0 +1,44 @@
+// 工作线程看门狗
+// 独立线程低频 (TaskQueueConstant::sWatchdogInterval) 扫描已登记的线程池， 由线程池检查卡住的工作线程:
+// 抓取卡住线程的堆栈并上报， 并行线程池补偿一条工作线程保持容量不变
+// 扫描不经过任务提交路径， 提交任务没有额外开销
+#ifndef __WORK_THREAD_WATCHDOG_H__
+#define __WORK_THREAD_WATCHDOG_H__
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/HESingleton.h"
+
+namespace task
+{
+class IThreadPool;
+class WorkThreadWatchdog : public task::HESingleton<WorkThreadWatchdog>
+{
+    friend class task::HESingleton<WorkThreadWatchdog>;
+
+public:
+    ~WorkThreadWatchdog();
+
+    // 登记线程池 (弱引用， 线程池释放后自动移除)
+    void watch(const std::shared_ptr<IThreadPool>& pool);
+
+private:
+    WorkThreadWatchdog();
+
+    void _run();
+    void _check();
+
+private:
+    std::mutex                              mMutex;
+    std::condition_variable                 mCond;
+    bool                                    mStopped{ false };
+    std::vector<std::weak_ptr<IThreadPool>> mPools;
+    std::thread                             mThread;
+};
+
+}  // namespace task
+
+#endif  // __WORK_THREAD_WATCHDOG_H__
@@ -0,0 +1,495 @@
+// 任务队列性能基准
+// 构建: cmake -S . -B build && cmake --build build --target dispatch_queue_bench
+// 运行: ./build/bin/dispatch_queue_bench --benchmark_out=result.json --benchmark_out_format=json
+// 对比: compare.py benchmarks old.json new.json (Google Benchmark tools)
+#include "../TaskDispatch.h"
+#include "../common/LWBarrier.h"
+#include "../common/LogHelper.h"
+#include "../common/Semaphore.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+using task::LWBarrier;
+using task::Semaphore;
+using task::TaskFileIoBackend;
+using task::TaskQueueFactory;
+using task::TaskQueuePriority;
+using task::WorkThreadPriority;
+
+namespace
+{
+constexpr int64_t kBatch = 1000;  // 吞吐测试每轮投递的任务数
+
+enum class QueueKind
+{
+    Concurrent,
+    Serial,     // 非独占串行队列 (在并行线程池上排空)
+    Exclusive,  // 独占线程串行队列
+};
+
+TaskQueuePtr& benchQueue(QueueKind kind)
+{
+    auto&               factory    = TaskQueueFactory::GetInstance();
+    static TaskQueuePtr sConcurrent = factory.createConcurrencyTaskQueue("bench_concurrent", TaskQueuePriority::TQP_Normal);
+    static TaskQueuePtr sSerial     = factory.createSerialTaskQueue("bench_serial", WorkThreadPriority::WTP_Normal, false);
+    static TaskQueuePtr sExclusive  = factory.createSerialTaskQueue("bench_exclusive", WorkThreadPriority::WTP_Normal, true);
+    switch (kind)
+    {
+        case QueueKind::Serial:
+            return sSerial;
+        case QueueKind::Exclusive:
+            return sExclusive;
+        default:
+            return sConcurrent;
+    }
+}
+
+// 等待计数达到目标 (让出CPU， 避免与工作线程争抢)
+void waitFor(const std::atomic<int64_t>& counter, int64_t target)
+{
+    while (counter.load(std::memory_order_acquire) < target)
+    {
+        std::this_thread::yield();
+    }
+}
+
+uint64_t nowMicros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// async 吞吐： 每个生产者线程每轮投递kBatch个空任务并等待执行完成
+void BM_AsyncThroughput(benchmark::State& state, QueueKind kind)
+{
+    auto&                queue = benchQueue(kind);
+    std::atomic<int64_t> done{ 0 };
+    int64_t              target = 0;
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < kBatch; ++i)
+        {
+            queue->async([&done]() { done.fetch_add(1, std::memory_order_release); });
+        }
+        target += kBatch;
+        waitFor(done, target);
+    }
+    state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK_CAPTURE(BM_AsyncThroughput, concurrent, QueueKind::Concurrent)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_CAPTURE(BM_AsyncThroughput, serial, QueueKind::Serial)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_CAPTURE(BM_AsyncThroughput, exclusive, QueueKind::Exclusive)->ThreadRange(1, 8)->UseRealTime();
+
+// sync 往返延迟： 投递空任务并等待其执行完成
+void BM_SyncRoundTrip(benchmark::State& state, QueueKind kind)
+{
+    auto& queue = benchQueue(kind);
+    for (auto _ : state)
+    {
+        queue->sync([]() {});
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_SyncRoundTrip, concurrent, QueueKind::Concurrent)->UseRealTime();
+BENCHMARK_CAPTURE(BM_SyncRoundTrip, serial, QueueKind::Serial)->UseRealTime();
+BENCHMARK_CAPTURE(BM_SyncRoundTrip, exclusive, QueueKind::Exclusive)->UseRealTime();
+
+// 任务组扇出/扇入： 每轮创建任务组， 投递width个任务并等待全部完成
+void BM_TaskGroupFanOutIn(benchmark::State& state)
+{
+    auto&      factory = TaskQueueFactory::GetInstance();
+    const auto width   = state.range(0);
+    for (auto _ : state)
+    {
+        auto group = factory.createTaskGroup();
+        for (int64_t i = 0; i < width; ++i)
+        {
+            group->async([]() {});
+        }
+        group->wait();
+    }
+    state.SetItemsProcessed(state.iterations() * width);
+}
+BENCHMARK(BM_TaskGroupFanOutIn)->Arg(8)->Arg(64)->Arg(512)->UseRealTime();
+
+// 并行循环： 逐个元素投递到任务组 与 parallelFor 分块执行同一循环
+void BM_LoopTaskGroup(benchmark::State& state)
+{
+    auto&              factory = TaskQueueFactory::GetInstance();
+    const auto         n       = static_cast<size_t>(state.range(0));
+    std::vector<float> out(n);
+    for (auto _ : state)
+    {
+        auto group = factory.createTaskGroup();
+        for (size_t i = 0; i < n; ++i)
+        {
+            group->async([&out, i]() { out[i] = static_cast<float>(i) * 0.5f; });
+        }
+        group->wait();
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LoopTaskGroup)->Arg(1 << 10)->Arg(1 << 16)->UseRealTime();
+
+void BM_LoopParallelFor(benchmark::State& state)
+{
+    const auto         n = static_cast<size_t>(state.range(0));
+    std::vector<float> out(n);
+    for (auto _ : state)
+    {
+        task::parallelFor(0, n, [&out](size_t i) { out[i] = static_cast<float>(i) * 0.5f; });
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LoopParallelFor)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 22)->UseRealTime();
+
+// 并行归约： 任务组 + 互斥锁累加 与 parallelReduce 分块部分和
+void BM_ReduceTaskGroupMutex(benchmark::State& state)
+{
+    auto&          factory = TaskQueueFactory::GetInstance();
+    const auto     n       = static_cast<size_t>(state.range(0));
+    constexpr auto kBlock  = size_t(1024);
+    for (auto _ : state)
+    {
+        auto       group = factory.createTaskGroup();
+        std::mutex mutex;
+        uint64_t   sum = 0;
+        for (size_t first = 0; first < n; first += kBlock)
+        {
+            group->async([first, n, &mutex, &sum]() {
+                for (size_t i = first; i < std::min(n, first + kBlock); ++i)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    sum += i;
+                }
+            });
+        }
+        group->wait();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReduceTaskGroupMutex)->Arg(1 << 16)->Arg(1 << 22)->UseRealTime();
+
+void BM_ParallelReduce(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        auto sum = task::parallelReduce(0, n, uint64_t(0), [](size_t i) { return static_cast<uint64_t>(i); }, std::plus<uint64_t>());
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParallelReduce)->Arg(1 << 16)->Arg(1 << 22)->UseRealTime();
+
+// 排序： std::sort / std::stable_sort 与 parallelSort / parallelStableSort， 1M ~ 100M 个随机 uint32
+// 每轮排序前恢复乱序数据 (不计时)
+template <typename Sort>
+void runSortBench(benchmark::State& state, Sort sort)
+{
+    const auto            n = static_cast<size_t>(state.range(0));
+    std::vector<uint32_t> source(n);
+    uint32_t              seed = 2463534242u;
+    for (auto& value : source)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        value = seed;
+    }
+    std::vector<uint32_t> values(n);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::copy(source.begin(), source.end(), values.begin());
+        state.ResumeTiming();
+        sort(values);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_StdSort(benchmark::State& state)
+{
+    runSortBench(state, [](std::vector<uint32_t>& v) { std::sort(v.begin(), v.end()); });
+}
+void BM_ParallelSort(benchmark::State& state)
+{
+    runSortBench(state, [](std::vector<uint32_t>& v) { task::parallelSort(v.begin(), v.end()); });
+}
+void BM_StdStableSort(benchmark::State& state)
+{
+    runSortBench(state, [](std::vector<uint32_t>& v) { std::stable_sort(v.begin(), v.end()); });
+}
+void BM_ParallelStableSort(benchmark::State& state)
+{
+    runSortBench(state, [](std::vector<uint32_t>& v) { task::parallelStableSort(v.begin(), v.end()); });
+}
+BENCHMARK(BM_StdSort)->Arg(1000000)->Arg(10000000)->Arg(100000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ParallelSort)->Arg(1000000)->Arg(10000000)->Arg(100000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_StdStableSort)->Arg(1000000)->Arg(10000000)->Arg(100000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ParallelStableSort)->Arg(1000000)->Arg(10000000)->Arg(100000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// 分治递归： 顺序递归 与 TaskForkJoin 派生子任务计算 fib(n)， 小于 kForkJoinCutoff 时顺序计算
+constexpr int kForkJoinCutoff = 18;
+
+uint64_t fibSerial(int n)
+{
+    return n < 2 ? n : fibSerial(n - 1) + fibSerial(n - 2);
+}
+
+uint64_t fibForkJoin(int n)
+{
+    if (n < kForkJoinCutoff)
+    {
+        return fibSerial(n);
+    }
+    uint64_t           a = 0;
+    task::TaskForkJoin scope;
+    scope.spawn([&a, n]() { a = fibForkJoin(n - 1); });
+    const uint64_t b = fibForkJoin(n - 2);
+    scope.join();
+    return a + b;
+}
+
+void BM_RecursionSerial(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(fibSerial(static_cast<int>(state.range(0))));
+    }
+}
+BENCHMARK(BM_RecursionSerial)->Arg(25)->Arg(30)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_RecursionForkJoin(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(fibForkJoin(static_cast<int>(state.range(0))));
+    }
+}
+BENCHMARK(BM_RecursionForkJoin)->Arg(25)->Arg(30)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// 文件读取： 任务组中阻塞 pread 与 TaskFileIo 异步读取 (io_uring / 线程池)， 每轮读取 range(0) 个 4K 块
+constexpr size_t kFileBlockSize  = 4096;
+constexpr size_t kFileBlockCount  = 1024;
+
+int benchFile()
+{
+    static int sFd = []() {
+        char path[] = "/tmp/dispatch_queue_bench_XXXXXX";
+        int  fd     = ::mkstemp(path);
+        ::unlink(path);
+        std::vector<char> block(kFileBlockSize, 'x');
+        for (size_t i = 0; i < kFileBlockCount; ++i)
+        {
+            (void)::pwrite(fd, block.data(), block.size(), static_cast<off_t>(i * kFileBlockSize));
+        }
+        return fd;
+    }();
+    return sFd;
+}
+
+void BM_FileReadBlocking(benchmark::State& state)
+{
+    auto&             factory = TaskQueueFactory::GetInstance();
+    const int         fd      = benchFile();
+    const auto        n       = static_cast<size_t>(state.range(0));
+    std::vector<char> buf(n * kFileBlockSize);
+    for (auto _ : state)
+    {
+        auto group = factory.createTaskGroup();
+        for (size_t i = 0; i < n; ++i)
+        {
+            group->async([&buf, fd, i]() {
+                (void)::pread(fd, buf.data() + i * kFileBlockSize, kFileBlockSize, static_cast<off_t>((i % kFileBlockCount) * kFileBlockSize));
+            });
+        }
+        group->wait();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FileReadBlocking)->Arg(64)->Arg(1024)->UseRealTime();
+
+void BM_FileReadAsync(benchmark::State& state)
+{
+    auto&             factory = TaskQueueFactory::GetInstance();
+    auto              io      = factory.createTaskFileIo(static_cast<TaskFileIoBackend>(state.range(1)));
+    auto&             queue   = factory.globalConcurrencyQueue(TaskQueuePriority::TQP_Normal);
+    const int         fd      = benchFile();
+    const auto        n       = static_cast<size_t>(state.range(0));
+    std::vector<char> buf(n * kFileBlockSize);
+    for (auto _ : state)
+    {
+        LWBarrier barrier;
+        std::atomic<size_t> remaining{ n };
+        for (size_t i = 0; i < n; ++i)
+        {
+            io->read(fd, buf.data() + i * kFileBlockSize, kFileBlockSize, (i % kFileBlockCount) * kFileBlockSize, queue,
+                     [&remaining, &barrier](int64_t) {
+                         if (remaining.fetch_sub(1) == 1)
+                         {
+                             barrier.notify();
+                         }
+                     });
+        }
+        barrier.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel(io->backend() == TaskFileIoBackend::TFB_IoUring ? "io_uring" : "thread_pool");
+}
+BENCHMARK(BM_FileReadAsync)
+    ->Args({ 64, static_cast<int64_t>(TaskFileIoBackend::TFB_IoUring) })
+    ->Args({ 1024, static_cast<int64_t>(TaskFileIoBackend::TFB_IoUring) })
+    ->Args({ 64, static_cast<int64_t>(TaskFileIoBackend::TFB_ThreadPool) })
+    ->Args({ 1024, static_cast<int64_t>(TaskFileIoBackend::TFB_ThreadPool) })
+    ->UseRealTime();
+
+// after() 定时精度： 实际触发时间相对预期的延后 (微秒)
+void BM_AfterLateness(benchmark::State& state)
+{
+    auto&                 queue = benchQueue(QueueKind::Concurrent);
+    const auto            delay = std::chrono::milliseconds(state.range(0));
+    std::atomic<uint64_t> firedAt{ 0 };
+    uint64_t              totalLate = 0;
+    uint64_t              maxLate   = 0;
+    for (auto _ : state)
+    {
+        firedAt.store(0, std::memory_order_relaxed);
+        const auto expected = nowMicros() + static_cast<uint64_t>(delay.count()) * 1000;
+        queue->after(delay, [&firedAt]() { firedAt.store(nowMicros(), std::memory_order_release); });
+        while (firedAt.load(std::memory_order_acquire) == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        const auto late = firedAt.load(std::memory_order_relaxed) > expected ? firedAt.load(std::memory_order_relaxed) - expected : 0;
+        totalLate += late;
+        maxLate = std::max(maxLate, late);
+    }
+    state.counters["late_us"]     = benchmark::Counter(static_cast<double>(totalLate), benchmark::Counter::kAvgIterations);
+    state.counters["late_max_us"] = static_cast<double>(maxLate);
+}
+BENCHMARK(BM_AfterLateness)->Arg(1)->Arg(5)->Arg(20)->Iterations(50)->UseRealTime();
+
+// 信号量： 单线程 release + tryAcquire
+void BM_SemaphoreReleaseAcquire(benchmark::State& state)
+{
+    Semaphore semaphore;
+    for (auto _ : state)
+    {
+        semaphore.release();
+        benchmark::DoNotOptimize(semaphore.tryAcquire());
+    }
+}
+BENCHMARK(BM_SemaphoreReleaseAcquire);
+
+// 信号量： 两个线程互相唤醒 (一次往返)
+void BM_SemaphorePingPong(benchmark::State& state)
+{
+    Semaphore         ping;
+    Semaphore         pong;
+    std::atomic<bool> stop{ false };
+    std::thread       peer([&]() {
+        while (true)
+        {
+            ping.waitAcquire(std::chrono::milliseconds(100));
+            if (stop.load(std::memory_order_acquire))
+            {
+                break;
+            }
+            pong.release();
+        }
+    });
+
+    for (auto _ : state)
+    {
+        ping.release();
+        while (!pong.waitAcquire(std::chrono::milliseconds(100)))
+        {
+        }
+    }
+
+    stop.store(true, std::memory_order_release);
+    ping.release();
+    peer.join();
+}
+BENCHMARK(BM_SemaphorePingPong)->UseRealTime();
+
+// 轻量屏障： 创建 + notify + wait (同一线程， 不阻塞)
+void BM_LWBarrierNotifyWait(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        LWBarrier barrier;
+        barrier.notify();
+        benchmark::DoNotOptimize(barrier.wait());
+    }
+}
+BENCHMARK(BM_LWBarrierNotifyWait);
+
+// 轻量屏障： 其他线程notify唤醒等待线程
+void BM_LWBarrierCrossThread(benchmark::State& state)
+{
+    Semaphore                  start;
+    std::atomic<bool>          stop{ false };
+    std::atomic<LWBarrier*>    current{ nullptr };
+    std::thread                peer([&]() {
+        while (true)
+        {
+            start.waitAcquire(std::chrono::milliseconds(100));
+            if (stop.load(std::memory_order_acquire))
+            {
+                break;
+            }
+            auto* barrier = current.load(std::memory_order_acquire);
+            if (barrier)
+            {
+                barrier->notify();
+            }
+        }
+    });
+
+    for (auto _ : state)
+    {
+        LWBarrier barrier;
+        current.store(&barrier, std::memory_order_release);
+        start.release();
+        barrier.wait();
+        current.store(nullptr, std::memory_order_release);
+    }
+
+    stop.store(true, std::memory_order_release);
+    start.release();
+    peer.join();
+}
+BENCHMARK(BM_LWBarrierCrossThread)->UseRealTime();
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    // 线程创建等上报日志会混入基准输出
+    task::LogHelper::setLevel(task::LogLevel::LL_Warn);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include "AsyncLogger.h"
+#include "LogHelper.h"
+#include "MPMCRing.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+
+namespace task
+{
+std::atomic<bool>    AsyncLogger::sAlive{ false };
+std::atomic<bool>    AsyncLogger::sDestroyed{ false };
+std::atomic<uint8_t> LogHelper::sLevel{ static_cast<uint8_t>(LogLevel::LL_Info) };
+std::atomic<bool>    LogHelper::sAsync{ true };
+
+namespace
+{
+constexpr size_t   kLogRingCapacity = 4096;
+constexpr size_t   kLogLineLength   = 512;
+constexpr uint32_t kLogIdleTimeout  = 50;  // 日志线程空闲等待(ms)， 兜底丢失的唤醒
+}  // namespace
+
+struct AsyncLogger::Ring : public MPMCRing<Record, kLogRingCapacity>
+{
+};
+
+AsyncLogger::AsyncLogger()
+    : mRing(new Ring())
+{
+    mOutput.store(stdout, std::memory_order_relaxed);
+    mThread = std::thread(&AsyncLogger::_run, this);
+    sAlive.store(true, std::memory_order_release);
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    sDestroyed.store(true, std::memory_order_release);
+    sAlive.store(false, std::memory_order_release);
+    mStopped.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCond.notify_all();
+    }
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+}
+
+void AsyncLogger::flush()
+{
+    // 以环形队列的入队位置为目标： 包含已占位但还未写完的记录， 出队位置越过目标时调用前的日志都已输出
+    const auto target = static_cast<uint64_t>(mRing->enqueuePos());
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCond.notify_one();
+    mFlushCond.wait(lock, [this, target]() {
+        return mFlushed.load(std::memory_order_acquire) >= target || mStopped.load(std::memory_order_acquire);
+    });
+}
+
+void AsyncLogger::setOutput(FILE* output)
+{
+    mOutput.store(output ? output : stdout, std::memory_order_release);
+}
+
+int64_t AsyncLogger::_now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+bool AsyncLogger::_push(const Record& record)
+{
+    if (!mRing->tryPush(record))
+    {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // 日志线程休眠时唤醒， 不加锁 (错过的唤醒由等待超时兜底)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (mSleeping.load(std::memory_order_relaxed))
+    {
+        mCond.notify_one();
+    }
+    return true;
+}
+
+void AsyncLogger::_run()
+{
+    Record record;
+    for (;;)
+    {
+        bool written = false;
+        while (mRing->tryPop(record))
+        {
+            _write(record);
+            written = true;
+        }
+
+        if (written)
+        {
+            fflush(mOutput.load(std::memory_order_acquire));
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFlushed.store(mRing->dequeuePos(), std::memory_order_release);
+            mFlushCond.notify_all();
+        }
+
+        if (mStopped.load(std::memory_order_acquire) && mRing->sizeApprox() == 0)
+        {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mSleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (mRing->sizeApprox() == 0 && !mStopped.load(std::memory_order_acquire))
+        {
+            mCond.wait_for(lock, std::chrono::milliseconds(kLogIdleTimeout));
+        }
+        mSleeping.store(false, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFlushCond.notify_all();
+}
+
+void AsyncLogger::_write(const Record& record)
+{
+    // 同一秒内复用时间格式化结果
+    const int64_t second = record.mTime / 1000000;
+    if (second != mCachedSecond)
+    {
+        std::time_t time = static_cast<std::time_t>(second);
+        std::tm     bt;
+        localtime_r(&time, &bt);
+        snprintf(mCachedTime, sizeof(mCachedTime), "%02d:%02d:%02d", bt.tm_hour, bt.tm_min, bt.tm_sec);
+        mCachedSecond = second;
+    }
+
+    char line[kLogLineLength];
+    int  prefix = snprintf(line, sizeof(line), "[%s.%03d] ", mCachedTime, static_cast<int>((record.mTime / 1000) % 1000));
+    int  len    = record.mDecoder(line + prefix, sizeof(line) - prefix, record.mFormat, record.mPayload);
+    if (len < 0)
+    {
+        len = 0;
+    }
+
+    size_t total = std::min(static_cast<size_t>(prefix + len), sizeof(line) - 2);
+    if (total == 0 || line[total - 1] != '\n')
+    {
+        line[total++] = '\n';
+    }
+    fwrite(line, 1, total, mOutput.load(std::memory_order_acquire));
+}
+
+}  // namespace task
@@ -0,0 +1,208 @@
+// 异步二进制日志
+// 生产者只保存 格式串指针 + 参数的二进制拷贝 到定长记录， 写入无锁环形队列 (不格式化， 不加锁， 不分配内存)
+// 后台线程解码、格式化 (时间戳 + snprintf) 后输出， 队列满时丢弃并计数
+//
+// 约束:
+// 1. 格式串必须为字符串常量 (只保存指针)
+// 2. 参数需可平凡拷贝 (整数/浮点/枚举/指针)， 字符串参数(const char*)按内容拷贝， 超出记录长度时截断
+#ifndef __ASYNC_LOGGER_H__
+#define __ASYNC_LOGGER_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include "HESingleton.h"
+
+namespace task
+{
+class AsyncLogger : public task::HESingleton<AsyncLogger>
+{
+    friend class task::HESingleton<AsyncLogger>;
+
+public:
+    static constexpr size_t kPayloadSize = 192;
+
+    using Decoder = int (*)(char* out, size_t size, const char* format, const uint8_t* payload);
+
+    struct Record
+    {
+        int64_t     mTime{ 0 };  // system_clock 微秒
+        const char* mFormat{ nullptr };
+        Decoder     mDecoder{ nullptr };
+        uint8_t     mLevel{ 0 };
+        uint8_t     mPayload[kPayloadSize];
+    };
+
+public:
+    // 已创建且未析构
+    static bool isAlive()
+    {
+        return sAlive.load(std::memory_order_acquire);
+    }
+
+    // 日志线程可用时返回实例， 第一次调用时创建； 静态析构后返回nullptr， 调用方改为同步输出
+    static AsyncLogger* tryGetInstance()
+    {
+        if (!isAlive() && sDestroyed.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return &GetInstance();
+    }
+
+    template <typename... Args>
+    bool log(uint8_t level, const char* format, const Args&... args)
+    {
+        static_assert(_fixedSize<std::decay_t<Args>...>() <= kPayloadSize, "too many log arguments");
+
+        Record record;
+        record.mTime    = _now();
+        record.mFormat  = format;
+        record.mDecoder = &_decode<std::decay_t<Args>...>;
+        record.mLevel   = level;
+
+        size_t fixedOffset  = 0;
+        size_t stringOffset = _fixedSize<std::decay_t<Args>...>();
+        ( void )fixedOffset;
+        ( void )stringOffset;
+        (LogArg<std::decay_t<Args>>::encode(record.mPayload, fixedOffset, stringOffset, args), ...);
+        return _push(record);
+    }
+
+    // 等待调用前写入的日志输出完成
+    void flush();
+
+    // 输出目标， 默认stdout (由日志线程写入)
+    void setOutput(FILE* output);
+
+    // 队列满被丢弃的日志数
+    uint64_t droppedRecords() const
+    {
+        return mDropped.load(std::memory_order_relaxed);
+    }
+
+    ~AsyncLogger();
+
+private:
+    AsyncLogger();
+
+    // 可平凡拷贝的参数， 按值保存在定长区
+    template <typename T, typename Enable = void>
+    struct LogArg
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "log argument must be trivially copyable or c string");
+        static constexpr size_t kFixedSize = sizeof(T);
+        using Decoded                      = T;
+
+        static void encode(uint8_t* payload, size_t& fixedOffset, size_t& /*stringOffset*/, const T& value)
+        {
+            memcpy(payload + fixedOffset, &value, sizeof(T));
+            fixedOffset += sizeof(T);
+        }
+
+        static T decode(const uint8_t* payload, size_t& fixedOffset, size_t& /*stringOffset*/)
+        {
+            T value;
+            memcpy(&value, payload + fixedOffset, sizeof(T));
+            fixedOffset += sizeof(T);
+            return value;
+        }
+    };
+
+    // 字符串参数， 按内容保存在定长区之后 (以'\0'结尾)
+    template <typename T>
+    struct LogArg<T, std::enable_if_t<std::is_same<T, const char*>::value || std::is_same<T, char*>::value>>
+    {
+        static constexpr size_t kFixedSize = 0;
+        using Decoded                      = const char*;
+
+        static void encode(uint8_t* payload, size_t& /*fixedOffset*/, size_t& stringOffset, const char* value)
+        {
+            if (stringOffset >= kPayloadSize)
+            {
+                return;
+            }
+            const char* str = value ? value : "(null)";
+            size_t      len = strnlen(str, kPayloadSize - stringOffset - 1);
+            memcpy(payload + stringOffset, str, len);
+            payload[stringOffset + len] = '\0';
+            stringOffset += len + 1;
+        }
+
+        static const char* decode(const uint8_t* payload, size_t& /*fixedOffset*/, size_t& stringOffset)
+        {
+            if (stringOffset >= kPayloadSize)
+            {
+                return "";
+            }
+            auto str = reinterpret_cast<const char*>(payload + stringOffset);
+            stringOffset += strlen(str) + 1;
+            return str;
+        }
+    };
+
+    template <typename... Args>
+    static constexpr size_t _fixedSize()
+    {
+        return (size_t(0) + ... + LogArg<Args>::kFixedSize);
+    }
+
+    template <typename... Args>
+    static int _decode(char* out, size_t size, const char* format, const uint8_t* payload)
+    {
+        if constexpr (sizeof...(Args) == 0)
+        {
+            ( void )payload;
+            return snprintf(out, size, "%s", format);
+        }
+        else
+        {
+            size_t fixedOffset  = 0;
+            size_t stringOffset = _fixedSize<Args...>();
+            // 花括号初始化保证从左到右解码
+            std::tuple<typename LogArg<Args>::Decoded...> values{ LogArg<Args>::decode(payload, fixedOffset, stringOffset)... };
+            return std::apply([out, size, format](auto... value) { return snprintf(out, size, format, value...); }, values);
+        }
+    }
+
+    static int64_t _now();
+
+    bool _push(const Record& record);
+    void _run();
+    void _write(const Record& record);
+
+private:
+    struct Ring;
+    std::unique_ptr<Ring> mRing;
+
+    std::thread             mThread;
+    std::mutex              mMutex;
+    std::condition_variable mCond;
+    std::condition_variable mFlushCond;
+    std::atomic<bool>       mSleeping{ false };
+    std::atomic<bool>       mStopped{ false };
+
+    std::atomic<uint64_t> mFlushed{ 0 };  // 已输出并flush到的出队位置
+    std::atomic<uint64_t> mDropped{ 0 };
+
+    std::atomic<FILE*> mOutput{ nullptr };
+
+    // 时间戳格式化缓存 (日志线程)
+    int64_t mCachedSecond{ -1 };
+    char    mCachedTime[16]{};
+
+    static std::atomic<bool> sAlive;
+    static std::atomic<bool> sDestroyed;
+};
+
+}  // namespace task
+
+#endif  // __ASYNC_LOGGER_H__
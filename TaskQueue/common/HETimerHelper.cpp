@@ -6,6 +6,7 @@
 //
 
 #include "HETimerHelper.h"
+#include <time.h>
 
 namespace task
 {
@@ -17,6 +18,13 @@ uint64_t HETimerHelper::millisecondTimestamp64()
         .count();
 }
 
+uint64_t HETimerHelper::microsecondTimestamp64()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
 uint64_t HETimerHelper::currentTimeMillis()
 {
     return std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -24,4 +32,14 @@ uint64_t HETimerHelper::currentTimeMillis()
             .count();
 }
 
+uint64_t HETimerHelper::threadCpuMicroseconds()
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+    {
+        return 0;
+    }
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + static_cast<uint64_t>(ts.tv_nsec) / 1000;
+}
+
 }  // namespace comm
@@ -18,7 +18,13 @@ class HETimerHelper
 public:
     static uint64_t millisecondTimestamp64();
 
+    // 单调时钟微秒时间戳
+    static uint64_t microsecondTimestamp64();
+
     static uint64_t currentTimeMillis();
+
+    // 当前线程CPU时间 (微秒)
+    static uint64_t threadCpuMicroseconds();
 };
 
 }
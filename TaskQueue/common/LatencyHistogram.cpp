@@ -0,0 +1,118 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace task
+{
+uint32_t LatencyHistogram::bucketIndex(uint64_t value)
+{
+    if (value < kSubBucketCount)
+    {
+        return static_cast<uint32_t>(value);
+    }
+
+    const uint64_t maxValue = (1ULL << (kMaxValueBits + 1)) - 1;
+    value                   = std::min(value, maxValue);
+
+    // value >> shift 落在 [kSubBucketHalf, kSubBucketCount) 区间
+    const uint32_t msb   = 63 - static_cast<uint32_t>(__builtin_clzll(value));
+    const uint32_t shift = msb - kSubBucketBits + 1;
+    const uint32_t sub   = static_cast<uint32_t>(value >> shift) - kSubBucketHalf;
+    return kSubBucketCount + (shift - 1) * kSubBucketHalf + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(uint32_t index)
+{
+    if (index < kSubBucketCount)
+    {
+        return index;
+    }
+
+    const uint32_t offset = index - kSubBucketCount;
+    const uint32_t shift  = offset / kSubBucketHalf + 1;
+    const uint64_t sub    = offset % kSubBucketHalf + kSubBucketHalf;
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value)
+{
+    mCounts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    mCount.fetch_add(1, std::memory_order_relaxed);
+    mSum.fetch_add(value, std::memory_order_relaxed);
+
+    // 峰值只在变大时写入
+    auto peak = mMax.load(std::memory_order_relaxed);
+    while (value > peak && !mMax.compare_exchange_weak(peak, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void LatencyHistogram::snapshot(Snapshot& out) const
+{
+    for (uint32_t i = 0; i < kBucketCount; ++i)
+    {
+        out.mCounts[i] += mCounts[i].load(std::memory_order_relaxed);
+    }
+    out.mCount += mCount.load(std::memory_order_relaxed);
+    out.mSum += mSum.load(std::memory_order_relaxed);
+    out.mMax = std::max(out.mMax, mMax.load(std::memory_order_relaxed));
+}
+
+void LatencyHistogram::add(const Snapshot& snapshot)
+{
+    for (uint32_t i = 0; i < kBucketCount; ++i)
+    {
+        if (snapshot.mCounts[i] != 0)
+        {
+            mCounts[i].fetch_add(snapshot.mCounts[i], std::memory_order_relaxed);
+        }
+    }
+    mCount.fetch_add(snapshot.mCount, std::memory_order_relaxed);
+    mSum.fetch_add(snapshot.mSum, std::memory_order_relaxed);
+
+    auto peak = mMax.load(std::memory_order_relaxed);
+    while (snapshot.mMax > peak && !mMax.compare_exchange_weak(peak, snapshot.mMax, std::memory_order_relaxed))
+    {
+    }
+}
+
+void LatencyHistogram::Snapshot::merge(const Snapshot& other)
+{
+    for (uint32_t i = 0; i < kBucketCount; ++i)
+    {
+        mCounts[i] += other.mCounts[i];
+    }
+    mCount += other.mCount;
+    mSum += other.mSum;
+    mMax = std::max(mMax, other.mMax);
+}
+
+uint64_t LatencyHistogram::Snapshot::percentile(double percent) const
+{
+    // 各桶计数与总数分别读取， 以桶计数之和为准
+    uint64_t total = 0;
+    for (auto count : mCounts)
+    {
+        total += count;
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    percent       = std::min(std::max(percent, 0.0), 100.0);
+    auto rank     = static_cast<uint64_t>(std::ceil(percent / 100.0 * static_cast<double>(total)));
+    rank          = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < kBucketCount; ++i)
+    {
+        seen += mCounts[i];
+        if (seen >= rank)
+        {
+            return std::min(bucketUpperBound(i), mMax);
+        }
+    }
+    return mMax;
+}
+
+}  // namespace task
@@ -0,0 +1,67 @@
+// 耗时分布直方图 (HDR风格， 对数-线性分桶)
+// 小于32的数值每个值一个桶， 之后每个2的幂区间分为16个子桶， 相对误差 < 6.25%
+// 记录只有relaxed原子操作， 无锁； 读取时合并为快照计算分位数
+#ifndef __LATENCY_HISTOGRAM_H__
+#define __LATENCY_HISTOGRAM_H__
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace task
+{
+class LatencyHistogram final
+{
+public:
+    static constexpr uint32_t kSubBucketBits  = 5;
+    static constexpr uint32_t kSubBucketCount = 1 << kSubBucketBits;
+    static constexpr uint32_t kSubBucketHalf  = kSubBucketCount / 2;
+    static constexpr uint32_t kMaxValueBits   = 40;  // 超出 2^41 的数值记入最后一个桶 (微秒时约25天)
+    static constexpr uint32_t kBucketCount    = kSubBucketCount + (kMaxValueBits - kSubBucketBits + 1) * kSubBucketHalf;
+
+    // 快照， 可以合并多个直方图
+    struct Snapshot
+    {
+        std::array<uint64_t, kBucketCount> mCounts{};
+        uint64_t                           mCount{ 0 };
+        uint64_t                           mSum{ 0 };
+        uint64_t                           mMax{ 0 };
+
+        void merge(const Snapshot& other);
+
+        // 分位数 (percent: 0 ~ 100)， 返回所在桶的上界
+        uint64_t percentile(double percent) const;
+        uint64_t mean() const
+        {
+            return mCount == 0 ? 0 : mSum / mCount;
+        }
+    };
+
+public:
+    LatencyHistogram()  = default;
+    ~LatencyHistogram() = default;
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(uint64_t value);
+
+    // 累加到快照
+    void snapshot(Snapshot& out) const;
+
+    // 合并快照 (用于保留已退出线程的统计)
+    void add(const Snapshot& snapshot);
+
+    static uint32_t bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(uint32_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> mCounts{};
+    std::atomic<uint64_t>                           mCount{ 0 };
+    std::atomic<uint64_t>                           mSum{ 0 };
+    std::atomic<uint64_t>                           mMax{ 0 };
+};
+
+}  // namespace task
+
+#endif  // __LATENCY_HISTOGRAM_H__
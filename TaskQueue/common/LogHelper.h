@@ -1,9 +1,33 @@
 #pragma once
 
+// 日志
+// 级别: Trace < Debug < Info < Warn < Error
+// 1. 编译期: 低于 TASK_LOG_LEVEL 的日志宏不输出、不求值参数 (编译器直接移除)， 未定义时 Debug 构建保留全部， NDEBUG 构建保留 Info 及以上
+// 2. 运行期: LogHelper::setLevel 调整输出级别 (默认Info)， 每条日志只有一次原子读判断
+// 3. 默认异步输出 (AsyncLogger)， 任务线程不格式化、不加锁； setAsync(false) 改为同步输出
+
+#include <atomic>
+#include <cstdint>
 #include <cstdio>
 #include <iostream>
 #include <chrono>
 #include <iomanip>
+#include "AsyncLogger.h"
+
+#define TASK_LOG_LEVEL_TRACE 0
+#define TASK_LOG_LEVEL_DEBUG 1
+#define TASK_LOG_LEVEL_INFO  2
+#define TASK_LOG_LEVEL_WARN  3
+#define TASK_LOG_LEVEL_ERROR 4
+#define TASK_LOG_LEVEL_OFF   5
+
+#ifndef TASK_LOG_LEVEL
+#ifdef NDEBUG
+#define TASK_LOG_LEVEL TASK_LOG_LEVEL_INFO
+#else
+#define TASK_LOG_LEVEL TASK_LOG_LEVEL_TRACE
+#endif
+#endif
 
 namespace task 
 {
@@ -55,11 +79,114 @@ void printf(const char* format, Args&&... args) {
     std::printf("\n");
 }
 
+enum class LogLevel : uint8_t
+{
+    LL_Trace = TASK_LOG_LEVEL_TRACE,
+    LL_Debug = TASK_LOG_LEVEL_DEBUG,
+    LL_Info  = TASK_LOG_LEVEL_INFO,
+    LL_Warn  = TASK_LOG_LEVEL_WARN,
+    LL_Error = TASK_LOG_LEVEL_ERROR,
+    LL_Off   = TASK_LOG_LEVEL_OFF,
+};
+
+class LogHelper
+{
+public:
+    // 运行期输出级别
+    static void setLevel(LogLevel level)
+    {
+        sLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    }
+
+    static LogLevel level()
+    {
+        return static_cast<LogLevel>(sLevel.load(std::memory_order_relaxed));
+    }
+
+    static bool isEnabled(LogLevel level)
+    {
+        return static_cast<uint8_t>(level) >= sLevel.load(std::memory_order_relaxed);
+    }
+
+    // 异步/同步输出
+    static void setAsync(bool async)
+    {
+        sAsync.store(async, std::memory_order_relaxed);
+    }
+
+    static bool isAsync()
+    {
+        return sAsync.load(std::memory_order_relaxed);
+    }
+
+    template <typename... Args>
+    static void write(LogLevel level, const char* format, const Args&... args)
+    {
+        if (isAsync())
+        {
+            // 第一次异步写入时创建日志线程
+            auto logger = AsyncLogger::tryGetInstance();
+            if (logger != nullptr)
+            {
+                logger->log(static_cast<uint8_t>(level), format, args...);
+                return;
+            }
+        }
+        task::printf(format, args...);
+    }
+
+private:
+    static std::atomic<uint8_t> sLevel;
+    static std::atomic<bool>    sAsync;
+};
+
 } // namespace log
 
+#define TASK_LOG_AT(level, format, args...)                          \
+    do                                                               \
+    {                                                                \
+        if (task::LogHelper::isEnabled(level))                       \
+        {                                                            \
+            task::LogHelper::write(level, format, ##args);           \
+        }                                                            \
+    } while (0)
+
+// 参数保留引用 (避免未使用告警) 但不求值
+#define TASK_LOG_DISABLED(format, args...)                                      \
+    do                                                                          \
+    {                                                                           \
+        if (false)                                                              \
+        {                                                                       \
+            task::LogHelper::write(task::LogLevel::LL_Trace, format, ##args);   \
+        }                                                                       \
+    } while (0)
+
+#if TASK_LOG_LEVEL <= TASK_LOG_LEVEL_TRACE
+#define LOGT(format, args...) TASK_LOG_AT(task::LogLevel::LL_Trace, format, ##args)
+#else
+#define LOGT(format, args...) TASK_LOG_DISABLED(format, ##args)
+#endif
+
+#if TASK_LOG_LEVEL <= TASK_LOG_LEVEL_DEBUG
+#define LOGD(format, args...) TASK_LOG_AT(task::LogLevel::LL_Debug, format, ##args)
+#else
+#define LOGD(format, args...) TASK_LOG_DISABLED(format, ##args)
+#endif
+
+#if TASK_LOG_LEVEL <= TASK_LOG_LEVEL_INFO
+#define LOGI(format, args...) TASK_LOG_AT(task::LogLevel::LL_Info, format, ##args)
+#else
+#define LOGI(format, args...) TASK_LOG_DISABLED(format, ##args)
+#endif
 
-#define LOGD(format, args...) task::printf(format, ##args)
-#define LOGI(format, args...) task::printf(format, ##args)
-#define LOGW(format, args...) task::printf(format, ##args)
-#define LOGE(format, args...) task::printf(format, ##args)
+#if TASK_LOG_LEVEL <= TASK_LOG_LEVEL_WARN
+#define LOGW(format, args...) TASK_LOG_AT(task::LogLevel::LL_Warn, format, ##args)
+#else
+#define LOGW(format, args...) TASK_LOG_DISABLED(format, ##args)
+#endif
 
+#if TASK_LOG_LEVEL <= TASK_LOG_LEVEL_ERROR
+#define LOGE(format, args...) TASK_LOG_AT(task::LogLevel::LL_Error, format, ##args)
+#else
+#define LOGE(format, args...) TASK_LOG_DISABLED(format, ##args)
+#endif
@@ -0,0 +1,135 @@
+// 有界无锁多生产者/多消费者环形队列 (Dmitry Vyukov bounded MPMC queue)
+// 容量固定为2的幂， 构造时一次性分配， 入队/出队不分配内存、不阻塞， 满时tryPush返回false
+// T 需要可默认构造、可拷贝赋值
+#ifndef __MPMC_RING_H__
+#define __MPMC_RING_H__
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace task
+{
+template <typename T, size_t Capacity>
+class MPMCRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MPMCRing capacity must be power of 2");
+
+public:
+    MPMCRing()
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+        {
+            mCells[i].mSequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPMCRing(const MPMCRing&) = delete;
+    MPMCRing& operator=(const MPMCRing&) = delete;
+
+    // 入队， 队列满返回false
+    bool tryPush(const T& value)
+    {
+        size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+        Cell*  cell;
+        for (;;)
+        {
+            cell          = &mCells[pos & kMask];
+            size_t   seq  = cell->mSequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = mEnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->mValue = value;
+        cell->mSequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 出队， 队列空返回false
+    bool tryPop(T& value)
+    {
+        size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+        Cell*  cell;
+        for (;;)
+        {
+            cell          = &mCells[pos & kMask];
+            size_t   seq  = cell->mSequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = mDequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        value = cell->mValue;
+        cell->mSequence.store(pos + kMask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 近似元素数量
+    size_t sizeApprox() const
+    {
+        size_t enqueuePos = mEnqueuePos.load(std::memory_order_relaxed);
+        size_t dequeuePos = mDequeuePos.load(std::memory_order_relaxed);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+    // 已占用的入队位置 (含正在写入的元素)， 单调递增
+    size_t enqueuePos() const
+    {
+        return mEnqueuePos.load(std::memory_order_acquire);
+    }
+
+    // 已出队的位置， 单调递增
+    size_t dequeuePos() const
+    {
+        return mDequeuePos.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity()
+    {
+        return Capacity;
+    }
+
+private:
+    static constexpr size_t kMask      = Capacity - 1;
+    static constexpr size_t kCacheLine = 64;
+
+    struct Cell
+    {
+        std::atomic<size_t> mSequence{ 0 };
+        T                   mValue{};
+    };
+
+    alignas(kCacheLine) std::array<Cell, Capacity> mCells;
+    alignas(kCacheLine) std::atomic<size_t> mEnqueuePos{ 0 };
+    alignas(kCacheLine) std::atomic<size_t> mDequeuePos{ 0 };
+};
+
+}  // namespace task
+
+#endif  // __MPMC_RING_H__
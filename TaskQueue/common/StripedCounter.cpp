@@ -0,0 +1,24 @@
+#include "StripedCounter.h"
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace task
+{
+size_t currentStripe(size_t stripes)
+{
+#if defined(__linux__)
+    // 按当前CPU分片， 同一CPU上的线程共享分片 (线程迁移只影响缓存命中， 不影响正确性)
+    int cpu = sched_getcpu();
+    if (cpu >= 0)
+    {
+        return static_cast<size_t>(cpu) & (stripes - 1);
+    }
+#endif
+    // 不支持时按线程分片
+    static std::atomic<size_t> sNextStripe{ 0 };
+    static thread_local size_t tStripe = sNextStripe.fetch_add(1, std::memory_order_relaxed);
+    return tStripe & (stripes - 1);
+}
+
+}  // namespace task
@@ -0,0 +1,49 @@
+// 分片计数器
+// 每个CPU(或线程)写入自己的缓存行， 写入为relaxed原子加， 读取时求和
+// Count: 每个分片中的计数器数量 (同一分片的计数器共享缓存行)
+#ifndef __STRIPED_COUNTER_H__
+#define __STRIPED_COUNTER_H__
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace task
+{
+// 当前线程对应的分片下标 (0 ~ stripes-1)
+size_t currentStripe(size_t stripes);
+
+template <size_t Count>
+class StripedCounter
+{
+public:
+    static constexpr size_t kStripes = 16;
+
+    void add(size_t index, uint64_t value = 1)
+    {
+        mStripes[currentStripe(kStripes)].mValues[index].fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t sum(size_t index) const
+    {
+        uint64_t total = 0;
+        for (auto& stripe : mStripes)
+        {
+            total += stripe.mValues[index].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    struct alignas(64) Stripe
+    {
+        std::array<std::atomic<uint64_t>, Count> mValues{};
+    };
+
+    std::array<Stripe, kStripes> mStripes;
+};
+
+}  // namespace task
+
+#endif  // __STRIPED_COUNTER_H__
@@ -0,0 +1,211 @@
+#include "ThreadStack.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <mutex>
+#include <thread>
+#include <unwind.h>
+
+namespace task
+{
+namespace
+{
+// 抓取堆栈使用的信号， 可通过 TASK_STACK_SIGNAL 指定
+#if defined(TASK_STACK_SIGNAL)
+int stackSignal()
+{
+    return TASK_STACK_SIGNAL;
+}
+#elif defined(__APPLE__)
+int stackSignal()
+{
+    return SIGUSR2;
+}
+#else
+int stackSignal()
+{
+    return SIGRTMIN + 3;
+}
+#endif
+
+enum CaptureState : int
+{
+    CS_Idle = 0,
+    CS_Requested,  // 已发送信号
+    CS_Capturing,  // 目标线程正在回溯
+    CS_Done,
+};
+
+constexpr size_t kMaxFrames = 64;
+constexpr size_t kSkipFrames = 2;  // 信号处理函数 与 信号跳板
+
+// 信号处理函数只访问静态存储
+struct Capture
+{
+    std::atomic<int> mState{ CS_Idle };
+    pthread_t        mTarget{};
+    uint64_t         mFrames[kMaxFrames]{};
+    size_t           mDepth{ 0 };
+};
+Capture sCapture;
+
+struct UnwindState
+{
+    uint64_t* mFrames;
+    size_t    mDepth;
+    size_t    mMaxFrames;
+    size_t    mSkip;
+};
+
+_Unwind_Reason_Code unwindFrame(_Unwind_Context* context, void* arg)
+{
+    auto*      state = static_cast<UnwindState*>(arg);
+    const auto ip    = static_cast<uint64_t>(_Unwind_GetIP(context));
+    if (ip == 0)
+    {
+        return _URC_END_OF_STACK;
+    }
+    if (state->mSkip > 0)
+    {
+        --state->mSkip;
+        return _URC_NO_REASON;
+    }
+    if (state->mDepth >= state->mMaxFrames)
+    {
+        return _URC_END_OF_STACK;
+    }
+    state->mFrames[state->mDepth++] = ip;
+    return _URC_NO_REASON;
+}
+
+void onStackSignal(int /*signo*/, siginfo_t* /*info*/, void* /*context*/)
+{
+    const int saved    = errno;
+    int       expected = CS_Requested;
+    if (pthread_equal(pthread_self(), sCapture.mTarget) && sCapture.mState.compare_exchange_strong(expected, CS_Capturing))
+    {
+        UnwindState state{ sCapture.mFrames, 0, kMaxFrames, kSkipFrames };
+        _Unwind_Backtrace(unwindFrame, &state);
+        sCapture.mDepth = state.mDepth;
+        sCapture.mState.store(CS_Done, std::memory_order_release);
+    }
+    errno = saved;
+}
+
+// 只在信号未被占用时安装
+bool installHandler()
+{
+    struct sigaction old;
+    if (sigaction(stackSignal(), nullptr, &old) != 0)
+    {
+        return false;
+    }
+    if ((old.sa_flags & SA_SIGINFO) || old.sa_handler != SIG_DFL)
+    {
+        return false;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    sigemptyset(&action.sa_mask);
+    action.sa_sigaction = onStackSignal;
+    action.sa_flags     = SA_SIGINFO | SA_RESTART;
+    return sigaction(stackSignal(), &action, nullptr) == 0;
+}
+}  // namespace
+
+size_t ThreadStack::capture(pthread_t thread, uint64_t* frames, size_t maxFrames, std::chrono::milliseconds timeout)
+{
+    if (frames == nullptr || maxFrames == 0)
+    {
+        return 0;
+    }
+
+    static const bool sInstalled = installHandler();
+    if (!sInstalled)
+    {
+        return 0;
+    }
+
+    static std::mutex           sMutex;
+    std::lock_guard<std::mutex> lock(sMutex);
+
+    sCapture.mTarget = thread;
+    sCapture.mDepth  = 0;
+    sCapture.mState.store(CS_Requested, std::memory_order_seq_cst);
+    if (pthread_kill(thread, stackSignal()) != 0)
+    {
+        sCapture.mState.store(CS_Idle, std::memory_order_relaxed);
+        return 0;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (sCapture.mState.load(std::memory_order_acquire) != CS_Done)
+    {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            // 信号未被处理 (线程屏蔽了信号)， 撤销请求； 已开始回溯则等待完成
+            int expected = CS_Requested;
+            if (sCapture.mState.compare_exchange_strong(expected, CS_Idle))
+            {
+                return 0;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const auto depth = std::min(sCapture.mDepth, maxFrames);
+    memcpy(frames, sCapture.mFrames, depth * sizeof(uint64_t));
+    sCapture.mState.store(CS_Idle, std::memory_order_release);
+    return depth;
+}
+
+size_t ThreadStack::symbolize(uint64_t address, char* buffer, size_t size)
+{
+    if (buffer == nullptr || size == 0)
+    {
+        return 0;
+    }
+
+    int     len = 0;
+    Dl_info info;
+    if (dladdr(reinterpret_cast<void*>(address), &info) != 0 && info.dli_fname != nullptr)
+    {
+        const char* module = strrchr(info.dli_fname, '/');
+        module             = module ? module + 1 : info.dli_fname;
+        if (info.dli_sname != nullptr)
+        {
+            int   status    = 0;
+            char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            len             = snprintf(buffer, size, "0x%llx %s(%s+0x%llx)", ( unsigned long long )address, module,
+                                       (status == 0 && demangled) ? demangled : info.dli_sname,
+                                       ( unsigned long long )(address - reinterpret_cast<uint64_t>(info.dli_saddr)));
+            free(demangled);
+        }
+        else
+        {
+            // 未导出符号， 输出模块内偏移 (可用 addr2line 解析)
+            len = snprintf(buffer, size, "0x%llx %s+0x%llx", ( unsigned long long )address, module,
+                           ( unsigned long long )(address - reinterpret_cast<uint64_t>(info.dli_fbase)));
+        }
+    }
+    else
+    {
+        len = snprintf(buffer, size, "0x%llx", ( unsigned long long )address);
+    }
+
+    if (len < 0)
+    {
+        buffer[0] = '\0';
+        return 0;
+    }
+    return std::min(static_cast<size_t>(len), size - 1);
+}
+
+}  // namespace task
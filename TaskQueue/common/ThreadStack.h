@@ -0,0 +1,29 @@
+// 线程堆栈抓取
+// 向目标线程发送信号， 在其信号处理函数中用 _Unwind_Backtrace 记录返回地址， 调用方等待抓取完成
+// 同一时刻只进行一次抓取； 信号已被应用安装处理函数时不覆盖， 抓取返回0
+// 符号化 (dladdr + demangle) 会分配内存， 只在非信号上下文调用
+#ifndef __THREAD_STACK_H__
+#define __THREAD_STACK_H__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <pthread.h>
+
+namespace task
+{
+
+class ThreadStack
+{
+public:
+    // 抓取线程堆栈， 返回帧数 (不支持 / 超时 / 线程已退出返回0)
+    static size_t capture(pthread_t thread, uint64_t* frames, size_t maxFrames,
+                          std::chrono::milliseconds timeout = std::chrono::milliseconds(100));
+
+    // 格式化单帧: "0x地址 模块(函数+偏移)"， 返回写入长度
+    static size_t symbolize(uint64_t address, char* buffer, size_t size);
+};
+
+}  // namespace task
+
+#endif  // __THREAD_STACK_H__
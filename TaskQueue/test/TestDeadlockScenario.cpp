@@ -1,4 +1,6 @@
 #include "../TaskDispatch.h"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cstdio>
@@ -101,6 +103,41 @@ int main(int argc, char* argv[])
         printf("安全方案3 - 任务组完成\n");
     });
     
+    // 线程池已达到最大线程数： 工作线程提交的任务不能切换到新线程， 由自身继续执行， 不会一直空转等待其他线程
+    printf("-------------------- 线程池已满时在工作线程提交 --------------------\n");
+    {
+        auto              parallel = factory.createConcurrencyTaskQueue("deadlock_full_pool", TaskQueuePriority::TQP_Normal);
+        const int         workers  = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        std::atomic<bool> release{ false };
+        std::atomic<int>  started{ 0 };
+        for (int i = 0; i < workers - 1; ++i)
+        {
+            parallel->async([&]() {
+                started++;
+                while (!release.load())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            });
+        }
+        for (int i = 0; i < 1000 && started.load() < workers - 1; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        assert(started.load() == workers - 1);
+
+        // 其余工作线程都被占用， 子任务只能由提交它的工作线程执行
+        std::atomic<bool> childDone{ false };
+        parallel->async([&]() { parallel->async([&childDone]() { childDone = true; }); });
+        for (int i = 0; i < 1000 && !childDone.load(); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        printf("工作线程数: %d, 子任务执行: %d\n", workers, childDone.load());
+        release = true;
+        assert(childDone.load());
+    }
+
     printf("-------------死锁场景测试完成，请等待所有异步任务执行完毕-------------\n");
     
     // 等待所有异步任务完成
@@ -0,0 +1,139 @@
+#include "../TaskDispatch.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <set>
+#include <stdio.h>
+#include <thread>
+using namespace task;
+
+// clang++ -o test TestForkJoin.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static std::mutex                sThreadMutex;
+static std::set<std::thread::id> sThreads;
+
+static long long elapsedUs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+static uint64_t fibSerial(int n)
+{
+    return n < 2 ? n : fibSerial(n - 1) + fibSerial(n - 2);
+}
+
+static uint64_t fib(int n)
+{
+    if (n < 16)
+    {
+        return fibSerial(n);
+    }
+
+    uint64_t     a = 0;
+    TaskForkJoin scope;
+    scope.spawn([&a, n] {
+        {
+            std::lock_guard<std::mutex> lock(sThreadMutex);
+            sThreads.insert(std::this_thread::get_id());
+        }
+        a = fib(n - 1);
+    });
+    const uint64_t b = fib(n - 2);
+    scope.join();
+    return a + b;
+}
+
+// 每层只派生一个子任务， 递归深度 depth
+static int chain(int depth)
+{
+    if (depth == 0)
+    {
+        return 0;
+    }
+    int          result = 0;
+    TaskForkJoin scope;
+    scope.spawn([&result, depth] { result = chain(depth - 1) + 1; });
+    scope.join();
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 分治任务测试 --------------------------------------\n");
+
+    printf("-------------------- 斐波那契 --------------------\n");
+    {
+        auto           start    = std::chrono::steady_clock::now();
+        const uint64_t expected = fibSerial(30);
+        const auto     serialUs = elapsedUs(start);
+
+        start                = std::chrono::steady_clock::now();
+        const uint64_t value = fib(30);
+        const auto     forkUs = elapsedUs(start);
+        printf("fib(30): %llu, serial: %lld us, fork-join: %lld us, threads: %zu\n", ( unsigned long long )value, serialUs, forkUs,
+               sThreads.size());
+        assert(value == expected);
+
+        // 递归派生不会让线程池额外创建线程： 参与执行的只有调用线程和并行线程池
+        assert(sThreads.size() <= std::max(1u, std::thread::hardware_concurrency()) + 1);
+    }
+
+    printf("-------------------- 空作用域/析构时join --------------------\n");
+    {
+        TaskForkJoin empty;
+        empty.join();
+        empty.join();
+
+        std::atomic<int> count{ 0 };
+        {
+            TaskForkJoin scope;
+            for (int i = 0; i < 100; ++i)
+            {
+                scope.spawn([&count] {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                    count++;
+                });
+            }
+            scope.spawn(nullptr);
+        }
+        assert(count.load() == 100);
+
+        // 作用域 join 后可以继续派生
+        TaskForkJoin scope;
+        scope.spawn([&count] { count++; });
+        scope.join();
+        scope.spawn([&count] { count++; });
+        scope.join();
+        assert(count.load() == 102);
+    }
+
+    printf("-------------------- 深度递归 --------------------\n");
+    {
+        const int depth = chain(2000);
+        printf("depth: %d\n", depth);
+        assert(depth == 2000);
+    }
+
+    // 在队列任务中递归派生， 多个根并发执行
+    printf("-------------------- 队列任务中派生 --------------------\n");
+    {
+        auto&                 factory = TaskQueueFactory::GetInstance();
+        auto                  queue   = factory.createConcurrencyTaskQueue("fork_join_roots", TaskQueuePriority::TQP_Normal);
+        std::atomic<uint64_t> total{ 0 };
+        auto                  group = factory.createTaskGroup();
+        for (int i = 0; i < 8; ++i)
+        {
+            group->asyncQueue([&total] { total += fib(22); }, queue);
+        }
+        assert(group->wait(std::chrono::milliseconds(20000)));
+        assert(total.load() == 8 * fibSerial(22));
+    }
+
+    printf("-------------分治任务测试完成-------------\n");
+    getchar();
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "../TaskDispatch.h"
+#include "../common/LatencyHistogram.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <stdio.h>
+#include <thread>
+using namespace task;
+
+// clang++ -o test TestLatencyStat.cpp -I.. -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static void printStat(const char* name, const TaskLatencyStat& stat)
+{
+    printf("%s: run cnt: %llu, mean: %llu us, p50: %llu us, p99: %llu us, p999: %llu us, max: %llu us | wait p50: %llu us, p99: %llu us\n",
+           name,
+           ( unsigned long long )stat.mRun.mCount,
+           ( unsigned long long )stat.mRun.mMean,
+           ( unsigned long long )stat.mRun.mP50,
+           ( unsigned long long )stat.mRun.mP99,
+           ( unsigned long long )stat.mRun.mP999,
+           ( unsigned long long )stat.mRun.mMax,
+           ( unsigned long long )stat.mWait.mP50,
+           ( unsigned long long )stat.mWait.mP99);
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 耗时分布统计测试 --------------------------------------\n");
+
+    // 直方图精度： 相对误差 < 1/16
+    printf("-------------------- 直方图精度 --------------------\n");
+    {
+        LatencyHistogram histogram;
+        for (uint64_t value = 1; value <= 100000; ++value)
+        {
+            histogram.record(value);
+        }
+        LatencyHistogram::Snapshot snapshot;
+        histogram.snapshot(snapshot);
+        assert(snapshot.mCount == 100000);
+        assert(snapshot.mMax == 100000);
+
+        const double percents[] = { 50.0, 90.0, 99.0, 99.9 };
+        for (auto percent : percents)
+        {
+            auto expected = static_cast<double>(percent * 1000);
+            auto actual   = static_cast<double>(snapshot.percentile(percent));
+            printf("p%.1f: 期望 %.0f, 实际 %.0f\n", percent, expected, actual);
+            assert(actual >= expected && actual <= expected * (1.0 + 1.0 / 16));
+        }
+
+        // 小数值精确， 超大数值落入最后一个桶
+        assert(LatencyHistogram::bucketIndex(31) == 31);
+        assert(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(31)) == 31);
+        assert(LatencyHistogram::bucketIndex(UINT64_MAX) == LatencyHistogram::kBucketCount - 1);
+    }
+
+    // 队列统计 与 线程池统计
+    printf("-------------------- 队列/线程池统计 --------------------\n");
+    {
+        auto& factory         = TaskQueueFactory::GetInstance();
+        auto  concurrentQueue = factory.createConcurrencyTaskQueue("stat_concurrent", TaskQueuePriority::TQP_Normal);
+        auto  serialQueue     = factory.createSerialTaskQueue("stat_serial", WorkThreadPriority::WTP_Normal, false);
+        auto  exclusiveQueue  = factory.createSerialTaskQueue("stat_exclusive", WorkThreadPriority::WTP_Normal, true);
+
+        auto parallelBefore = factory.poolLatencyStat(TaskQueueType::TQT_Parallel);
+        auto serialBefore   = factory.poolLatencyStat(TaskQueueType::TQT_Serial);
+
+        // 多个生产线程并发提交
+        std::thread producers[4];
+        for (auto& producer : producers)
+        {
+            producer = std::thread([&]() {
+                for (int i = 0; i < 25; ++i)
+                {
+                    concurrentQueue->async([]() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+                    serialQueue->async([]() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+                }
+            });
+        }
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+        for (int i = 0; i < 50; ++i)
+        {
+            exclusiveQueue->async([]() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); });
+        }
+
+        serialQueue->sync([]() {});
+        exclusiveQueue->sync([]() {});
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+        auto concurrentStat = concurrentQueue->latencyStat();
+        auto serialStat     = serialQueue->latencyStat();
+        auto exclusiveStat  = exclusiveQueue->latencyStat();
+        auto parallelAfter  = factory.poolLatencyStat(TaskQueueType::TQT_Parallel);
+        auto serialAfter    = factory.poolLatencyStat(TaskQueueType::TQT_Serial);
+        printStat("并行队列", concurrentStat);
+        printStat("串行队列", serialStat);
+        printStat("独占队列", exclusiveStat);
+        printStat("并行线程池", parallelAfter);
+        printStat("独占线程池", serialAfter);
+
+        // sync 任务同样计入
+        assert(concurrentStat.mRun.mCount == 100);
+        assert(serialStat.mRun.mCount == 101);
+        assert(exclusiveStat.mRun.mCount == 51);
+        assert(concurrentStat.mRun.mP50 >= 1000);
+        assert(exclusiveStat.mRun.mP50 >= 2000);
+        assert(concurrentStat.mRun.mP50 <= concurrentStat.mRun.mP99 && concurrentStat.mRun.mP99 <= concurrentStat.mRun.mMax);
+
+        // 非独占串行队列在并行线程池执行
+        assert(parallelAfter.mRun.mCount - parallelBefore.mRun.mCount >= 201);
+        assert(serialAfter.mRun.mCount - serialBefore.mRun.mCount == 51);
+    }
+
+    printf("-------------耗时分布统计测试完成-------------\n");
+    getchar();
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include "../TaskDispatch.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <stdio.h>
+#include <thread>
+using namespace task;
+
+// clang++ -o test TestLoadShedding.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static void printStat(const char* name, const TaskLoadShedStat& stat)
+{
+    printf("%s: shedding: %d, min wait: %llu us, enter: %llu, rejected submitted: %llu, rejected queued: %llu, deferred: %llu\n",
+           name, stat.mShedding, ( unsigned long long )stat.mMinWaitMicros, ( unsigned long long )stat.mEnterCount,
+           ( unsigned long long )stat.mRejectedSubmitted, ( unsigned long long )stat.mRejectedQueued,
+           ( unsigned long long )stat.mDeferred);
+}
+
+static bool waitUntil(const std::atomic<int>& value, int expected, int timeoutMs = 5000)
+{
+    for (int i = 0; i < timeoutMs / 5 && value.load() < expected; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return value.load() >= expected;
+}
+
+static bool waitShedding(TaskQueueFactory& factory, bool shedding, int timeoutMs = 3000)
+{
+    for (int i = 0; i < timeoutMs / 5 && factory.loadShedStat().mShedding != shedding; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return factory.loadShedStat().mShedding == shedding;
+}
+
+// 提交超过工作线程处理能力的普通优先级任务
+static int overload(const TaskQueuePtr& queue, std::atomic<int>& done)
+{
+    const int workers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const int count   = workers * 30;
+    for (int i = 0; i < count; ++i)
+    {
+        queue->async([&done]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            done++;
+        });
+    }
+    return count;
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 降载测试 --------------------------------------\n");
+
+    auto& factory = TaskQueueFactory::GetInstance();
+    auto  normal  = factory.createConcurrencyTaskQueue("shed_normal", TaskQueuePriority::TQP_Normal);
+    auto  low     = factory.createConcurrencyTaskQueue("shed_low", TaskQueuePriority::TQP_Low);
+
+    TaskLoadShedding config;
+    config.mEnabled     = true;
+    config.mTargetDelay = std::chrono::milliseconds(5);
+    config.mInterval    = std::chrono::milliseconds(50);
+
+    // 未过载时不降载
+    printf("-------------------- 未过载 --------------------\n");
+    {
+        factory.setLoadShedding(config);
+        std::atomic<int> count{ 0 };
+        for (int i = 0; i < 10; ++i)
+        {
+            assert(low->async([&count]() { count++; }) == TaskSubmitResult::TSR_Accepted);
+        }
+        assert(waitUntil(count, 10));
+        printStat("idle", factory.loadShedStat());
+        assert(!factory.loadShedStat().mShedding);
+    }
+
+    // 拒绝： 新提交及已排队的低优先级任务
+    printf("-------------------- 拒绝 --------------------\n");
+    {
+        config.mAction     = TaskShedAction::TSA_Reject;
+        config.mShedQueued = true;
+        factory.setLoadShedding(config);
+
+        std::atomic<int> done{ 0 };
+        const int        total = overload(normal, done);
+
+        // 排在普通任务之后， 出队时仍处于降载
+        std::atomic<int> lowRan{ 0 };
+        for (int i = 0; i < 3; ++i)
+        {
+            assert(low->async([&lowRan]() { lowRan++; }) == TaskSubmitResult::TSR_Accepted);
+        }
+
+        assert(waitShedding(factory, true));
+        auto rejected = std::make_shared<TaskOperator>([&lowRan](const TaskOperatorPtr&) { lowRan++; });
+        assert(low->async(rejected) == TaskSubmitResult::TSR_Shed);
+        assert(rejected->isCancelled());
+
+        // 带截止时间的任务不降载
+        auto deadline = std::make_shared<TaskOperator>([&lowRan](const TaskOperatorPtr&) { lowRan++; });
+        deadline->setDeadline(std::chrono::milliseconds(1000));
+        assert(low->async(deadline) == TaskSubmitResult::TSR_Accepted);
+
+        // 普通优先级任务不受影响
+        assert(normal->async([&done]() { done++; }) == TaskSubmitResult::TSR_Accepted);
+
+        assert(waitUntil(done, total + 1, 20000));
+        assert(waitUntil(lowRan, 1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        auto stat = factory.loadShedStat();
+        printStat("reject", stat);
+        printf("low ran: %d\n", lowRan.load());
+        assert(stat.mEnterCount >= 1);
+        assert(stat.mRejectedSubmitted == 1);
+        assert(stat.mRejectedQueued + lowRan.load() == 4);  // 3个排队任务 + 截止时间任务
+        assert(stat.mMinWaitMicros > 5000);
+
+        // 负载排空后没有新样本， 自动退出降载
+        assert(waitShedding(factory, false));
+        assert(low->async([]() {}) == TaskSubmitResult::TSR_Accepted);
+        assert(low->metrics().mCancelled == stat.mRejectedSubmitted + stat.mRejectedQueued);
+    }
+
+    // 延后： 降载期间延后投递， 退出降载后执行
+    printf("-------------------- 延后 --------------------\n");
+    {
+        config.mAction     = TaskShedAction::TSA_Defer;
+        config.mShedQueued = false;
+        config.mDeferDelay = std::chrono::milliseconds(50);
+        factory.setLoadShedding(config);
+
+        std::atomic<int> done{ 0 };
+        const int        total = overload(normal, done);
+        assert(waitShedding(factory, true));
+
+        std::atomic<int> deferred{ 0 };
+        assert(low->async([&deferred]() { deferred++; }) == TaskSubmitResult::TSR_Deferred);
+        assert(deferred.load() == 0);
+
+        assert(waitUntil(done, total, 20000));
+        assert(waitUntil(deferred, 1));
+
+        auto stat = factory.loadShedStat();
+        printStat("defer", stat);
+        assert(stat.mDeferred >= 1);
+        assert(stat.mRejectedSubmitted == 0 && stat.mRejectedQueued == 0);
+    }
+
+    // 关闭
+    factory.setLoadShedding(TaskLoadShedding());
+    printStat("disabled", factory.loadShedStat());
+
+    printf("-------------降载测试完成-------------\n");
+    getchar();
+    return 0;
+}
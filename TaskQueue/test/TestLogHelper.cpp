@@ -0,0 +1,180 @@
+#include "../TaskDispatch.h"
+#include "../common/LogHelper.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+using task::AsyncLogger;
+using task::LogHelper;
+using task::LogLevel;
+
+// clang++ -o test TestLogHelper.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static std::string readAll(FILE* file)
+{
+    std::string content;
+    char        buffer[1024];
+    rewind(file);
+    while (fgets(buffer, sizeof(buffer), file))
+    {
+        content += buffer;
+    }
+    return content;
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 日志测试 --------------------------------------\n");
+
+    // 默认异步输出： 第一次写入时创建日志线程， 不需要手动创建
+    printf("-------------------- 默认异步 --------------------\n");
+    {
+        assert(LogHelper::isAsync());
+        LOGE("first log creates async logger %d", 0);
+        assert(AsyncLogger::isAlive());
+        printf("第一次写入后异步日志已创建\n");
+    }
+
+    auto& logger = AsyncLogger::GetInstance();
+    FILE* output = tmpfile();
+    assert(output);
+    logger.setOutput(output);
+
+    // 运行期级别过滤
+    printf("-------------------- 运行期级别 --------------------\n");
+    {
+        LogHelper::setLevel(LogLevel::LL_Info);
+        LOGT("trace hidden %d", 1);
+        LOGD("debug hidden %d", 2);
+        LOGI("info shown %d", 3);
+        LOGE("error shown %s", "e");
+
+        LogHelper::setLevel(LogLevel::LL_Trace);
+        LOGT("trace shown %d", 4);
+        logger.flush();
+
+        auto content = readAll(output);
+        assert(content.find("hidden") == std::string::npos);
+        assert(content.find("info shown 3") != std::string::npos);
+        assert(content.find("error shown e") != std::string::npos);
+        assert(content.find("trace shown 4") != std::string::npos);
+        printf("%s", content.c_str());
+    }
+
+    // 参数按值保存： 字符串内容拷贝， 调用后释放不影响输出
+    printf("-------------------- 参数拷贝 --------------------\n");
+    {
+        {
+            std::string temp = "temporary_label";
+            LOGI("label: %s, value: %llu, ratio: %.2f, ptr: %p, enum: %d", temp.c_str(), ( unsigned long long )42, 0.5, ( void* )0x10,
+                 task::TaskQueuePriority::TQP_High);
+            temp.assign(temp.size(), 'x');
+        }
+        std::string longText(1000, 'a');
+        LOGI("long: %s, tail: %d", longText.c_str(), 7);
+        logger.flush();
+
+        auto content = readAll(output);
+        assert(content.find("label: temporary_label, value: 42, ratio: 0.50, ptr: 0x10, enum: 2") != std::string::npos);
+        assert(content.find("tail: 7") != std::string::npos);  // 超长字符串截断， 后续参数不受影响
+        printf("参数拷贝正确\n");
+    }
+
+    // 多线程写入： flush 返回时本线程调用前写入的日志都已输出
+    printf("-------------------- 多线程 flush --------------------\n");
+    {
+        char path[] = "/tmp/task_log_XXXXXX";
+        int  fd     = mkstemp(path);
+        assert(fd >= 0);
+        FILE* shared = fdopen(fd, "w+");
+        assert(shared);
+        logger.setOutput(shared);
+
+        std::atomic<int>         missing{ 0 };
+        std::vector<std::thread> writers;
+        for (int t = 0; t < 8; ++t)
+        {
+            writers.emplace_back([t, &logger, &missing, &path]() {
+                for (int i = 0; i < 50; ++i)
+                {
+                    LOGI("flush marker %d-%d.", t, i);
+                    logger.flush();
+
+                    char marker[64];
+                    snprintf(marker, sizeof(marker), "flush marker %d-%d.", t, i);
+                    FILE* reader = fopen(path, "r");
+                    if (reader == nullptr || readAll(reader).find(marker) == std::string::npos)
+                    {
+                        missing++;
+                    }
+                    if (reader)
+                    {
+                        fclose(reader);
+                    }
+                }
+            });
+        }
+        for (auto& writer : writers)
+        {
+            writer.join();
+        }
+        printf("flush 返回后未输出: %d\n", missing.load());
+        assert(missing.load() == 0);
+
+        logger.setOutput(output);
+        logger.flush();
+        fclose(shared);
+        unlink(path);
+    }
+
+    // 耗时: 关闭级别 / 异步写入
+    printf("-------------------- 耗时 --------------------\n");
+    {
+        const int count = 100000;
+        FILE*     null  = fopen("/dev/null", "w");
+        logger.setOutput(null);
+
+        LogHelper::setLevel(LogLevel::LL_Info);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; ++i)
+        {
+            LOGT("[Job] disabled, task: %p, idx: %d", ( void* )&i, i);
+        }
+        auto disabled = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        LogHelper::setLevel(LogLevel::LL_Trace);
+        const auto dropped = logger.droppedRecords();
+        start              = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; ++i)
+        {
+            LOGT("[Job] enabled, task: %p, idx: %d", ( void* )&i, i);
+        }
+        auto async = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        logger.flush();
+
+        printf("关闭级别: %.1f ns/条, 异步写入: %.1f ns/条, 丢弃: %llu\n", ( double )disabled / count, ( double )async / count,
+               ( unsigned long long )(logger.droppedRecords() - dropped));
+        logger.setOutput(stdout);
+        fclose(null);
+    }
+
+    // 同步输出
+    printf("-------------------- 同步输出 --------------------\n");
+    {
+        LogHelper::setAsync(false);
+        LOGI("sync output %d", 1);
+        LogHelper::setAsync(true);
+    }
+
+    LogHelper::setLevel(LogLevel::LL_Info);
+    fclose(output);
+    printf("-------------日志测试完成-------------\n");
+    getchar();
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include "../TaskDispatch.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <utility>
+#include <vector>
+using namespace task;
+
+// clang++ -o test TestParallelFor.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static long long elapsedUs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 每个下标恰好执行一次
+static void testCoverage(size_t begin, size_t end, const TaskParallelOptions& options)
+{
+    std::vector<std::atomic<int>> hits(end);
+    parallelFor(begin, end, [&hits](size_t i) { hits[i]++; }, options);
+    for (size_t i = 0; i < end; ++i)
+    {
+        assert(hits[i].load() == (i >= begin ? 1 : 0));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 并行循环测试 --------------------------------------\n");
+
+    auto& factory = TaskQueueFactory::GetInstance();
+
+    printf("-------------------- 覆盖 --------------------\n");
+    {
+        testCoverage(0, 0, TaskParallelOptions());
+        testCoverage(0, 1, TaskParallelOptions());
+        testCoverage(3, 7, TaskParallelOptions());
+        testCoverage(0, 100000, TaskParallelOptions());
+        testCoverage(17, 100003, TaskParallelOptions());
+
+        TaskParallelOptions options;
+        options.mGrain = 1;
+        testCoverage(0, 1000, options);
+        options.mGrain = 333;
+        options.mAlign = 1;
+        testCoverage(5, 10000, options);
+        options.mMaxWorkers = 1;
+        options.mPriority   = TaskQueuePriority::TQP_High;
+        testCoverage(0, 10000, options);
+    }
+
+    // 块边界对齐到64的整数倍下标， 调用线程参与执行
+    printf("-------------------- 分块 --------------------\n");
+    {
+        std::mutex                            mutex;
+        std::vector<std::pair<size_t, size_t>> chunks;
+        size_t                                callerChunks = 0;
+        const auto                            caller       = std::this_thread::get_id();
+        parallelForRange(10, 1000010, [&](size_t first, size_t last) {
+            std::lock_guard<std::mutex> lock(mutex);
+            chunks.emplace_back(first, last);
+            if (std::this_thread::get_id() == caller)
+            {
+                callerChunks++;
+            }
+        });
+
+        std::sort(chunks.begin(), chunks.end());
+        printf("chunks: %zu, caller chunks: %zu, first: %zu, last: %zu\n", chunks.size(), callerChunks,
+               chunks.front().second - chunks.front().first, chunks.back().second - chunks.back().first);
+        assert(chunks.front().first == 10 && chunks.back().second == 1000010);
+        for (size_t i = 1; i < chunks.size(); ++i)
+        {
+            assert(chunks[i].first == chunks[i - 1].second);
+            assert(chunks[i].first % 64 == 0);
+        }
+        assert(callerChunks > 0);
+        // 块数与线程数相关， 与元素数无关
+        assert(chunks.size() < 1000);
+    }
+
+    // 在工作线程中嵌套调用： 工作线程全忙时由调用线程执行完， 不会死锁
+    printf("-------------------- 嵌套 --------------------\n");
+    {
+        auto                  group = factory.createTaskGroup();
+        std::atomic<uint64_t> sum{ 0 };
+        for (int t = 0; t < 8; ++t)
+        {
+            group->async([&sum]() {
+                parallelFor(0, 64, [&sum](size_t i) {
+                    parallelFor(0, 1000, [&sum, i](size_t j) { sum.fetch_add(i * 1000 + j, std::memory_order_relaxed); });
+                });
+            });
+        }
+        assert(group->wait(std::chrono::milliseconds(10000)));
+        const uint64_t n = 64 * 1000;
+        printf("nested sum: %llu\n", ( unsigned long long )sum.load());
+        assert(sum.load() == 8 * (n * (n - 1) / 2));
+    }
+
+    // 对比逐个元素投递到任务组
+    printf("-------------------- 耗时 --------------------\n");
+    {
+        const size_t       n = 100000;
+        std::vector<float> out(n);
+
+        auto start = std::chrono::steady_clock::now();
+        auto group = factory.createTaskGroup();
+        for (size_t i = 0; i < n; ++i)
+        {
+            group->async([&out, i]() { out[i] = static_cast<float>(i) * 0.5f; });
+        }
+        group->wait();
+        const auto groupCost = elapsedUs(start);
+
+        std::fill(out.begin(), out.end(), 0.0f);
+        start = std::chrono::steady_clock::now();
+        parallelFor(0, n, [&out](size_t i) { out[i] = static_cast<float>(i) * 0.5f; });
+        const auto loopCost = elapsedUs(start);
+
+        printf("task group: %lld us, parallelFor: %lld us\n", groupCost, loopCost);
+        for (size_t i = 0; i < n; ++i)
+        {
+            assert(out[i] == static_cast<float>(i) * 0.5f);
+        }
+        assert(loopCost < groupCost);
+    }
+
+    printf("-------------并行循环测试完成-------------\n");
+    getchar();
+    return 0;
+}
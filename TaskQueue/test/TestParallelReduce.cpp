@@ -0,0 +1,121 @@
+#include "../TaskDispatch.h"
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <stdio.h>
+#include <string>
+#include <vector>
+using namespace task;
+
+// clang++ -o test TestParallelReduce.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static long long elapsedUs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 并行归约测试 --------------------------------------\n");
+
+    auto& factory = TaskQueueFactory::GetInstance();
+
+    printf("-------------------- 求和 --------------------\n");
+    {
+        auto square = [](size_t i) { return static_cast<uint64_t>(i) * i; };
+        assert(parallelReduce(0, 0, uint64_t(7), square, std::plus<uint64_t>()) == 7);
+        assert(parallelReduce(3, 4, uint64_t(0), square, std::plus<uint64_t>()) == 9);
+
+        const uint64_t n   = 1000000;
+        const uint64_t sum = parallelReduce(0, n, uint64_t(0), square, std::plus<uint64_t>());
+        printf("sum of squares: %llu\n", ( unsigned long long )sum);
+        assert(sum == (n - 1) * n * (2 * n - 1) / 6);
+
+        TaskParallelOptions options;
+        options.mGrain = 7;
+        assert(parallelReduce(10, 1000, uint64_t(0), square, std::plus<uint64_t>(), options)
+               == parallelReduce(10, 1000, uint64_t(0), square, std::plus<uint64_t>()));
+    }
+
+    // 不满足交换律的合并： 结果保持下标顺序
+    printf("-------------------- 顺序 --------------------\n");
+    {
+        auto digit = [](size_t i) { return std::string(1, static_cast<char>('0' + i % 10)); };
+        auto text  = parallelReduce(0, 1000, std::string(), digit, std::plus<std::string>());
+        assert(text.size() == 1000);
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            assert(text[i] == static_cast<char>('0' + i % 10));
+        }
+
+        std::vector<int> values{ 1, 2, 3, 4, 5 };
+        auto             joined = transformReduce(values.begin(), values.end(), std::string("#"), std::plus<std::string>(),
+                                                  [](int v) { return std::to_string(v); });
+        assert(joined == "#12345");
+        assert(transformReduce(values.begin(), values.begin(), 42, std::plus<int>(), [](int v) { return v; }) == 42);
+    }
+
+    // 浮点求和： 块划分与线程数无关， 每次结果逐位相同
+    printf("-------------------- 确定性 --------------------\n");
+    {
+        std::vector<double> values(1 << 20);
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            values[i] = 1.0 / static_cast<double>(i + 1) * ((i % 3 == 0) ? -1.0 : 1.0);
+        }
+        auto identity = [](double v) { return v; };
+
+        const double expected = transformReduce(values.begin(), values.end(), 0.0, std::plus<double>(), identity);
+        for (uint32_t workers = 0; workers < 4; ++workers)
+        {
+            TaskParallelOptions options;
+            options.mMaxWorkers = workers;
+            for (int round = 0; round < 5; ++round)
+            {
+                const double sum = transformReduce(values.begin(), values.end(), 0.0, std::plus<double>(), identity, options);
+                assert(sum == expected);
+            }
+        }
+        printf("sum: %.17g\n", expected);
+    }
+
+    // 对比任务组 + 互斥锁累加
+    printf("-------------------- 耗时 --------------------\n");
+    {
+        const size_t n     = 1 << 22;
+        const size_t block = 1024;
+
+        auto       start = std::chrono::steady_clock::now();
+        auto       group = factory.createTaskGroup();
+        std::mutex mutex;
+        uint64_t   locked = 0;
+        for (size_t first = 0; first < n; first += block)
+        {
+            group->async([first, block, &mutex, &locked]() {
+                for (size_t i = first; i < first + block; ++i)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    locked += i;
+                }
+            });
+        }
+        group->wait();
+        const auto groupCost = elapsedUs(start);
+
+        start            = std::chrono::steady_clock::now();
+        const auto total = parallelReduce(0, n, uint64_t(0), [](size_t i) { return static_cast<uint64_t>(i); }, std::plus<uint64_t>());
+        const auto reduceCost = elapsedUs(start);
+
+        printf("task group + mutex: %lld us, parallelReduce: %lld us\n", groupCost, reduceCost);
+        assert(locked == total);
+        assert(total == static_cast<uint64_t>(n) * (n - 1) / 2);
+        assert(reduceCost < groupCost);
+    }
+
+    printf("-------------并行归约测试完成-------------\n");
+    getchar();
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "../TaskDispatch.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <random>
+#include <stdio.h>
+#include <string>
+#include <vector>
+using namespace task;
+
+// clang++ -o test TestParallelSort.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static long long elapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::vector<uint32_t> randomValues(size_t count, uint32_t range, uint32_t seed)
+{
+    std::mt19937          rng(seed);
+    std::vector<uint32_t> values(count);
+    for (auto& value : values)
+    {
+        value = rng() % range;
+    }
+    return values;
+}
+
+// 与 std::sort 的结果一致
+static void testSort(size_t count, size_t cutoff)
+{
+    TaskParallelOptions options;
+    options.mGrain = cutoff;
+
+    auto values   = randomValues(count, 1000000, static_cast<uint32_t>(count));
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+    parallelSort(values.begin(), values.end(), std::less<uint32_t>(), options);
+    assert(values == expected);
+
+    std::sort(expected.begin(), expected.end(), std::greater<uint32_t>());
+    parallelSort(values.begin(), values.end(), std::greater<uint32_t>(), options);
+    assert(values == expected);
+}
+
+struct Record
+{
+    uint32_t mKey{ 0 };
+    uint32_t mSeq{ 0 };
+};
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 并行排序测试 --------------------------------------\n");
+
+    printf("-------------------- 正确性 --------------------\n");
+    {
+        // 覆盖顺序执行、一轮归并 (结果在缓冲区， 搬回原区间)、多轮归并
+        testSort(0, 0);
+        testSort(1, 0);
+        testSort(1000, 0);
+        testSort(3000, 1000);
+        testSort(100003, 1000);
+        testSort(1 << 20, 0);
+
+        // 已排序、逆序、全部相等
+        std::vector<int> sorted(200000);
+        for (size_t i = 0; i < sorted.size(); ++i)
+        {
+            sorted[i] = static_cast<int>(i);
+        }
+        auto reversed = sorted;
+        std::reverse(reversed.begin(), reversed.end());
+        std::vector<int> same(200000, 7);
+        TaskParallelOptions options;
+        options.mGrain = 4096;
+        parallelSort(sorted.begin(), sorted.end(), std::less<int>(), options);
+        parallelSort(reversed.begin(), reversed.end(), std::less<int>(), options);
+        parallelSort(same.begin(), same.end(), std::less<int>(), options);
+        assert(std::is_sorted(sorted.begin(), sorted.end()));
+        assert(reversed == sorted);
+        assert(std::count(same.begin(), same.end(), 7) == 200000);
+
+        // 非指针迭代器、移动元素
+        std::deque<std::string> words;
+        for (auto value : randomValues(50000, 100000, 3))
+        {
+            words.push_back(std::to_string(value));
+        }
+        std::vector<std::string> expected(words.begin(), words.end());
+        std::sort(expected.begin(), expected.end());
+        options.mGrain = 1000;
+        parallelSort(words.begin(), words.end(), std::less<std::string>(), options);
+        assert(std::equal(words.begin(), words.end(), expected.begin()));
+    }
+
+    // 稳定排序： 相等的键保持原有顺序
+    printf("-------------------- 稳定排序 --------------------\n");
+    {
+        auto                keys = randomValues(300000, 100, 11);
+        std::vector<Record> records(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            records[i].mKey = keys[i];
+            records[i].mSeq = static_cast<uint32_t>(i);
+        }
+        auto expected = records;
+        auto byKey    = [](const Record& a, const Record& b) { return a.mKey < b.mKey; };
+        std::stable_sort(expected.begin(), expected.end(), byKey);
+
+        TaskParallelOptions options;
+        options.mGrain = 5000;
+        parallelStableSort(records.begin(), records.end(), byKey, options);
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            assert(records[i].mKey == expected[i].mKey && records[i].mSeq == expected[i].mSeq);
+        }
+    }
+
+    printf("-------------------- 耗时 --------------------\n");
+    {
+        auto values = randomValues(1 << 22, UINT32_MAX, 7);
+        auto copy   = values;
+
+        auto start = std::chrono::steady_clock::now();
+        std::sort(copy.begin(), copy.end());
+        const auto stdCost = elapsedMs(start);
+
+        start = std::chrono::steady_clock::now();
+        parallelSort(values.begin(), values.end());
+        const auto parallelCost = elapsedMs(start);
+
+        printf("threads: %zu, std::sort: %lld ms, parallelSort: %lld ms\n", parallelConcurrency(), stdCost, parallelCost);
+        assert(values == copy);
+    }
+
+    printf("-------------并行排序测试完成-------------\n");
+    getchar();
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include "../TaskDispatch.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <stdio.h>
+#include <thread>
+using namespace task;
+
+// clang++ -o test TestPoolShutdown.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static long long elapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 每个线程池只能关闭一次， 两个场景分别使用独占线程池与并行线程池
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 线程池关闭测试 --------------------------------------\n");
+
+    auto& factory = TaskQueueFactory::GetInstance();
+
+    // 独占线程池： 执行完排队任务， 卡住的队列超时后取消剩余任务
+    printf("-------------------- 独占线程池 (TSP_Drain) --------------------\n");
+    {
+        auto blocked = factory.createSerialTaskQueue("shutdown_blocked", WorkThreadPriority::WTP_Normal, true);
+        auto normal  = factory.createSerialTaskQueue("shutdown_normal", WorkThreadPriority::WTP_Normal, true);
+
+        std::atomic<int> started{ 0 };
+        std::atomic<int> blockedRan{ 0 };
+        std::atomic<int> normalRan{ 0 };
+        blocked->async([&started]() {
+            started++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        });
+        for (int i = 0; i < 10; ++i)
+        {
+            blocked->async([&blockedRan]() { blockedRan++; });
+        }
+        for (int i = 0; i < 20; ++i)
+        {
+            normal->async([&normalRan]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                normalRan++;
+            });
+        }
+        while (started.load() == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto stat  = factory.shutdownPool(TaskQueueType::TQT_Serial, std::chrono::milliseconds(100), TaskShutdownPolicy::TSP_Drain);
+        auto cost  = elapsedMs(start);
+        printf("cost: %lld ms, dropped: %llu, joined: %u, busy: %u, timedOut: %d\n", cost, ( unsigned long long )stat.mDropped,
+               stat.mJoinedThreads, stat.mBusyThreads, stat.mTimedOut);
+        assert(normalRan.load() == 20);
+        assert(stat.mTimedOut);
+        assert(stat.mDropped == 10);
+        assert(stat.mBusyThreads == 1);
+        assert(stat.mJoinedThreads >= 1);
+        assert(cost < 250);
+
+        // 关闭后拒绝新任务， 同步任务立即返回
+        assert(normal->async([&normalRan]() { normalRan++; }) == TaskSubmitResult::TSR_Shutdown);
+        normal->sync([&normalRan]() { normalRan++; });
+        assert(normalRan.load() == 20);
+
+        // 只能关闭一次
+        auto again = factory.shutdownPool(TaskQueueType::TQT_Serial, std::chrono::milliseconds(100));
+        assert(again.mDropped == 0 && again.mJoinedThreads == 0);
+
+        // 卡住的任务执行完后线程自行退出， 剩余任务不再执行
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        assert(blockedRan.load() == 0);
+    }
+
+    // 并行线程池： 取消排队任务 (含非独占串行队列)， 只等待正在执行的任务
+    printf("-------------------- 并行线程池 (TSP_Cancel) --------------------\n");
+    {
+        auto parallel = factory.createConcurrencyTaskQueue("shutdown_parallel", TaskQueuePriority::TQP_Normal);
+        auto serial   = factory.createSerialTaskQueue("shutdown_serial", WorkThreadPriority::WTP_Normal, false);
+        auto group    = factory.createTaskGroup();
+
+        std::atomic<int> started{ 0 };
+        std::atomic<int> finished{ 0 };
+        std::atomic<int> ran{ 0 };
+        serial->async([&started, &finished]() {
+            started++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            finished++;
+        });
+        while (started.load() == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        for (int i = 0; i < 100; ++i)
+        {
+            group->asyncQueue([&ran]() { ran++; }, parallel);
+            serial->async([&ran]() { ran++; });
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto stat  = factory.shutdownPool(TaskQueueType::TQT_Parallel, std::chrono::milliseconds(2000), TaskShutdownPolicy::TSP_Cancel);
+        auto cost  = elapsedMs(start);
+        printf("cost: %lld ms, dropped: %llu, joined: %u, busy: %u, timedOut: %d\n", cost, ( unsigned long long )stat.mDropped,
+               stat.mJoinedThreads, stat.mBusyThreads, stat.mTimedOut);
+        assert(finished.load() == 1);
+        assert(ran.load() == 0);
+        assert(stat.mDropped == 200);
+        assert(!stat.mTimedOut && stat.mBusyThreads == 0);
+        assert(stat.mJoinedThreads >= 1);
+        assert(cost < 1000);
+
+        // 被取消的任务计为完成， 任务组不会卡住
+        assert(group->wait(std::chrono::milliseconds(100)));
+        assert(parallel->async([&ran]() { ran++; }) == TaskSubmitResult::TSR_Shutdown);
+        assert(serial->async([&ran]() { ran++; }) == TaskSubmitResult::TSR_Shutdown);
+        assert(ran.load() == 0);
+    }
+
+    printf("-------------线程池关闭测试完成-------------\n");
+    getchar();
+    return 0;
+}
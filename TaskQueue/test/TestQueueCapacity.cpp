@@ -0,0 +1,315 @@
+#include "../TaskDispatch.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+using namespace task;
+
+// clang++ -o test TestQueueCapacity.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static void printStat(const char* name, const TaskOverflowStat& stat)
+{
+    printf("%s: accepted: %llu, blocked: %llu, rejected: %llu, timeout: %llu, dropped: %llu, caller runs: %llu\n", name,
+           ( unsigned long long )stat.mAccepted, ( unsigned long long )stat.mBlocked, ( unsigned long long )stat.mRejected,
+           ( unsigned long long )stat.mTimedOut, ( unsigned long long )stat.mDropped, ( unsigned long long )stat.mCallerRuns);
+}
+
+static bool waitUntil(const std::atomic<int>& value, int expected)
+{
+    for (int i = 0; i < 200 && value.load() < expected; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return value.load() >= expected;
+}
+
+static void blockUntil(const std::atomic<bool>& release)
+{
+    while (!release.load())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 队列容量限制测试 --------------------------------------\n");
+
+    auto& factory = TaskQueueFactory::GetInstance();
+
+    // 非独占串行队列： 丢弃最早入队的任务
+    printf("-------------------- 串行队列 丢弃最早 --------------------\n");
+    {
+        auto queue = factory.createSerialTaskQueue("capacity_drop", WorkThreadPriority::WTP_Normal, false);
+        TaskCapacity capacity;
+        capacity.mMaxPending = 3;
+        capacity.mPolicy     = TaskOverflowPolicy::TOP_DropOldest;
+        assert(queue->setCapacity(capacity));
+
+        std::atomic<bool> release{ false };
+        std::atomic<int>  started{ 0 };
+        queue->async([&]() {
+            started++;
+            blockUntil(release);
+        });
+        assert(waitUntil(started, 1));
+
+        std::mutex       mutex;
+        std::vector<int> executed;
+        for (int i = 0; i < 5; ++i)
+        {
+            auto result = queue->async([i, &mutex, &executed]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                executed.push_back(i);
+            });
+            assert(result == (i < 3 ? TaskSubmitResult::TSR_Accepted : TaskSubmitResult::TSR_DroppedOldest));
+        }
+
+        auto stat = queue->overflowStat();
+        printStat("capacity_drop", stat);
+        assert(stat.mAccepted == 4 && stat.mDropped == 2);  // 含阻塞任务
+
+        // 取消限制后同步等待， 同步任务本身不会被丢弃
+        queue->setCapacity(TaskCapacity());
+        release = true;
+        queue->sync([]() {});
+        printf("executed: ");
+        for (auto i : executed)
+        {
+            printf("%d ", i);
+        }
+        printf("\n");
+        assert((executed == std::vector<int>{ 2, 3, 4 }));
+        assert(queue->metrics().mCancelled == 2);
+    }
+
+    // 独占串行队列： 拒绝， 被拒绝的同步任务立即返回
+    printf("-------------------- 独占队列 拒绝 --------------------\n");
+    {
+        auto queue = factory.createSerialTaskQueue("capacity_reject", WorkThreadPriority::WTP_Normal, true);
+        TaskCapacity capacity;
+        capacity.mMaxPending = 2;
+        capacity.mPolicy     = TaskOverflowPolicy::TOP_Reject;
+        assert(queue->setCapacity(capacity));
+
+        std::atomic<bool> release{ false };
+        std::atomic<int>  started{ 0 };
+        queue->async([&]() {
+            started++;
+            blockUntil(release);
+        });
+        assert(waitUntil(started, 1));
+
+        std::atomic<int> count{ 0 };
+        assert(queue->async([&count]() { count++; }) == TaskSubmitResult::TSR_Accepted);
+        assert(queue->async([&count]() { count++; }) == TaskSubmitResult::TSR_Accepted);
+
+        auto rejected = std::make_shared<TaskOperator>([&count](const TaskOperatorPtr&) { count++; });
+        assert(queue->async(rejected) == TaskSubmitResult::TSR_Rejected);
+        assert(rejected->isCancelled());
+
+        auto begin = std::chrono::steady_clock::now();
+        queue->sync([&count]() { count++; });
+        assert(std::chrono::steady_clock::now() - begin < std::chrono::milliseconds(500));
+
+        release = true;
+        assert(waitUntil(count, 2));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        assert(count.load() == 2);
+
+        auto stat = queue->overflowStat();
+        printStat("capacity_reject", stat);
+        assert(stat.mAccepted == 3 && stat.mRejected == 2);  // 含阻塞任务
+    }
+
+    // 串行队列： 在提交线程执行会与队列的工作线程并发， CallerRuns 退化为拒绝
+    printf("-------------------- 串行队列 CallerRuns --------------------\n");
+    {
+        auto queue = factory.createSerialTaskQueue("capacity_caller", WorkThreadPriority::WTP_Normal, false);
+        TaskCapacity capacity;
+        capacity.mMaxPending = 1;
+        capacity.mPolicy     = TaskOverflowPolicy::TOP_CallerRuns;
+        assert(queue->setCapacity(capacity));
+
+        std::atomic<bool> release{ false };
+        std::atomic<int>  started{ 0 };
+        queue->async([&]() {
+            started++;
+            blockUntil(release);
+        });
+        assert(waitUntil(started, 1));
+
+        std::atomic<int> count{ 0 };
+        assert(queue->async([&count]() { count++; }) == TaskSubmitResult::TSR_Accepted);
+        assert(queue->async([&count]() { count++; }) == TaskSubmitResult::TSR_Rejected);
+        assert(count.load() == 0);
+
+        release = true;
+        assert(waitUntil(count, 1));
+        auto stat = queue->overflowStat();
+        printStat("capacity_caller", stat);
+        assert(stat.mCallerRuns == 0 && stat.mRejected == 1);
+    }
+
+    // 多线程并发提交： 入队前原子地预留空位， 排队任务数不会超出上限
+    printf("-------------------- 并发提交不超出上限 --------------------\n");
+    for (bool exclusive : { false, true })
+    {
+        for (auto policy : { TaskOverflowPolicy::TOP_Reject, TaskOverflowPolicy::TOP_DropOldest })
+        {
+            auto queue = factory.createSerialTaskQueue("capacity_concurrent", WorkThreadPriority::WTP_Normal, exclusive);
+            TaskCapacity capacity;
+            capacity.mMaxPending = 4;
+            capacity.mPolicy     = policy;
+            assert(queue->setCapacity(capacity));
+
+            std::atomic<bool> release{ false };
+            std::atomic<int>  started{ 0 };
+            queue->async([&]() {
+                started++;
+                blockUntil(release);
+            });
+            assert(waitUntil(started, 1));
+
+            std::atomic<int>         accepted{ 0 };
+            std::atomic<int>         executed{ 0 };
+            std::vector<std::thread> producers;
+            for (int t = 0; t < 8; ++t)
+            {
+                producers.emplace_back([&]() {
+                    for (int i = 0; i < 500; ++i)
+                    {
+                        auto result = queue->async([&executed]() { executed++; });
+                        if (result == TaskSubmitResult::TSR_Accepted || result == TaskSubmitResult::TSR_DroppedOldest)
+                        {
+                            accepted++;
+                        }
+                    }
+                });
+            }
+            for (auto& producer : producers)
+            {
+                producer.join();
+            }
+
+            queue->setCapacity(TaskCapacity());
+            release = true;
+            queue->sync([]() {});
+            printf("exclusive: %d, policy: %d, accepted: %d, executed: %d\n", exclusive, ( int )policy, accepted.load(),
+                   executed.load());
+            assert(executed.load() == 4);
+            if (policy == TaskOverflowPolicy::TOP_Reject)
+            {
+                assert(accepted.load() == 4);
+            }
+        }
+    }
+
+    // 任务组： 被丢弃的任务同样归还计数， wait不会卡住
+    printf("-------------------- 任务组 --------------------\n");
+    {
+        auto queue = factory.createSerialTaskQueue("capacity_group", WorkThreadPriority::WTP_Normal, true);
+        TaskCapacity capacity;
+        capacity.mMaxPending = 1;
+        capacity.mPolicy     = TaskOverflowPolicy::TOP_DropOldest;
+        queue->setCapacity(capacity);
+
+        std::atomic<bool> release{ false };
+        std::atomic<int>  started{ 0 };
+        queue->async([&]() {
+            started++;
+            blockUntil(release);
+        });
+        assert(waitUntil(started, 1));
+
+        std::atomic<int> count{ 0 };
+        auto             group = factory.createTaskGroup();
+        for (int i = 0; i < 4; ++i)
+        {
+            group->asyncQueue([&count]() { count++; }, queue);
+        }
+        release = true;
+        assert(group->wait(std::chrono::milliseconds(2000)));
+        printStat("capacity_group", queue->overflowStat());
+        assert(count.load() == 1);
+    }
+
+    // 并行线程池： 占满所有工作线程后测试各策略
+    printf("-------------------- 并行线程池 --------------------\n");
+    {
+        auto queue = factory.createConcurrencyTaskQueue("capacity_pool", TaskQueuePriority::TQP_Normal);
+        assert(!queue->setCapacity(TaskCapacity()));
+
+        const int         workers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        std::atomic<bool> release{ false };
+        std::atomic<int>  started{ 0 };
+        for (int i = 0; i < workers; ++i)
+        {
+            queue->async([&]() {
+                started++;
+                blockUntil(release);
+            });
+            assert(waitUntil(started, i + 1));
+        }
+
+        TaskCapacity capacity;
+        capacity.mMaxPending = 2;
+        capacity.mPolicy     = TaskOverflowPolicy::TOP_Reject;
+        factory.setPoolCapacity(capacity);
+
+        std::atomic<int> count{ 0 };
+        assert(queue->async([&count]() { count++; }) == TaskSubmitResult::TSR_Accepted);
+        assert(queue->async([&count]() { count++; }) == TaskSubmitResult::TSR_Accepted);
+        assert(queue->async([&count]() { count++; }) == TaskSubmitResult::TSR_Rejected);
+
+        // 在提交线程执行
+        capacity.mPolicy = TaskOverflowPolicy::TOP_CallerRuns;
+        factory.setPoolCapacity(capacity);
+        std::thread::id runner;
+        assert(queue->async([&runner]() { runner = std::this_thread::get_id(); }) == TaskSubmitResult::TSR_CallerRan);
+        assert(runner == std::this_thread::get_id());
+
+        // 工作线程上提交时不执行用户任务， 退化为拒绝
+        auto             worker   = factory.createSerialTaskQueue("capacity_caller_worker", WorkThreadPriority::WTP_Normal, true);
+        TaskSubmitResult inWorker = TaskSubmitResult::TSR_Accepted;
+        worker->sync([&queue, &inWorker]() { inWorker = queue->async([]() {}); });
+        assert(inWorker == TaskSubmitResult::TSR_Rejected);
+
+        // 阻塞等待超时
+        capacity.mPolicy       = TaskOverflowPolicy::TOP_Block;
+        capacity.mBlockTimeout = std::chrono::milliseconds(50);
+        factory.setPoolCapacity(capacity);
+        auto begin  = std::chrono::steady_clock::now();
+        auto result = queue->async([&count]() { count++; });
+        auto cost   = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+        printf("block timeout cost: %lld ms\n", ( long long )cost);
+        assert(result == TaskSubmitResult::TSR_TimedOut);
+        assert(cost >= 50);
+
+        // 阻塞等待， 工作线程取走任务后入队
+        capacity.mBlockTimeout = std::chrono::milliseconds(-1);
+        factory.setPoolCapacity(capacity);
+        std::thread releaser([&release]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            release = true;
+        });
+        assert(queue->async([&count]() { count++; }) == TaskSubmitResult::TSR_Accepted);
+        releaser.join();
+
+        auto stat = factory.poolOverflowStat();
+        printStat("pool", stat);
+        assert(stat.mBlocked == 1);
+
+        assert(waitUntil(count, 3));
+        factory.setPoolCapacity(TaskCapacity());
+        printStat("pool reset", factory.poolOverflowStat());
+    }
+
+    printf("-------------队列容量限制测试完成-------------\n");
+    getchar();
+    return 0;
+}
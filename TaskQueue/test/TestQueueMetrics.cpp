@@ -0,0 +1,132 @@
+#include "../TaskDispatch.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <stdio.h>
+#include <string>
+#include <thread>
+using namespace task;
+
+// clang++ -o test TestQueueMetrics.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static TaskQueueMetrics findMetrics(const std::string& label)
+{
+    for (auto& metrics : TaskQueueFactory::GetInstance().queueMetrics())
+    {
+        if (metrics.mLabel == label)
+        {
+            return metrics;
+        }
+    }
+    return TaskQueueMetrics();
+}
+
+// 等待同名队列全部任务出队
+static TaskQueueMetrics waitIdle(const std::string& label)
+{
+    for (int i = 0; i < 500; ++i)
+    {
+        auto metrics = findMetrics(label);
+        if (metrics.mSubmitted > 0 && metrics.mInFlight == 0)
+        {
+            return metrics;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return findMetrics(label);
+}
+
+static void printMetrics(const TaskQueueMetrics& metrics)
+{
+    printf("%s: queues: %u, submitted: %llu, completed: %llu, cancelled: %llu, inflight: %llu, run p99: %llu us, wait p99: %llu us\n",
+           metrics.mLabel.c_str(), metrics.mQueueCount, ( unsigned long long )metrics.mSubmitted,
+           ( unsigned long long )metrics.mCompleted, ( unsigned long long )metrics.mCancelled,
+           ( unsigned long long )metrics.mInFlight, ( unsigned long long )metrics.mLatency.mRun.mP99,
+           ( unsigned long long )metrics.mLatency.mWait.mP99);
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 队列指标测试 --------------------------------------\n");
+
+    auto& factory = TaskQueueFactory::GetInstance();
+
+    // 同名队列合并， 取消的任务单独计数
+    printf("-------------------- 入队/完成/取消 --------------------\n");
+    {
+        auto queueA1 = factory.createConcurrencyTaskQueue("metrics_a", TaskQueuePriority::TQP_Normal);
+        auto queueA2 = factory.createConcurrencyTaskQueue("metrics_a", TaskQueuePriority::TQP_Normal);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            queueA1->async([]() { std::this_thread::sleep_for(std::chrono::microseconds(100)); });
+        }
+        for (int i = 0; i < 50; ++i)
+        {
+            auto task = std::make_shared<TaskOperator>([](const TaskOperatorPtr&) {});
+            if (i % 5 == 0)
+            {
+                task->cancel();
+            }
+            queueA2->async(task);
+        }
+
+        auto metrics = waitIdle("metrics_a");
+        printMetrics(metrics);
+        assert(metrics.mQueueCount == 2);
+        assert(metrics.mSubmitted == 150);
+        assert(metrics.mCompleted == 140);
+        assert(metrics.mCancelled == 10);
+        assert(metrics.mLatency.mRun.mCount == 140);
+
+        auto single = queueA1->metrics();
+        assert(single.mSubmitted == 100 && single.mCompleted == 100);
+
+        // 释放一个队列， 累计值保留
+        queueA2 = nullptr;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        metrics = findMetrics("metrics_a");
+        printMetrics(metrics);
+        assert(metrics.mQueueCount == 1);
+        assert(metrics.mSubmitted == 150);
+        assert(metrics.mCancelled == 10);
+    }
+
+    // 未完成数： 排队中 + 执行中
+    printf("-------------------- 未完成数 --------------------\n");
+    {
+        auto              queueB = factory.createSerialTaskQueue("metrics_b", WorkThreadPriority::WTP_Normal, false);
+        std::atomic<bool> release{ false };
+        queueB->async([&release]() {
+            while (!release.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        for (int i = 0; i < 5; ++i)
+        {
+            queueB->async([]() {});
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        auto metrics = findMetrics("metrics_b");
+        printMetrics(metrics);
+        assert(metrics.mInFlight == 6);
+
+        release = true;
+        metrics = waitIdle("metrics_b");
+        printMetrics(metrics);
+        assert(metrics.mCompleted == 6);
+    }
+
+    printf("-------------------- 全部队列 --------------------\n");
+    for (auto& metrics : factory.queueMetrics())
+    {
+        printMetrics(metrics);
+    }
+
+    printf("-------------队列指标测试完成-------------\n");
+    getchar();
+    return 0;
+}
@@ -0,0 +1,264 @@
+#include "../TaskDispatch.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+using namespace task;
+
+// clang++ -o test TestRateLimit.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static void printStat(const char* name, const TaskRateLimitStat& stat)
+{
+    printf("%s: immediate: %llu, delayed: %llu, pending: %llu, rejected: %llu\n", name, ( unsigned long long )stat.mImmediate,
+           ( unsigned long long )stat.mDelayed, ( unsigned long long )stat.mPending, ( unsigned long long )stat.mRejected);
+}
+
+static bool waitUntil(const std::atomic<int>& value, int expected, int timeoutMs = 5000)
+{
+    for (int i = 0; i < timeoutMs / 5 && value.load() < expected; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return value.load() >= expected;
+}
+
+static long long elapsedMs(std::chrono::steady_clock::time_point begin)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 速率限制测试 --------------------------------------\n");
+
+    auto& factory = TaskQueueFactory::GetInstance();
+
+    // 串行队列： 突发后按速率入队， 保持提交顺序
+    printf("-------------------- 串行队列 --------------------\n");
+    {
+        auto queue = factory.createSerialTaskQueue("rate_serial", WorkThreadPriority::WTP_Normal, false);
+        TaskRateLimit limit;
+        limit.mRate  = 50;
+        limit.mBurst = 5;
+        queue->setRateLimit(limit);
+
+        std::mutex       mutex;
+        std::vector<int> order;
+        std::atomic<int> count{ 0 };
+        auto             begin     = std::chrono::steady_clock::now();
+        int              immediate = 0;
+        for (int i = 0; i < 30; ++i)
+        {
+            auto result = queue->async([i, &mutex, &order, &count]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(i);
+                count++;
+            });
+            // 突发额度内立即入队 (提交期间按速率补充令牌， 负载高时可能多几个)， 之后全部排队
+            if (result == TaskSubmitResult::TSR_Accepted)
+            {
+                assert(immediate == i);
+                immediate++;
+            }
+            else
+            {
+                assert(result == TaskSubmitResult::TSR_RateLimited);
+            }
+        }
+        printStat("rate_serial", queue->rateLimitStat());
+        assert(immediate >= 5 && immediate <= 10);
+        assert(queue->rateLimitStat().mPending == static_cast<uint64_t>(30 - immediate));
+
+        // 剩余20~25个任务以每秒50个入队， 约400~500ms
+        assert(waitUntil(count, 30));
+        auto cost = elapsedMs(begin);
+        printf("immediate: %d, cost: %lld ms\n", immediate, cost);
+        assert(cost >= 300 && cost < 2000);
+        for (int i = 0; i < 30; ++i)
+        {
+            assert(order[i] == i);
+        }
+
+        auto stat = queue->rateLimitStat();
+        printStat("rate_serial", stat);
+        assert(stat.mImmediate == static_cast<uint64_t>(immediate) && stat.mDelayed == static_cast<uint64_t>(30 - immediate)
+               && stat.mPending == 0);
+    }
+
+    // 并行队列： 工作线程不为限速休眠， 其他队列的任务不受影响
+    printf("-------------------- 并行队列 --------------------\n");
+    {
+        auto limited = factory.createConcurrencyTaskQueue("rate_parallel", TaskQueuePriority::TQP_Normal);
+        auto other   = factory.createConcurrencyTaskQueue("rate_other", TaskQueuePriority::TQP_Normal);
+        TaskRateLimit limit;
+        limit.mRate  = 20;
+        limit.mBurst = 1;
+        limited->setRateLimit(limit);
+
+        std::atomic<int> count{ 0 };
+        for (int i = 0; i < 10; ++i)
+        {
+            limited->async([&count]() { count++; });
+        }
+
+        auto             begin = std::chrono::steady_clock::now();
+        std::atomic<int> otherCount{ 0 };
+        for (int i = 0; i < 100; ++i)
+        {
+            other->async([&otherCount]() { otherCount++; });
+        }
+        assert(waitUntil(otherCount, 100));
+        printf("other queue cost: %lld ms, limited done: %d\n", elapsedMs(begin), count.load());
+        assert(count.load() < 10);
+
+        assert(waitUntil(count, 10));
+        printStat("rate_parallel", limited->rateLimitStat());
+    }
+
+    // 延时任务到期同样限速； 取消限制时暂存任务立即入队
+    printf("-------------------- 取消限制 --------------------\n");
+    {
+        auto queue = factory.createSerialTaskQueue("rate_reset", WorkThreadPriority::WTP_Normal, true);
+        TaskRateLimit limit;
+        limit.mRate  = 1;
+        limit.mBurst = 1;
+        queue->setRateLimit(limit);
+
+        std::atomic<int> count{ 0 };
+        for (int i = 0; i < 5; ++i)
+        {
+            queue->async([&count]() { count++; });
+        }
+        queue->after(std::chrono::milliseconds(10), [&count]() { count++; });
+        assert(waitUntil(count, 1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        assert(count.load() == 1);
+        printStat("rate_reset", queue->rateLimitStat());
+        assert(queue->rateLimitStat().mPending == 5);
+
+        auto begin = std::chrono::steady_clock::now();
+        queue->setRateLimit(TaskRateLimit());
+        assert(waitUntil(count, 6));
+        printf("flush cost: %lld ms\n", elapsedMs(begin));
+        assert(elapsedMs(begin) < 500);
+        assert(queue->async([]() {}) == TaskSubmitResult::TSR_Accepted);
+    }
+
+    // 队列释放时暂存的任务被丢弃， 任务组不会卡住
+    printf("-------------------- 队列释放 --------------------\n");
+    {
+        std::atomic<int> count{ 0 };
+        auto             group = factory.createTaskGroup();
+        {
+            auto queue = factory.createSerialTaskQueue("rate_release", WorkThreadPriority::WTP_Normal, false);
+            TaskRateLimit limit;
+            limit.mRate  = 1;
+            limit.mBurst = 1;
+            queue->setRateLimit(limit);
+            for (int i = 0; i < 3; ++i)
+            {
+                group->asyncQueue([&count]() { count++; }, queue);
+            }
+            assert(waitUntil(count, 1));
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            assert(queue->rateLimitStat().mPending == 2);
+        }
+        assert(group->wait(std::chrono::milliseconds(2000)));
+        printf("released queue, executed: %d\n", count.load());
+        assert(count.load() == 1);
+    }
+
+    // 容量限制： 暂存前预留空位， 暂存数不超过容量上限， 超出时提交方立即得到拒绝
+    printf("-------------------- 容量限制 --------------------\n");
+    {
+        auto queue = factory.createSerialTaskQueue("rate_capacity", WorkThreadPriority::WTP_Normal, false);
+        std::atomic<bool> release{ false };
+        std::atomic<int>  started{ 0 };
+        queue->async([&]() {
+            started++;
+            while (!release.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        assert(waitUntil(started, 1));
+
+        TaskCapacity capacity;
+        capacity.mMaxPending = 3;
+        capacity.mPolicy     = TaskOverflowPolicy::TOP_Reject;
+        assert(queue->setCapacity(capacity));
+        TaskRateLimit limit;
+        limit.mRate  = 1;
+        limit.mBurst = 1;
+        queue->setRateLimit(limit);
+
+        std::atomic<int> count{ 0 };
+        int              limited  = 0;
+        int              rejected = 0;
+        for (int i = 0; i < 10; ++i)
+        {
+            auto result = queue->async([&count]() { count++; });
+            if (i == 0)
+            {
+                assert(result == TaskSubmitResult::TSR_Accepted);
+            }
+            else if (result == TaskSubmitResult::TSR_RateLimited)
+            {
+                limited++;
+            }
+            else
+            {
+                assert(result == TaskSubmitResult::TSR_Rejected);
+                rejected++;
+            }
+        }
+        printStat("rate_capacity", queue->rateLimitStat());
+        assert(limited == 2 && rejected == 7);
+        assert(queue->rateLimitStat().mPending == 2);
+        assert(queue->overflowStat().mRejected == 7);
+
+        // 取消限制后暂存的任务入队， 不会因容量再被拒绝
+        release = true;
+        queue->setRateLimit(TaskRateLimit());
+        assert(waitUntil(count, 3));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        assert(count.load() == 3);
+        assert(queue->rateLimitStat().mRejected == 0);
+        assert(queue->overflowStat().mRejected == 7);
+    }
+
+    // 暂存后入队时被拒绝 (线程池已关闭)： 计入被拒绝数， 等待方被唤醒 【关闭串行线程池， 放在最后】
+    printf("-------------------- 暂存后被拒绝 --------------------\n");
+    {
+        auto queue = factory.createSerialTaskQueue("rate_shutdown", WorkThreadPriority::WTP_Normal, true);
+        TaskRateLimit limit;
+        limit.mRate  = 20;
+        limit.mBurst = 1;
+        queue->setRateLimit(limit);
+
+        std::atomic<int> count{ 0 };
+        auto             group = factory.createTaskGroup();
+        for (int i = 0; i < 10; ++i)
+        {
+            group->asyncQueue([&count]() { count++; }, queue);
+        }
+        auto delayed = queue->rateLimitStat().mPending;
+        factory.shutdownPool(TaskQueueType::TQT_Serial, std::chrono::milliseconds(1000), TaskShutdownPolicy::TSP_Cancel);
+
+        assert(group->wait(std::chrono::milliseconds(3000)));
+        auto stat = queue->rateLimitStat();
+        printStat("rate_shutdown", stat);
+        printf("delayed: %llu, executed: %d\n", ( unsigned long long )delayed, count.load());
+        assert(stat.mPending == 0);
+        assert(stat.mRejected == delayed);
+        assert(count.load() <= 1);
+    }
+
+    printf("-------------速率限制测试完成-------------\n");
+    getchar();
+    return 0;
+}
@@ -0,0 +1,243 @@
+#include "../TaskDispatch.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+using namespace task;
+
+// clang++ -o test TestTaskCancel.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+// 任务捕获的资源， 统计存活数量
+struct Payload
+{
+    static std::atomic<int> sAlive;
+    std::vector<char>       mData;
+
+    Payload()
+        : mData(1024)
+    {
+        sAlive++;
+    }
+    ~Payload()
+    {
+        sAlive--;
+    }
+};
+std::atomic<int> Payload::sAlive{ 0 };
+
+static bool waitUntil(const std::atomic<int>& value, int expected, int timeoutMs = 2000)
+{
+    for (int i = 0; i < timeoutMs / 5 && value.load() < expected; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return value.load() >= expected;
+}
+
+static void blockUntil(const std::atomic<bool>& release)
+{
+    while (!release.load())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 任务取消测试 --------------------------------------\n");
+
+    auto& factory = TaskQueueFactory::GetInstance();
+
+    // 串行队列： 取消后立即释放捕获的资源， 出队时跳过
+    printf("-------------------- 串行队列 --------------------\n");
+    {
+        auto queue = factory.createSerialTaskQueue("cancel_serial", WorkThreadPriority::WTP_Normal, true);
+        queue->setCancelTracking(true);
+
+        std::atomic<bool> release{ false };
+        std::atomic<int>  started{ 0 };
+        queue->async([&]() {
+            started++;
+            blockUntil(release);
+        });
+        assert(waitUntil(started, 1));
+
+        std::atomic<int> ran{ 0 };
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto payload = std::make_shared<Payload>();
+            queue->async([payload, &ran]() { ran++; });
+        }
+        queue->after(std::chrono::milliseconds(50), [&ran]() { ran++; });
+        assert(Payload::sAlive.load() == 1000);
+
+        auto cancelled = queue->cancelAll();
+        printf("cancelled: %zu, alive payload: %d\n", cancelled, Payload::sAlive.load());
+        assert(cancelled == 1002);  // 含阻塞任务
+        assert(Payload::sAlive.load() == 0);
+
+        release = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        queue->sync([]() {});
+        assert(ran.load() == 0);
+        printf("metrics cancelled: %llu\n", ( unsigned long long )queue->metrics().mCancelled);
+        assert(queue->metrics().mCancelled >= 1000);
+
+        // 之后提交的任务不受影响
+        queue->sync([&ran]() { ran++; });
+        assert(ran.load() == 1);
+    }
+
+    // 未开启记录： 提交不记录， cancelAll 不影响已提交的任务
+    printf("-------------------- 未开启记录 --------------------\n");
+    {
+        auto queue = factory.createSerialTaskQueue("cancel_untracked", WorkThreadPriority::WTP_Normal, true);
+
+        std::atomic<bool> release{ false };
+        std::atomic<int>  started{ 0 };
+        queue->async([&]() {
+            started++;
+            blockUntil(release);
+        });
+        assert(waitUntil(started, 1));
+
+        std::atomic<int> ran{ 0 };
+        for (int i = 0; i < 10; ++i)
+        {
+            queue->async([&ran]() { ran++; });
+        }
+        assert(queue->cancelAll() == 0);
+        release = true;
+        queue->sync([]() {});
+        printf("untracked ran: %d\n", ran.load());
+        assert(ran.load() == 10);
+    }
+
+    // 非独占串行队列 + 周期任务
+    printf("-------------------- 周期任务 --------------------\n");
+    {
+        auto             queue = factory.createSerialTaskQueue("cancel_every", WorkThreadPriority::WTP_Normal, false);
+        queue->setCancelTracking(true);
+        std::atomic<int> ticks{ 0 };
+        auto             handle = queue->every(std::chrono::milliseconds(10), std::chrono::milliseconds(0), [&ticks]() { ticks++; });
+        assert(waitUntil(ticks, 3));
+        assert(queue->cancelAll() >= 1);
+        assert(handle->isCancelled());
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        const int stopped = ticks.load();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        printf("ticks: %d\n", ticks.load());
+        assert(ticks.load() == stopped);
+    }
+
+    // 任务组： 被取消的任务计为完成， wait不会卡住
+    printf("-------------------- 任务组 --------------------\n");
+    {
+        auto queue   = factory.createConcurrencyTaskQueue("cancel_group", TaskQueuePriority::TQP_Normal);
+        auto blocker = factory.createSerialTaskQueue("cancel_group_blocker", WorkThreadPriority::WTP_Normal, true);
+
+        std::atomic<bool> release{ false };
+        std::atomic<int>  started{ 0 };
+        blocker->async([&]() {
+            started++;
+            blockUntil(release);
+        });
+        assert(waitUntil(started, 1));
+
+        auto             group = factory.createTaskGroup();
+        std::atomic<int> ran{ 0 };
+        for (int i = 0; i < 100; ++i)
+        {
+            auto payload = std::make_shared<Payload>();
+            group->asyncQueue([payload, &ran]() { ran++; }, blocker);
+        }
+        auto cancelled = group->cancelAll();
+        printf("group cancelled: %zu, alive payload: %d\n", cancelled, Payload::sAlive.load());
+        assert(cancelled == 100);
+        assert(Payload::sAlive.load() == 0);
+
+        release = true;
+        assert(group->wait(std::chrono::milliseconds(2000)));
+        assert(ran.load() == 0);
+
+        // 任务组可以继续使用
+        group->asyncQueue([&ran]() { ran++; }, queue);
+        assert(group->wait(std::chrono::milliseconds(2000)));
+        assert(ran.load() == 1);
+    }
+
+    // 标签： 跨队列取消带同一标签的任务， 其他任务正常执行
+    printf("-------------------- 标签 --------------------\n");
+    {
+        auto serial     = factory.createSerialTaskQueue("cancel_tag_serial", WorkThreadPriority::WTP_Normal, true);
+        auto concurrent = factory.createConcurrencyTaskQueue("cancel_tag_parallel", TaskQueuePriority::TQP_Low);
+        auto scope      = std::make_shared<TaskCancelScope>();
+
+        std::atomic<bool> release{ false };
+        std::atomic<int>  started{ 0 };
+        serial->async([&]() {
+            started++;
+            blockUntil(release);
+        });
+        assert(waitUntil(started, 1));
+
+        std::atomic<int> tagged{ 0 };
+        std::atomic<int> untagged{ 0 };
+        for (int i = 0; i < 10; ++i)
+        {
+            auto task = std::make_shared<TaskOperator>([&tagged](const TaskOperatorPtr&) { tagged++; });
+            task->setCancelScope(scope);
+            serial->async(task);
+            serial->async([&untagged]() { untagged++; });
+        }
+        auto delayed = std::make_shared<TaskOperator>([&tagged](const TaskOperatorPtr&) { tagged++; });
+        delayed->setCancelScope(scope);
+        concurrent->after(std::chrono::milliseconds(100), delayed);
+
+        assert(scope->trackedCount() == 11);
+        assert(scope->cancel() == 11);
+        assert(scope->trackedCount() == 0);
+
+        release = true;
+        serial->sync([]() {});
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        printf("tagged: %d, untagged: %d\n", tagged.load(), untagged.load());
+        assert(tagged.load() == 0 && untagged.load() == 10);
+    }
+
+    // 正在执行的任务： 执行结束后释放
+    printf("-------------------- 执行中取消 --------------------\n");
+    {
+        auto queue = factory.createConcurrencyTaskQueue("cancel_running", TaskQueuePriority::TQP_Normal);
+        queue->setCancelTracking(true);
+
+        std::atomic<bool> release{ false };
+        std::atomic<int>  started{ 0 };
+        {
+            auto payload = std::make_shared<Payload>();
+            queue->async([payload, &release, &started]() {
+                started++;
+                blockUntil(release);
+            });
+        }
+        assert(waitUntil(started, 1));
+        assert(queue->cancelAll() == 1);
+        assert(Payload::sAlive.load() == 1);
+
+        release = true;
+        for (int i = 0; i < 200 && Payload::sAlive.load() > 0; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        assert(Payload::sAlive.load() == 0);
+    }
+
+    printf("-------------任务取消测试完成-------------\n");
+    getchar();
+    return 0;
+}
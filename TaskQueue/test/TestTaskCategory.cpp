@@ -0,0 +1,110 @@
+#include "../TaskDispatch.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <stdio.h>
+#include <string>
+#include <thread>
+using namespace task;
+
+// clang++ -o test TestTaskCategory.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static TaskCategoryStat findStat(TaskCategory category)
+{
+    for (auto& stat : TaskQueueFactory::GetInstance().taskCategoryStats())
+    {
+        if (stat.mCategory == category)
+        {
+            return stat;
+        }
+    }
+    return TaskCategoryStat();
+}
+
+static void printStat(const TaskCategoryStat& stat)
+{
+    printf("%s(%u): cnt: %llu, run: %llu us, wait: %llu us, cpu: %llu us, cpu ratio: %.2f\n", stat.mName.c_str(), stat.mCategory,
+           ( unsigned long long )stat.mCount, ( unsigned long long )stat.mRunMicros, ( unsigned long long )stat.mWaitMicros,
+           ( unsigned long long )stat.mCpuMicros, stat.cpuRatio());
+}
+
+static void busyFor(std::chrono::milliseconds duration)
+{
+    auto              end  = std::chrono::steady_clock::now() + duration;
+    volatile uint64_t sink = 0;
+    while (std::chrono::steady_clock::now() < end)
+    {
+        sink = sink + 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 任务类别测试 --------------------------------------\n");
+
+    auto& factory = TaskQueueFactory::GetInstance();
+
+    // 同名类别返回同一ID
+    printf("-------------------- 注册 --------------------\n");
+    const auto cpuCategory = factory.registerTaskCategory("cpu_bound");
+    const auto ioCategory  = factory.registerTaskCategory("io_bound");
+    assert(cpuCategory != kNoTaskCategory && ioCategory != kNoTaskCategory);
+    assert(cpuCategory != ioCategory);
+    assert(factory.registerTaskCategory("cpu_bound") == cpuCategory);
+    printf("cpu_bound: %u, io_bound: %u\n", cpuCategory, ioCategory);
+
+    // CPU密集任务的CPU耗时接近执行耗时， 休眠任务的CPU耗时接近0
+    printf("-------------------- 类别统计 --------------------\n");
+    {
+        auto queue = factory.createConcurrencyTaskQueue("category_queue", TaskQueuePriority::TQP_Normal);
+        for (int i = 0; i < 10; ++i)
+        {
+            queue->async(cpuCategory, []() { busyFor(std::chrono::milliseconds(5)); });
+            queue->async(ioCategory, []() { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+            queue->async([]() { busyFor(std::chrono::milliseconds(1)); });  // 未分类
+        }
+
+        // 同步/延时任务的包装任务继承类别
+        auto syncTask = std::make_shared<TaskOperator>([](const TaskOperatorPtr&) { busyFor(std::chrono::milliseconds(5)); });
+        syncTask->setCategory(cpuCategory);
+        queue->sync(syncTask);
+        assert(syncTask->taskCpuDurationMicros() > 0);
+        assert(syncTask->taskCostInfo().find("tskType:" + std::to_string(cpuCategory)) == 0);
+
+        auto afterTask = std::make_shared<TaskOperator>([](const TaskOperatorPtr&) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+        afterTask->setCategory(ioCategory);
+        queue->after(std::chrono::milliseconds(10), afterTask);
+
+        for (int i = 0; i < 300 && (findStat(cpuCategory).mCount < 11 || findStat(ioCategory).mCount < 11); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        auto cpuStat = findStat(cpuCategory);
+        auto ioStat  = findStat(ioCategory);
+        printStat(cpuStat);
+        printStat(ioStat);
+        assert(cpuStat.mName == "cpu_bound" && cpuStat.mCount == 11);
+        assert(ioStat.mName == "io_bound" && ioStat.mCount == 11);
+        assert(cpuStat.mRunMicros >= 11 * 5000);
+        assert(ioStat.mRunMicros >= 11 * 5000);
+        assert(cpuStat.cpuRatio() > ioStat.cpuRatio());
+        assert(ioStat.cpuRatio() < 0.5);
+
+        // 未分类任务不读取CPU时间
+        auto plain = std::make_shared<TaskOperator>([](const TaskOperatorPtr&) { busyFor(std::chrono::milliseconds(2)); });
+        queue->sync(plain);
+        assert(plain->category() == kNoTaskCategory && plain->taskCpuDurationMicros() == 0);
+    }
+
+    printf("-------------------- 全部类别 --------------------\n");
+    for (auto& stat : factory.taskCategoryStats())
+    {
+        printStat(stat);
+    }
+
+    printf("-------------任务类别测试完成-------------\n");
+    getchar();
+    return 0;
+}
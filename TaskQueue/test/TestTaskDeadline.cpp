@@ -0,0 +1,161 @@
+#include "../TaskDispatch.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+using namespace task;
+
+// clang++ -o test TestTaskDeadline.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+// 占满并行线程池的所有工作线程， 返回是否全部阻塞成功
+static bool blockWorkers(const TaskQueuePtr& queue, int workers, std::atomic<int>& started, std::atomic<bool>& gate)
+{
+    for (int i = 0; i < workers; ++i)
+    {
+        queue->async([&started, &gate]() {
+            started++;
+            while (!gate)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+
+    for (int i = 0; i < 1000 && started < workers; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return started == workers;
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 截止时间调度测试 --------------------------------------\n");
+
+    auto&     factory = TaskQueueFactory::GetInstance();
+    auto      queue   = factory.globalConcurrencyQueue(TaskQueuePriority::TQP_High);
+    const int workers = std::max(1u, std::thread::hardware_concurrency());
+
+    // EDF通道优先于优先级队列， 并按截止时间先后执行
+    printf("-------------------- EDF 优先调度 --------------------\n");
+    {
+        std::atomic<int>  started{ 0 };
+        std::atomic<bool> gate{ false };
+        bool              blocked = blockWorkers(queue, workers, started, gate);
+
+        std::mutex       mutex;
+        std::vector<int> order;  // >= 0 截止时间任务(按截止时间编号)， -1 普通任务
+        for (int i = 0; i < 50; ++i)
+        {
+            queue->async([&mutex, &order]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(-1);
+            });
+        }
+
+        const int budgets[] = { 400, 100, 300, 200, 500 };
+        for (auto budget : budgets)
+        {
+            auto task = std::make_shared<TaskOperator>([&mutex, &order, budget](const TaskOperatorPtr&) {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(budget);
+            });
+            task->setDeadline(std::chrono::milliseconds(budget));
+            queue->async(task);
+        }
+
+        gate = true;
+        queue->sync([]() {});
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        std::lock_guard<std::mutex> lock(mutex);
+        assert(order.size() == 55);
+        int lastDeadline = -1;
+        int deadlineSeen = 0;
+        for (size_t i = 0; i < order.size() && deadlineSeen < 5; ++i)
+        {
+            if (order[i] >= 0)
+            {
+                deadlineSeen++;
+                // 单线程时严格按截止时间顺序
+                if (workers == 1 && blocked)
+                {
+                    assert(order[i] > lastDeadline);
+                }
+                lastDeadline = order[i];
+            }
+            else if (blocked)
+            {
+                // 截止时间任务全部执行前， 普通任务最多被其他工作线程并发取走
+                assert(static_cast<int>(i) - deadlineSeen < workers);
+            }
+        }
+        printf("截止时间任务先于普通任务执行, workers: %d, blocked: %d\n", workers, blocked);
+    }
+
+    // 错过截止时间： 计入错过率， 可选丢弃
+    printf("-------------------- 错过截止时间 --------------------\n");
+    {
+        auto before = factory.deadlineStat();
+
+        std::atomic<int>  started{ 0 };
+        std::atomic<bool> gate{ false };
+        blockWorkers(queue, workers, started, gate);
+
+        std::atomic<bool> keptRun{ false };
+        std::atomic<bool> droppedRun{ false };
+        auto              kept = std::make_shared<TaskOperator>([&keptRun](const TaskOperatorPtr&) { keptRun = true; });
+        auto              dropped = std::make_shared<TaskOperator>([&droppedRun](const TaskOperatorPtr&) { droppedRun = true; });
+        kept->setDeadline(std::chrono::milliseconds(5));
+        dropped->setDeadline(std::chrono::milliseconds(5), true);
+        queue->async(kept);
+        queue->async(dropped);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        gate = true;
+        queue->sync([]() {});
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        auto after = factory.deadlineStat();
+        printf("scheduled: %llu, started: %llu, missed: %llu, dropped: %llu, missRate: %.2f\n",
+               ( unsigned long long )after.mScheduled,
+               ( unsigned long long )after.mStarted,
+               ( unsigned long long )after.mMissed,
+               ( unsigned long long )after.mDropped,
+               after.missRate());
+        assert(keptRun);
+        assert(!droppedRun);
+        assert(after.mScheduled - before.mScheduled == 2);
+        assert(after.mMissed - before.mMissed == 2);
+        assert(after.mDropped - before.mDropped == 1);
+        assert(after.missRate() > 0.0);
+    }
+
+    // 丢弃的任务唤醒等待方： 任务组计数被释放， wait不会挂起
+    printf("-------------------- 丢弃后唤醒等待方 --------------------\n");
+    {
+        std::atomic<int>  started{ 0 };
+        std::atomic<bool> gate{ false };
+        blockWorkers(queue, workers, started, gate);
+
+        std::atomic<bool> droppedRun{ false };
+        auto              group   = factory.createTaskGroup();
+        auto              dropped = std::make_shared<TaskOperator>([&droppedRun](const TaskOperatorPtr&) { droppedRun = true; });
+        dropped->setDeadline(std::chrono::milliseconds(5), true);
+        group->asyncQueue(dropped, queue);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        gate = true;
+        assert(group->wait(std::chrono::milliseconds(2000)));
+        assert(!droppedRun);
+        printf("丢弃的任务已释放任务组等待\n");
+    }
+
+    printf("-------------截止时间调度测试完成-------------\n");
+    getchar();
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include "../TaskDispatch.h"
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <stdio.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+using namespace task;
+
+// clang++ -o test TestTaskFileIo.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+// 等待条件成立， 超时返回false
+template <typename Pred>
+static bool waitFor(Pred&& pred, int timeoutMs = 10000)
+{
+    for (int i = 0; i < timeoutMs && !pred(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return pred();
+}
+
+static void testBackend(TaskFileIoBackend preferred)
+{
+    auto& factory = TaskQueueFactory::GetInstance();
+    auto  io      = factory.createTaskFileIo(preferred);
+    auto  queue   = factory.createSerialTaskQueue("file_io_done", WorkThreadPriority::WTP_Normal, true);
+    printf("backend: %s\n", io->backend() == TaskFileIoBackend::TFB_IoUring ? "io_uring" : "thread pool");
+    if (preferred == TaskFileIoBackend::TFB_ThreadPool)
+    {
+        assert(io->backend() == TaskFileIoBackend::TFB_ThreadPool);
+    }
+
+    char path[] = "/tmp/task_file_io_XXXXXX";
+    int  fd     = ::mkstemp(path);
+    assert(fd >= 0);
+    ::unlink(path);
+
+    // 回调在指定队列执行
+    std::thread::id   queueThread;
+    std::atomic<bool> ready{ false };
+    queue->async([&] {
+        queueThread = std::this_thread::get_id();
+        ready       = true;
+    });
+    assert(waitFor([&] { return ready.load(); }));
+
+    // 并发写入不同偏移， 刷盘后读回校验
+    const int                      blocks    = 64;
+    const size_t                   blockSize = 4096;
+    std::vector<std::vector<char>> data(blocks, std::vector<char>(blockSize));
+    for (int i = 0; i < blocks; ++i)
+    {
+        memset(data[i].data(), 'a' + i % 26, blockSize);
+    }
+
+    std::atomic<int>  written{ 0 };
+    std::atomic<int>  failed{ 0 };
+    std::atomic<bool> offQueue{ false };
+    for (int i = 0; i < blocks; ++i)
+    {
+        assert(io->write(fd, data[i].data(), blockSize, i * blockSize, queue, [&, i](int64_t result) {
+            if (result != static_cast<int64_t>(blockSize))
+            {
+                failed++;
+            }
+            if (std::this_thread::get_id() != queueThread)
+            {
+                offQueue = true;
+            }
+            written++;
+        }));
+    }
+    assert(waitFor([&] { return written.load() == blocks; }));
+    assert(failed.load() == 0);
+    assert(!offQueue.load());
+
+    std::atomic<int64_t> synced{ 1 };
+    assert(io->fsync(fd, queue, [&](int64_t result) { synced = result; }, true));
+    assert(waitFor([&] { return synced.load() != 1; }));
+    assert(synced.load() == 0);
+
+    std::vector<std::vector<char>> readBack(blocks, std::vector<char>(blockSize));
+    std::atomic<int>               readDone{ 0 };
+    for (int i = 0; i < blocks; ++i)
+    {
+        assert(io->read(fd, readBack[i].data(), blockSize, i * blockSize, nullptr, [&](int64_t result) {
+            if (result != static_cast<int64_t>(blockSize))
+            {
+                failed++;
+            }
+            readDone++;
+        }));
+    }
+    assert(waitFor([&] { return readDone.load() == blocks; }));
+    assert(failed.load() == 0);
+    for (int i = 0; i < blocks; ++i)
+    {
+        assert(readBack[i] == data[i]);
+    }
+
+    // 读到文件末尾： 字节数少于请求长度， 超出末尾为0
+    std::vector<char>    tail(blockSize * 2);
+    std::atomic<int64_t> tailResult{ -1 };
+    std::atomic<int64_t> eofResult{ -1 };
+    assert(io->read(fd, tail.data(), tail.size(), (blocks - 1) * blockSize, queue, [&](int64_t result) { tailResult = result; }));
+    assert(io->read(fd, tail.data(), tail.size(), blocks * blockSize * 2, queue, [&](int64_t result) { eofResult = result; }));
+    assert(waitFor([&] { return tailResult.load() >= 0 && eofResult.load() >= 0; }));
+    assert(tailResult.load() == static_cast<int64_t>(blockSize));
+    assert(eofResult.load() == 0);
+
+    // 错误以 -errno 返回
+    int                  closed = ::dup(fd);
+    ::close(closed);
+    std::atomic<int64_t> errorResult{ 0 };
+    assert(!io->read(-1, tail.data(), tail.size(), 0, queue, [](int64_t) {}));
+    assert(io->read(closed, tail.data(), tail.size(), 0, queue, [&](int64_t result) { errorResult = result; }));
+    assert(waitFor([&] { return errorResult.load() != 0; }));
+    assert(errorResult.load() == -EBADF);
+
+    // 回调队列已满： IO已经完成， 回调不受容量限制 (TOP_Block 时IO线程不阻塞)， 每个请求都会回调
+    {
+        auto         full = factory.createSerialTaskQueue("file_io_full", WorkThreadPriority::WTP_Normal, false);
+        TaskCapacity capacity;
+        capacity.mMaxPending = 1;
+        capacity.mPolicy     = TaskOverflowPolicy::TOP_Block;
+        assert(full->setCapacity(capacity));
+
+        std::atomic<bool> release{ false };
+        std::atomic<bool> started{ false };
+        full->async([&] {
+            started = true;
+            while (!release.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        assert(waitFor([&] { return started.load(); }));
+        assert(full->async([] {}) == TaskSubmitResult::TSR_Accepted);
+
+        std::atomic<int64_t> fullResult{ -1 };
+        std::atomic<int64_t> afterResult{ -1 };
+        assert(io->read(fd, tail.data(), blockSize, 0, full, [&](int64_t result) { fullResult = result; }));
+        assert(io->read(fd, tail.data(), blockSize, 0, queue, [&](int64_t result) { afterResult = result; }));
+        assert(waitFor([&] { return afterResult.load() >= 0; }, 2000));
+        assert(full->overflowStat().mBlocked == 0);
+
+        release = true;
+        assert(waitFor([&] { return fullResult.load() >= 0; }));
+        assert(fullResult.load() == static_cast<int64_t>(blockSize));
+    }
+
+    // 拒绝策略 + 速率限制： 回调不被拒绝也不被限速
+    {
+        auto         limited = factory.createSerialTaskQueue("file_io_limited", WorkThreadPriority::WTP_Normal, true);
+        TaskCapacity capacity;
+        capacity.mMaxPending = 2;
+        capacity.mPolicy     = TaskOverflowPolicy::TOP_Reject;
+        assert(limited->setCapacity(capacity));
+        TaskRateLimit limit;
+        limit.mRate  = 1;
+        limit.mBurst = 1;
+        limited->setRateLimit(limit);
+
+        std::atomic<bool> release{ false };
+        std::atomic<bool> started{ false };
+        limited->async([&] {
+            started = true;
+            while (!release.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        assert(waitFor([&] { return started.load(); }));
+
+        const int         count = 64;
+        std::atomic<int>  called{ 0 };
+        std::atomic<int>  failed{ 0 };
+        const auto        dropped = io->stat().mDropped;
+        for (int i = 0; i < count; ++i)
+        {
+            assert(io->read(fd, tail.data(), blockSize, 0, limited, [&](int64_t result) {
+                if (result != static_cast<int64_t>(blockSize))
+                {
+                    failed++;
+                }
+                called++;
+            }));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        release = true;
+        assert(waitFor([&] { return called.load() == count; }, 2000));
+        assert(failed.load() == 0);
+        assert(io->stat().mDropped == dropped);
+        assert(limited->overflowStat().mRejected == 0);
+    }
+
+    // 批量提交： 一次提交多个请求； 释放时等待已提交的请求完成
+    std::atomic<int> batchDone{ 0 };
+    const int        batchCount = 1000;
+    std::vector<char> scratch(512 * batchCount);
+    for (int i = 0; i < batchCount; ++i)
+    {
+        io->read(fd, scratch.data() + i * 512, 512, (i % blocks) * blockSize, queue, [&](int64_t) { batchDone++; });
+    }
+    auto stat = io->stat();
+    io.reset();
+    assert(waitFor([&] { return batchDone.load() == batchCount; }));
+    printf("submitted: %llu, completed: %llu, batches: %llu, dropped: %llu\n", ( unsigned long long )stat.mSubmitted,
+           ( unsigned long long )stat.mCompleted, ( unsigned long long )stat.mBatches, ( unsigned long long )stat.mDropped);
+    if (stat.mBackend == TaskFileIoBackend::TFB_IoUring)
+    {
+        assert(stat.mBatches > 0 && stat.mBatches < stat.mSubmitted);
+    }
+    ::close(fd);
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 异步文件IO测试 --------------------------------------\n");
+
+    printf("-------------------- io_uring (不可用时回退) --------------------\n");
+    testBackend(TaskFileIoBackend::TFB_IoUring);
+
+    printf("-------------------- 线程池 --------------------\n");
+    testBackend(TaskFileIoBackend::TFB_ThreadPool);
+
+    printf("-------------异步文件IO测试完成-------------\n");
+    getchar();
+    return 0;
+}
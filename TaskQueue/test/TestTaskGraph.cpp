@@ -0,0 +1,228 @@
+#include "../TaskDispatch.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+using namespace task;
+
+// clang++ -o test TestTaskGraph.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static int64_t elapsedMicros(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- TaskGraph测试 --------------------------------------\n");
+
+    auto& factory = TaskQueueFactory::GetInstance();
+
+    // 菱形依赖 a -> (b, c) -> d
+    printf("-------------------- 菱形依赖测试 --------------------\n");
+    {
+        auto graph = factory.createTaskGraph();
+        assert(graph != nullptr);
+
+        std::mutex       orderMutex;
+        std::vector<int> order;
+        auto             record = [&orderMutex, &order](int v) {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.push_back(v);
+        };
+
+        auto serialQueue = factory.createSerialTaskQueue("graph_serial", WorkThreadPriority::WTP_Normal, false);
+        auto a           = graph->addNode([&record]() { record(0); });
+        auto b           = graph->addNode([&record]() { record(1); });
+        auto c           = graph->addNode([&record]() { record(2); }, serialQueue);
+        auto d           = graph->addNode([&record]() { record(3); });
+        assert(graph->addEdge(a, b));
+        assert(graph->addEdge(a, c));
+        assert(graph->addEdge(b, d));
+        assert(graph->addEdge(c, d));
+        assert(!graph->addEdge(a, a));
+        assert(!graph->addEdge(a, 100));
+
+        // 同一个图运行多次
+        for (int round = 0; round < 3; ++round)
+        {
+            order.clear();
+            assert(graph->run());
+            assert(graph->wait(std::chrono::milliseconds(5000)));
+            assert(order.size() == 4);
+            assert(order.front() == 0);
+            assert(order.back() == 3);
+            printf("第%d次运行顺序: %d %d %d %d\n", round, order[0], order[1], order[2], order[3]);
+        }
+    }
+
+    // 环检测
+    printf("-------------------- 环检测测试 --------------------\n");
+    {
+        auto graph = factory.createTaskGraph();
+        auto a     = graph->addNode([]() {});
+        auto b     = graph->addNode([]() {});
+        assert(graph->addEdge(a, b));
+        assert(graph->addEdge(b, a));
+        assert(!graph->run());
+        printf("有环的图拒绝运行\n");
+    }
+
+    // 完成通知
+    printf("-------------------- 完成通知测试 --------------------\n");
+    {
+        auto             graph = factory.createTaskGraph();
+        std::atomic<int> count{ 0 };
+        for (int i = 0; i < 8; ++i)
+        {
+            graph->addNode([&count]() { count++; });
+        }
+        std::atomic<bool> notified{ false };
+        assert(graph->run([&notified]() { notified = true; }, factory.globalSerialQueue()));
+        assert(graph->wait(std::chrono::milliseconds(5000)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        assert(count == 8);
+        assert(notified);
+        printf("完成通知测试通过\n");
+    }
+
+    // 节点被丢弃： 后继节点不执行， 运行仍能结束
+    printf("-------------------- 节点丢弃测试 --------------------\n");
+    {
+        // 独占队列： 阻塞任务不占用并行线程池
+        auto         full = factory.createSerialTaskQueue("graph_full", WorkThreadPriority::WTP_Normal, true);
+        TaskCapacity capacity;
+        capacity.mMaxPending = 1;
+        capacity.mPolicy     = TaskOverflowPolicy::TOP_Reject;
+        assert(full->setCapacity(capacity));
+
+        std::atomic<bool> release{ false };
+        std::atomic<bool> started{ false };
+        full->async([&] {
+            started = true;
+            while (!release.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        while (!started.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::atomic<bool> drained{ false };
+        assert(full->async([&drained] { drained = true; }) == TaskSubmitResult::TSR_Accepted);
+
+        // a(已满队列) -> b -> d, c -> d, e 独立
+        auto             graph = factory.createTaskGraph();
+        std::atomic<int> ran[5];
+        for (auto& r : ran)
+        {
+            r = 0;
+        }
+        auto a = graph->addNode([&ran]() { ran[0]++; }, full);
+        auto b = graph->addNode([&ran]() { ran[1]++; });
+        auto c = graph->addNode([&ran]() { ran[2]++; });
+        auto d = graph->addNode([&ran]() { ran[3]++; });
+        graph->addNode([&ran]() { ran[4]++; });
+        assert(graph->addEdge(a, b));
+        assert(graph->addEdge(b, d));
+        assert(graph->addEdge(c, d));
+
+        std::atomic<bool> notified{ false };
+        assert(graph->run([&notified]() { notified = true; }, factory.globalSerialQueue()));
+        assert(graph->wait(std::chrono::milliseconds(5000)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        assert(ran[0] == 0 && ran[1] == 0 && ran[3] == 0);
+        assert(ran[2] == 1 && ran[4] == 1);
+        assert(graph->skippedCount() == 3);
+        assert(notified);
+
+        // 队列恢复后再次运行， 所有节点执行
+        release = true;
+        while (!drained.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        assert(graph->run());
+        assert(graph->wait(std::chrono::milliseconds(5000)));
+        for (auto& r : ran)
+        {
+            assert(r >= 1);
+        }
+        assert(ran[3] == 1);
+        assert(graph->skippedCount() == 0);
+        printf("节点丢弃测试通过\n");
+    }
+
+    // 性能测试：宽图 (1 -> N -> 1) 与 深图 (N 个节点的链)
+    printf("-------------------- 性能测试 --------------------\n");
+    const int kWidth  = 256;
+    const int kDepth  = 256;
+    const int kRounds = 50;
+    {
+        auto             graph = factory.createTaskGraph();
+        std::atomic<int> count{ 0 };
+        auto             source = graph->addNode([&count]() { count++; });
+        auto             sink   = graph->addNode([&count]() { count++; });
+        for (int i = 0; i < kWidth; ++i)
+        {
+            auto node = graph->addNode([&count]() { count++; });
+            graph->addEdge(source, node);
+            graph->addEdge(node, sink);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kRounds; ++round)
+        {
+            graph->run();
+            graph->wait();
+        }
+        assert(count == (kWidth + 2) * kRounds);
+        printf("宽图 (%d 节点) TaskGraph 平均耗时: %lld us\n", kWidth + 2, ( long long )(elapsedMicros(start) / kRounds));
+
+        // 对比： TaskGroup 嵌套 wait 实现同样的依赖
+        count = 0;
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kRounds; ++round)
+        {
+            count++;
+            auto group = factory.createTaskGroup();
+            for (int i = 0; i < kWidth; ++i)
+            {
+                group->async([&count]() { count++; });
+            }
+            group->wait();
+            count++;
+        }
+        assert(count == (kWidth + 2) * kRounds);
+        printf("宽图 (%d 节点) TaskGroup 平均耗时: %lld us\n", kWidth + 2, ( long long )(elapsedMicros(start) / kRounds));
+    }
+    {
+        auto             graph = factory.createTaskGraph();
+        std::atomic<int> count{ 0 };
+        auto             prev = graph->addNode([&count]() { count++; });
+        for (int i = 1; i < kDepth; ++i)
+        {
+            auto node = graph->addNode([&count]() { count++; });
+            graph->addEdge(prev, node);
+            prev = node;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kRounds; ++round)
+        {
+            graph->run();
+            graph->wait();
+        }
+        assert(count == kDepth * kRounds);
+        printf("深图 (%d 节点) TaskGraph 平均耗时: %lld us\n", kDepth, ( long long )(elapsedMicros(start) / kRounds));
+    }
+
+    printf("-------------TaskGraph测试完成-------------\n");
+    getchar();
+    return 0;
+}
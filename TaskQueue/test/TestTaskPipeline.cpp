@@ -0,0 +1,222 @@
+#include "../TaskDispatch.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+using namespace task;
+
+// clang++ -o test TestTaskPipeline.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+using Item = TaskPipeline::Item;
+
+// 记录在途数据项的峰值
+struct InFlight
+{
+    std::atomic<int> mCurrent{ 0 };
+    std::atomic<int> mPeak{ 0 };
+
+    void enter()
+    {
+        const int current = ++mCurrent;
+        int       peak    = mPeak.load();
+        while (current > peak && !mPeak.compare_exchange_weak(peak, current))
+        {
+        }
+    }
+    void leave()
+    {
+        mCurrent--;
+    }
+};
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 流水线测试 --------------------------------------\n");
+
+    auto& factory = TaskQueueFactory::GetInstance();
+    auto  ioQueue = factory.createSerialTaskQueue("pipeline_io", WorkThreadPriority::WTP_Normal, true);
+
+    // 并行阶段乱序完成， 有序阶段按输入顺序输出； 令牌限制在途数量
+    printf("-------------------- 有序输出 --------------------\n");
+    {
+        auto             pipeline = factory.createTaskPipeline();
+        InFlight         inFlight;
+        int              next = 0;
+        std::vector<int> output;
+
+        assert(!pipeline->run(4));  // 未设置输入阶段
+        pipeline->setSource(
+            [&next, &inFlight](Item& item) {
+                if (next == 1000)
+                {
+                    return false;
+                }
+                inFlight.enter();
+                item = next++;
+                return true;
+            },
+            ioQueue);
+        pipeline->addStage(TaskPipelineMode::TPM_Parallel, [](Item&& item) -> Item {
+            const int value = std::any_cast<int>(item);
+            if (value % 7 == 0)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            return value * 2;
+        });
+        pipeline->addStage(TaskPipelineMode::TPM_SerialInOrder, [&output, &inFlight](Item&& item) -> Item {
+            output.push_back(std::any_cast<int>(item));
+            inFlight.leave();
+            return {};
+        });
+        assert(pipeline->stageCount() == 2);
+
+        assert(pipeline->run(4));
+        assert(!pipeline->run(4));
+        assert(pipeline->wait(std::chrono::milliseconds(10000)));
+        printf("output: %zu, peak in flight: %d\n", output.size(), inFlight.mPeak.load());
+        assert(output.size() == 1000);
+        for (int i = 0; i < 1000; ++i)
+        {
+            assert(output[i] == i * 2);
+        }
+        assert(inFlight.mPeak.load() <= 4);
+    }
+
+    // 过滤： 被过滤的数据项归还令牌， 不进入后续阶段， 有序阶段不会等待它
+    printf("-------------------- 过滤 --------------------\n");
+    {
+        auto             pipeline = factory.createTaskPipeline();
+        int              next     = 0;
+        std::vector<int> output;
+        pipeline->setSource([&next](Item& item) {
+            if (next == 500)
+            {
+                return false;
+            }
+            item = next++;
+            return true;
+        });
+        pipeline->addStage(TaskPipelineMode::TPM_Parallel, [](Item&& item) -> Item {
+            return std::any_cast<int>(item) % 3 == 0 ? Item() : item;
+        });
+        pipeline->addStage(TaskPipelineMode::TPM_SerialInOrder, [&output](Item&& item) -> Item {
+            output.push_back(std::any_cast<int>(item));
+            return {};
+        });
+        assert(pipeline->run(2));
+        assert(pipeline->wait(std::chrono::milliseconds(10000)));
+        assert(output.size() == 333);
+        assert(std::is_sorted(output.begin(), output.end()));
+        assert(std::none_of(output.begin(), output.end(), [](int v) { return v % 3 == 0; }));
+    }
+
+    // 串行无序阶段逐个处理； 慢阶段限制输入速度
+    printf("-------------------- 串行无序 --------------------\n");
+    {
+        auto             pipeline = factory.createTaskPipeline();
+        InFlight         inFlight;
+        std::atomic<int> running{ 0 };
+        std::atomic<int> overlapped{ 0 };
+        std::atomic<int> count{ 0 };
+        int              next = 0;
+        pipeline->setSource([&next, &inFlight](Item& item) {
+            if (next == 100)
+            {
+                return false;
+            }
+            inFlight.enter();
+            item = next++;
+            return true;
+        });
+        pipeline->addStage(TaskPipelineMode::TPM_Parallel, [](Item&& item) -> Item { return item; });
+        pipeline->addStage(TaskPipelineMode::TPM_SerialOutOfOrder, [&](Item&& item) -> Item {
+            if (running++ > 0)
+            {
+                overlapped++;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            count++;
+            running--;
+            inFlight.leave();
+            return item;
+        });
+
+        std::atomic<int> notified{ 0 };
+        assert(pipeline->run(3, [&notified]() { notified++; }));
+        assert(pipeline->wait(std::chrono::milliseconds(10000)));
+        for (int i = 0; i < 200 && notified.load() == 0; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        printf("count: %d, overlapped: %d, peak in flight: %d\n", count.load(), overlapped.load(), inFlight.mPeak.load());
+        assert(count.load() == 100);
+        assert(overlapped.load() == 0);
+        assert(inFlight.mPeak.load() <= 3);
+        assert(notified.load() == 1);
+    }
+
+    // 停止读取输入后结束； 同一条流水线可以再次运行； 释放流水线后仍能执行完
+    printf("-------------------- 停止/复用 --------------------\n");
+    {
+        auto             pipeline = factory.createTaskPipeline();
+        std::atomic<int> produced{ 0 };
+        std::atomic<int> consumed{ 0 };
+        pipeline->setSource([&produced](Item& item) {
+            item = produced++;
+            return true;
+        });
+        pipeline->addStage(TaskPipelineMode::TPM_SerialInOrder, [&consumed](Item&& item) -> Item {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            consumed++;
+            return item;
+        });
+
+        assert(pipeline->run(8));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        pipeline->stop();
+        assert(pipeline->wait(std::chrono::milliseconds(10000)));
+        printf("produced: %d, consumed: %d\n", produced.load(), consumed.load());
+        assert(produced.load() == consumed.load());
+        assert(consumed.load() > 0);
+
+        const int first = consumed.load();
+        assert(pipeline->run(8));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        pipeline->stop();
+        assert(pipeline->wait(std::chrono::milliseconds(10000)));
+        assert(consumed.load() > first && produced.load() == consumed.load());
+
+        std::atomic<int> done{ 0 };
+        {
+            auto temp = factory.createTaskPipeline();
+            int  next = 0;
+            temp->setSource([next](Item& item) mutable {
+                if (next == 100)
+                {
+                    return false;
+                }
+                item = next++;
+                return true;
+            });
+            temp->addStage(TaskPipelineMode::TPM_Parallel, [&done](Item&& item) -> Item {
+                done++;
+                return item;
+            });
+            temp->run(4);
+        }
+        for (int i = 0; i < 400 && done.load() < 100; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        assert(done.load() == 100);
+    }
+
+    printf("-------------流水线测试完成-------------\n");
+    getchar();
+    return 0;
+}
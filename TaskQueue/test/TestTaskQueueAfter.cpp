@@ -0,0 +1,108 @@
+#include "../TaskDispatch.h"
+#include "../backend/TimerManager.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <stdio.h>
+#include <thread>
+using namespace task;
+
+// clang++ -o test TestTaskQueueAfter.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static int64_t elapsedMillis(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 延时任务测试 --------------------------------------\n");
+
+    auto& factory         = TaskQueueFactory::GetInstance();
+    auto  concurrentQueue = factory.globalConcurrencyQueue(TaskQueuePriority::TQP_Normal);
+    auto  serialQueue     = factory.createSerialTaskQueue("after_serial", WorkThreadPriority::WTP_Normal, false);
+    auto  exclusiveQueue  = factory.createSerialTaskQueue("after_exclusive", WorkThreadPriority::WTP_Normal, true);
+
+    // 延时任务不占用工作线程： 延时期间普通任务立即执行
+    printf("-------------------- 延时期间不阻塞工作线程 --------------------\n");
+    {
+        auto              start = std::chrono::steady_clock::now();
+        std::atomic<bool> delayed{ false };
+        std::atomic<bool> immediate{ false };
+        concurrentQueue->after(std::chrono::milliseconds(1000), [&delayed]() { delayed = true; });
+        serialQueue->after(std::chrono::milliseconds(1000), []() {});
+        exclusiveQueue->after(std::chrono::milliseconds(1000), []() {});
+
+        concurrentQueue->async([&immediate]() { immediate = true; });
+        serialQueue->sync([]() {});
+        exclusiveQueue->sync([]() {});
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        assert(immediate);
+        assert(!delayed);
+        printf("延时期间普通任务执行耗时: %lld ms\n", ( long long )elapsedMillis(start));
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+        assert(delayed);
+    }
+
+    // 精度： 跨越时间轮不同层级
+    printf("-------------------- 延时精度 --------------------\n");
+    {
+        const int         delays[] = { 0, 5, 63, 64, 100, 700, 4500 };
+        std::atomic<int>  fired{ 0 };
+        auto              start = std::chrono::steady_clock::now();
+        for (auto delay : delays)
+        {
+            serialQueue->after(std::chrono::milliseconds(delay), [delay, start, &fired]() {
+                auto actual = elapsedMillis(start);
+                printf("延时 %d ms, 实际: %lld ms\n", delay, ( long long )actual);
+                assert(actual >= delay);
+                fired++;
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5000));
+        assert(fired == sizeof(delays) / sizeof(delays[0]));
+    }
+
+    // 取消： 到期前取消的任务不会投递
+    printf("-------------------- 延时任务取消 --------------------\n");
+    {
+        std::atomic<bool> executed{ false };
+        auto              task = std::make_shared<TaskOperator>([&executed](const TaskOperatorPtr&) {
+            executed = true;
+        });
+        concurrentQueue->after(std::chrono::milliseconds(200), task);
+        task->cancel();
+        std::this_thread::sleep_for(std::chrono::milliseconds(400));
+        assert(!executed);
+        printf("取消的延时任务未执行\n");
+    }
+
+    // 句柄取消： 立即从时间轮移除， 不等到期 (长延时任务不再占用定时器)
+    printf("-------------------- 延时句柄取消 --------------------\n");
+    {
+        auto&             timers = TimerManager::GetInstance();
+        std::atomic<bool> executed{ false };
+        const auto        before = timers.timerCount();
+        auto handle = concurrentQueue->after(std::chrono::hours(3), [&executed]() { executed = true; });
+        assert(handle != nullptr);
+        assert(timers.timerCount() == before + 1);
+        handle->cancel();
+        assert(timers.timerCount() == before);
+
+        // 队列批量取消同样移除定时器
+        serialQueue->setCancelTracking(true);
+        serialQueue->after(std::chrono::hours(3), [&executed]() { executed = true; });
+        serialQueue->after(std::chrono::hours(3), [&executed]() { executed = true; });
+        assert(timers.timerCount() == before + 2);
+        assert(serialQueue->cancelAll() >= 2);
+        assert(timers.timerCount() == before);
+        assert(!executed);
+        printf("取消的延时句柄已移除定时器\n");
+    }
+
+    printf("-------------延时任务测试完成-------------\n");
+    getchar();
+    return 0;
+}
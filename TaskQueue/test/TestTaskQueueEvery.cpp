@@ -0,0 +1,174 @@
+#include "../TaskDispatch.h"
+#include "../backend/TimerManager.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+using namespace task;
+
+// clang++ -o test TestTaskQueueEvery.cpp -I.. -I../backend -I../common -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static int64_t elapsedMillis(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 统计一组周期定时器在duration内的唤醒次数
+static uint64_t measureWakeups(int timers, std::chrono::milliseconds interval, std::chrono::milliseconds leeway)
+{
+    auto&                 timer = TimerManager::GetInstance();
+    std::atomic<int>      fired{ 0 };
+    std::vector<uint64_t> ids;
+    for (int i = 0; i < timers; ++i)
+    {
+        // 错开启动时间， 不加leeway时每个定时器单独唤醒
+        ids.push_back(timer.addPeriodicTimer(interval, leeway, [&fired]() { fired++; }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto before = timer.wakeupCount();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    auto wakeups = timer.wakeupCount() - before;
+    for (auto id : ids)
+    {
+        assert(timer.cancelTimer(id));
+    }
+    printf("定时器: %d, leeway: %lld ms, 1秒内唤醒: %llu 次, 触发: %d 次\n",
+           timers,
+           ( long long )leeway.count(),
+           ( unsigned long long )wakeups,
+           fired.load());
+    return wakeups;
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 周期任务测试 --------------------------------------\n");
+
+    auto& factory         = TaskQueueFactory::GetInstance();
+    auto  concurrentQueue = factory.globalConcurrencyQueue(TaskQueuePriority::TQP_Normal);
+    auto  serialQueue     = factory.createSerialTaskQueue("every_serial", WorkThreadPriority::WTP_Normal, false);
+
+    // 无漂移： 任务本身耗时不影响后续触发时间
+    printf("-------------------- 无漂移 --------------------\n");
+    {
+        std::mutex           mutex;
+        std::vector<int64_t> fireTimes;
+        auto                 start  = std::chrono::steady_clock::now();
+        auto                 handle = serialQueue->every(std::chrono::milliseconds(50), std::chrono::milliseconds(0), [&]() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                fireTimes.push_back(elapsedMillis(start));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(1025));
+        handle->cancel();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < fireTimes.size(); ++i)
+        {
+            // 第n次触发时间不早于 n * 50ms； 单次延后受调度负载影响， 只做宽松限制
+            auto expected = static_cast<int64_t>(i + 1) * 50;
+            assert(fireTimes[i] >= expected);
+            assert(fireTimes[i] - expected < 50);
+        }
+        // 不累计漂移： 首尾间隔接近 (n - 1) * 50ms (按执行结束重新计时每次会累计约10ms)
+        auto span         = fireTimes.back() - fireTimes.front();
+        auto expectedSpan = static_cast<int64_t>(fireTimes.size() - 1) * 50;
+        printf("触发: %zu 次, 最后一次: %lld ms, 首尾间隔: %lld ms (理论 %lld ms)\n",
+               fireTimes.size(),
+               ( long long )fireTimes.back(),
+               ( long long )span,
+               ( long long )expectedSpan);
+        assert(span > expectedSpan - 40 && span < expectedSpan + 40);
+        assert(fireTimes.size() >= 19);
+    }
+
+    // 取消： 取消句柄或原始任务后不再执行
+    printf("-------------------- 周期任务取消 --------------------\n");
+    {
+        std::atomic<int> count{ 0 };
+        auto             handle = concurrentQueue->every(std::chrono::milliseconds(20), std::chrono::milliseconds(5), [&count]() {
+            count++;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(210));
+        handle->cancel();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        auto stopped = count.load();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        assert(stopped >= 5);
+        assert(count == stopped);
+
+        std::atomic<int> count2{ 0 };
+        auto             task = std::make_shared<TaskOperator>([&count2](const TaskOperatorPtr&) { count2++; });
+        concurrentQueue->every(std::chrono::milliseconds(20), std::chrono::milliseconds(0), task);
+        std::this_thread::sleep_for(std::chrono::milliseconds(110));
+        task->cancel();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        auto stopped2 = count2.load();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        assert(count2 == stopped2);
+        printf("取消后不再执行, 句柄: %d 次, 原始任务: %d 次\n", stopped, stopped2);
+    }
+
+    // 上一次未执行完时跳过本次
+    printf("-------------------- 执行过慢时跳过 --------------------\n");
+    {
+        std::atomic<int> count{ 0 };
+        auto             handle = serialQueue->every(std::chrono::milliseconds(10), std::chrono::milliseconds(0), [&count]() {
+            count++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        handle->cancel();
+        serialQueue->sync([]() {});
+        printf("500ms 内执行: %d 次\n", count.load());
+        assert(count <= 11);
+    }
+
+    // 统计记录完成后才允许再次投递： 每次执行都计入队列完成数
+    printf("-------------------- 执行统计 --------------------\n");
+    {
+        auto& factory = TaskQueueFactory::GetInstance();
+        std::vector<TaskQueuePtr> queues = {
+            factory.createSerialTaskQueue("every_stat_serial", WorkThreadPriority::WTP_Normal, false),
+            factory.createSerialTaskQueue("every_stat_exclusive", WorkThreadPriority::WTP_Normal, true),
+            factory.createConcurrencyTaskQueue("every_stat_parallel", TaskQueuePriority::TQP_Normal),
+        };
+        for (auto& queue : queues)
+        {
+            std::atomic<int> count{ 0 };
+            auto             handle = queue->every(std::chrono::milliseconds(1), std::chrono::milliseconds(0), [&count]() {
+                count++;
+                std::this_thread::sleep_for(std::chrono::microseconds(900));
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            handle->cancel();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            queue->sync([]() {});
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));  // 同步任务返回后才记录
+
+            auto metrics = queue->metrics();
+            printf("executed: %d, completed: %llu, submitted: %llu\n", count.load(), ( unsigned long long )metrics.mCompleted,
+                   ( unsigned long long )metrics.mSubmitted);
+            assert(metrics.mCompleted == static_cast<uint64_t>(count.load()) + 1);  // 含sync
+        }
+    }
+
+    // leeway 合并唤醒
+    printf("-------------------- leeway 合并唤醒 --------------------\n");
+    {
+        auto strict    = measureWakeups(50, std::chrono::milliseconds(100), std::chrono::milliseconds(0));
+        auto coalesced = measureWakeups(50, std::chrono::milliseconds(100), std::chrono::milliseconds(50));
+        assert(coalesced * 4 < strict);
+    }
+
+    printf("-------------周期任务测试完成-------------\n");
+    getchar();
+    return 0;
+}
@@ -0,0 +1,177 @@
+#include "../TaskDispatch.h"
+#include "../TaskQueueReporter.h"
+#include "../TaskQueueReportSink.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdio.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+using namespace task;
+
+// clang++ -o test TestTaskQueueReporter.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 上报测试 --------------------------------------\n");
+
+    auto& reporter = TaskQueueReporter::GetInstance();
+    auto& factory  = TaskQueueFactory::GetInstance();
+
+    // 回调上报器： 线程数量变化为结构化事件
+    printf("-------------------- 回调上报 --------------------\n");
+    {
+        std::mutex                        mutex;
+        std::vector<TaskQueueReportEvent> events;
+        auto sink = std::make_shared<TaskQueueCallbackSink>([&mutex, &events](const TaskQueueReportEvent& event) {
+            std::lock_guard<std::mutex> lock(mutex);
+            events.push_back(event);
+        });
+        reporter.addSink(sink);
+
+        {
+            auto queue = factory.createSerialTaskQueue("reporter_exclusive", WorkThreadPriority::WTP_Normal, true);
+            queue->sync([]() {});
+        }
+        reporter.flush();
+        reporter.removeSink(sink);
+
+        bool created = false;
+        for (auto& event : events)
+        {
+            if (event.mType == TaskQueueReporterType::TQRT_ThreadCountChanged
+                && event.mThreadCount.mReason == TaskQueueReportReason::TQRR_ThreadCreated
+                && event.mThreadCount.mPoolType == TaskQueueType::TQT_Serial)
+            {
+                assert(event.mThreadCount.mThreadId >= 0);
+                assert(event.mTimestamp > 0);
+                created = true;
+            }
+        }
+        assert(created);
+        printf("收到事件: %zu\n", events.size());
+    }
+
+    // 限次上报： 超过次数不构造事件
+    printf("-------------------- 限次上报 --------------------\n");
+    {
+        std::atomic<int32_t> count{ 0 };
+        int                  made = 0;
+        for (int i = 0; i < 10; ++i)
+        {
+            reporter.notifyReportLimit(3, count, [&made]() {
+                ++made;
+                TaskCountExceedEvent event;
+                event.mPendingCount = 100;
+                return TaskQueueReportEvent(event);
+            });
+        }
+        assert(made == 3);
+        printf("构造事件: %d\n", made);
+    }
+
+    // 文件上报器
+    printf("-------------------- 文件上报 --------------------\n");
+    {
+        const char* path = "/tmp/task_queue_report_test.log";
+        remove(path);
+        auto sink = std::make_shared<TaskQueueFileSink>(path);
+        assert(sink->isOpen());
+        reporter.addSink(sink);
+
+        TaskDurationExceedEvent event;
+        event.mThreadId      = 7;
+        event.mBlockedMillis = 6000;
+        TaskQueueReporter::copyName(event.mThreadName, "a_very_long_thread_name_that_will_be_truncated");
+        assert(strlen(event.mThreadName) == kReportNameLength - 1);
+        reporter.notifyReport(event);
+        reporter.flush();
+        reporter.removeSink(sink);
+
+        // 线程池事件并发写入同一个文件， 逐行查找
+        FILE* file = fopen(path, "r");
+        assert(file);
+        char line[512] = { 0 };
+        bool found     = false;
+        while (!found && fgets(line, sizeof(line), file))
+        {
+            found = strstr(line, "blockT: 6000 ms") != nullptr;
+        }
+        fclose(file);
+        remove(path);
+        assert(found);
+        printf("文件内容: %s", line);
+    }
+
+    // unix socket 上报器
+    printf("-------------------- unix socket 上报 --------------------\n");
+    {
+        const char* path = "/tmp/task_queue_report_test.sock";
+        unlink(path);
+        int server = socket(AF_UNIX, SOCK_DGRAM, 0);
+        assert(server >= 0);
+        sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+        assert(bind(server, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+
+        auto sink = std::make_shared<TaskQueueUnixSocketSink>(path);
+        reporter.addSink(sink);
+        ThreadCountChangedEvent event;
+        event.mReason = TaskQueueReportReason::TQRR_MaxThreadsArrived;
+        event.mMax    = 8;
+        reporter.notifyReport(event);
+        reporter.flush();
+        reporter.removeSink(sink);
+
+        char buffer[512] = { 0 };
+        auto len         = recv(server, buffer, sizeof(buffer) - 1, MSG_DONTWAIT);
+        assert(len > 0);
+        assert(strstr(buffer, "max_threads_arrived"));
+        printf("socket 收到: %s\n", buffer);
+        close(server);
+        unlink(path);
+    }
+
+    // 队列满： 生产者不阻塞， 丢弃并计数
+    printf("-------------------- 队列满丢弃 --------------------\n");
+    {
+        std::atomic<bool> release{ false };
+        auto              slowSink = std::make_shared<TaskQueueCallbackSink>([&release](const TaskQueueReportEvent&) {
+            while (!release.load())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        reporter.clearSinks();
+        reporter.addSink(slowSink);
+
+        const auto dropped = reporter.droppedEvents();
+        auto       start   = std::chrono::steady_clock::now();
+        for (int i = 0; i < 5000; ++i)
+        {
+            TaskCountExceedEvent event;
+            event.mPendingCount = i;
+            reporter.notifyReport(event);
+        }
+        auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        assert(reporter.droppedEvents() > dropped);
+        printf("投递5000个事件耗时: %lld ms, 丢弃: %llu\n", ( long long )cost, ( unsigned long long )(reporter.droppedEvents() - dropped));
+
+        release = true;
+        reporter.flush();
+        reporter.clearSinks();
+        reporter.addSink(std::make_shared<TaskQueueLogSink>());
+    }
+
+    printf("-------------上报测试完成-------------\n");
+    getchar();
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "../TaskDispatch.h"
+#include "../TaskQueueTracer.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <string>
+#include <thread>
+using namespace task;
+
+// clang++ -o test TestTaskQueueTracer.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static size_t countOf(const std::string& text, const std::string& pattern)
+{
+    size_t count = 0;
+    for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + pattern.size()))
+    {
+        count++;
+    }
+    return count;
+}
+
+static int64_t runTasks(const TaskQueuePtr& queue, int count)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+        queue->async([]() {});
+    }
+    queue->sync([]() {});
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 任务轨迹测试 --------------------------------------\n");
+
+    auto& factory         = TaskQueueFactory::GetInstance();
+    auto& tracer          = TaskQueueTracer::GetInstance();
+    auto  concurrentQueue = factory.createConcurrencyTaskQueue("trace_concurrent", TaskQueuePriority::TQP_Normal);
+    auto  serialQueue     = factory.createSerialTaskQueue("trace_serial", WorkThreadPriority::WTP_Normal, false);
+    auto  exclusiveQueue  = factory.createSerialTaskQueue("trace_exclusive", WorkThreadPriority::WTP_Normal, true);
+    auto  escapedQueue    = factory.createSerialTaskQueue("trace_\"esc\"\\q", WorkThreadPriority::WTP_Normal, false);
+
+    // 未开启时不记录
+    assert(!TaskQueueTracer::isEnabled());
+    auto disabledCost = runTasks(serialQueue, 1000);
+
+    printf("-------------------- 记录轨迹 --------------------\n");
+    const std::string path = "task_trace.json";
+    assert(tracer.start(path));
+    assert(!tracer.start(path));
+    assert(TaskQueueTracer::isEnabled());
+
+    auto enabledCost = runTasks(serialQueue, 1000);
+    for (int i = 0; i < 10; ++i)
+    {
+        concurrentQueue->async([]() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+        exclusiveQueue->async([]() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+    }
+    concurrentQueue->sync([]() {});
+    exclusiveQueue->sync([]() {});
+    escapedQueue->sync([]() {});
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    tracer.stop();
+    assert(!TaskQueueTracer::isEnabled());
+    printf("1000个任务耗时: 未开启 %lld us, 开启 %lld us, 丢弃事件: %llu\n",
+           ( long long )disabledCost,
+           ( long long )enabledCost,
+           ( unsigned long long )tracer.droppedEvents());
+
+    // 停止后不再记录
+    runTasks(serialQueue, 100);
+
+    std::ifstream     file(path);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const auto text = buffer.str();
+
+    const auto enqueued = countOf(text, "\"name\":\"enqueue\"");
+    const auto begins   = countOf(text, "\"ph\":\"B\"");
+    const auto ends     = countOf(text, "\"ph\":\"E\"");
+    printf("enqueue: %zu, begin: %zu, end: %zu\n", enqueued, begins, ends);
+
+    // 1001 + 11 + 11 + 1 个任务
+    assert(text.rfind("{\"displayTimeUnit\"", 0) == 0);
+    assert(text.find("]}") != std::string::npos);
+    assert(enqueued == 1024);
+    assert(begins == enqueued && ends == enqueued);
+    assert(countOf(text, "\"name\":\"trace_serial\"") == 1001);
+    assert(countOf(text, "\"name\":\"trace_concurrent\"") == 11);
+    assert(countOf(text, "\"name\":\"trace_exclusive\"") == 11);
+    // 标签中的引号与反斜杠转义后写入
+    assert(countOf(text, "\"name\":\"trace_\\\"esc\\\"\\\\q\"") == 1);
+    assert(text.find("thread_name") != std::string::npos);
+    std::remove(path.c_str());
+
+    printf("-------------任务轨迹测试完成-------------\n");
+    getchar();
+    return 0;
+}
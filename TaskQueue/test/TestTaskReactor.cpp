@@ -0,0 +1,376 @@
+#include "../TaskDispatch.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+using namespace task;
+
+// clang++ -o test TestTaskReactor.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static void setNonBlocking(int fd)
+{
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+// 等待条件成立， 超时返回false
+template <typename Pred>
+static bool waitFor(Pred&& pred, int timeoutMs = 5000)
+{
+    for (int i = 0; i < timeoutMs && !pred(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return pred();
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- IO就绪监听测试 --------------------------------------\n");
+
+    auto& factory  = TaskQueueFactory::GetInstance();
+    auto& reactor  = TaskReactor::GetInstance();
+    auto  serial   = factory.createSerialTaskQueue("reactor_serial", WorkThreadPriority::WTP_Normal, true);
+    auto  parallel = factory.createConcurrencyTaskQueue("reactor_parallel", TaskQueuePriority::TQP_Normal);
+
+    assert(reactor.onReadable(-1, serial, [](int) {}) == 0);
+    assert(reactor.onReadable(0, nullptr, [](int) {}) == 0);
+
+    // 一次性监听： 就绪一次后移除， 回调在指定队列执行
+    printf("-------------------- 一次性 (pipe) --------------------\n");
+    {
+        int fds[2];
+        assert(::pipe(fds) == 0);
+        setNonBlocking(fds[0]);
+
+        std::atomic<int>  calls{ 0 };
+        std::atomic<int>  received{ 0 };
+        std::atomic<bool> onQueue{ false };
+        std::thread::id   serialThread;
+        std::atomic<bool> ready{ false };
+        serial->async([&] {
+            serialThread = std::this_thread::get_id();
+            ready        = true;
+        });
+        assert(waitFor([&] { return ready.load(); }));
+        auto              id = reactor.onReadable(fds[0], serial, [&](int fd) {
+            onQueue = std::this_thread::get_id() == serialThread;
+            char buf[16];
+            while (::read(fd, buf, sizeof(buf)) > 0)
+            {
+                received++;
+            }
+            calls++;
+        });
+        assert(id != 0);
+        assert(reactor.stat().mRegistrations == 1);
+
+        assert(::write(fds[1], "a", 1) == 1);
+        assert(waitFor([&] { return calls.load() == 1; }));
+        assert(onQueue.load());
+        assert(!reactor.cancel(id));  // 已触发
+
+        assert(::write(fds[1], "b", 1) == 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        assert(calls.load() == 1);
+        assert(reactor.stat().mRegistrations == 0);
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    // 持续监听： 多次就绪多次回调， 同一监听的回调不会并发执行
+    printf("-------------------- 持续监听 (socketpair) --------------------\n");
+    {
+        int fds[2];
+        assert(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        setNonBlocking(fds[0]);
+
+        std::atomic<int> calls{ 0 };
+        std::atomic<int> received{ 0 };
+        std::atomic<int> running{ 0 };
+        std::atomic<int> overlapped{ 0 };
+        auto             id = reactor.onReadable(
+            fds[0], parallel,
+            [&](int fd) {
+                if (running++ > 0)
+                {
+                    overlapped++;
+                }
+                char    buf[64];
+                ssize_t n = 0;
+                while ((n = ::read(fd, buf, sizeof(buf))) > 0)
+                {
+                    received += static_cast<int>(n);
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                calls++;
+                running--;
+            },
+            TaskIoTrigger::TIT_Persistent);
+        assert(id != 0);
+
+        const int total = 2000;
+        for (int i = 0; i < total; ++i)
+        {
+            assert(::write(fds[1], "x", 1) == 1);
+            if (i % 100 == 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+        assert(waitFor([&] { return received.load() == total; }));
+        printf("calls: %d, received: %d, overlapped: %d\n", calls.load(), received.load(), overlapped.load());
+        assert(calls.load() > 1);
+        assert(overlapped.load() == 0);
+
+        // 移除后不再回调
+        assert(reactor.cancel(id));
+        assert(!reactor.cancel(id));
+        assert(waitFor([&] { return running.load() == 0; }));
+        const int before = calls.load();
+        assert(::write(fds[1], "y", 1) == 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        assert(calls.load() == before);
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    // 持续监听是电平触发语义： 每次回调只读一个字节， 剩余数据仍会继续回调
+    printf("-------------------- 持续监听不读完 --------------------\n");
+    {
+        int fds[2];
+        assert(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        setNonBlocking(fds[0]);
+
+        std::atomic<int> received{ 0 };
+        auto             id = reactor.onReadable(
+            fds[0], parallel,
+            [&](int fd) {
+                char c;
+                if (::read(fd, &c, 1) == 1)
+                {
+                    received++;
+                }
+            },
+            TaskIoTrigger::TIT_Persistent);
+        assert(id != 0);
+
+        const int total = 16;
+        assert(::write(fds[1], "0123456789abcdef", total) == total);
+        assert(waitFor([&] { return received.load() == total; }));
+        assert(reactor.cancel(id));
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    // 边沿触发： 没读完的数据不会再回调， 新数据到达时才回调
+    printf("-------------------- 边沿触发 --------------------\n");
+    {
+        int fds[2];
+        assert(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        setNonBlocking(fds[0]);
+
+        std::atomic<int> calls{ 0 };
+        std::atomic<int> received{ 0 };
+        auto             id = reactor.onReadable(
+            fds[0], parallel,
+            [&](int fd) {
+                char c;
+                if (::read(fd, &c, 1) == 1)
+                {
+                    received++;
+                }
+                calls++;
+            },
+            TaskIoTrigger::TIT_Edge);
+        assert(id != 0);
+
+        // 另一方向触发方式不一致时注册失败
+        assert(reactor.onWritable(fds[0], parallel, [](int) {}) == 0);
+        assert(reactor.onWritable(fds[0], parallel, [](int) {}, TaskIoTrigger::TIT_Persistent) == 0);
+
+        assert(::write(fds[1], "0123456789abcdef", 16) == 16);
+        assert(waitFor([&] { return calls.load() == 1; }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        assert(calls.load() == 1);
+        assert(received.load() == 1);
+
+        // 新数据到达
+        assert(::write(fds[1], "g", 1) == 1);
+        assert(waitFor([&] { return calls.load() == 2; }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        assert(calls.load() == 2);
+        assert(reactor.cancel(id));
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    // 边沿触发读到 EAGAIN： 回调不并发， 回调期间的新数据不丢失
+    printf("-------------------- 边沿触发读完 --------------------\n");
+    {
+        int fds[2];
+        assert(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        setNonBlocking(fds[0]);
+
+        std::atomic<int> calls{ 0 };
+        std::atomic<int> received{ 0 };
+        std::atomic<int> running{ 0 };
+        std::atomic<int> overlapped{ 0 };
+        auto             id = reactor.onReadable(
+            fds[0], parallel,
+            [&](int fd) {
+                if (running++ > 0)
+                {
+                    overlapped++;
+                }
+                char    buf[64];
+                ssize_t n = 0;
+                while ((n = ::read(fd, buf, sizeof(buf))) > 0)
+                {
+                    received += static_cast<int>(n);
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                calls++;
+                running--;
+            },
+            TaskIoTrigger::TIT_Edge);
+        assert(id != 0);
+
+        const int total = 2000;
+        for (int i = 0; i < total; ++i)
+        {
+            assert(::write(fds[1], "x", 1) == 1);
+            if (i % 100 == 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+        assert(waitFor([&] { return received.load() == total; }));
+        printf("calls: %d, received: %d, overlapped: %d\n", calls.load(), received.load(), overlapped.load());
+        assert(calls.load() > 1);
+        assert(overlapped.load() == 0);
+        assert(reactor.cancel(id));
+        assert(waitFor([&] { return running.load() == 0; }));
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    // 边沿触发： 数据只在回调读完之后、 返回之前到达， 回调结束后再回调一次
+    printf("-------------------- 边沿触发回调期间到达 --------------------\n");
+    {
+        int fds[2];
+        assert(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        setNonBlocking(fds[0]);
+
+        std::atomic<int>  calls{ 0 };
+        std::atomic<int>  received{ 0 };
+        std::atomic<bool> drained{ false };
+        std::atomic<bool> release{ false };
+        auto              id = reactor.onReadable(
+            fds[0], parallel,
+            [&](int fd) {
+                char    buf[64];
+                ssize_t n = 0;
+                while ((n = ::read(fd, buf, sizeof(buf))) > 0)
+                {
+                    received += static_cast<int>(n);
+                }
+                if (calls++ == 0)
+                {
+                    drained = true;
+                    while (!release.load())
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }
+            },
+            TaskIoTrigger::TIT_Edge);
+        assert(id != 0);
+
+        assert(::write(fds[1], "a", 1) == 1);
+        assert(waitFor([&] { return drained.load(); }));
+        assert(::write(fds[1], "b", 1) == 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        release = true;
+        assert(waitFor([&] { return received.load() == 2; }));
+        assert(calls.load() == 2);
+        assert(reactor.cancel(id));
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    // 同一fd同时监听可读与可写， 互不影响； 重复监听替换
+    printf("-------------------- 可读+可写/替换 --------------------\n");
+    {
+        int fds[2];
+        assert(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        setNonBlocking(fds[0]);
+
+        std::atomic<int> writable{ 0 };
+        std::atomic<int> oldReadable{ 0 };
+        std::atomic<int> readable{ 0 };
+        auto readId = reactor.onReadable(fds[0], serial, [&](int) { oldReadable++; });
+        assert(readId != 0);
+        assert(reactor.onWritable(fds[0], serial, [&](int) { writable++; }) != 0);
+        assert(waitFor([&] { return writable.load() == 1; }));  // 空 socket 立即可写
+        assert(oldReadable.load() == 0);
+
+        // 替换可读监听， 旧监听失效
+        auto newId = reactor.onReadable(fds[0], parallel, [&](int fd) {
+            char buf[8];
+            while (::read(fd, buf, sizeof(buf)) > 0)
+            {
+            }
+            readable++;
+        });
+        assert(newId != 0 && newId != readId);
+        assert(!reactor.cancel(readId));
+        assert(::write(fds[1], "z", 1) == 1);
+        assert(waitFor([&] { return readable.load() == 1; }));
+        assert(oldReadable.load() == 0);
+        assert(writable.load() == 1);
+
+        // 移除未就绪的监听
+        auto pendingId = reactor.onReadable(fds[0], serial, [&](int) { oldReadable++; });
+        assert(reactor.cancel(pendingId));
+        assert(::write(fds[1], "w", 1) == 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        assert(oldReadable.load() == 0);
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    // 对端关闭： 挂断时回调， read 返回0
+    printf("-------------------- 对端关闭 --------------------\n");
+    {
+        int fds[2];
+        assert(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        setNonBlocking(fds[0]);
+        std::atomic<int> eof{ 0 };
+        assert(reactor.onReadable(fds[0], parallel, [&](int fd) {
+            char buf[8];
+            if (::read(fd, buf, sizeof(buf)) == 0)
+            {
+                eof++;
+            }
+        }) != 0);
+        ::close(fds[1]);
+        assert(waitFor([&] { return eof.load() == 1; }));
+        ::close(fds[0]);
+    }
+
+    auto stat = reactor.stat();
+    printf("registrations: %llu, reactor events: %llu, idle events: %llu, dropped: %llu\n",
+           ( unsigned long long )stat.mRegistrations, ( unsigned long long )stat.mReactorEvents, ( unsigned long long )stat.mIdleEvents,
+           ( unsigned long long )stat.mDropped);
+    assert(stat.mRegistrations == 0);
+    assert(stat.mReactorEvents + stat.mIdleEvents > 0);
+
+    printf("-------------IO就绪监听测试完成-------------\n");
+    getchar();
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include "../TaskDispatch.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+using namespace task;
+
+// clang++ -o test TestTaskSuspend.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static bool waitUntil(const std::atomic<int>& value, int expected, int timeoutMs = 2000)
+{
+    for (int i = 0; i < timeoutMs / 5 && value.load() < expected; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return value.load() >= expected;
+}
+
+// 挂起期间提交的任务不执行， 恢复后按提交顺序执行
+static void testSerial(const TaskQueuePtr& queue)
+{
+    std::atomic<int> ran{ 0 };
+    std::mutex       mutex;
+    std::vector<int> order;
+
+    queue->suspend();
+    assert(queue->isSuspended());
+    for (int i = 0; i < 100; ++i)
+    {
+        auto result = queue->async([i, &ran, &mutex, &order]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(i);
+            ran++;
+        });
+        assert(result == TaskSubmitResult::TSR_Suspended);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    assert(ran.load() == 0);
+
+    assert(queue->resume());
+    assert(!queue->isSuspended());
+    assert(waitUntil(ran, 100));
+    for (int i = 0; i < 100; ++i)
+    {
+        assert(order[i] == i);
+    }
+
+    // 恢复后正常提交
+    assert(queue->async([&ran]() { ran++; }) == TaskSubmitResult::TSR_Accepted);
+    queue->sync([]() {});
+    assert(ran.load() == 101);
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 挂起/恢复测试 --------------------------------------\n");
+
+    auto& factory = TaskQueueFactory::GetInstance();
+
+    printf("-------------------- 非独占串行队列 --------------------\n");
+    testSerial(factory.createSerialTaskQueue("suspend_serial", WorkThreadPriority::WTP_Normal, false));
+
+    printf("-------------------- 独占串行队列 --------------------\n");
+    testSerial(factory.createSerialTaskQueue("suspend_exclusive", WorkThreadPriority::WTP_Normal, true));
+
+    // 非独占串行队列在当前任务执行完后暂停
+    printf("-------------------- 执行中挂起 --------------------\n");
+    {
+        auto             queue = factory.createSerialTaskQueue("suspend_running", WorkThreadPriority::WTP_Normal, false);
+        std::atomic<int> ran{ 0 };
+        queue->async([&queue, &ran]() {
+            queue->suspend();
+            ran++;
+        });
+        for (int i = 0; i < 10; ++i)
+        {
+            queue->async([&ran]() { ran++; });
+        }
+        assert(waitUntil(ran, 1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        printf("ran while suspended: %d\n", ran.load());
+        assert(ran.load() == 1);
+        assert(queue->resume());
+        assert(waitUntil(ran, 11));
+    }
+
+    // 并行队列： 嵌套挂起， 延时任务到期时同样暂存
+    printf("-------------------- 并行队列 --------------------\n");
+    {
+        auto             queue = factory.createConcurrencyTaskQueue("suspend_parallel", TaskQueuePriority::TQP_Normal);
+        std::atomic<int> ran{ 0 };
+
+        assert(!queue->resume());
+        queue->suspend();
+        queue->suspend();
+        for (int i = 0; i < 1000; ++i)
+        {
+            assert(queue->async([&ran]() { ran++; }) == TaskSubmitResult::TSR_Suspended);
+        }
+        queue->after(std::chrono::milliseconds(10), [&ran]() { ran++; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        assert(ran.load() == 0);
+
+        assert(queue->resume());
+        assert(queue->isSuspended());
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        assert(ran.load() == 0);
+
+        auto start = std::chrono::steady_clock::now();
+        assert(queue->resume());
+        assert(!queue->isSuspended());
+        assert(waitUntil(ran, 1001));
+        auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        printf("flush 1001 tasks: %lld us\n", ( long long )cost);
+
+        // 挂起时长不计入排队耗时
+        auto stat = queue->latencyStat();
+        printf("wait p99: %llu us\n", ( unsigned long long )stat.mWait.mP99);
+        assert(stat.mWait.mP99 < 50000);
+    }
+
+    // 同步任务等待到恢复； 取消挂起期间的任务
+    printf("-------------------- 同步任务/取消 --------------------\n");
+    {
+        auto             queue = factory.createConcurrencyTaskQueue("suspend_sync", TaskQueuePriority::TQP_Normal);
+        std::atomic<int> ran{ 0 };
+
+        queue->suspend();
+        std::thread resumer([&queue]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            queue->resume();
+        });
+        queue->sync([&ran]() { ran++; });
+        assert(ran.load() == 1);
+        resumer.join();
+
+        auto other = factory.createSerialTaskQueue("suspend_cancel", WorkThreadPriority::WTP_Normal, true);
+        other->setCancelTracking(true);
+        other->suspend();
+        auto group = factory.createTaskGroup();
+        for (int i = 0; i < 10; ++i)
+        {
+            group->asyncQueue([&ran]() { ran++; }, other);
+        }
+        auto cancelled = other->cancelAll();
+        printf("cancelled: %zu\n", cancelled);
+        assert(cancelled == 10);
+        // 已取消的任务从暂存中移除， 任务组不用等到恢复
+        assert(group->wait(std::chrono::milliseconds(1000)));
+        assert(other->resume());
+        other->sync([]() {});
+        assert(ran.load() == 1);
+    }
+
+    printf("-------------挂起/恢复测试完成-------------\n");
+    getchar();
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include "../TaskDispatch.h"
+#include "../TaskQueueConstant.h"
+#include "../TaskQueueReporter.h"
+#include "../TaskQueueReportSink.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+using namespace task;
+
+// clang++ -o test TestWorkThreadWatchdog.cpp -L../build/lib -ldispatch_queue -Wl,-rpath,@loader_path/../build/lib -g -O0
+
+static std::atomic<bool> sRelease{ false };
+
+// 卡住的任务， 堆栈中应包含此函数
+__attribute__((noinline)) static void blockedFunction()
+{
+    while (!sRelease.load())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+static bool containsFunction(const TaskDurationExceedEvent& event, void (*function)())
+{
+    const auto begin = reinterpret_cast<uint64_t>(function);
+    for (uint32_t i = 0; i < event.mStackDepth; ++i)
+    {
+        if (event.mStack[i] > begin && event.mStack[i] < begin + 256)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char* argv[])
+{
+    printf("-------------------------------------- 看门狗测试 --------------------------------------\n");
+
+    TaskQueueConstant::sBlockTimeoutThreshold = 300;
+    TaskQueueConstant::sWatchdogInterval      = 50;
+
+    auto& reporter = TaskQueueReporter::GetInstance();
+    auto& factory  = TaskQueueFactory::GetInstance();
+
+    std::mutex                           mutex;
+    std::vector<TaskDurationExceedEvent> events;
+    auto sink = std::make_shared<TaskQueueCallbackSink>([&mutex, &events](const TaskQueueReportEvent& event) {
+        if (event.mType == TaskQueueReporterType::TQRT_TaskDurationExceedThreshold)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            events.push_back(event.mDuration);
+        }
+    });
+    reporter.addSink(sink);
+
+    auto waitEvent = [&mutex, &events](TaskQueueType type) {
+        for (int i = 0; i < 300; ++i)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (auto& event : events)
+                {
+                    if (event.mPoolType == type)
+                    {
+                        return event;
+                    }
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return TaskDurationExceedEvent();
+    };
+
+    // 并行线程池： 上报堆栈， 补偿线程后其他任务继续执行
+    printf("-------------------- 并行线程池 --------------------\n");
+    {
+        auto queue = factory.createConcurrencyTaskQueue("watchdog_parallel", TaskQueuePriority::TQP_Normal);
+        auto begin = std::chrono::steady_clock::now();
+        queue->async([]() { blockedFunction(); });
+
+        // 线程池占满后， 其余任务由补偿的线程执行
+        std::atomic<int> finished{ 0 };
+        const int        count = ( int )std::thread::hardware_concurrency();
+        for (int i = 1; i < count; ++i)
+        {
+            queue->async([]() { blockedFunction(); });
+        }
+        queue->async([&finished]() { finished++; });
+
+        auto event = waitEvent(TaskQueueType::TQT_Parallel);
+        assert(event.mThreadId >= 0);
+        assert(event.mBlockedMillis >= 300);
+        printf("卡住线程: %d, 已执行: %llu ms, 堆栈帧数: %u\n", event.mThreadId, ( unsigned long long )event.mBlockedMillis,
+               event.mStackDepth);
+        TaskQueueReportEvent wrapped(event);
+        char                 line[256];
+        for (size_t i = 0; TaskQueueReporter::formatFrame(wrapped, i, line, sizeof(line)) > 0; ++i)
+        {
+            printf("%s\n", line);
+        }
+        assert(event.mStackDepth > 0);
+        assert(containsFunction(event, &blockedFunction));
+
+        for (int i = 0; i < 200 && finished.load() == 0; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        assert(finished.load() == 1);
+        printf("补偿线程执行任务, 耗时: %lld ms\n",
+               ( long long )std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count());
+
+        // 同一个卡住的任务只上报一次
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            int                         reported = 0;
+            for (auto& item : events)
+            {
+                reported += item.mThreadId == event.mThreadId ? 1 : 0;
+            }
+            assert(reported == 1);
+        }
+
+        sRelease = true;
+        queue->sync([]() {});
+        sRelease = false;
+    }
+
+    // 独占线程： 只上报
+    printf("-------------------- 独占线程 --------------------\n");
+    {
+        auto queue = factory.createSerialTaskQueue("watchdog_serial", WorkThreadPriority::WTP_Normal, true);
+        queue->async([]() { blockedFunction(); });
+
+        auto event = waitEvent(TaskQueueType::TQT_Serial);
+        printf("卡住线程: %d, 名称: %s, 堆栈帧数: %u\n", event.mThreadId, event.mThreadName, event.mStackDepth);
+        assert(event.mThreadId >= 0);
+        assert(containsFunction(event, &blockedFunction));
+
+        sRelease = true;
+        queue->sync([]() {});
+    }
+
+    reporter.flush();
+    reporter.removeSink(sink);
+    printf("-------------看门狗测试完成-------------\n");
+    getchar();
+    return 0;
+}